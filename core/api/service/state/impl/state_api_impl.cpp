@@ -93,6 +93,30 @@ namespace kagome::api {
     return trie_reader->get(key);
   }
 
+  outcome::result<std::vector<primitives::StorageChangeSet>>
+  StateApiImpl::queryStorageAt(
+      const std::vector<common::Buffer> &keys,
+      const boost::optional<primitives::BlockHash> &at) const {
+    auto block = at ? at.value() : block_tree_->getLastFinalized().hash;
+    OUTCOME_TRY(header, block_repo_->getBlockHeader(block));
+    OUTCOME_TRY(trie_reader, storage_->getEphemeralBatchAt(header.state_root));
+    auto values = trie_reader->getMany(keys);
+
+    primitives::StorageChangeSet change_set{block, {}};
+    change_set.changes.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto &value = values.at(i);
+      if (value) {
+        change_set.changes.push_back({keys[i], std::move(value.value())});
+      } else if (value.error() == storage::trie::TrieError::NO_VALUE) {
+        change_set.changes.push_back({keys[i], boost::none});
+      } else {
+        return value.error();
+      }
+    }
+    return std::vector{std::move(change_set)};
+  }
+
   outcome::result<primitives::Version> StateApiImpl::getRuntimeVersion(
       const boost::optional<primitives::BlockHash> &at) const {
     return runtime_core_->version(at);
@@ -39,6 +39,10 @@ namespace kagome::api {
         const common::Buffer &key,
         const primitives::BlockHash &at) const override;
 
+    outcome::result<std::vector<primitives::StorageChangeSet>> queryStorageAt(
+        const std::vector<common::Buffer> &keys,
+        const boost::optional<primitives::BlockHash> &at) const override;
+
     outcome::result<uint32_t> subscribeStorage(
         const std::vector<common::Buffer> &keys) override;
     outcome::result<bool> unsubscribeStorage(
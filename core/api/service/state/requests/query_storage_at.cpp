@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/state/requests/query_storage_at.hpp"
+
+namespace kagome::api::state::request {
+
+  outcome::result<void> QueryStorageAt::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 2 or params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    auto &keys = params[0];
+    if (not keys.IsArray()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'keys' must be a string array of the storage keys");
+    }
+
+    auto &key_str_array = keys.AsArray();
+    keys_.clear();
+    keys_.reserve(key_str_array.size());
+    for (auto &key_str : key_str_array) {
+      if (not key_str.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'keys' must be a string array of the storage keys");
+      }
+      OUTCOME_TRY(key, common::unhexWith0x(key_str.AsString()));
+      keys_.emplace_back(std::move(key));
+    }
+
+    at_.reset();
+    if (params.size() > 1) {
+      auto &param1 = params[1];
+      if (param1.IsString()) {
+        OUTCOME_TRY(at_span, common::unhexWith0x(param1.AsString()));
+        OUTCOME_TRY(at, primitives::BlockHash::fromSpan(at_span));
+        at_ = at;
+      } else if (not param1.IsNil()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'at' must be a hex string or null");
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<primitives::StorageChangeSet>>
+  QueryStorageAt::execute() {
+    return api_->queryStorageAt(keys_, at_);
+  }
+
+}  // namespace kagome::api::state::request
@@ -0,0 +1,43 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_QUERY_STORAGE_AT
+#define KAGOME_API_REQUEST_QUERY_STORAGE_AT
+
+#include <jsonrpc-lean/request.h>
+
+#include <boost/optional.hpp>
+
+#include "api/service/state/state_api.hpp"
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "primitives/storage_change_set.hpp"
+
+namespace kagome::api::state::request {
+
+  class QueryStorageAt final {
+   public:
+    QueryStorageAt(const QueryStorageAt &) = delete;
+    QueryStorageAt &operator=(const QueryStorageAt &) = delete;
+
+    QueryStorageAt(QueryStorageAt &&) = default;
+    QueryStorageAt &operator=(QueryStorageAt &&) = default;
+
+    explicit QueryStorageAt(std::shared_ptr<StateApi> api)
+        : api_(std::move(api)){};
+    ~QueryStorageAt() = default;
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+    outcome::result<std::vector<primitives::StorageChangeSet>> execute();
+
+   private:
+    std::shared_ptr<StateApi> api_;
+    std::vector<common::Buffer> keys_;
+    boost::optional<primitives::BlockHash> at_;
+  };
+
+}  // namespace kagome::api::state::request
+
+#endif  // KAGOME_API_REQUEST_QUERY_STORAGE_AT
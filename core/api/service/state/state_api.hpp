@@ -12,6 +12,7 @@
 #include "common/buffer.hpp"
 #include "outcome/outcome.hpp"
 #include "primitives/common.hpp"
+#include "primitives/storage_change_set.hpp"
 #include "primitives/version.hpp"
 
 namespace kagome::api {
@@ -34,6 +35,14 @@ namespace kagome::api {
     virtual outcome::result<common::Buffer> getStorage(
         const common::Buffer &key, const primitives::BlockHash &at) const = 0;
 
+    /**
+     * @returns values of \arg keys at the block \arg at, or at the last
+     * finalized block if it is not given
+     */
+    virtual outcome::result<std::vector<primitives::StorageChangeSet>>
+    queryStorageAt(const std::vector<common::Buffer> &keys,
+                   const boost::optional<primitives::BlockHash> &at) const = 0;
+
     virtual outcome::result<uint32_t> subscribeStorage(
         const std::vector<common::Buffer> &keys) = 0;
     virtual outcome::result<bool> unsubscribeStorage(
@@ -10,6 +10,7 @@
 #include "api/service/state/requests/get_metadata.hpp"
 #include "api/service/state/requests/get_runtime_version.hpp"
 #include "api/service/state/requests/get_storage.hpp"
+#include "api/service/state/requests/query_storage_at.hpp"
 #include "api/service/state/requests/subscribe_runtime_version.hpp"
 #include "api/service/state/requests/subscribe_storage.hpp"
 #include "api/service/state/requests/unsubscribe_runtime_version.hpp"
@@ -39,6 +40,9 @@ namespace kagome::api::state {
     server_->registerHandler("state_getStorageAt",
                              Handler<request::GetStorage>(api_));
 
+    server_->registerHandler("state_queryStorageAt",
+                             Handler<request::QueryStorageAt>(api_));
+
     server_->registerHandler("state_getRuntimeVersion",
                              Handler<request::GetRuntimeVersion>(api_));
 
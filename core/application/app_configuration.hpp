@@ -18,6 +18,7 @@
 #include "log/logger.hpp"
 #include "network/peering_config.hpp"
 #include "network/types/roles.hpp"
+#include "storage/leveldb/leveldb_config.hpp"
 
 namespace kagome::application {
 
@@ -35,6 +36,18 @@ namespace kagome::application {
 
     virtual ~AppConfiguration() = default;
 
+    /**
+     * How the runtime code is executed
+     */
+    enum class RuntimeExecutionMethod {
+      /// the code is interpreted as it is
+      Interpret,
+      /// the code is optimized ahead of the calls by the optimization passes
+      /// of the interpreter and then interpreted, and the optimized code is
+      /// kept on disk
+      Optimize
+    };
+
     /**
      * @return roles of current run
      */
@@ -63,6 +76,60 @@ namespace kagome::application {
     virtual boost::filesystem::path keystorePath(
         std::string chain_id) const = 0;
 
+    /**
+     * @return path to the directory the optimized runtime codes of the chain
+     * \arg chain_id are kept in
+     */
+    virtual boost::filesystem::path runtimeCacheDirPath(
+        std::string chain_id) const = 0;
+
+    /**
+     * @return max number of decoded trie nodes kept in memory; 0 disables
+     * the cache
+     */
+    virtual uint32_t trieNodeCacheSize() const = 0;
+
+    /**
+     * @return true if a flat snapshot of the finalized state should be kept
+     * in the database to serve reads at that state without a trie walk
+     */
+    virtual bool isFlatStateEnabled() const = 0;
+
+    /**
+     * @return number of finalized states to keep in the database, or none if
+     * no state is ever removed
+     */
+    virtual boost::optional<uint32_t> statePruningDepth() const = 0;
+
+    /**
+     * @return minimal number of modified trie nodes to encode and hash them on
+     * several threads when a trie is stored; 0 stands for a single thread
+     */
+    virtual uint32_t parallelTrieCommitThreshold() const = 0;
+
+    /**
+     * @return sizes of the caches and buffers of the node's database
+     */
+    virtual const storage::LevelDBConfig &levelDbConfig() const = 0;
+
+    /**
+     * @return max number of ready instances kept for each runtime code, or
+     * none to keep one per core
+     */
+    virtual boost::optional<uint32_t> runtimeInstancePoolSize() const = 0;
+
+    /**
+     * @return max total size in megabytes of the kept results of the runtime
+     * calls which depend only on the runtime code or the state, like the
+     * runtime version and metadata; 0 disables the cache
+     */
+    virtual uint32_t runtimeCallCacheSize() const = 0;
+
+    /**
+     * @return how the runtime code is executed
+     */
+    virtual RuntimeExecutionMethod runtimeExecMethod() const = 0;
+
     /**
      * @return the secret key to use for libp2p networking
      */
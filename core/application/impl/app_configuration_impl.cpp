@@ -42,6 +42,13 @@ namespace {
   const uint16_t def_p2p_port = 30363;
   const int def_verbosity = static_cast<int>(kagome::log::Level::INFO);
   const bool def_dev_mode = false;
+  const uint32_t def_trie_node_cache_size = 65536;
+  const bool def_flat_state_enabled = false;
+  const uint32_t def_parallel_trie_commit_threshold = 4096;
+  const uint32_t def_runtime_call_cache_size = 32;
+  const auto def_runtime_exec_method =
+      kagome::application::AppConfiguration::RuntimeExecutionMethod::Interpret;
+  const size_t kMegabyte = 1024 * 1024;
   const kagome::network::Roles def_roles = [] {
     kagome::network::Roles roles;
     roles.flags.full = 1;
@@ -77,6 +84,11 @@ namespace kagome::application {
         rpc_http_host_(def_rpc_http_host),
         rpc_ws_host_(def_rpc_ws_host),
         openmetrics_http_host_(def_openmetrics_http_host),
+        trie_node_cache_size_(def_trie_node_cache_size),
+        flat_state_enabled_(def_flat_state_enabled),
+        parallel_trie_commit_threshold_(def_parallel_trie_commit_threshold),
+        runtime_call_cache_size_(def_runtime_call_cache_size),
+        runtime_exec_method_(def_runtime_exec_method),
         rpc_http_port_(def_rpc_http_port),
         rpc_ws_port_(def_rpc_ws_port),
         openmetrics_http_port_(def_openmetrics_http_port),
@@ -101,6 +113,25 @@ namespace kagome::application {
     return chainPath(chain_id) / "keystore";
   }
 
+  fs::path AppConfigurationImpl::runtimeCacheDirPath(
+      std::string chain_id) const {
+    return chainPath(chain_id) / "runtimes";
+  }
+
+  boost::optional<AppConfiguration::RuntimeExecutionMethod>
+  AppConfigurationImpl::parseRuntimeExecMethod(const std::string &str) const {
+    if (str == "Interpreted") {
+      return RuntimeExecutionMethod::Interpret;
+    }
+    if (str == "Optimized") {
+      return RuntimeExecutionMethod::Optimize;
+    }
+    logger_->error("Invalid runtime execution method '{}', expected "
+                   "'Interpreted' or 'Optimized'",
+                   str);
+    return boost::none;
+  }
+
   AppConfigurationImpl::FilePtr AppConfigurationImpl::open_file(
       const std::string &filepath) {
     assert(!filepath.empty());
@@ -194,12 +225,45 @@ namespace kagome::application {
     std::string chain_spec_path_str;
     load_str(val, "chain", chain_spec_path_str);
     chain_spec_path_ = fs::path(chain_spec_path_str);
+    uint32_t runtime_instance_pool_size = 0;
+    if (load_u32(val, "runtime-instances", runtime_instance_pool_size)) {
+      runtime_instance_pool_size_ = runtime_instance_pool_size;
+    }
+    load_u32(val, "runtime-call-cache", runtime_call_cache_size_);
+    std::string runtime_exec_method_str;
+    if (load_str(val, "wasm-execution", runtime_exec_method_str)) {
+      if (auto method = parseRuntimeExecMethod(runtime_exec_method_str)) {
+        runtime_exec_method_ = method.value();
+      }
+    }
   }
 
   void AppConfigurationImpl::parse_storage_segment(rapidjson::Value &val) {
     std::string base_path_str;
     load_str(val, "base-path", base_path_str);
     base_path_ = fs::path(base_path_str);
+    load_u32(val, "trie-node-cache", trie_node_cache_size_);
+    load_bool(val, "enable-flat-state", flat_state_enabled_);
+    uint32_t state_pruning_depth = 0;
+    if (load_u32(val, "state-pruning", state_pruning_depth)) {
+      state_pruning_depth_ = state_pruning_depth;
+    }
+    load_u32(
+        val, "parallel-commit-threshold", parallel_trie_commit_threshold_);
+    uint32_t db_cache_mb = 0;
+    if (load_u32(val, "db-cache", db_cache_mb)) {
+      leveldb_config_.block_cache_size = db_cache_mb * kMegabyte;
+    }
+    load_u32(val, "db-bloom-bits", leveldb_config_.bloom_filter_bits);
+    uint32_t db_write_buffer_mb = 0;
+    if (load_u32(val, "db-write-buffer", db_write_buffer_mb)) {
+      leveldb_config_.write_buffer_size = db_write_buffer_mb * kMegabyte;
+    }
+    load_u32(val, "db-max-open-files", leveldb_config_.max_open_files);
+    bool db_compression_disabled = false;
+    if (load_bool(val, "disable-db-compression", db_compression_disabled)) {
+      leveldb_config_.compression = not db_compression_disabled;
+    }
   }
 
   void AppConfigurationImpl::parse_network_segment(rapidjson::Value &val) {
@@ -345,11 +409,23 @@ namespace kagome::application {
     po::options_description blockhain_desc("Blockchain options");
     blockhain_desc.add_options()
         ("chain", po::value<std::string>(), "required, chainspec file path")
+        ("runtime-instances", po::value<uint32_t>(), "number of ready runtime instances to keep, each taking the initial memory of the runtime; 0 to instantiate the runtime for each call (one per core by default)")
+        ("runtime-call-cache", po::value<uint32_t>(), "size in megabytes of the cache of the runtime version, metadata and other results of runtime calls which depend only on the runtime code or the state; 0 to disable (32 by default)")
+        ("wasm-execution", po::value<std::string>(), "choose the desired wasm execution method: Interpreted, Optimized (Interpreted by default); an optimized runtime is kept in the chain directory")
         ;
 
     po::options_description storage_desc("Storage options");
     storage_desc.add_options()
         ("base-path,d", po::value<std::string>(), "required, node base path (keeps storage and keys for known chains)")
+        ("trie-node-cache", po::value<uint32_t>(), "number of decoded state trie nodes to keep in memory; 0 to disable the cache (65536 by default)")
+        ("enable-flat-state", "keep a flat snapshot of the finalized state for faster reads")
+        ("state-pruning", po::value<uint32_t>(), "number of finalized states to keep; older states are removed from a database created with this option (keeps all states by default)")
+        ("parallel-commit-threshold", po::value<uint32_t>(), "number of modified trie nodes to store a trie on several threads from; 0 to always use one thread (4096 by default)")
+        ("db-cache", po::value<uint32_t>(), "size of the database block cache in MiB (64 by default)")
+        ("db-bloom-bits", po::value<uint32_t>(), "bits per key of the database bloom filters; 0 to disable them (10 by default)")
+        ("db-write-buffer", po::value<uint32_t>(), "size of the database writes kept in memory in MiB (16 by default)")
+        ("db-max-open-files", po::value<uint32_t>(), "max number of database files kept open (1000 by default)")
+        ("disable-db-compression", "store the database blocks without compression")
         ;
 
     po::options_description network_desc("Network options");
@@ -619,6 +695,64 @@ namespace kagome::application {
       }
     }
 
+    find_argument<uint32_t>(vm, "trie-node-cache", [&](uint32_t val) {
+      trie_node_cache_size_ = val;
+    });
+
+    if (vm.count("enable-flat-state") > 0) {
+      flat_state_enabled_ = true;
+    }
+
+    find_argument<uint32_t>(vm, "state-pruning", [&](uint32_t val) {
+      state_pruning_depth_ = val;
+    });
+
+    find_argument<uint32_t>(
+        vm, "parallel-commit-threshold", [&](uint32_t val) {
+          parallel_trie_commit_threshold_ = val;
+        });
+
+    find_argument<uint32_t>(vm, "runtime-instances", [&](uint32_t val) {
+      runtime_instance_pool_size_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "runtime-call-cache", [&](uint32_t val) {
+      runtime_call_cache_size_ = val;
+    });
+
+    bool runtime_exec_method_valid = true;
+    find_argument<std::string>(
+        vm, "wasm-execution", [&](const std::string &val) {
+          if (auto method = parseRuntimeExecMethod(val)) {
+            runtime_exec_method_ = method.value();
+          } else {
+            runtime_exec_method_valid = false;
+          }
+        });
+    if (not runtime_exec_method_valid) {
+      return false;
+    }
+
+    find_argument<uint32_t>(vm, "db-cache", [&](uint32_t val) {
+      leveldb_config_.block_cache_size = val * kMegabyte;
+    });
+
+    find_argument<uint32_t>(vm, "db-bloom-bits", [&](uint32_t val) {
+      leveldb_config_.bloom_filter_bits = val;
+    });
+
+    find_argument<uint32_t>(vm, "db-write-buffer", [&](uint32_t val) {
+      leveldb_config_.write_buffer_size = val * kMegabyte;
+    });
+
+    find_argument<uint32_t>(vm, "db-max-open-files", [&](uint32_t val) {
+      leveldb_config_.max_open_files = val;
+    });
+
+    if (vm.count("disable-db-compression") > 0) {
+      leveldb_config_.compression = false;
+    }
+
     find_argument<uint32_t>(vm, "max-blocks-in-response", [&](uint32_t val) {
       max_blocks_in_response_ = val;
     });
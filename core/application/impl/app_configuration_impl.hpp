@@ -72,6 +72,8 @@ namespace kagome::application {
     boost::filesystem::path chainPath(std::string chain_id) const override;
     boost::filesystem::path databasePath(std::string chain_id) const override;
     boost::filesystem::path keystorePath(std::string chain_id) const override;
+    boost::filesystem::path runtimeCacheDirPath(
+        std::string chain_id) const override;
 
     const boost::optional<crypto::Ed25519PrivateKey> &nodeKey() const override {
       return node_key_;
@@ -119,6 +121,30 @@ namespace kagome::application {
     const network::PeeringConfig &peeringConfig() const override {
       return peering_config_;
     }
+    uint32_t trieNodeCacheSize() const override {
+      return trie_node_cache_size_;
+    }
+    bool isFlatStateEnabled() const override {
+      return flat_state_enabled_;
+    }
+    boost::optional<uint32_t> statePruningDepth() const override {
+      return state_pruning_depth_;
+    }
+    uint32_t parallelTrieCommitThreshold() const override {
+      return parallel_trie_commit_threshold_;
+    }
+    const storage::LevelDBConfig &levelDbConfig() const override {
+      return leveldb_config_;
+    }
+    boost::optional<uint32_t> runtimeInstancePoolSize() const override {
+      return runtime_instance_pool_size_;
+    }
+    uint32_t runtimeCallCacheSize() const override {
+      return runtime_call_cache_size_;
+    }
+    RuntimeExecutionMethod runtimeExecMethod() const override {
+      return runtime_exec_method_;
+    }
     bool isRunInDevMode() const override {
       return dev_mode_;
     }
@@ -169,6 +195,9 @@ namespace kagome::application {
                   uint32_t &target);
     bool load_bool(const rapidjson::Value &val, char const *name, bool &target);
 
+    boost::optional<RuntimeExecutionMethod> parseRuntimeExecMethod(
+        const std::string &str) const;
+
     boost::asio::ip::tcp::endpoint get_endpoint_from(const std::string &host,
                                                      uint16_t port);
     FilePtr open_file(const std::string &filepath);
@@ -192,6 +221,14 @@ namespace kagome::application {
     std::string openmetrics_http_host_;
     boost::filesystem::path chain_spec_path_;
     boost::filesystem::path base_path_;
+    uint32_t trie_node_cache_size_;
+    bool flat_state_enabled_;
+    boost::optional<uint32_t> state_pruning_depth_;
+    uint32_t parallel_trie_commit_threshold_;
+    storage::LevelDBConfig leveldb_config_;
+    boost::optional<uint32_t> runtime_instance_pool_size_;
+    uint32_t runtime_call_cache_size_;
+    RuntimeExecutionMethod runtime_exec_method_;
     uint16_t rpc_http_port_;
     uint16_t rpc_ws_port_;
     uint16_t openmetrics_http_port_;
@@ -6,9 +6,13 @@
 #ifndef KAGOME_BLOCK_STORAGE_HPP
 #define KAGOME_BLOCK_STORAGE_HPP
 
+#include <boost/optional.hpp>
+
 #include "primitives/block.hpp"
 #include "primitives/block_data.hpp"
 #include "primitives/block_id.hpp"
+#include "primitives/common.hpp"
+#include "primitives/hashed_block_header.hpp"
 #include "primitives/justification.hpp"
 
 namespace kagome::blockchain {
@@ -48,6 +52,14 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::BlockHash> putBlock(
         const primitives::Block &block) = 0;
 
+    /**
+     * Puts the block with \arg header, whose hash and encoding are already
+     * calculated, and \arg body
+     */
+    virtual outcome::result<void> putBlock(
+        const primitives::HashedBlockHeader &header,
+        const primitives::BlockBody &body) = 0;
+
     virtual outcome::result<void> putJustification(
         const primitives::Justification &j,
         const primitives::BlockHash &hash,
@@ -56,6 +68,32 @@ namespace kagome::blockchain {
     virtual outcome::result<void> removeBlock(
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) = 0;
+
+    /**
+     * @returns hash of the block with \arg number in the canonical chain,
+     * i.e. the finalized chain continued by the best one, or none if there is
+     * no such block marked
+     */
+    virtual outcome::result<boost::optional<primitives::BlockHash>>
+    getCanonicalHash(primitives::BlockNumber number) const = 0;
+
+    /**
+     * @returns hashes of the canonical chain blocks with numbers from \arg from
+     * to \arg to inclusive, read in a single scan; the hashes end before the
+     * first number with no block marked
+     */
+    virtual outcome::result<std::vector<primitives::BlockHash>>
+    getCanonicalHashes(primitives::BlockNumber from,
+                       primitives::BlockNumber to) const = 0;
+
+    /**
+     * Unmarks the canonical chain blocks at \arg removed numbers and marks the
+     * \arg marked blocks instead, all in one write, so the index never holds a
+     * mix of the old and the new chain
+     */
+    virtual outcome::result<void> updateCanonicalHashes(
+        const std::vector<primitives::BlockNumber> &removed,
+        const std::vector<primitives::BlockInfo> &marked) = 0;
   };
 
 }  // namespace kagome::blockchain
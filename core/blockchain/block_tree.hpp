@@ -14,6 +14,7 @@
 #include "outcome/outcome.hpp"
 #include "primitives/block.hpp"
 #include "primitives/block_id.hpp"
+#include "primitives/hashed_block_header.hpp"
 #include "primitives/common.hpp"
 #include "primitives/justification.hpp"
 #include "primitives/version.hpp"
@@ -111,6 +112,16 @@ namespace kagome::blockchain {
      */
     virtual outcome::result<void> addBlock(const primitives::Block &block) = 0;
 
+    /**
+     * Add a new block to the tree as addBlock(block) does, but with the hash
+     * of its \arg header already calculated
+     * @param header of the block along with its hash
+     * @param body of the block
+     */
+    virtual outcome::result<void> addBlock(
+        const primitives::HashedBlockHeader &header,
+        const primitives::BlockBody &body) = 0;
+
     /**
      * Mark the block as finalized and store a finalization justification
      * @param block to be finalized
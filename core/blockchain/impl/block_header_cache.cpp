@@ -0,0 +1,42 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+namespace kagome::blockchain {
+
+  BlockHeaderCache::BlockHeaderCache(size_t capacity) : cache_{capacity} {}
+
+  std::shared_ptr<const primitives::BlockHeader> BlockHeaderCache::get(
+      const primitives::BlockHash &hash) {
+    return cache_.get(hash);
+  }
+
+  void BlockHeaderCache::put(const primitives::BlockHash &hash,
+                             const primitives::BlockHeader &header) {
+    cache_.put(hash, std::make_shared<const primitives::BlockHeader>(header));
+  }
+
+  void BlockHeaderCache::remove(const primitives::BlockHash &hash) {
+    cache_.remove(hash);
+  }
+
+  size_t BlockHeaderCache::size() const {
+    return cache_.entries();
+  }
+
+  size_t BlockHeaderCache::capacity() const {
+    return cache_.maxEntries();
+  }
+
+  uint64_t BlockHeaderCache::hits() const {
+    return cache_.hits();
+  }
+
+  uint64_t BlockHeaderCache::misses() const {
+    return cache_.misses();
+  }
+
+}  // namespace kagome::blockchain
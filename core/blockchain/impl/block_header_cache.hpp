@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE
+#define KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE
+
+#include <memory>
+
+#include "common/lru_cache.hpp"
+#include "primitives/block_header.hpp"
+
+namespace kagome::blockchain {
+
+  /**
+   * Bounded LRU cache of decoded block headers by their hashes, shared by the
+   * header repository and the block storage, so that the headers of the
+   * recent blocks are neither read from the database nor decoded again.
+   * A hash always denotes the same header, so an entry may only become
+   * outdated by the removal of its block.
+   * Thread-safe.
+   */
+  class BlockHeaderCache {
+   public:
+    static constexpr size_t kDefaultCapacity = 8192;
+
+    /**
+     * @param capacity max number of the kept headers
+     */
+    explicit BlockHeaderCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * @returns the header of the block with \arg hash, or nullptr if there is
+     * no such header in the cache
+     */
+    std::shared_ptr<const primitives::BlockHeader> get(
+        const primitives::BlockHash &hash);
+
+    /**
+     * Puts the \arg header of the block with \arg hash to the cache, evicting
+     * the least recently used header if the cache is full
+     */
+    void put(const primitives::BlockHash &hash,
+             const primitives::BlockHeader &header);
+
+    /**
+     * Forgets the header of the block with \arg hash
+     */
+    void remove(const primitives::BlockHash &hash);
+
+    size_t size() const;
+    size_t capacity() const;
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+   private:
+    common::LruCache<primitives::BlockHash, primitives::BlockHeader> cache_;
+  };
+
+}  // namespace kagome::blockchain
+
+#endif  // KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE
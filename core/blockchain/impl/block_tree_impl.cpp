@@ -6,6 +6,7 @@
 #include "blockchain/impl/block_tree_impl.hpp"
 
 #include <algorithm>
+#include <deque>
 
 #include "blockchain/block_tree_error.hpp"
 #include "blockchain/impl/common.hpp"
@@ -72,6 +73,19 @@ namespace kagome::blockchain {
                          ? parent->next_epoch_digest
                          : epoch_digest = parent->epoch_digest;
       next_epoch_digest = parent->next_epoch_digest;
+
+      // two jumps of the same length are merged into one twice as long, so
+      // the jump lengths form a skew-binary sequence
+      auto parent_jump = parent->jump.lock();
+      auto parent_jump_jump =
+          parent_jump ? parent_jump->jump.lock() : std::shared_ptr<TreeNode>{};
+      if (parent_jump_jump
+          && parent->depth - parent_jump->depth
+                 == parent_jump->depth - parent_jump_jump->depth) {
+        jump = parent_jump_jump;
+      } else {
+        jump = parent;
+      }
     } else {
       epoch_digest = std::make_shared<consensus::EpochDigest>(
           next_epoch_digest_opt.value());
@@ -90,66 +104,22 @@ namespace kagome::blockchain {
     }
   }
 
-  boost::optional<std::vector<std::shared_ptr<BlockTreeImpl::TreeNode>>>
-  BlockTreeImpl::TreeNode::getPathTo(const primitives::BlockHash &hash) {
-    std::vector<std::shared_ptr<TreeNode>> stack{shared_from_this()};
-    std::unordered_map<primitives::BlockNumber, size_t> forks;
-
-    bool came_back = false;
-    while (not stack.empty()) {
-      auto &current = stack.back();
-
-      // Found
-      if (current->block_hash == hash) {
-        return stack;
-      }
-
-      // Straight
-      if (current->children.size() == 1) {
-        if (not came_back) {
-          // Go to children
-          stack.push_back(current->children.front());
-          continue;
-        }
-        // else - continue going back
-      }
-
-      // Fork
-      if (current->children.size() > 1) {
-        auto &children_index = forks[current->depth];
-        if (children_index < current->children.size()) {
-          // Go to next child
-          stack.push_back(current->children[children_index++]);
-          came_back = false;
-          continue;
-        }
-        // else (no more children) - going back
-      }
-
-      // Going back
-      forks.erase(current->depth);
-      stack.pop_back();
-      came_back = true;
+  std::shared_ptr<BlockTreeImpl::TreeNode>
+  BlockTreeImpl::TreeNode::getAncestorAt(primitives::BlockNumber depth) {
+    if (depth > this->depth) {
+      return nullptr;
     }
-    return boost::none;
-  }
-
-  std::shared_ptr<BlockTreeImpl::TreeNode> BlockTreeImpl::TreeNode::getByHash(
-      const primitives::BlockHash &hash) {
-    // standard BFS
-    std::queue<std::shared_ptr<TreeNode>> nodes_to_scan;
-    nodes_to_scan.push(shared_from_this());
-    while (!nodes_to_scan.empty()) {
-      const auto &node = nodes_to_scan.front();
-      if (node->block_hash == hash) {
-        return node;
-      }
-      for (const auto &child : node->children) {
-        nodes_to_scan.push(child);
+    auto node = shared_from_this();
+    while (node->depth > depth) {
+      if (auto jump = node->jump.lock(); jump && jump->depth >= depth) {
+        node = std::move(jump);
+      } else if (auto parent = node->parent.lock()) {
+        node = std::move(parent);
+      } else {
+        return nullptr;
       }
-      nodes_to_scan.pop();
     }
-    return nullptr;
+    return node;
   }
 
   bool BlockTreeImpl::TreeNode::operator==(const TreeNode &other) const {
@@ -214,7 +184,9 @@ namespace kagome::blockchain {
           extrinsic_event_key_repo,
       std::shared_ptr<runtime::Core> runtime_core,
       std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-      std::shared_ptr<consensus::BabeUtil> babe_util) {
+      std::shared_ptr<consensus::BabeUtil> babe_util,
+      std::shared_ptr<storage::trie::FlatState> flat_state,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner) {
     // create meta structures from the retrieved header
     OUTCOME_TRY(hash, header_repo->getHashById(last_finalized_block));
     OUTCOME_TRY(number, header_repo->getNumberById(last_finalized_block));
@@ -338,7 +310,9 @@ namespace kagome::blockchain {
                                         std::move(extrinsic_event_key_repo),
                                         std::move(runtime_core),
                                         std::move(babe_configuration),
-                                        std::move(babe_util));
+                                        std::move(babe_util),
+                                        std::move(flat_state),
+                                        std::move(state_pruner));
     return std::shared_ptr<BlockTreeImpl>(block_tree);
   }
 
@@ -356,7 +330,9 @@ namespace kagome::blockchain {
           extrinsic_event_key_repo,
       std::shared_ptr<runtime::Core> runtime_core,
       std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-      std::shared_ptr<consensus::BabeUtil> babe_util)
+      std::shared_ptr<consensus::BabeUtil> babe_util,
+      std::shared_ptr<storage::trie::FlatState> flat_state,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner)
       : header_repo_{std::move(header_repo)},
         storage_{std::move(storage)},
         tree_{std::move(tree)},
@@ -368,7 +344,9 @@ namespace kagome::blockchain {
         extrinsic_event_key_repo_{std::move(extrinsic_event_key_repo)},
         runtime_core_(std::move(runtime_core)),
         babe_configuration_(std::move(babe_configuration)),
-        babe_util_(std::move(babe_util)) {
+        babe_util_(std::move(babe_util)),
+        flat_state_(std::move(flat_state)),
+        state_pruner_(std::move(state_pruner)) {
     BOOST_ASSERT(header_repo_ != nullptr);
     BOOST_ASSERT(storage_ != nullptr);
     BOOST_ASSERT(tree_ != nullptr);
@@ -381,6 +359,9 @@ namespace kagome::blockchain {
     BOOST_ASSERT(runtime_core_ != nullptr);
     BOOST_ASSERT(babe_configuration_ != nullptr);
     BOOST_ASSERT(babe_util_ != nullptr);
+    // the tree is grown from the last finalized block alone
+    BOOST_ASSERT(tree_->children.empty());
+    nodes_.emplace(tree_->block_hash, tree_.get());
     // initialize metrics
     registry_->registerGaugeFamily(kBlockHeightGaugeName,
                                      "Block height info of the chain");
@@ -394,7 +375,7 @@ namespace kagome::blockchain {
 
   outcome::result<void> BlockTreeImpl::addBlockHeader(
       const primitives::BlockHeader &header) {
-    auto parent = tree_->getByHash(header.parent_hash);
+    auto parent = getNode(header.parent_hash);
     if (!parent) {
       return BlockTreeError::NO_PARENT;
     }
@@ -416,13 +397,7 @@ namespace kagome::blockchain {
     // update local meta with the new block
     auto new_node = std::make_shared<TreeNode>(
         block_hash, header.number, parent, epoch_number, std::move(next_epoch));
-    parent->children.push_back(new_node);
-
-    tree_meta_->leaves.insert(new_node->block_hash);
-    tree_meta_->leaves.erase(parent->block_hash);
-    if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
-      tree_meta_->deepest_leaf = *new_node;
-    }
+    OUTCOME_TRY(updateMeta(new_node));
 
     chain_events_engine_->notify(primitives::events::ChainEventType::kNewHeads,
                                  header);
@@ -430,58 +405,122 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
-  void BlockTreeImpl::updateMeta(const std::shared_ptr<TreeNode> &new_node) {
+  outcome::result<void> BlockTreeImpl::updateMeta(
+      const std::shared_ptr<TreeNode> &new_node) {
     auto parent = new_node->parent.lock();
     parent->children.push_back(new_node);
+    nodes_.emplace(new_node->block_hash, new_node.get());
 
     tree_meta_->leaves.insert(new_node->block_hash);
     tree_meta_->leaves.erase(parent->block_hash);
     if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
+      auto prev_best_depth = tree_meta_->deepest_leaf.get().depth;
       tree_meta_->deepest_leaf = *new_node;
+      OUTCOME_TRY(updateCanonicalChain(*new_node, prev_best_depth));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> BlockTreeImpl::updateCanonicalChain(
+      const TreeNode &best_leaf, primitives::BlockNumber prev_best_depth) {
+    std::vector<primitives::BlockNumber> removed;
+    for (auto number = prev_best_depth; number > best_leaf.depth; --number) {
+      removed.push_back(number);
+    }
+    // the chains are the same below the first block already marked
+    std::vector<primitives::BlockInfo> marked;
+    std::shared_ptr<const TreeNode> node = best_leaf.shared_from_this();
+    while (node != nullptr) {
+      OUTCOME_TRY(canonical_hash, storage_->getCanonicalHash(node->depth));
+      if (canonical_hash and *canonical_hash == node->block_hash) {
+        break;
+      }
+      marked.emplace_back(node->depth, node->block_hash);
+      node = node->parent.lock();
+    }
+    if (removed.empty() and marked.empty()) {
+      return outcome::success();
+    }
+    return storage_->updateCanonicalHashes(removed, marked);
+  }
+
+  std::shared_ptr<BlockTreeImpl::TreeNode> BlockTreeImpl::getNode(
+      const primitives::BlockHash &hash) const {
+    auto it = nodes_.find(hash);
+    if (it == nodes_.end()) {
+      return nullptr;
+    }
+    return it->second->shared_from_this();
+  }
+
+  void BlockTreeImpl::unindexSubtree(const TreeNode &node) {
+    std::vector<const TreeNode *> to_unindex{&node};
+    while (not to_unindex.empty()) {
+      auto current = to_unindex.back();
+      to_unindex.pop_back();
+      nodes_.erase(current->block_hash);
+      for (const auto &child : current->children) {
+        to_unindex.push_back(child.get());
+      }
     }
   }
 
   outcome::result<void> BlockTreeImpl::addBlock(
       const primitives::Block &block) {
+    return addBlock(primitives::HashedBlockHeader{block.header, *hasher_},
+                    block.body);
+  }
+
+  outcome::result<void> BlockTreeImpl::addBlock(
+      const primitives::HashedBlockHeader &hashed_header,
+      const primitives::BlockBody &body) {
+    const auto &header = hashed_header.header();
+    const auto &block_hash = hashed_header.hash();
+
     // Check if we know parent of this block; if not, we cannot insert it
-    auto parent = tree_->getByHash(block.header.parent_hash);
+    auto parent = getNode(header.parent_hash);
     if (!parent) {
       return BlockTreeError::NO_PARENT;
     }
 
     // Save block
-    OUTCOME_TRY(block_hash, storage_->putBlock(block));
+    OUTCOME_TRY(storage_->putBlock(hashed_header, body));
+
+    // the block state has just been written, so it has to be kept from now on
+    if (state_pruner_ != nullptr) {
+      OUTCOME_TRY(state_pruner_->addState(header.state_root));
+    }
 
     consensus::EpochNumber epoch_number = 0;
-    auto babe_digests_res = consensus::getBabeDigests(block.header);
+    auto babe_digests_res = consensus::getBabeDigests(header);
     if (babe_digests_res.has_value()) {
       auto babe_slot = babe_digests_res.value().second.slot_number;
       epoch_number = babe_util_->slotToEpoch(babe_slot);
     }
 
     boost::optional<consensus::EpochDigest> next_epoch;
-    if (auto digest = consensus::getNextEpochDigest(block.header);
+    if (auto digest = consensus::getNextEpochDigest(header);
         digest.has_value()) {
       next_epoch.emplace(std::move(digest.value()));
     }
 
     // Update local meta with the block
     auto new_node = std::make_shared<TreeNode>(block_hash,
-                                               block.header.number,
+                                               header.number,
                                                parent,
                                                epoch_number,
                                                std::move(next_epoch));
 
-    updateMeta(new_node);
+    OUTCOME_TRY(updateMeta(new_node));
     chain_events_engine_->notify(primitives::events::ChainEventType::kNewHeads,
-                                 block.header);
-    for (size_t idx = 0; idx < block.body.size(); idx++) {
-      if (auto key = extrinsic_event_key_repo_->getEventKey(block.header.number,
+                                 header);
+    for (size_t idx = 0; idx < body.size(); idx++) {
+      if (auto key = extrinsic_event_key_repo_->getEventKey(header.number,
                                                             idx)) {
         extrinsic_events_engine_->notify(
             key.value(),
             primitives::events::ExtrinsicLifecycleEvent::InBlock(
-                key.value(), std::move(block_hash)));
+                key.value(), block_hash));
       }
     }
 
@@ -493,13 +532,13 @@ namespace kagome::blockchain {
   outcome::result<void> BlockTreeImpl::addExistingBlock(
       const primitives::BlockHash &block_hash,
       const primitives::BlockHeader &block_header) {
-    auto node = tree_->getByHash(block_hash);
+    auto node = getNode(block_hash);
     // Check if tree doesn't have this block; if not, we skip that
     if (node != nullptr) {
       return BlockTreeError::BLOCK_EXISTS;
     }
     // Check if we know parent of this block; if not, we cannot insert it
-    auto parent = tree_->getByHash(block_header.parent_hash);
+    auto parent = getNode(block_header.parent_hash);
     if (parent == nullptr) {
       return BlockTreeError::NO_PARENT;
     }
@@ -524,7 +563,7 @@ namespace kagome::blockchain {
                                                epoch_number,
                                                std::move(next_epoch));
 
-    updateMeta(new_node);
+    OUTCOME_TRY(updateMeta(new_node));
 
     return outcome::success();
   }
@@ -540,7 +579,7 @@ namespace kagome::blockchain {
   outcome::result<void> BlockTreeImpl::finalize(
       const primitives::BlockHash &block_hash,
       const primitives::Justification &justification) {
-    auto node = tree_->getByHash(block_hash);
+    auto node = getNode(block_hash);
     if (!node) {
       return BlockTreeError::NO_SUCH_BLOCK;
     }
@@ -555,18 +594,47 @@ namespace kagome::blockchain {
 
     // update our local meta
     node->finalized = true;
+    auto prev_best_depth = tree_meta_->deepest_leaf.get().depth;
 
     OUTCOME_TRY(prune(node));
 
+    // the ancestors of the finalized block and the forks off them are not
+    // kept in the tree anymore
+    const TreeNode *chain_node = node.get();
+    for (auto ancestor = node->parent.lock(); ancestor;
+         ancestor = ancestor->parent.lock()) {
+      for (const auto &child : ancestor->children) {
+        if (child.get() != chain_node) {
+          unindexSubtree(*child);
+        }
+      }
+      nodes_.erase(ancestor->block_hash);
+      chain_node = ancestor.get();
+    }
+
+    // the finalized chain is marked canonical while the ancestors of the
+    // finalized block are still linked
+    auto meta = std::make_shared<TreeMeta>(*node);
+    OUTCOME_TRY(
+        updateCanonicalChain(meta->deepest_leaf.get(), prev_best_depth));
+
     tree_ = node;
 
-    tree_meta_ = std::make_shared<TreeMeta>(*tree_);
+    tree_meta_ = std::move(meta);
 
     tree_->parent.reset();
 
     OUTCOME_TRY(storage_->setLastFinalizedBlockHash(node->block_hash));
     OUTCOME_TRY(header, storage_->getBlockHeader(node->block_hash));
 
+    if (flat_state_ != nullptr) {
+      if (auto res = flat_state_->finalize(header.state_root); not res) {
+        log_->error("Failed to update flat state to the block {}: {}",
+                    block_hash.toHex(),
+                    res.error().message());
+      }
+    }
+
     chain_events_engine_->notify(
         primitives::events::ChainEventType::kFinalizedHeads, header);
 
@@ -702,6 +770,19 @@ namespace kagome::blockchain {
              from,
              to);
 
+    // a chain of the canonical blocks is read from their index in a single
+    // scan instead of following the parents one header at a time
+    OUTCOME_TRY(top_canonical, storage_->getCanonicalHash(from));
+    OUTCOME_TRY(bottom_canonical, storage_->getCanonicalHash(to));
+    if (top_canonical and *top_canonical == top_block and bottom_canonical
+        and *bottom_canonical == bottom_block) {
+      OUTCOME_TRY(hashes,
+                  storage_->getCanonicalHashes(from, from + response_length - 1));
+      if (hashes.size() == response_length) {
+        return std::move(hashes);
+      }
+    }
+
     auto current_hash = bottom_block;
 
     std::deque<primitives::BlockHash> chain;
@@ -731,31 +812,31 @@ namespace kagome::blockchain {
       const primitives::BlockHash &top_block,
       const primitives::BlockHash &bottom_block,
       boost::optional<uint32_t> max_count) {
-    if (auto from = tree_->getByHash(top_block)) {
-      if (auto way_opt = from->getPathTo(bottom_block)) {
-        auto &way = way_opt.value();
-        const auto in_tree_branch_len = way.back()->depth - from->depth + 1;
-        const auto response_length =
-            max_count ? std::min(in_tree_branch_len, max_count.value())
-                      : in_tree_branch_len;
-        SL_TRACE(log_,
-                 "Create {} length chain from number {} to {} from cache.",
-                 response_length,
-                 from->depth,
-                 way.back()->depth);
-
-        way.resize(response_length);
-
-        std::vector<primitives::BlockHash> result;
-        result.reserve(response_length);
-        for (auto &s : way) {
-          result.emplace_back(s->block_hash);
-        }
+    auto from = getNode(top_block);
+    auto to = getNode(bottom_block);
+    if (from == nullptr || to == nullptr
+        || to->getAncestorAt(from->depth) != from) {
+      return boost::none;
+    }
 
-        return result;
-      }
+    const auto in_tree_branch_len = to->depth - from->depth + 1;
+    const auto response_length =
+        max_count ? std::min(in_tree_branch_len, max_count.value())
+                  : in_tree_branch_len;
+    SL_TRACE(log_,
+             "Create {} length chain from number {} to {} from cache.",
+             response_length,
+             from->depth,
+             to->depth);
+
+    // the chain is collected backwards from its last block
+    std::vector<primitives::BlockHash> result(response_length);
+    auto node = to->getAncestorAt(from->depth + response_length - 1);
+    for (auto it = result.rbegin(); it != result.rend(); ++it) {
+      *it = node->block_hash;
+      node = node->parent.lock();
     }
-    return boost::none;
+    return result;
   }
 
   BlockTreeImpl::BlockHashVecRes BlockTreeImpl::getChainByBlocks(
@@ -766,20 +847,13 @@ namespace kagome::blockchain {
 
   bool BlockTreeImpl::hasDirectChain(const primitives::BlockHash &ancestor,
                                      const primitives::BlockHash &descendant) {
-    auto ancestor_node_ptr = tree_->getByHash(ancestor);
-    auto descendant_node_ptr = tree_->getByHash(descendant);
+    auto ancestor_node_ptr = getNode(ancestor);
+    auto descendant_node_ptr = getNode(descendant);
 
     // if both nodes are in our light tree, we can use this representation only
     if (ancestor_node_ptr && descendant_node_ptr) {
-      auto current_node = descendant_node_ptr;
-      while (current_node != ancestor_node_ptr) {
-        if (auto parent = current_node->parent; !parent.expired()) {
-          current_node = parent.lock();
-        } else {
-          return false;
-        }
-      }
-      return true;
+      return descendant_node_ptr->getAncestorAt(ancestor_node_ptr->depth)
+             == ancestor_node_ptr;
     }
 
     // else, we need to use a database
@@ -873,7 +947,7 @@ namespace kagome::blockchain {
 
   BlockTreeImpl::BlockHashVecRes BlockTreeImpl::getChildren(
       const primitives::BlockHash &block) {
-    auto node = tree_->getByHash(block);
+    auto node = getNode(block);
     if (!node) {
       return BlockTreeError::NO_SUCH_BLOCK;
     }
@@ -895,7 +969,7 @@ namespace kagome::blockchain {
   outcome::result<consensus::EpochDigest> BlockTreeImpl::getEpochDescriptor(
       consensus::EpochNumber epoch_number,
       primitives::BlockHash block_hash) const {
-    auto node = tree_->getByHash(block_hash);
+    auto node = getNode(block_hash);
     if (node) {
       if (node->epoch_number != epoch_number) {
         return *node->next_epoch_digest;
@@ -910,7 +984,7 @@ namespace kagome::blockchain {
     auto leaves = getLeaves();
     leaf_depths.reserve(leaves.size());
     for (auto &leaf : leaves) {
-      auto leaf_node = tree_->getByHash(leaf);
+      auto leaf_node = getNode(leaf);
       leaf_depths.emplace_back(
           primitives::BlockInfo{leaf_node->depth, leaf_node->block_hash});
     }
@@ -945,33 +1019,62 @@ namespace kagome::blockchain {
     std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
         to_remove;
 
+    // newly finalized blocks, descending
+    std::vector<primitives::BlockHash> finalized{
+        lastFinalizedNode->block_hash};
+
     auto current_node = lastFinalizedNode;
 
     for (;;) {
       auto parent_node = current_node->parent.lock();
-      if (!parent_node || parent_node->finalized) {
+      if (!parent_node) {
         break;
       }
 
       auto main_chain_node = current_node;
       current_node = parent_node;
+      if (not current_node->finalized) {
+        finalized.push_back(current_node->block_hash);
+      }
 
       // collect hashes for removing (except main chain block)
       for (const auto &child : current_node->children) {
         if (child->block_hash != main_chain_node->block_hash) {
           collectDescendants(child, to_remove);
           to_remove.emplace_back(child->block_hash, child->depth);
+          unindexSubtree(*child);
         }
       }
 
       // remove (in memory) all child, except main chain block
       current_node->children = {main_chain_node};
+
+      // the forks off the previously finalized block are discarded as well,
+      // but nothing is left to prune behind it
+      if (current_node->finalized) {
+        break;
+      }
     }
 
     std::vector<primitives::Extrinsic> extrinsics;
+    std::vector<storage::trie::RootHash> discarded_states;
+    std::vector<storage::trie::RootHash> finalized_states;
+
+    if (state_pruner_ != nullptr) {
+      for (auto it = finalized.rbegin(); it != finalized.rend(); ++it) {
+        OUTCOME_TRY(header, storage_->getBlockHeader(*it));
+        finalized_states.push_back(header.state_root);
+      }
+    }
 
     // remove from storage
     for (const auto &[hash, number] : to_remove) {
+      if (state_pruner_ != nullptr) {
+        if (auto header_res = storage_->getBlockHeader(hash); header_res) {
+          discarded_states.push_back(header_res.value().state_root);
+        }
+      }
+
       auto block_body_res = storage_->getBlockBody(hash);
       if (block_body_res.has_value()) {
         extrinsics.reserve(extrinsics.size() + block_body_res.value().size());
@@ -989,6 +1092,17 @@ namespace kagome::blockchain {
       OUTCOME_TRY(storage_->removeBlock(hash, number));
     }
 
+    // the pruner keeps the states it failed to release and releases them on
+    // the next finalization, so the blocks are finalized anyway
+    if (state_pruner_ != nullptr) {
+      if (auto res =
+              state_pruner_->onFinalized(finalized_states, discarded_states);
+          not res) {
+        log_->warn("Failed to prune the states of discarded blocks: {}",
+                   res.error().message());
+      }
+    }
+
     // trying to return back extrinsics to transaction pool
     for (auto &&extrinsic : extrinsics) {
       auto result = extrinsic_observer_->onTxMessage(extrinsic);
@@ -1008,8 +1122,8 @@ namespace kagome::blockchain {
           &container) {
     // avoid deep recursion
     while (node->children.size() == 1) {
-      container.emplace_back(node->block_hash, node->depth);
       node = node->children.front();
+      container.emplace_back(node->block_hash, node->depth);
     }
 
     // collect descendants' hashes recursively
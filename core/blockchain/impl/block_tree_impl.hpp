@@ -10,7 +10,7 @@
 
 #include <functional>
 #include <memory>
-#include <queue>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <boost/optional.hpp>
@@ -29,6 +29,8 @@
 #include "primitives/babe_configuration.hpp"
 #include "primitives/event_types.hpp"
 #include "runtime/core.hpp"
+#include "storage/trie/impl/flat_state.hpp"
+#include "storage/trie/impl/trie_pruner.hpp"
 #include "subscription/extrinsic_event_key_repository.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
@@ -60,6 +62,11 @@ namespace kagome::blockchain {
       primitives::BlockHash block_hash;
       primitives::BlockNumber depth;
       std::weak_ptr<TreeNode> parent;
+      /**
+       * Skew-binary jump pointer to an ancestor: together with the parent
+       * link, it lets to reach an ancestor at any depth in O(log n) steps
+       */
+      std::weak_ptr<TreeNode> jump;
       consensus::EpochNumber epoch_number;
       std::shared_ptr<consensus::EpochDigest> epoch_digest;
       std::shared_ptr<consensus::EpochDigest> next_epoch_digest;
@@ -68,13 +75,10 @@ namespace kagome::blockchain {
       std::vector<std::shared_ptr<TreeNode>> children{};
 
       /**
-       * Get a node of the tree, containing block with the specified hash, if it
-       * can be found
+       * @returns the ancestor of this node (or the node itself) at \arg depth,
+       * nullptr if there is no such one in the tree
        */
-      std::shared_ptr<TreeNode> getByHash(const primitives::BlockHash &hash);
-
-      boost::optional<std::vector<std::shared_ptr<TreeNode>>> getPathTo(
-          const primitives::BlockHash &hash);
+      std::shared_ptr<TreeNode> getAncestorAt(primitives::BlockNumber depth);
 
       bool operator==(const TreeNode &other) const;
       bool operator!=(const TreeNode &other) const;
@@ -115,6 +119,10 @@ namespace kagome::blockchain {
      * @param last_finalized_block - last finalized block, from which the tree
      * is going to grow
      * @param hasher - pointer to the hasher
+     * @param flat_state - optional flat state snapshot, which is moved to the
+     * state of each finalized block
+     * @param state_pruner - optional state pruner, which is told the states of
+     * the added, finalized and discarded blocks
      * @return ptr to the created instance or error
      */
     static outcome::result<std::shared_ptr<BlockTreeImpl>> create(
@@ -130,7 +138,9 @@ namespace kagome::blockchain {
             extrinsic_event_key_repo,
         std::shared_ptr<runtime::Core> runtime_core,
         std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-        std::shared_ptr<consensus::BabeUtil> babe_util);
+        std::shared_ptr<consensus::BabeUtil> babe_util,
+        std::shared_ptr<storage::trie::FlatState> flat_state = nullptr,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner = nullptr);
 
     ~BlockTreeImpl() override = default;
 
@@ -148,6 +158,9 @@ namespace kagome::blockchain {
 
     outcome::result<void> addBlock(const primitives::Block &block) override;
 
+    outcome::result<void> addBlock(const primitives::HashedBlockHeader &header,
+                                   const primitives::BlockBody &body) override;
+
     outcome::result<void> addExistingBlock(
         const primitives::BlockHash &block_hash,
         const primitives::BlockHeader &block_header) override;
@@ -221,12 +234,34 @@ namespace kagome::blockchain {
             extrinsic_event_key_repo,
         std::shared_ptr<runtime::Core> runtime_core,
         std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-        std::shared_ptr<consensus::BabeUtil> babe_util);
+        std::shared_ptr<consensus::BabeUtil> babe_util,
+        std::shared_ptr<storage::trie::FlatState> flat_state,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner);
 
     /**
      * Update local meta with the provided node
      */
-    void updateMeta(const std::shared_ptr<TreeNode> &new_node);
+    outcome::result<void> updateMeta(const std::shared_ptr<TreeNode> &new_node);
+
+    /**
+     * Marks the chain ending with \arg best_leaf as the canonical one, down to
+     * the first block already marked, and unmarks the numbers past the leaf up
+     * to \arg prev_best_depth; both are written at once, so the index never
+     * mixes the old and the new chain
+     */
+    outcome::result<void> updateCanonicalChain(
+        const TreeNode &best_leaf, primitives::BlockNumber prev_best_depth);
+
+    /**
+     * @returns the node of the tree, containing block with the specified hash,
+     * or nullptr if there is no such one
+     */
+    std::shared_ptr<TreeNode> getNode(const primitives::BlockHash &hash) const;
+
+    /**
+     * Removes \arg node and all its descendants from the nodes index
+     */
+    void unindexSubtree(const TreeNode &node);
 
     /**
      * Walks the chain backwards starting from \param start until the current
@@ -250,6 +285,10 @@ namespace kagome::blockchain {
      */
     std::vector<primitives::BlockHash> getLeavesSorted() const;
 
+    /**
+     * Puts every descendant of \arg node, but not the node itself, to
+     * \arg container once
+     */
     static void collectDescendants(
         std::shared_ptr<TreeNode> node,
         std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
@@ -263,6 +302,8 @@ namespace kagome::blockchain {
 
     std::shared_ptr<TreeNode> tree_;
     std::shared_ptr<TreeMeta> tree_meta_;
+    // every node of the tree by its block hash; the nodes are owned by tree_
+    std::unordered_map<primitives::BlockHash, TreeNode *> nodes_;
 
     std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer_;
 
@@ -274,6 +315,8 @@ namespace kagome::blockchain {
     std::shared_ptr<runtime::Core> runtime_core_;
     std::shared_ptr<primitives::BabeConfiguration> babe_configuration_;
     std::shared_ptr<const consensus::BabeUtil> babe_util_;
+    std::shared_ptr<storage::trie::FlatState> flat_state_;
+    std::shared_ptr<storage::trie::TriePruner> state_pruner_;
     boost::optional<primitives::Version> actual_runtime_version_;
     log::Logger log_ = log::createLogger("BlockTree", "blockchain");
     //metrics
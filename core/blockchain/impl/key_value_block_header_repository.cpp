@@ -22,8 +22,11 @@ namespace kagome::blockchain {
 
   KeyValueBlockHeaderRepository::KeyValueBlockHeaderRepository(
       std::shared_ptr<storage::BufferStorage> map,
-      std::shared_ptr<crypto::Hasher> hasher)
-      : map_{std::move(map)}, hasher_{std::move(hasher)} {
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache)
+      : map_{std::move(map)},
+        hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)} {
     BOOST_ASSERT(hasher_);
   }
 
@@ -39,20 +42,29 @@ namespace kagome::blockchain {
   outcome::result<common::Hash256>
   KeyValueBlockHeaderRepository::getHashByNumber(
       const primitives::BlockNumber &number) const {
-    OUTCOME_TRY(header, getBlockHeader(number));
-    OUTCOME_TRY(enc_header, scale::encode(header));
-    return hasher_->blake2b_256(enc_header);
+    auto canonical_res = map_->get(canonicalHashKey(number));
+    if (canonical_res.has_value()) {
+      return Hash256::fromSpan(canonical_res.value());
+    }
+    if (not isNotFoundError(canonical_res.error())) {
+      return canonical_res.as_failure();
+    }
+
+    // the block is not marked canonical yet: the lookup key of the last stored
+    // block with the number ends with the hash of the block
+    OUTCOME_TRY(key, idToLookupKey(*map_, number));
+    return lookupKeyToHash(key);
   }
 
   outcome::result<primitives::BlockHeader>
   KeyValueBlockHeaderRepository::getBlockHeader(const BlockId &id) const {
-    auto header_res = getWithPrefix(*map_, Prefix::HEADER, id);
+    auto header_res =
+        blockchain::getBlockHeader(*map_, header_cache_.get(), id);
     if (!header_res) {
       return (isNotFoundError(header_res.error())) ? Error::BLOCK_NOT_FOUND
                                                    : header_res.error();
     }
-
-    return scale::decode<primitives::BlockHeader>(header_res.value());
+    return header_res;
   }
 
   outcome::result<BlockStatus> KeyValueBlockHeaderRepository::getBlockStatus(
@@ -8,6 +8,7 @@
 
 #include "blockchain/block_header_repository.hpp"
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "crypto/hasher.hpp"
 
@@ -15,8 +16,15 @@ namespace kagome::blockchain {
 
   class KeyValueBlockHeaderRepository : public BlockHeaderRepository {
    public:
-    KeyValueBlockHeaderRepository(std::shared_ptr<storage::BufferStorage> map,
-                                  std::shared_ptr<crypto::Hasher> hasher);
+    /**
+     * @param header_cache cache of decoded headers shared with the block
+     * storage, which keeps it up to date; nullptr if the headers are not
+     * cached
+     */
+    KeyValueBlockHeaderRepository(
+        std::shared_ptr<storage::BufferStorage> map,
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     ~KeyValueBlockHeaderRepository() override = default;
 
@@ -35,6 +43,7 @@ namespace kagome::blockchain {
    private:
     std::shared_ptr<storage::BufferStorage> map_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
   };
 
 }  // namespace kagome::blockchain
@@ -40,9 +40,11 @@ namespace kagome::blockchain {
 
   KeyValueBlockStorage::KeyValueBlockStorage(
       std::shared_ptr<storage::BufferStorage> storage,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache)
       : storage_{std::move(storage)},
         hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)},
         logger_{log::createLogger("BlockStorage", "blockchain")} {}
 
   outcome::result<std::shared_ptr<KeyValueBlockStorage>>
@@ -50,21 +52,28 @@ namespace kagome::blockchain {
       storage::trie::RootHash state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       const std::shared_ptr<crypto::Hasher> &hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, hasher));
+        KeyValueBlockStorage(storage, hasher, header_cache));
 
     auto last_finalized_block_hash_res =
         block_storage->getLastFinalizedBlockHash();
 
     if (last_finalized_block_hash_res.has_value()) {
-      return loadExisting(storage, hasher, on_finalized_block_found);
+      return loadExisting(storage,
+                          hasher,
+                          on_finalized_block_found,
+                          std::move(header_cache));
     }
 
     if (last_finalized_block_hash_res
         == outcome::failure(Error::FINALIZED_BLOCK_NOT_FOUND)) {
-      return createWithGenesis(
-          std::move(state_root), storage, hasher, on_finalized_block_found);
+      return createWithGenesis(std::move(state_root),
+                               storage,
+                               hasher,
+                               on_finalized_block_found,
+                               std::move(header_cache));
     }
 
     return last_finalized_block_hash_res.error();
@@ -74,9 +83,11 @@ namespace kagome::blockchain {
   KeyValueBlockStorage::loadExisting(
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(
+            storage, std::move(hasher), std::move(header_cache)));
 
     OUTCOME_TRY(last_finalized_block_hash,
                 block_storage->getLastFinalizedBlockHash());
@@ -97,9 +108,11 @@ namespace kagome::blockchain {
       storage::trie::RootHash state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_genesis_created) {
+      const BlockHandler &on_genesis_created,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(
+            storage, std::move(hasher), std::move(header_cache)));
 
     OUTCOME_TRY(block_storage->ensureGenesisNotExists());
 
@@ -123,9 +136,7 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHeader> KeyValueBlockStorage::getBlockHeader(
       const primitives::BlockId &id) const {
-    OUTCOME_TRY(encoded_header, getWithPrefix(*storage_, Prefix::HEADER, id));
-    OUTCOME_TRY(header, scale::decode<primitives::BlockHeader>(encoded_header));
-    return std::move(header);
+    return blockchain::getBlockHeader(*storage_, header_cache_.get(), id);
   }
 
   outcome::result<primitives::BlockBody> KeyValueBlockStorage::getBlockBody(
@@ -139,11 +150,8 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockData> KeyValueBlockStorage::getBlockData(
       const primitives::BlockId &id) const {
-    OUTCOME_TRY(encoded_block_data,
-                getWithPrefix(*storage_, Prefix::BLOCK_DATA, id));
-    OUTCOME_TRY(block_data,
-                scale::decode<primitives::BlockData>(encoded_block_data));
-    return std::move(block_data);
+    return decodeWithPrefix<primitives::BlockData>(
+        *storage_, Prefix::BLOCK_DATA, id);
   }
 
   outcome::result<primitives::Justification>
@@ -158,14 +166,22 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHash> KeyValueBlockStorage::putBlockHeader(
       const primitives::BlockHeader &header) {
-    OUTCOME_TRY(encoded_header, scale::encode(header));
-    auto block_hash = hasher_->blake2b_256(encoded_header);
+    primitives::HashedBlockHeader hashed_header{header, *hasher_};
+    OUTCOME_TRY(putHeader(hashed_header));
+    return hashed_header.hash();
+  }
+
+  outcome::result<void> KeyValueBlockStorage::putHeader(
+      const primitives::HashedBlockHeader &header) {
     OUTCOME_TRY(putWithPrefix(*storage_,
                               Prefix::HEADER,
-                              header.number,
-                              block_hash,
-                              Buffer{std::move(encoded_header)}));
-    return block_hash;
+                              header.header().number,
+                              header.hash(),
+                              header.encoded()));
+    if (header_cache_ != nullptr) {
+      header_cache_->put(header.hash(), header.header());
+    }
+    return outcome::success();
   }
 
   outcome::result<void> KeyValueBlockStorage::putBlockData(
@@ -207,12 +223,26 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHash> KeyValueBlockStorage::putBlock(
       const primitives::Block &block) {
+    primitives::HashedBlockHeader header{block.header, *hasher_};
+    OUTCOME_TRY(putBlock(header, block.body));
+    return header.hash();
+  }
+
+  outcome::result<void> KeyValueBlockStorage::putBlock(
+      const primitives::HashedBlockHeader &header,
+      const primitives::BlockBody &body) {
     // TODO(xDimon): Need to implement mechanism for wipe out orphan blocks
     //  (in side-chains whom rejected by finalization)
     //  for avoid leaks of storage space
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
+    const auto &block_hash = header.hash();
+    // only the presence of the header matters, so it is not copied
     auto block_in_storage_res =
-        getWithPrefix(*storage_, Prefix::HEADER, block_hash);
+        viewWithPrefix(*storage_,
+                       Prefix::HEADER,
+                       block_hash,
+                       [](auto) -> outcome::result<void> {
+                         return outcome::success();
+                       });
     if (block_in_storage_res.has_value()) {
       return Error::BLOCK_EXISTS;
     }
@@ -222,19 +252,19 @@ namespace kagome::blockchain {
     }
 
     // insert our block's parts into the database-
-    OUTCOME_TRY(putBlockHeader(block.header));
+    OUTCOME_TRY(putHeader(header));
 
     primitives::BlockData block_data;
     block_data.hash = block_hash;
-    block_data.header = block.header;
-    block_data.body = block.body;
+    block_data.header = header.header();
+    block_data.body = body;
 
-    OUTCOME_TRY(putBlockData(block.header.number, block_data));
+    OUTCOME_TRY(putBlockData(header.header().number, block_data));
     logger_->info("Added block. Number: {}. Hash: {}. State root: {}",
-                  block.header.number,
+                  header.header().number,
                   block_hash.toHex(),
-                  block.header.state_root.toHex());
-    return block_hash;
+                  header.header().state_root.toHex());
+    return outcome::success();
   }
 
   outcome::result<void> KeyValueBlockStorage::putJustification(
@@ -250,6 +280,9 @@ namespace kagome::blockchain {
   outcome::result<void> KeyValueBlockStorage::removeBlock(
       const primitives::BlockHash &hash,
       const primitives::BlockNumber &number) {
+    if (header_cache_ != nullptr) {
+      header_cache_->remove(hash);
+    }
     auto block_lookup_key = numberAndHashToLookupKey(number, hash);
     auto header_lookup_key = prependPrefix(block_lookup_key, Prefix::HEADER);
     if (auto rm_res = storage_->remove(header_lookup_key); !rm_res) {
@@ -267,6 +300,55 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
+  outcome::result<boost::optional<primitives::BlockHash>>
+  KeyValueBlockStorage::getCanonicalHash(primitives::BlockNumber number) const {
+    auto hash_res = storage_->get(canonicalHashKey(number));
+    if (hash_res.has_value()) {
+      OUTCOME_TRY(hash, primitives::BlockHash::fromSpan(hash_res.value()));
+      return boost::make_optional(hash);
+    }
+    if (isNotFoundError(hash_res.error())) {
+      return boost::optional<primitives::BlockHash>{};
+    }
+    return hash_res.as_failure();
+  }
+
+  outcome::result<std::vector<primitives::BlockHash>>
+  KeyValueBlockStorage::getCanonicalHashes(primitives::BlockNumber from,
+                                           primitives::BlockNumber to) const {
+    std::vector<primitives::BlockHash> hashes;
+    if (to < from) {
+      return hashes;
+    }
+    hashes.reserve(to - from + 1);
+
+    // the keys are ordered as the numbers, so the hashes go in a row
+    auto cursor = storage_->cursor();
+    OUTCOME_TRY(cursor->seek(canonicalHashKey(from)));
+    for (auto number = from; number <= to and cursor->isValid(); ++number) {
+      if (cursor->key() != canonicalHashKey(number)) {
+        break;
+      }
+      OUTCOME_TRY(hash, primitives::BlockHash::fromSpan(cursor->value().value()));
+      hashes.push_back(hash);
+      OUTCOME_TRY(cursor->next());
+    }
+    return hashes;
+  }
+
+  outcome::result<void> KeyValueBlockStorage::updateCanonicalHashes(
+      const std::vector<primitives::BlockNumber> &removed,
+      const std::vector<primitives::BlockInfo> &marked) {
+    auto batch = storage_->batch();
+    for (auto number : removed) {
+      OUTCOME_TRY(batch->remove(canonicalHashKey(number)));
+    }
+    for (const auto &block : marked) {
+      OUTCOME_TRY(batch->put(canonicalHashKey(block.number), Buffer{block.hash}));
+    }
+    return batch->commit();
+  }
+
   outcome::result<primitives::BlockHash>
   KeyValueBlockStorage::getGenesisBlockHash() const {
     if (genesis_block_hash_.has_value()) {
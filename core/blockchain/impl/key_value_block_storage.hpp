@@ -8,6 +8,7 @@
 
 #include "blockchain/block_storage.hpp"
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "crypto/hasher.hpp"
 #include "log/logger.hpp"
@@ -34,29 +35,36 @@ namespace kagome::blockchain {
         storage::trie::RootHash state_root,
         const std::shared_ptr<storage::BufferStorage> &storage,
         const std::shared_ptr<crypto::Hasher> &hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     /**
      * Initialise block storage with existing data
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache cache of decoded headers shared with the header
+     * repository, or nullptr
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>> loadExisting(
         const std::shared_ptr<storage::BufferStorage> &storage,
         std::shared_ptr<crypto::Hasher> hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     /**
      * Initialise block storage with a genesis block which is created inside
      * from merkle trie root
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache cache of decoded headers shared with the header
+     * repository, or nullptr
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>>
     createWithGenesis(storage::trie::RootHash state_root,
                       const std::shared_ptr<storage::BufferStorage> &storage,
                       std::shared_ptr<crypto::Hasher> hasher,
-                      const BlockHandler &on_genesis_created);
+                      const BlockHandler &on_genesis_created,
+                      std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     outcome::result<primitives::BlockHash> getGenesisBlockHash() const override;
 
@@ -81,6 +89,8 @@ namespace kagome::blockchain {
         const primitives::BlockData &block_data) override;
     outcome::result<primitives::BlockHash> putBlock(
         const primitives::Block &block) override;
+    outcome::result<void> putBlock(const primitives::HashedBlockHeader &header,
+                                   const primitives::BlockBody &body) override;
 
     outcome::result<void> putJustification(
         const primitives::Justification &j,
@@ -91,14 +101,28 @@ namespace kagome::blockchain {
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) override;
 
+    outcome::result<boost::optional<primitives::BlockHash>> getCanonicalHash(
+        primitives::BlockNumber number) const override;
+
+    outcome::result<std::vector<primitives::BlockHash>> getCanonicalHashes(
+        primitives::BlockNumber from, primitives::BlockNumber to) const override;
+
+    outcome::result<void> updateCanonicalHashes(
+        const std::vector<primitives::BlockNumber> &removed,
+        const std::vector<primitives::BlockInfo> &marked) override;
+
    private:
     KeyValueBlockStorage(std::shared_ptr<storage::BufferStorage> storage,
-                         std::shared_ptr<crypto::Hasher> hasher);
+                         std::shared_ptr<crypto::Hasher> hasher,
+                         std::shared_ptr<BlockHeaderCache> header_cache);
 
     outcome::result<void> ensureGenesisNotExists() const;
 
+    outcome::result<void> putHeader(const primitives::HashedBlockHeader &header);
+
     std::shared_ptr<storage::BufferStorage> storage_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
     log::Logger logger_;
     boost::optional<primitives::BlockHash>  genesis_block_hash_;
   };
@@ -49,6 +49,51 @@ namespace kagome::blockchain {
     return map.get(prependPrefix(key, prefix));
   }
 
+  outcome::result<void> viewWithPrefix(
+      const storage::BufferStorage &map,
+      prefix::Prefix prefix,
+      const primitives::BlockId &block_id,
+      const storage::BufferStorage::ViewConsumer &consumer) {
+    OUTCOME_TRY(key, idToLookupKey(map, block_id));
+    return map.view(prependPrefix(key, prefix), consumer);
+  }
+
+  outcome::result<primitives::BlockHeader> getBlockHeader(
+      const storage::BufferStorage &map,
+      BlockHeaderCache *cache,
+      const primitives::BlockId &block_id) {
+    if (cache == nullptr) {
+      return decodeWithPrefix<primitives::BlockHeader>(
+          map, Prefix::HEADER, block_id);
+    }
+
+    // a header looked up by hash is served from the cache without any read
+    const auto *hash = boost::get<primitives::BlockHash>(&block_id);
+    if (hash != nullptr) {
+      if (auto header = cache->get(*hash)) {
+        return *header;
+      }
+    }
+
+    OUTCOME_TRY(lookup_key, idToLookupKey(map, block_id));
+    primitives::BlockHash block_hash;
+    if (hash != nullptr) {
+      block_hash = *hash;
+    } else {
+      OUTCOME_TRY(hash_from_key, lookupKeyToHash(lookup_key));
+      if (auto header = cache->get(hash_from_key)) {
+        return *header;
+      }
+      block_hash = hash_from_key;
+    }
+
+    OUTCOME_TRY(header,
+                decodeByLookupKey<primitives::BlockHeader>(
+                    map, Prefix::HEADER, lookup_key));
+    cache->put(block_hash, header);
+    return header;
+  }
+
   common::Buffer numberToIndexKey(primitives::BlockNumber n) {
     // TODO(Harrm) Figure out why exactly it is this way in substrate
     BOOST_ASSERT((n & 0xffffffff00000000) == 0);
@@ -66,6 +111,20 @@ namespace kagome::blockchain {
     return lookup_key;
   }
 
+  common::Buffer canonicalHashKey(primitives::BlockNumber number) {
+    return prependPrefix(numberToIndexKey(number), Prefix::CANONICAL_HASH);
+  }
+
+  outcome::result<primitives::BlockHash> lookupKeyToHash(
+      const common::Buffer &key) {
+    auto number_size = numberToIndexKey(0).size();
+    if (key.size() != number_size + Hash256::size()) {
+      return KeyValueRepositoryError::INVALID_KEY;
+    }
+    return Hash256::fromSpan(
+        gsl::make_span(key).subspan(static_cast<ptrdiff_t>(number_size)));
+  }
+
   outcome::result<primitives::BlockNumber> lookupKeyToNumber(
       const common::Buffer &key) {
     if (key.size() < 4) {
@@ -6,9 +6,14 @@
 #ifndef KAGOME_CORE_BLOCKCHAIN_IMPL_PERSISTENT_MAP_UTIL_HPP
 #define KAGOME_CORE_BLOCKCHAIN_IMPL_PERSISTENT_MAP_UTIL_HPP
 
+#include <boost/optional.hpp>
+
+#include "blockchain/impl/block_header_cache.hpp"
+#include "blockchain/impl/common.hpp"
 #include "common/buffer.hpp"
 #include "primitives/block_header.hpp"
 #include "primitives/block_id.hpp"
+#include "scale/scale.hpp"
 #include "storage/buffer_map_types.hpp"
 
 /**
@@ -36,7 +41,22 @@ namespace kagome::blockchain {
       JUSTIFICATION = 6,
 
       // node of a trie db
-      TRIE_NODE = 7
+      TRIE_NODE = 7,
+
+      // value of the last finalized state by its raw storage key
+      FLAT_STATE = 8,
+
+      // changes of a state not yet applied to the flat state
+      FLAT_STATE_JOURNAL = 9,
+
+      // number of references to a trie node, kept if state pruning is on
+      TRIE_NODE_REFCOUNT = 10,
+
+      // number of blocks referencing a trie state, kept if state pruning is on
+      TRIE_STATE_REFCOUNT = 11,
+
+      // hash of the block of the finalized or the best chain by its number
+      CANONICAL_HASH = 12
     };
   }
 
@@ -80,6 +100,65 @@ namespace kagome::blockchain {
       prefix::Prefix prefix,
       const primitives::BlockId &block_id);
 
+  /**
+   * Pass an entry from the database to \arg consumer without copying it
+   * @param map to get the entry from
+   * @param prefix, with which the entry was put into
+   * @param block_id - id of the block to get entry for
+   * @param consumer - function to process the encoded entry, which is valid
+   * only during the call
+   * @return error of the lookup or of \arg consumer
+   */
+  outcome::result<void> viewWithPrefix(
+      const storage::BufferStorage &map,
+      prefix::Prefix prefix,
+      const primitives::BlockId &block_id,
+      const storage::BufferStorage::ViewConsumer &consumer);
+
+  /**
+   * Get an entry by the \arg lookup_key of its block decoded right from the
+   * memory it is read to
+   * @return decoded entry or error
+   */
+  template <typename T>
+  outcome::result<T> decodeByLookupKey(const storage::BufferStorage &map,
+                                       prefix::Prefix prefix,
+                                       const common::Buffer &lookup_key) {
+    boost::optional<T> value;
+    OUTCOME_TRY(map.view(prependPrefix(lookup_key, prefix),
+                         [&value](auto encoded) -> outcome::result<void> {
+                           OUTCOME_TRY(decoded, scale::decode<T>(encoded));
+                           value = std::move(decoded);
+                           return outcome::success();
+                         }));
+    return std::move(value.value());
+  }
+
+  /**
+   * Get an entry from the database decoded right from the memory it is read
+   * to
+   * @see viewWithPrefix
+   * @see decodeByLookupKey
+   */
+  template <typename T>
+  outcome::result<T> decodeWithPrefix(const storage::BufferStorage &map,
+                                      prefix::Prefix prefix,
+                                      const primitives::BlockId &block_id) {
+    OUTCOME_TRY(lookup_key, idToLookupKey(map, block_id));
+    return decodeByLookupKey<T>(map, prefix, lookup_key);
+  }
+
+  /**
+   * Get a block header from \arg cache, falling back to the database
+   * @param cache of the decoded headers, the header read from the database is
+   * put to it; may be nullptr
+   * @return the header, or the error of the database lookup
+   */
+  outcome::result<primitives::BlockHeader> getBlockHeader(
+      const storage::BufferStorage &map,
+      BlockHeaderCache *cache,
+      const primitives::BlockId &block_id);
+
   /**
    * Convert block number into short lookup key (LE representation) for
    * blocks that are in the canonical chain.
@@ -96,6 +175,18 @@ namespace kagome::blockchain {
   common::Buffer numberAndHashToLookupKey(primitives::BlockNumber number,
                                           const common::Hash256 &hash);
 
+  /**
+   * @returns key of the canonical chain block hash with \arg number; the keys
+   * are ordered as the numbers
+   */
+  common::Buffer canonicalHashKey(primitives::BlockNumber number);
+
+  /**
+   * Get block hash from the long lookup key
+   */
+  outcome::result<primitives::BlockHash> lookupKeyToHash(
+      const common::Buffer &key);
+
   /**
    * Convert lookup key to a block number
    */
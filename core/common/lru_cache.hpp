@@ -0,0 +1,143 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_LRU_CACHE
+#define KAGOME_CORE_COMMON_LRU_CACHE
+
+#include <atomic>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/assert.hpp>
+
+namespace kagome::common {
+
+  /**
+   * Bounded LRU cache of immutable values, which are shared with the callers.
+   * The cache is bounded by the number of its entries and, optionally, by the
+   * total size of its values, the size of each value being told by the caller.
+   * Thread-safe.
+   */
+  template <typename Key, typename Value, typename Hash = std::hash<Key>>
+  class LruCache {
+   public:
+    using ValuePtr = std::shared_ptr<const Value>;
+
+    /**
+     * @param max_entries max number of the kept values
+     * @param max_size max total size of the kept values; a value larger than
+     * that is not kept at all
+     */
+    explicit LruCache(size_t max_entries,
+                      size_t max_size = std::numeric_limits<size_t>::max())
+        : max_entries_{max_entries}, max_size_{max_size} {
+      BOOST_ASSERT(max_entries_ > 0);
+    }
+
+    /**
+     * @returns the value under \arg key, or nullptr if there is no such value
+     * in the cache
+     */
+    ValuePtr get(const Key &key) {
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(key);
+      if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+      }
+      ++hits_;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->value;
+    }
+
+    /**
+     * Puts the \arg value of \arg value_size under \arg key, evicting the
+     * least recently used values to stay within the bounds.
+     * A value already kept under the key is not replaced, as a key is meant
+     * to always denote the same value
+     */
+    void put(const Key &key, ValuePtr value, size_t value_size = 0) {
+      if (value_size > max_size_) {
+        return;
+      }
+      std::lock_guard lock{mutex_};
+      if (auto it = index_.find(key); it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+      }
+      size_ += value_size;
+      lru_.push_front(Entry{key, std::move(value), value_size});
+      index_.emplace(key, lru_.begin());
+      while (lru_.size() > max_entries_ or size_ > max_size_) {
+        auto &entry = lru_.back();
+        size_ -= entry.size;
+        index_.erase(entry.key);
+        lru_.pop_back();
+      }
+    }
+
+    /**
+     * Forgets the value under \arg key
+     */
+    void remove(const Key &key) {
+      std::lock_guard lock{mutex_};
+      if (auto it = index_.find(key); it != index_.end()) {
+        size_ -= it->second->size;
+        lru_.erase(it->second);
+        index_.erase(it);
+      }
+    }
+
+    /// @returns number of the kept values
+    size_t entries() const {
+      std::lock_guard lock{mutex_};
+      return lru_.size();
+    }
+
+    /// @returns total size of the kept values
+    size_t size() const {
+      std::lock_guard lock{mutex_};
+      return size_;
+    }
+
+    size_t maxEntries() const {
+      return max_entries_;
+    }
+
+    uint64_t hits() const {
+      return hits_.load();
+    }
+
+    uint64_t misses() const {
+      return misses_.load();
+    }
+
+   private:
+    struct Entry {
+      Key key;
+      ValuePtr value;
+      size_t size;
+    };
+    using LruList = std::list<Entry>;
+
+    const size_t max_entries_;
+    const size_t max_size_;
+    mutable std::mutex mutex_;
+    // the most recently used entry is in front
+    LruList lru_;
+    std::unordered_map<Key, typename LruList::iterator, Hash> index_;
+    // total size of the kept values
+    size_t size_ = 0;
+
+    std::atomic_uint64_t hits_{0};
+    std::atomic_uint64_t misses_{0};
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_LRU_CACHE
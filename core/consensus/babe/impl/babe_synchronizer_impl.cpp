@@ -5,6 +5,8 @@
 
 #include "consensus/babe/impl/babe_synchronizer_impl.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <random>
 
 #include <boost/assert.hpp>
@@ -13,17 +15,37 @@
 #include "network/protocols/sync_protocol.hpp"
 #include "primitives/block.hpp"
 
+namespace {
+  // weight of the last measurement in the throughput score
+  constexpr double kScoreSmoothing = 0.3;
+  // the score of a peer is divided by it on a failure
+  constexpr double kFailurePenalty = 2.;
+
+  kagome::primitives::BlocksRequestId nextRequestId() {
+    static std::random_device rd{};
+    static std::uniform_int_distribution<kagome::primitives::BlocksRequestId>
+        dis{};
+    return dis(rd);
+  }
+}  // namespace
+
 namespace kagome::consensus {
   BabeSynchronizerImpl::BabeSynchronizerImpl(
-      std::shared_ptr<network::SyncClientsSet> sync_clients,
       const application::AppConfiguration &app_configuration,
-      std::shared_ptr<network::Router> router)
-      : sync_clients_{std::move(sync_clients)},
-        logger_{log::createLogger("BabeSynchronizer", "babe_synchronizer")},
-        app_configuration_(app_configuration),
-        router_(std::move(router)) {
-    BOOST_ASSERT(sync_clients_);
+      std::shared_ptr<network::Router> router,
+      std::shared_ptr<network::PeerManager> peer_manager,
+      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+      std::shared_ptr<boost::asio::io_context> io_context)
+      : app_configuration_(app_configuration),
+        router_(std::move(router)),
+        peer_manager_(std::move(peer_manager)),
+        header_repo_(std::move(header_repo)),
+        io_context_(std::move(io_context)),
+        logger_{log::createLogger("BabeSynchronizer", "babe_synchronizer")} {
     BOOST_ASSERT(router_);
+    BOOST_ASSERT(peer_manager_);
+    BOOST_ASSERT(header_repo_);
+    BOOST_ASSERT(io_context_);
   }
 
   void BabeSynchronizerImpl::request(const primitives::BlockId &from,
@@ -36,104 +58,270 @@ namespace kagome::consensus {
         [](primitives::BlockNumber number) { return std::to_string(number); });
     logger_->info("Requesting blocks from {} to {}", from_str, to.toHex());
 
-    static std::random_device rd{};
-    static std::uniform_int_distribution<primitives::BlocksRequestId> dis{};
-    network::BlocksRequest request{
-        dis(rd),
-        network::BlocksRequest::kBasicAttributes,
-        from,
-        to,
-        network::Direction::ASCENDING,
-        static_cast<uint32_t>(app_configuration_.maxBlocksInResponse())};
+    auto chunk_size =
+        static_cast<uint32_t>(app_configuration_.maxBlocksInResponse());
+    auto download = std::make_shared<RangeDownload>();
+    download->to = to;
+    download->handler = block_list_handler;
 
-    return pollClients(request, peer_id, block_list_handler);
-  }
+    // the range is split only if its start is known and the announcing peer
+    // has the blocks beyond the first chunk
+    size_t chunks_num = 1;
+    primitives::BlockNumber from_number = 0;
+    auto from_number_res = visit_in_place(
+        from,
+        [this](const primitives::BlockHash &hash) {
+          return header_repo_->getNumberByHash(hash);
+        },
+        [](primitives::BlockNumber number)
+            -> outcome::result<primitives::BlockNumber> { return number; });
+    auto status = peer_manager_->getPeerStatus(peer_id);
+    if (from_number_res.has_value() and status.has_value()
+        and status->best_block.number > from_number_res.value()) {
+      from_number = from_number_res.value();
+      auto range_size = status->best_block.number - from_number + 1;
+      chunks_num = std::min<size_t>((range_size + chunk_size - 1) / chunk_size,
+                                    kMaxParallelChunks);
+    }
 
-  std::shared_ptr<network::SyncProtocolClient>
-  BabeSynchronizerImpl::selectNextClient(
-      std::unordered_set<std::shared_ptr<network::SyncProtocolClient>>
-          &polled_clients) const {
-    // we want to ask each client until we get the blocks we lack, but the
-    // sync_clients_ set can change between the requests, so we need to keep
-    // track of the clients we already asked
-    std::shared_ptr<network::SyncProtocolClient> next_client;
-    for (const auto &[it, client] : sync_clients_->clients()) {
-      if (polled_clients.find(client) == polled_clients.end()) {
-        next_client = client;
-        polled_clients.insert(client);
-        break;
-      }
+    for (size_t i = 0; i < chunks_num; ++i) {
+      Chunk chunk;
+      chunk.request = network::BlocksRequest{
+          nextRequestId(),
+          network::BlocksRequest::kBasicAttributes,
+          i == 0 ? from
+                 : primitives::BlockId{from_number
+                                       + static_cast<primitives::BlockNumber>(
+                                           i * chunk_size)},
+          to,
+          network::Direction::ASCENDING,
+          chunk_size};
+      chunk.timer = std::make_unique<boost::asio::steady_timer>(*io_context_);
+      download->chunks.emplace_back(std::move(chunk));
     }
+    download->pending = download->chunks.size();
 
-    if (!next_client) {
-      // we asked all clients we could, so start over
-      polled_clients.clear();
-      next_client = sync_clients_->clients().begin()->second;
-      polled_clients.insert(next_client);
+    auto peers = selectPeers(peer_id, from_number, chunks_num, {});
+    BOOST_ASSERT(not peers.empty());
+    for (size_t i = 0; i < download->chunks.size(); ++i) {
+      // the peers with the best throughput get the first chunks, which are
+      // needed first; the rest are shared between them if there are too few
+      requestChunk(download, i, peers[i % peers.size()]);
     }
-    return next_client;
   }
 
-  /**
-   * Get blocks from resposne
-   * @param response containing block data for blocks
-   * @return blocks from block data
-   */
-  boost::optional<std::vector<primitives::Block>> getBlocks(
-      const network::BlocksResponse &response) {
-    // now we need to check if every block data from response contains header;
-    // if any of them does not contain block header, we should proceed to the
-    // next client
-    std::vector<primitives::Block> blocks;
-    for (const auto &block_data : response.blocks) {
-      primitives::Block block;
-      if (!block_data.header) {
-        // that's bad, we can't insert a block, which does not have at
-        // least a header
-        return boost::none;
-      }
-      block.header = *block_data.header;
+  void BabeSynchronizerImpl::setChunkTimeout(
+      std::chrono::milliseconds timeout) {
+    chunk_timeout_ = timeout;
+  }
 
-      if (block_data.body) {
-        block.body = *block_data.body;
+  std::vector<libp2p::peer::PeerId> BabeSynchronizerImpl::selectPeers(
+      const PeerId &peer_id,
+      primitives::BlockNumber from,
+      size_t count,
+      const std::vector<PeerId> &excluded) {
+    auto is_excluded = [&excluded](const PeerId &peer) {
+      return std::find(excluded.begin(), excluded.end(), peer)
+             != excluded.end();
+    };
+
+    std::vector<std::pair<double, PeerId>> candidates;
+    auto add_candidate = [&](const PeerId &peer) {
+      auto it = peer_scores_.find(peer);
+      // an unmeasured peer is tried first to get its score
+      auto score = it != peer_scores_.end()
+                       ? it->second
+                       : std::numeric_limits<double>::max();
+      candidates.emplace_back(score, peer);
+    };
+
+    if (not is_excluded(peer_id)) {
+      add_candidate(peer_id);
+    }
+    peer_manager_->forEachPeer([&](const PeerId &peer) {
+      if (peer == peer_id or is_excluded(peer)) {
+        return;
+      }
+      auto status = peer_manager_->getPeerStatus(peer);
+      if (status.has_value() and status->best_block.number >= from) {
+        add_candidate(peer);
       }
+    });
 
-      blocks.push_back(block);
+    std::stable_sort(
+        candidates.begin(), candidates.end(), [](auto &lhs, auto &rhs) {
+          return lhs.first > rhs.first;
+        });
+    std::vector<PeerId> peers;
+    for (size_t i = 0; i < candidates.size() and i < count; ++i) {
+      peers.push_back(candidates[i].second);
     }
-    return blocks;
+    return peers;
   }
 
-  void BabeSynchronizerImpl::pollClients(
-      network::BlocksRequest request,
-      const libp2p::peer::PeerId &peer_id,
-      const BlocksHandler &requested_blocks_handler) const {
-    auto sync_protocol = router_->getSyncProtocol();
+  void BabeSynchronizerImpl::requestChunk(
+      const std::shared_ptr<RangeDownload> &download,
+      size_t index,
+      const PeerId &peer_id) {
+    auto &chunk = download->chunks[index];
+    chunk.tried_peers.push_back(peer_id);
+    auto attempt = ++chunk.attempt;
+    chunk.request.id = nextRequestId();
 
-    sync_protocol->request(
+    chunk.timer->expires_after(chunk_timeout_);
+    chunk.timer->async_wait([wp = weak_from_this(),
+                             download,
+                             index,
+                             attempt,
+                             peer_id](const boost::system::error_code &ec) {
+      if (ec) {
+        return;
+      }
+      if (auto self = wp.lock()) {
+        self->logger_->warn("Peer {} did not respond with blocks in time",
+                            peer_id.toBase58());
+        self->onChunkFailed(download, index, attempt, peer_id);
+      }
+    });
+
+    router_->getSyncProtocol()->request(
         peer_id,
-        std::move(request),
+        chunk.request,
         [wp = weak_from_this(),
-         h = requested_blocks_handler](auto &&response_res) mutable {
+         download,
+         index,
+         attempt,
+         peer_id,
+         started = std::chrono::steady_clock::now()](auto &&response_res) {
           if (auto self = wp.lock()) {
-            if (not response_res.has_value()) {
-              self->logger_->error("Could not sync. Error: {}",
-                                   response_res.error().message());
-              h(boost::none);
-              return;
-            }
-            auto &response = response_res.value();
-
-            if (response.blocks.empty()) {
-              self->logger_->error("Could not sync. Empty response");
-              h(boost::none);
-              return;
-            }
-
-            h(std::cref(response.blocks));
+            self->onChunkReceived(download,
+                                  index,
+                                  attempt,
+                                  peer_id,
+                                  started,
+                                  std::move(response_res));
           }
         });
+  }
+
+  void BabeSynchronizerImpl::onChunkReceived(
+      const std::shared_ptr<RangeDownload> &download,
+      size_t index,
+      size_t attempt,
+      const PeerId &peer_id,
+      std::chrono::steady_clock::time_point started,
+      outcome::result<network::BlocksResponse> response_res) {
+    auto &chunk = download->chunks[index];
+    if (chunk.done or chunk.attempt != attempt) {
+      return;
+    }
 
-    return;
+    if (not response_res.has_value()) {
+      logger_->error("Could not sync. Error: {}",
+                     response_res.error().message());
+      onChunkFailed(download, index, attempt, peer_id);
+      return;
+    }
+    auto &response = response_res.value();
+    if (response.blocks.empty()) {
+      logger_->error("Could not sync. Empty response");
+      onChunkFailed(download, index, attempt, peer_id);
+      return;
+    }
+
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - started;
+    updateScore(peer_id,
+                response.blocks.size()
+                    / std::max(elapsed.count(),
+                               std::numeric_limits<double>::epsilon()));
+    chunk.blocks = std::move(response.blocks);
+    chunkDone(download, index);
+  }
+
+  void BabeSynchronizerImpl::onChunkFailed(
+      const std::shared_ptr<RangeDownload> &download,
+      size_t index,
+      size_t attempt,
+      const PeerId &peer_id) {
+    auto &chunk = download->chunks[index];
+    if (chunk.done or chunk.attempt != attempt) {
+      return;
+    }
+    updateScore(peer_id, boost::none);
+
+    if (chunk.tried_peers.size() < kMaxChunkAttempts) {
+      primitives::BlockNumber from = 0;
+      if (auto number = boost::get<primitives::BlockNumber>(
+              &chunk.request.from)) {
+        from = *number;
+      }
+      auto peers = selectPeers(peer_id, from, 1, chunk.tried_peers);
+      if (not peers.empty()) {
+        logger_->info("Requesting blocks again from peer {}",
+                      peers.front().toBase58());
+        requestChunk(download, index, peers.front());
+        return;
+      }
+    }
+    chunkDone(download, index);
+  }
+
+  void BabeSynchronizerImpl::chunkDone(
+      const std::shared_ptr<RangeDownload> &download, size_t index) {
+    auto &chunk = download->chunks[index];
+    BOOST_ASSERT(not chunk.done);
+    chunk.done = true;
+    chunk.timer->cancel();
+    BOOST_ASSERT(download->pending > 0);
+    if (--download->pending == 0) {
+      completeDownload(*download);
+    }
+  }
+
+  void BabeSynchronizerImpl::completeDownload(RangeDownload &download) {
+    auto chunk_size = app_configuration_.maxBlocksInResponse();
+    std::vector<primitives::BlockData> blocks;
+    for (auto &chunk : download.chunks) {
+      if (not chunk.blocks) {
+        break;
+      }
+      auto &chunk_blocks = chunk.blocks.value();
+      if (not blocks.empty()
+          and (not chunk_blocks.front().header
+               or chunk_blocks.front().header->parent_hash
+                      != blocks.back().hash)) {
+        logger_->warn("Received chunks of blocks do not make a chain");
+        break;
+      }
+      std::move(chunk_blocks.begin(),
+                chunk_blocks.end(),
+                std::back_inserter(blocks));
+      // a short chunk ends the range of the peer
+      if (chunk_blocks.size() < chunk_size
+          or blocks.back().hash == download.to) {
+        break;
+      }
+    }
+
+    if (blocks.empty()) {
+      download.handler(boost::none);
+      return;
+    }
+    download.handler(std::cref(blocks));
+  }
+
+  void BabeSynchronizerImpl::updateScore(
+      const PeerId &peer_id, boost::optional<double> blocks_per_second) {
+    auto [it, is_new] = peer_scores_.try_emplace(peer_id, 0.);
+    auto &score = it->second;
+    if (not blocks_per_second) {
+      score /= kFailurePenalty;
+    } else if (is_new) {
+      score = *blocks_per_second;
+    } else {
+      score += kScoreSmoothing * (*blocks_per_second - score);
+    }
   }
 
 }  // namespace kagome::consensus
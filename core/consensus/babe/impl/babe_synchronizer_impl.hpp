@@ -8,56 +8,137 @@
 
 #include "consensus/babe/babe_synchronizer.hpp"
 
+#include <chrono>
+#include <unordered_map>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
 #include "application/app_configuration.hpp"
+#include "blockchain/block_header_repository.hpp"
 #include "log/logger.hpp"
-#include "network/types/sync_clients_set.hpp"
+#include "network/peer_manager.hpp"
 #include "network/router.hpp"
 
 namespace kagome::consensus {
 
   /**
    * Implementation of babe synchronizer that requests blocks from provided
-   * peers
+   * peers.
+   * A requested range of blocks is split into chunks of the max response
+   * size, which are requested from several peers at once and put back in
+   * order. A chunk which is not received in time is requested from another
+   * peer. The peers are chosen by the download throughput they have shown so
+   * far, a peer not tried yet is preferred to the measured ones.
+   * Runs in the io context.
    */
   class BabeSynchronizerImpl
       : public BabeSynchronizer,
         public std::enable_shared_from_this<BabeSynchronizerImpl> {
    public:
+    /// Max number of chunks of a range requested at once
+    static constexpr size_t kMaxParallelChunks = 4;
+    /// Max number of peers a chunk is requested from in turn
+    static constexpr size_t kMaxChunkAttempts = 3;
+    /// Time given to a peer to respond with a chunk
+    static constexpr std::chrono::seconds kChunkTimeout{10};
+
     ~BabeSynchronizerImpl() override = default;
 
     BabeSynchronizerImpl(
-        std::shared_ptr<network::SyncClientsSet> sync_clients,
         const application::AppConfiguration &app_configuration,
-        std::shared_ptr<network::Router> router);
+        std::shared_ptr<network::Router> router,
+        std::shared_ptr<network::PeerManager> peer_manager,
+        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+        std::shared_ptr<boost::asio::io_context> io_context);
 
     void request(const primitives::BlockId &from,
                  const primitives::BlockHash &to,
                  const libp2p::peer::PeerId &peer_id,
                  const BlocksHandler &block_list_handler) override;
 
+    /// Overrides kChunkTimeout, mostly for testing purposes
+    void setChunkTimeout(std::chrono::milliseconds timeout);
+
    private:
+    using PeerId = libp2p::peer::PeerId;
+
+    struct Chunk {
+      network::BlocksRequest request;
+      // peers the chunk has been requested from
+      std::vector<PeerId> tried_peers;
+      // responses to the earlier attempts are ignored
+      size_t attempt = 0;
+      std::unique_ptr<boost::asio::steady_timer> timer;
+      // none if the chunk could not be received
+      boost::optional<std::vector<primitives::BlockData>> blocks;
+      bool done = false;
+    };
+
+    struct RangeDownload {
+      primitives::BlockHash to;
+      BlocksHandler handler;
+      std::vector<Chunk> chunks;
+      // number of the chunks not done yet
+      size_t pending = 0;
+    };
+
+    /**
+     * @returns up to \arg count peers to request the blocks from \arg from
+     * number, ordered by their throughput; the announcing \arg peer_id is
+     * always a candidate
+     */
+    std::vector<PeerId> selectPeers(const PeerId &peer_id,
+                                    primitives::BlockNumber from,
+                                    size_t count,
+                                    const std::vector<PeerId> &excluded);
+
+    void requestChunk(const std::shared_ptr<RangeDownload> &download,
+                      size_t index,
+                      const PeerId &peer_id);
+
+    void onChunkReceived(const std::shared_ptr<RangeDownload> &download,
+                         size_t index,
+                         size_t attempt,
+                         const PeerId &peer_id,
+                         std::chrono::steady_clock::time_point started,
+                         outcome::result<network::BlocksResponse> response_res);
+
     /**
-     * Select next client to be polled
-     * @param polled_clients clients that we already polled
-     * @return next clint to be polled
+     * Requests the chunk from another peer, or gives it up if the attempts
+     * are over
      */
-    std::shared_ptr<network::SyncProtocolClient> selectNextClient(
-        std::unordered_set<std::shared_ptr<network::SyncProtocolClient>>
-            &polled_clients) const;
+    void onChunkFailed(const std::shared_ptr<RangeDownload> &download,
+                       size_t index,
+                       size_t attempt,
+                       const PeerId &peer_id);
+
+    void chunkDone(const std::shared_ptr<RangeDownload> &download,
+                   size_t index);
+
     /**
-     * Request blocks from provided peers
-     * @param response_res block request message
-     * @param polled_clients peers that were already requested
-     * @param requested_blocks_handler handler of received blocks
+     * Passes the chunks continuing each other from the first one to the
+     * handler of the download
      */
-    void pollClients(network::BlocksRequest response_res,
-                     const libp2p::peer::PeerId &peer_id,
-                     const BlocksHandler &requested_blocks_handler) const;
+    void completeDownload(RangeDownload &download);
+
+    /**
+     * Updates the throughput score of \arg peer_id with the measured
+     * \arg blocks_per_second, or lowers it if the peer failed
+     */
+    void updateScore(const PeerId &peer_id,
+                     boost::optional<double> blocks_per_second);
 
-    std::shared_ptr<network::SyncClientsSet> sync_clients_;
-    log::Logger logger_;
     const application::AppConfiguration &app_configuration_;
     std::shared_ptr<network::Router> router_;
+    std::shared_ptr<network::PeerManager> peer_manager_;
+    std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    log::Logger logger_;
+
+    std::chrono::milliseconds chunk_timeout_ = kChunkTimeout;
+    // moving average of the download throughput in blocks per second
+    std::unordered_map<PeerId, double> peer_scores_;
   };
 }  // namespace kagome::consensus
 
@@ -24,6 +24,12 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::consensus, BlockExecutor::Error, e) {
   return "Unknown error";
 }
 
+namespace {
+  constexpr const char *kImportQueueGaugeName = "kagome_import_queue_blocks";
+  constexpr const char *kImportedBlocksCounterName =
+      "kagome_import_blocks_total";
+}  // namespace
+
 namespace kagome::consensus {
 
   BlockExecutor::BlockExecutor(
@@ -67,6 +73,21 @@ namespace kagome::consensus {
     BOOST_ASSERT(io_context_ != nullptr);
     BOOST_ASSERT(sync_timer_ != nullptr);
     BOOST_ASSERT(logger_ != nullptr);
+
+    // initialize metrics
+    registry_->registerGaugeFamily(
+        kImportQueueGaugeName,
+        "Number of downloaded blocks waiting to be applied");
+    queued_blocks_ = registry_->registerGaugeMetric(kImportQueueGaugeName);
+    registry_->registerCounterFamily(
+        kImportedBlocksCounterName,
+        "Number of blocks which passed a stage of the import");
+    fetched_blocks_ = registry_->registerCounterMetric(
+        kImportedBlocksCounterName, {{"stage", "fetched"}});
+    applied_blocks_ = registry_->registerCounterMetric(
+        kImportedBlocksCounterName, {{"stage", "applied"}});
+    rejected_blocks_ = registry_->registerCounterMetric(
+        kImportedBlocksCounterName, {{"stage", "rejected"}});
   }
 
   void BlockExecutor::processNextBlock(
@@ -136,126 +157,185 @@ namespace kagome::consensus {
                                     const primitives::BlockHash &to,
                                     const libp2p::peer::PeerId &peer_id,
                                     std::function<void()> &&on_retrieved) {
+    auto queue = std::make_shared<ImportQueue>(
+        ImportQueue{to, peer_id, std::move(on_retrieved)});
+    queue->last_fetched = from;
+    fetchNextPage(queue);
+  }
+
+  void BlockExecutor::fetchNextPage(const std::shared_ptr<ImportQueue> &queue) {
+    BOOST_ASSERT(not queue->fetching);
+    queue->fetching = true;
     babe_synchronizer_->request(
-        from,
-        to,
-        peer_id,
-        [wp = weak_from_this(),
-         on_retrieved = std::move(on_retrieved),
-         to,
-         from,
-         peer_id](auto blocks_res) mutable {
-          auto self = wp.lock();
-          if (not self) {
-            on_retrieved();
+        queue->last_fetched,
+        queue->to,
+        queue->peer_id,
+        [wp = weak_from_this(), queue](auto blocks_res) {
+          queue->fetching = false;
+          if (queue->finished) {
             return;
           }
-
-          if (not blocks_res.has_value()) {
-            on_retrieved();
+          auto self = wp.lock();
+          if (not self) {
+            queue->finish();
             return;
           }
-          auto &blocks = blocks_res->get();
 
-          if (blocks.empty()) {
-            self->logger_->warn("Received empty list of blocks");
-            on_retrieved();
-            return;
+          if (not blocks_res.has_value() or blocks_res->get().empty()) {
+            if (blocks_res.has_value()) {
+              self->logger_->warn("Received empty list of blocks");
+            }
+            // the blocks downloaded so far are still applied
+            queue->fetched_all = true;
+          } else {
+            const auto &blocks = blocks_res->get();
+            if (blocks.front().header && blocks.back().header) {
+              self->logger_->info(
+                  "Received portion of blocks: {}..{}, {}..{}, count {}",
+                  blocks.front().hash.toHex(),
+                  blocks.back().hash.toHex(),
+                  blocks.front().header->number,
+                  blocks.back().header->number,
+                  blocks.size());
+            }
+            self->enqueueBlocks(*queue, blocks);
           }
 
-          if (blocks.front().header && blocks.back().header) {
-            self->logger_->info(
-                "Received portion of blocks: {}..{}, {}..{}, count {}",
-                blocks.front().hash.toHex(),
-                blocks.back().hash.toHex(),
-                blocks.front().header->number,
-                blocks.back().header->number,
-                blocks.size());
+          // the next page is downloaded while the queued blocks are applied
+          if (not queue->fetched_all
+              and queue->blocks.size() < kMaxQueuedBlocks) {
+            self->logger_->info("Request next page of blocks: {}..{}",
+                                queue->last_fetched.toHex(),
+                                queue->to.toHex());
+            self->fetchNextPage(queue);
           }
+          self->scheduleApply(queue);
+        });
+  }
 
-          auto async_helper = std::make_shared<AsyncHelper>(self->io_context_);
-
-          async_helper->setFunction([wp,
-                                     to,
-                                     peer_id,
-                                     on_retrieved = std::move(on_retrieved),
-                                     next_iteration = async_helper->next(),
-                                     blocks = std::move(blocks),
-                                     i = static_cast<size_t>(0)]() mutable {
-            auto self = wp.lock();
-            if (not self) {
-              return;
-            }
+  void BlockExecutor::enqueueBlocks(
+      ImportQueue &queue, const std::vector<primitives::BlockData> &blocks) {
+    auto queued = queue.blocks.size();
+    for (const auto &block : blocks) {
+      if (not block.header) {
+        logger_->warn("Received a block without header during synchronizing");
+        queue.fetched_all = true;
+        break;
+      }
+      primitives::HashedBlockHeader header{*block.header, *hasher_};
+      // a page starts with the block it is requested from, which is known
+      if (header.hash() == queue.last_fetched) {
+        continue;
+      }
+      if (header.hash() != block.hash
+          or header.header().parent_hash != queue.last_fetched) {
+        logger_->warn(
+            "Received block #{} does not continue the chain of blocks {}",
+            header.header().number,
+            queue.last_fetched.toHex());
+        rejected_blocks_->inc();
+        queue.fetched_all = true;
+        break;
+      }
 
-            ExecutorState state = kSyncState;
-            if (self->sync_state_.compare_exchange_strong(state, kSyncState)) {
-              self->sync_timer_->cancel();
-              self->sync_timer_->expiresAfter(std::chrono::seconds(30));
-              self->sync_timer_->asyncWait([wp](auto e) {
-                if (auto self = wp.lock()) {
-                  if (not e) {
-                    self->sync_state_ = kReadyState;
-                  }
-                }
-              });
-            }
+      queue.last_fetched = header.hash();
+      auto is_last = header.hash() == queue.to;
+      queue.blocks.push_back(QueuedBlock{
+          std::move(header),
+          block.body ? *block.body : primitives::BlockBody{},
+          block.justification});
+      if (is_last) {
+        queue.fetched_all = true;
+        break;
+      }
+    }
 
-            auto block = std::move(blocks[i++]);  // For free memory asap
-
-            auto apply_res = self->applyBlock(block);
-
-            // Failed
-            if (not apply_res.has_value()
-                && apply_res
-                       != outcome::failure(
-                           blockchain::BlockTreeError::BLOCK_EXISTS)) {
-              self->logger_->warn(
-                  "Could not apply block #{} during synchronizing. Error: {}",
-                  block.header->number,
-                  apply_res.error().message());
-              on_retrieved();
-              return;
-            }
+    // a page with no new blocks would be requested again and again
+    if (queue.blocks.size() == queued) {
+      queue.fetched_all = true;
+    }
+    fetched_blocks_->inc(queue.blocks.size() - queued);
+    queued_blocks_->set(queue.blocks.size());
+  }
 
-            // Portion of blocks is out
-            if (i == blocks.size()) {
-              // Endian block reveived
-              if (to == block.hash) {
-                on_retrieved();
-                return;
-              }
+  void BlockExecutor::scheduleApply(const std::shared_ptr<ImportQueue> &queue) {
+    if (queue->applying or queue->finished) {
+      return;
+    }
+    if (queue->blocks.empty()) {
+      if (queue->fetched_all and not queue->fetching) {
+        queue->finish();
+      }
+      return;
+    }
+    queue->applying = true;
+    // the blocks are applied one per handler, so that the received pages are
+    // processed in between
+    io_context_->post([wp = weak_from_this(), queue] {
+      if (auto self = wp.lock()) {
+        self->applyNext(queue);
+      } else {
+        queue->finish();
+      }
+    });
+  }
 
-              self->logger_->info("Request next page of blocks: {}..{}",
-                                  block.hash.toHex(),
-                                  to.toHex());
-              self->requestBlocks(
-                  block.hash, to, peer_id, std::move(on_retrieved));
+  void BlockExecutor::applyNext(const std::shared_ptr<ImportQueue> &queue) {
+    queue->applying = false;
+    if (queue->finished) {
+      return;
+    }
 
-              return;
-            }
+    ExecutorState state = kSyncState;
+    if (sync_state_.compare_exchange_strong(state, kSyncState)) {
+      sync_timer_->cancel();
+      sync_timer_->expiresAfter(std::chrono::seconds(30));
+      sync_timer_->asyncWait([wp = weak_from_this()](auto e) {
+        if (auto self = wp.lock()) {
+          if (not e) {
+            self->sync_state_ = kReadyState;
+          }
+        }
+      });
+    }
 
-            next_iteration();
-          });
+    auto block = std::move(queue->blocks.front());
+    queue->blocks.pop_front();
+    queued_blocks_->set(queue->blocks.size());
+
+    auto apply_res = applyBlock(block.header, block.body, block.justification);
+
+    // Failed
+    if (not apply_res.has_value()
+        && apply_res
+               != outcome::failure(blockchain::BlockTreeError::BLOCK_EXISTS)) {
+      logger_->warn("Could not apply block #{} during synchronizing. Error: {}",
+                    block.header.header().number,
+                    apply_res.error().message());
+      rejected_blocks_->inc();
+      queue->finish();
+      return;
+    }
+    applied_blocks_->inc();
 
-          async_helper->run();
-        });
+    // the queue has room for one more page
+    if (not queue->fetching and not queue->fetched_all
+        and queue->blocks.size() < kMaxQueuedBlocks) {
+      fetchNextPage(queue);
+    }
+    scheduleApply(queue);
   }
 
   outcome::result<void> BlockExecutor::applyBlock(
-      const primitives::BlockData &b) {
-    if (!b.header) {
-      logger_->warn("Skipping a block without header.");
-      return Error::INVALID_BLOCK;
-    }
-
+      const primitives::HashedBlockHeader &hashed_header,
+      const primitives::BlockBody &body,
+      const boost::optional<primitives::Justification> &justification) {
     /// TODO(iceseer): remove copy.
-    primitives::Block block;
-    block.header = *b.header;
-    if (b.body) block.body = *b.body;
+    primitives::Block block{hashed_header.header(), body};
     // get current time to measure performance if block execution
     auto t_start = std::chrono::high_resolution_clock::now();
 
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
+    const auto &block_hash = hashed_header.hash();
 
     // check if block body already exists. If so, do not apply
     if (block_tree_->getBlockBody(block_hash)) {
@@ -329,7 +409,7 @@ namespace kagome::consensus {
     OUTCOME_TRY(core_->execute_block(block_without_seal_digest));
 
     // add block header if it does not exist
-    OUTCOME_TRY(block_tree_->addBlock(block));
+    OUTCOME_TRY(block_tree_->addBlock(hashed_header, block.body));
 
     // observe possible changes of authorities
     for (auto &digest_item : block_without_seal_digest.header.digest) {
@@ -346,12 +426,12 @@ namespace kagome::consensus {
     }
 
     // apply justification if any
-    if (b.justification.has_value()) {
+    if (justification.has_value()) {
       logger_->verbose("Justification received for block number {}",
-                    block.header.number);
+                       block.header.number);
       OUTCOME_TRY(grandpa_environment_->applyJustification(
           primitives::BlockInfo(block.header.number, block_hash),
-          b.justification.value()));
+          justification.value()));
     }
 
     // remove block's extrinsics from tx pool
@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 #define KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 
+#include <deque>
+
 #include <libp2p/peer/peer_id.hpp>
 
 #include "blockchain/block_tree.hpp"
@@ -17,8 +19,11 @@
 #include "consensus/validation/block_validator.hpp"
 #include "crypto/hasher.hpp"
 #include "log/logger.hpp"
+#include "metrics/metrics.hpp"
 #include "primitives/babe_configuration.hpp"
 #include "primitives/block_header.hpp"
+#include "primitives/hashed_block_header.hpp"
+#include "primitives/justification.hpp"
 #include "runtime/core.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
@@ -88,10 +93,76 @@ namespace kagome::consensus {
       /// past.
       kSyncState = 1,
     };
+
+    /// Max number of the downloaded blocks waiting to be applied; the next
+    /// page of blocks is not requested while there are that many of them
+    static constexpr size_t kMaxQueuedBlocks = 1024;
+
+    /// Downloaded block with its header hashed once for the whole import
+    struct QueuedBlock {
+      primitives::HashedBlockHeader header;
+      primitives::BlockBody body;
+      boost::optional<primitives::Justification> justification;
+    };
+
+    /**
+     * Import of the blocks between two ones from a peer. It is done in
+     * overlapping stages: the next page of blocks is requested as soon as the
+     * previous one is received, the headers of a received page are hashed
+     * and checked to continue the chain, and the queued blocks are applied
+     * one by one meanwhile. The number of the queued blocks is bounded by
+     * kMaxQueuedBlocks.
+     * All the stages are run in the io context.
+     */
+    struct ImportQueue {
+      primitives::BlockHash to;
+      libp2p::peer::PeerId peer_id;
+      std::function<void()> on_retrieved;
+
+      std::deque<QueuedBlock> blocks;
+      // hash of the last downloaded block, the next page starts from it
+      primitives::BlockHash last_fetched;
+      // a page is being requested
+      bool fetching = false;
+      // no more pages are to be requested
+      bool fetched_all = false;
+      // applying of the next block is scheduled
+      bool applying = false;
+      bool finished = false;
+
+      void finish() {
+        if (not finished) {
+          finished = true;
+          blocks.clear();
+          on_retrieved();
+        }
+      }
+    };
+
+    void fetchNextPage(const std::shared_ptr<ImportQueue> &queue);
+
+    /**
+     * Hashes the headers of the received \arg blocks and queues the ones
+     * continuing the downloaded chain
+     */
+    void enqueueBlocks(ImportQueue &queue,
+                       const std::vector<primitives::BlockData> &blocks);
+
+    /**
+     * Schedules applying of the next queued block, or finishes the import if
+     * there is nothing left to apply and to download
+     */
+    void scheduleApply(const std::shared_ptr<ImportQueue> &queue);
+
+    void applyNext(const std::shared_ptr<ImportQueue> &queue);
+
     std::atomic<ExecutorState> sync_state_;
     std::unique_ptr<clock::Timer> sync_timer_;
     // should only be invoked when parent of block exists
-    outcome::result<void> applyBlock(const primitives::BlockData &block);
+    outcome::result<void> applyBlock(
+        const primitives::HashedBlockHeader &header,
+        const primitives::BlockBody &body,
+        const boost::optional<primitives::Justification> &justification);
 
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<runtime::Core> core_;
@@ -107,47 +178,12 @@ namespace kagome::consensus {
     std::shared_ptr<boost::asio::io_context> io_context_;
     log::Logger logger_;
 
-    /**
-     * Aux class for doing iterable action aynchronously (not all iteration as
-     * solid execution)
-     */
-    class AsyncHelper : public std::enable_shared_from_this<AsyncHelper> {
-     public:
-      AsyncHelper() = delete;
-      AsyncHelper(AsyncHelper &&) noexcept = delete;
-      AsyncHelper(const AsyncHelper &) = delete;
-
-      AsyncHelper(std::shared_ptr<boost::asio::io_context> context)
-          : std::enable_shared_from_this<AsyncHelper>(),
-            io_context_(std::move(context)){};
-
-      ~AsyncHelper() = default;
-
-      // Does next iteration
-      std::function<void()> next() {
-        return [self = shared_from_this()] {
-          self->io_context_->post([wp = self->weak_from_this()] {
-            if (auto self = wp.lock()) {
-              self->func_();
-            }
-          });
-        };
-      }
-
-      // Set up iterable function
-      void setFunction(std::function<void()> &&func) {
-        func_ = std::move(func);
-      }
-
-      // Start function (does first iteration)
-      void run() {
-        func_();
-      }
-
-     private:
-      std::shared_ptr<boost::asio::io_context> io_context_;
-      std::function<void()> func_;
-    };  // namespace kagome::common
+    // metrics
+    metrics::RegistryPtr registry_ = metrics::createRegistry();
+    metrics::Gauge *queued_blocks_;
+    metrics::Counter *fetched_blocks_;
+    metrics::Counter *applied_blocks_;
+    metrics::Counter *rejected_blocks_;
   };
 
 }  // namespace kagome::consensus
@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "host_api/impl/batch_verification_workers.hpp"
+
+#include <boost/asio/post.hpp>
+
+namespace kagome::host_api {
+
+  BatchVerificationWorkers::BatchVerificationWorkers(size_t threads)
+      : pool_{threads} {}
+
+  BatchVerificationWorkers::~BatchVerificationWorkers() {
+    pool_.join();
+  }
+
+  std::future<bool> BatchVerificationWorkers::submit(Verifier verifier) {
+    auto task =
+        std::make_shared<std::packaged_task<bool()>>(std::move(verifier));
+    auto result = task->get_future();
+    boost::asio::post(pool_, [task] { (*task)(); });
+    return result;
+  }
+
+}  // namespace kagome::host_api
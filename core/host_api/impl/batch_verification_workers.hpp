@@ -0,0 +1,43 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_HOST_API_IMPL_BATCH_VERIFICATION_WORKERS_HPP
+#define KAGOME_HOST_API_IMPL_BATCH_VERIFICATION_WORKERS_HPP
+
+#include <functional>
+#include <future>
+
+#include <boost/asio/thread_pool.hpp>
+
+namespace kagome::host_api {
+
+  /**
+   * Threads which check the signatures queued by a runtime during a batch
+   * verification, while the runtime goes on with its execution. Shared by
+   * all the runtime instances
+   */
+  class BatchVerificationWorkers {
+   public:
+    using Verifier = std::function<bool()>;
+
+    /**
+     * @param threads number of worker threads
+     */
+    explicit BatchVerificationWorkers(size_t threads);
+    ~BatchVerificationWorkers();
+
+    /**
+     * Starts \arg verifier on a worker
+     * @return result of the verifier once it is done
+     */
+    std::future<bool> submit(Verifier verifier);
+
+   private:
+    boost::asio::thread_pool pool_;
+  };
+
+}  // namespace kagome::host_api
+
+#endif  // KAGOME_HOST_API_IMPL_BATCH_VERIFICATION_WORKERS_HPP
@@ -42,7 +42,8 @@ namespace kagome::host_api {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<BatchVerificationWorkers> verification_workers)
       : memory_(std::move(memory)),
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
@@ -50,6 +51,7 @@ namespace kagome::host_api {
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
         bip39_provider_(std::move(bip39_provider)),
+        verification_workers_(std::move(verification_workers)),
         logger_{log::createLogger("CryptoExtension", "extentions")} {
     BOOST_ASSERT(memory_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
@@ -92,36 +94,43 @@ namespace kagome::host_api {
   }
 
   void CryptoExtension::ext_start_batch_verify() {
-    // TODO (kamilsa) 05.07.21 https://github.com/soramitsu/kagome/issues/804
-    /*
     if (batch_verify_.has_value()) {
       throw std::runtime_error("Previous batch_verify is not finished");
     }
 
     batch_verify_.emplace();
-     */
   }
 
   runtime::WasmSize CryptoExtension::ext_finish_batch_verify() {
-    // TODO (kamilsa) 05.07.21 https://github.com/soramitsu/kagome/issues/804
-    /*
     if (not batch_verify_.has_value()) {
       throw std::runtime_error("No batch_verify is started");
     }
 
-    auto &verification_queue = batch_verify_.value();
-    while (not verification_queue.empty()) {
-      auto single_verification_result = verification_queue.front().get();
-      if (single_verification_result == kLegacyVerifyFail) {
-        batch_verify_.reset();
-        return kVerifyBatchFail;
-      }
-      BOOST_ASSERT_MSG(single_verification_result == kLegacyVerifySuccess,
-                       "Successful verification result must be equal to 0");
-      verification_queue.pop();
+    auto verification_results = std::move(batch_verify_.value());
+    batch_verify_.reset();
+
+    // all the results are awaited, so that no verification of the batch
+    // outlives it
+    bool all_succeeded = true;
+    for (auto &result : verification_results) {
+      all_succeeded = result.get() and all_succeeded;
+    }
+    return all_succeeded ? kVerifyBatchSuccess : kVerifyBatchFail;
+  }
+
+  runtime::WasmSize CryptoExtension::verifyOrQueue(
+      BatchVerificationWorkers::Verifier verifier) {
+    if (not batch_verify_.has_value()) {
+      return verifier() ? kLegacyVerifySuccess : kLegacyVerifyFail;
+    }
+    if (verification_workers_ != nullptr) {
+      batch_verify_->emplace_back(
+          verification_workers_->submit(std::move(verifier)));
+    } else {
+      batch_verify_->emplace_back(
+          std::async(std::launch::deferred, std::move(verifier)));
     }
-    */
-    return kVerifyBatchSuccess;
+    return kLegacyVerifySuccess;
   }
 
   runtime::WasmSize CryptoExtension::ext_ed25519_verify(
@@ -147,28 +156,15 @@ namespace kagome::host_api {
     }
     auto pubkey = pubkey_res.value();
 
-    auto verifier = [self_weak = weak_from_this(),
+    // the verifier owns all it uses, as it may run on a worker thread
+    auto verifier = [provider = ed25519_provider_,
                      signature = std::move(signature),
                      msg = std::move(msg),
-                     pubkey = std::move(pubkey)]() mutable {
-      auto self = self_weak.lock();
-      if (not self) {
-        BOOST_UNREACHABLE_RETURN(kEd25519LegacyVerifyFail);
-      }
-
-      auto result = self->ed25519_provider_->verify(signature, msg, pubkey);
-      auto is_succeeded = result && result.value();
-
-      return is_succeeded ? kLegacyVerifySuccess : kLegacyVerifyFail;
+                     pubkey = std::move(pubkey)] {
+      auto result = provider->verify(signature, msg, pubkey);
+      return result && result.value();
     };
-    if (batch_verify_.has_value()) {
-      auto &verification_queue = batch_verify_.value();
-      verification_queue.emplace(
-          std::async(std::launch::deferred, std::move(verifier)));
-      return kLegacyVerifySuccess;
-    }
-
-    return verifier();
+    return verifyOrQueue(std::move(verifier));
   }
 
   runtime::WasmSize CryptoExtension::ext_sr25519_verify(
@@ -193,38 +189,28 @@ namespace kagome::host_api {
                 sr25519_constants::SIGNATURE_SIZE,
                 signature.begin());
 
-    auto verifier = [self_weak = weak_from_this(),
+    // the verifier owns all it uses, as it may run on a worker thread
+    auto verifier = [provider = sr25519_provider_,
+                     logger = logger_,
                      signature = std::move(signature),
                      msg = std::move(msg),
-                     pubkey = std::move(key)]() mutable {
-      auto self = self_weak.lock();
-      if (not self) {
-        BOOST_UNREACHABLE_RETURN(kLegacyVerifyFail);
-      }
-
-      auto res = self->sr25519_provider_->verify(signature, msg, pubkey);
+                     pubkey = std::move(key)] {
+      auto res = provider->verify(signature, msg, pubkey);
       bool is_succeeded = res && res.value();
       if (not is_succeeded) {
-        SL_DEBUG(self->logger_,
+        SL_DEBUG(logger,
                  "SR25519 signature verification failed. Signature is "
                  "{}. Message is {}. Public key is {}.",
                  signature.toHex(),
                  msg.toHex(),
                  pubkey.toHex());
         if(res.has_error()) {
-          SL_DEBUG(self->logger_, "Error: {}", res.error().message());
+          SL_DEBUG(logger, "Error: {}", res.error().message());
         }
       }
-      return is_succeeded ? kLegacyVerifySuccess : kLegacyVerifyFail;
+      return is_succeeded;
     };
-    if (batch_verify_.has_value()) {
-      auto &verification_queue = batch_verify_.value();
-      verification_queue.emplace(
-          std::async(std::launch::deferred, std::move(verifier)));
-      return kLegacyVerifySuccess;
-    }
-
-    return verifier();
+    return verifyOrQueue(std::move(verifier));
   }
 
   void CryptoExtension::ext_twox_64(runtime::WasmPointer data,
@@ -8,10 +8,11 @@
 
 #include <future>
 #include <optional>
-#include <queue>
+#include <vector>
 
 #include "crypto/bip39/bip39_types.hpp"
 #include "crypto/crypto_store.hpp"
+#include "host_api/impl/batch_verification_workers.hpp"
 #include "log/logger.hpp"
 #include "runtime/wasm_memory.hpp"
 
@@ -47,7 +48,9 @@ namespace kagome::host_api {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<BatchVerificationWorkers> verification_workers =
+            nullptr);
 
     inline void reset() {
       batch_verify_ = boost::none;
@@ -227,6 +230,14 @@ namespace kagome::host_api {
    private:
     common::Blob<32> deriveSeed(std::string_view content);
 
+    /**
+     * Runs \arg verifier at once, or queues it to the started batch
+     * verification, which is then checked by the verification workers
+     * @return the legacy verification result, success if the verifier is
+     * queued
+     */
+    runtime::WasmSize verifyOrQueue(BatchVerificationWorkers::Verifier verifier);
+
     std::shared_ptr<runtime::WasmMemory> memory_;
     std::shared_ptr<crypto::Sr25519Provider> sr25519_provider_;
     std::shared_ptr<crypto::Ed25519Provider> ed25519_provider_;
@@ -234,7 +245,10 @@ namespace kagome::host_api {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
-    boost::optional<std::queue<std::future<runtime::WasmSize>>> batch_verify_;
+    std::shared_ptr<BatchVerificationWorkers> verification_workers_;
+    // results of the verifications queued since the start of the batch, or
+    // none if no batch is started
+    boost::optional<std::vector<std::future<bool>>> batch_verify_;
     log::Logger logger_;
   };
 }  // namespace kagome::host_api
@@ -16,14 +16,16 @@ namespace kagome::host_api {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<BatchVerificationWorkers> verification_workers)
       : changes_tracker_{std::move(tracker)},
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
         secp256k1_provider_(std::move(secp256k1_provider)),
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
-        bip39_provider_(std::move(bip39_provider)) {
+        bip39_provider_(std::move(bip39_provider)),
+        verification_workers_(std::move(verification_workers)) {
     BOOST_ASSERT(changes_tracker_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
     BOOST_ASSERT(ed25519_provider_ != nullptr);
@@ -49,6 +51,7 @@ namespace kagome::host_api {
                                          secp256k1_provider_,
                                          hasher_,
                                          crypto_store_,
-                                         bip39_provider_);
+                                         bip39_provider_,
+                                         verification_workers_);
   }
 }  // namespace kagome::host_api
@@ -14,6 +14,7 @@
 #include "crypto/hasher.hpp"
 #include "crypto/secp256k1_provider.hpp"
 #include "crypto/sr25519_provider.hpp"
+#include "host_api/impl/batch_verification_workers.hpp"
 #include "host_api/impl/misc_extension.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 
@@ -30,7 +31,9 @@ namespace kagome::host_api {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<BatchVerificationWorkers> verification_workers =
+            nullptr);
 
     std::unique_ptr<HostApi> make(
         std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
@@ -48,6 +51,7 @@ namespace kagome::host_api {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
+    std::shared_ptr<BatchVerificationWorkers> verification_workers_;
   };
 
 }  // namespace kagome::host_api
@@ -28,7 +28,8 @@ namespace kagome::host_api {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<BatchVerificationWorkers> verification_workers)
       : memory_(memory),
         storage_provider_(std::move(storage_provider)),
         crypto_ext_{
@@ -38,7 +39,8 @@ namespace kagome::host_api {
                                               std::move(secp256k1_provider),
                                               std::move(hasher),
                                               std::move(crypto_store),
-                                              std::move(bip39_provider))},
+                                              std::move(bip39_provider),
+                                              std::move(verification_workers))},
         io_ext_(memory),
         memory_ext_(memory),
         misc_ext_{DEFAULT_CHAIN_ID,
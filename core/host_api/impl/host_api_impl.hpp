@@ -36,7 +36,9 @@ namespace kagome::host_api {
                 std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
                 std::shared_ptr<crypto::Hasher> hasher,
                 std::shared_ptr<crypto::CryptoStore> crypto_store,
-                std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+                std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+                std::shared_ptr<BatchVerificationWorkers>
+                    verification_workers = nullptr);
 
     ~HostApiImpl() override = default;
 
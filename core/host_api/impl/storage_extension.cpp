@@ -9,7 +9,6 @@
 
 #include "runtime/common/runtime_transaction_error.hpp"
 #include "runtime/wasm_result.hpp"
-#include "scale/encode_append.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 #include "storage/trie/serialization/ordered_trie_hash.hpp"
 
@@ -255,7 +254,7 @@ namespace kagome::host_api {
     outcome::result<storage::trie::RootHash> res{{}};
     if (auto opt_batch = storage_provider_->tryGetPersistentBatch();
         opt_batch.has_value() and opt_batch.value() != nullptr) {
-      res = opt_batch.value()->commit();
+      res = opt_batch.value()->calculateRoot();
     } else {
       logger_->warn("ext_storage_root called in an ephemeral extension");
       res = storage_provider_->forceCommit();
@@ -384,7 +383,7 @@ namespace kagome::host_api {
     outcome::result<storage::trie::RootHash> res{{}};
     if (auto opt_batch = storage_provider_->tryGetPersistentBatch();
         opt_batch.has_value() and opt_batch.value() != nullptr) {
-      res = opt_batch.value()->commit();
+      res = opt_batch.value()->calculateRoot();
     } else {
       logger_->warn("ext_storage_root called in an ephemeral extension");
       res = storage_provider_->forceCommit();
@@ -444,19 +443,14 @@ namespace kagome::host_api {
     auto key_bytes = memory_->loadN(key_ptr, key_size);
     auto append_bytes = memory_->loadN(append_ptr, append_size);
 
-    auto &&val_res = get(key_bytes);
-    auto &&val = val_res ? std::move(val_res.value()) : common::Buffer();
-
-    if (scale::append_or_new_vec(val.asVector(), append_bytes).has_value()) {
-      auto batch = storage_provider_->getCurrentBatch();
-      auto &&put_result = batch->put(key_bytes, std::move(val));
-      if (not put_result) {
-        logger_->error(
-            "ext_storage_append_version_1 failed, due to fail in trie db with "
-            "reason: {}",
-            put_result.error().message());
-      }
-      return;
+    // the batch keeps the appended items apart from the vector, so that it
+    // is not copied on each append
+    auto batch = storage_provider_->getCurrentBatch();
+    if (auto res = batch->append(key_bytes, append_bytes); not res) {
+      logger_->error(
+          "ext_storage_append_version_1 failed, due to fail in trie db with "
+          "reason: {}",
+          res.error().message());
     }
   }
 
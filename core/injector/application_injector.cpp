@@ -37,6 +37,7 @@
 #include "authorship/impl/block_builder_factory_impl.hpp"
 #include "authorship/impl/block_builder_impl.hpp"
 #include "authorship/impl/proposer_impl.hpp"
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/block_tree_impl.hpp"
 #include "blockchain/impl/key_value_block_header_repository.hpp"
 #include "blockchain/impl/key_value_block_storage.hpp"
@@ -87,6 +88,8 @@
 #include "runtime/binaryen/binaryen_wasm_memory_factory.hpp"
 #include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
 #include "runtime/binaryen/module/wasm_module_impl.hpp"
+#include "runtime/binaryen/module/optimizing_wasm_module_factory.hpp"
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
 #include "runtime/binaryen/runtime_api/account_nonce_api_impl.hpp"
 #include "runtime/binaryen/runtime_api/babe_api_impl.hpp"
 #include "runtime/binaryen/runtime_api/block_builder_impl.hpp"
@@ -96,6 +99,7 @@
 #include "runtime/binaryen/runtime_api/metadata_impl.hpp"
 #include "runtime/binaryen/runtime_api/offchain_worker_impl.hpp"
 #include "runtime/binaryen/runtime_api/parachain_host_impl.hpp"
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
 #include "runtime/binaryen/runtime_api/tagged_transaction_queue_impl.hpp"
 #include "runtime/binaryen/runtime_api/transaction_payment_api_impl.hpp"
 #include "runtime/common/storage_wasm_provider.hpp"
@@ -104,11 +108,15 @@
 #include "storage/database_error.hpp"
 #include "storage/leveldb/leveldb.hpp"
 #include "storage/predefined_keys.hpp"
+#include "storage/trie/impl/flat_state.hpp"
+#include "storage/trie/impl/trie_pruner.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/impl/trie_storage_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_commit_workers.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 #include "transaction_pool/impl/pool_moderator_impl.hpp"
 #include "transaction_pool/impl/transaction_pool_impl.hpp"
@@ -178,11 +186,27 @@ namespace {
     return initialized.value();
   }
 
+  sptr<blockchain::BlockHeaderCache> get_block_header_cache() {
+    static auto initialized =
+        boost::optional<sptr<blockchain::BlockHeaderCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    auto cache = std::make_shared<blockchain::BlockHeaderCache>(
+        blockchain::BlockHeaderCache::kDefaultCapacity);
+
+    initialized.emplace(std::move(cache));
+    return initialized.value();
+  }
+
   sptr<blockchain::BlockStorage> get_block_storage(
       sptr<crypto::Hasher> hasher,
       sptr<storage::BufferStorage> db,
       sptr<storage::trie::TrieStorage> trie_storage,
-      sptr<runtime::GrandpaApi> grandpa_api) {
+      sptr<runtime::GrandpaApi> grandpa_api,
+      sptr<blockchain::BlockHeaderCache> header_cache) {
     static auto initialized =
         boost::optional<sptr<blockchain::BlockStorage>>(boost::none);
 
@@ -242,7 +266,8 @@ namespace {
               common::raise(save_res.error());
             }
           }
-        });
+        },
+        std::move(header_cache));
     if (storage_res.has_error()) {
       common::raise(storage_res.error());
     }
@@ -266,14 +291,19 @@ namespace {
       return initialized.value();
     }
 
-    auto factory =
-        std::make_shared<host_api::HostApiFactoryImpl>(tracker,
-                                                       sr25519_provider,
-                                                       ed25519_provider,
-                                                       secp256k1_provider,
-                                                       hasher,
-                                                       crypto_store,
-                                                       bip39_provider);
+    auto verification_workers =
+        std::make_shared<host_api::BatchVerificationWorkers>(
+            std::max(1u, std::thread::hardware_concurrency()));
+
+    auto factory = std::make_shared<host_api::HostApiFactoryImpl>(
+        tracker,
+        sr25519_provider,
+        ed25519_provider,
+        secp256k1_provider,
+        hasher,
+        crypto_store,
+        bip39_provider,
+        std::move(verification_workers));
 
     initialized.emplace(std::move(factory));
     return initialized.value();
@@ -296,11 +326,204 @@ namespace {
     return initialized.value();
   }
 
+  sptr<storage::trie::TrieNodeCache> get_trie_node_cache(
+      application::AppConfiguration const &app_config) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieNodeCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    // the serializer goes without a cache if it is disabled
+    sptr<storage::trie::TrieNodeCache> cache;
+    if (auto capacity = app_config.trieNodeCacheSize(); capacity > 0) {
+      cache = std::make_shared<storage::trie::TrieNodeCache>(capacity);
+    }
+
+    initialized.emplace(std::move(cache));
+    return initialized.value();
+  }
+
+  sptr<storage::trie::TrieCommitWorkers> get_trie_commit_workers(
+      application::AppConfiguration const &app_config) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieCommitWorkers>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    auto threshold = app_config.parallelTrieCommitThreshold();
+    auto threads = std::thread::hardware_concurrency();
+    if (threshold == 0 or threads < 2) {
+      initialized.emplace(nullptr);
+      return initialized.value();
+    }
+
+    // the calling thread stores a subtree as well
+    auto workers = std::make_shared<storage::trie::TrieCommitWorkers>(
+        threads - 1, threshold);
+
+    initialized.emplace(std::move(workers));
+    return initialized.value();
+  }
+
+  sptr<runtime::binaryen::WasmModuleInstancePool>
+  get_wasm_module_instance_pool(
+      application::AppConfiguration const &app_config) {
+    static auto initialized = boost::optional<
+        sptr<runtime::binaryen::WasmModuleInstancePool>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    auto capacity = app_config.runtimeInstancePoolSize().value_or(
+        std::thread::hardware_concurrency());
+    if (capacity == 0) {
+      initialized.emplace(nullptr);
+      return initialized.value();
+    }
+
+    auto pool =
+        std::make_shared<runtime::binaryen::WasmModuleInstancePool>(capacity);
+
+    initialized.emplace(std::move(pool));
+    return initialized.value();
+  }
+
+  sptr<runtime::binaryen::RuntimeCallCache> get_runtime_call_cache(
+      application::AppConfiguration const &app_config) {
+    static auto initialized = boost::optional<
+        sptr<runtime::binaryen::RuntimeCallCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    auto size_mb = app_config.runtimeCallCacheSize();
+    if (size_mb == 0) {
+      initialized.emplace(nullptr);
+      return initialized.value();
+    }
+
+    auto cache = std::make_shared<runtime::binaryen::RuntimeCallCache>(
+        runtime::binaryen::RuntimeCallCache::kDefaultMaxEntries,
+        static_cast<size_t>(size_mb) * 1024 * 1024);
+
+    initialized.emplace(std::move(cache));
+    return initialized.value();
+  }
+
+  sptr<runtime::binaryen::WasmModuleFactory> get_wasm_module_factory(
+      application::AppConfiguration const &app_config,
+      sptr<application::ChainSpec> chain_spec,
+      sptr<crypto::Hasher> hasher) {
+    static auto initialized =
+        boost::optional<sptr<runtime::binaryen::WasmModuleFactory>>(
+            boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    using RuntimeExecutionMethod =
+        application::AppConfiguration::RuntimeExecutionMethod;
+    if (app_config.runtimeExecMethod() == RuntimeExecutionMethod::Optimize) {
+      auto cache = std::make_shared<runtime::binaryen::WasmModuleCache>(
+          app_config.runtimeCacheDirPath(chain_spec->id()));
+      initialized.emplace(
+          std::make_shared<runtime::binaryen::OptimizingWasmModuleFactory>(
+              std::move(cache), std::move(hasher)));
+    } else {
+      initialized.emplace(
+          std::make_shared<runtime::binaryen::WasmModuleFactoryImpl>());
+    }
+    return initialized.value();
+  }
+
+  sptr<storage::trie::FlatState> get_flat_state(
+      application::AppConfiguration const &app_config,
+      sptr<storage::BufferStorage> storage,
+      sptr<storage::trie::TrieSerializer> serializer) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::FlatState>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    if (not app_config.isFlatStateEnabled()) {
+      initialized.emplace(nullptr);
+      return initialized.value();
+    }
+
+    auto flat_state_res = storage::trie::FlatState::create(
+        storage,
+        common::Buffer{blockchain::prefix::FLAT_STATE},
+        common::Buffer{blockchain::prefix::FLAT_STATE_JOURNAL},
+        serializer->getEmptyRootHash());
+    if (not flat_state_res) {
+      common::raise(flat_state_res.error());
+    }
+
+    initialized.emplace(std::move(flat_state_res.value()));
+    return initialized.value();
+  }
+
+  sptr<storage::trie::TriePruner> get_trie_pruner(
+      application::AppConfiguration const &app_config,
+      sptr<storage::BufferStorage> storage,
+      sptr<storage::trie::TrieStorageBackend> backend,
+      sptr<storage::trie::Codec> codec) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TriePruner>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+
+    auto depth = app_config.statePruningDepth();
+    if (not depth) {
+      initialized.emplace(nullptr);
+      return initialized.value();
+    }
+
+    // the nodes of a database filled without pruning are not counted, so
+    // it is impossible to tell which of them are still needed
+    if (storage->contains(storage::kGenesisBlockHashLookupKey)
+        and not storage->contains(storage::kTriePrunerStateLookupKey)) {
+      auto log = log::createLogger("Injector", "injector");
+      log->error(
+          "State pruning is only possible for a database created with it; "
+          "all states are kept");
+      initialized.emplace(nullptr);
+      return initialized.value();
+    }
+
+    // the state of the last finalized block is always needed
+    auto pruner_res = storage::trie::TriePruner::create(
+        storage,
+        std::move(backend),
+        std::move(codec),
+        common::Buffer{blockchain::prefix::TRIE_NODE_REFCOUNT},
+        common::Buffer{blockchain::prefix::TRIE_STATE_REFCOUNT},
+        std::max<uint32_t>(depth.value(), 1));
+    if (not pruner_res) {
+      common::raise(pruner_res.error());
+    }
+
+    initialized.emplace(std::move(pruner_res.value()));
+    return initialized.value();
+  }
+
   sptr<storage::trie::TrieStorageImpl> get_trie_storage_impl(
       sptr<storage::trie::PolkadotTrieFactory> factory,
       sptr<storage::trie::Codec> codec,
       sptr<storage::trie::TrieSerializer> serializer,
-      sptr<storage::changes_trie::ChangesTracker> tracker) {
+      sptr<storage::changes_trie::ChangesTracker> tracker,
+      sptr<storage::trie::FlatState> flat_state) {
     static auto initialized =
         boost::optional<sptr<storage::trie::TrieStorageImpl>>(boost::none);
 
@@ -309,7 +532,7 @@ namespace {
     }
 
     auto trie_storage_res = storage::trie::TrieStorageImpl::createEmpty(
-        factory, codec, serializer, tracker);
+        factory, codec, serializer, tracker, flat_state);
 
     if (!trie_storage_res) {
       common::raise(trie_storage_res.error());
@@ -322,7 +545,10 @@ namespace {
 
   sptr<storage::trie::TrieStorage> get_trie_storage(
       sptr<application::ChainSpec> configuration_storage,
-      sptr<storage::trie::TrieStorageImpl> trie_storage) {
+      sptr<storage::trie::TrieStorageImpl> trie_storage,
+      sptr<storage::trie::TrieSerializer> serializer,
+      sptr<storage::trie::FlatState> flat_state,
+      sptr<storage::trie::TriePruner> state_pruner) {
     static auto initialized =
         boost::optional<sptr<storage::trie::TrieStorage>>(boost::none);
     if (initialized) {
@@ -347,8 +573,33 @@ namespace {
         common::raise(res.error());
       }
     }
-    if (auto res = batch.value()->commit(); not res) {
-      common::raise(res.error());
+    auto genesis_root_res = batch.value()->commit();
+    if (not genesis_root_res) {
+      common::raise(genesis_root_res.error());
+    }
+
+    // a snapshot which has never been written to follows the chain from the
+    // genesis state
+    if (flat_state != nullptr
+        and flat_state->root() == serializer->getEmptyRootHash()) {
+      if (auto res = flat_state->finalize(genesis_root_res.value()); not res) {
+        common::raise(res.error());
+      }
+    }
+
+    // the genesis block is never added to the block tree, so its state is
+    // kept here, once for the whole life of the database
+    if (state_pruner != nullptr) {
+      auto has_state_res = state_pruner->hasState(genesis_root_res.value());
+      if (not has_state_res) {
+        common::raise(has_state_res.error());
+      }
+      if (not has_state_res.value()) {
+        if (auto res = state_pruner->addState(genesis_root_res.value());
+            not res) {
+          common::raise(res.error());
+        }
+      }
     }
 
     initialized.emplace(std::move(trie_storage));
@@ -366,7 +617,9 @@ namespace {
     auto options = leveldb::Options{};
     options.create_if_missing = true;
     auto db_res = storage::LevelDB::create(
-        app_config.databasePath(chain_spec->id()), options);
+        app_config.databasePath(chain_spec->id()),
+        app_config.levelDbConfig(),
+        options);
     if (!db_res) {
       auto log = log::createLogger("Injector", "injector");
       log->critical("Can't create LevelDB in {}: {}",
@@ -656,6 +909,10 @@ namespace {
             .template create<std::shared_ptr<primitives::BabeConfiguration>>();
     auto babe_util =
         injector.template create<std::shared_ptr<consensus::BabeUtil>>();
+    auto flat_state =
+        injector.template create<sptr<storage::trie::FlatState>>();
+    auto state_pruner =
+        injector.template create<sptr<storage::trie::TriePruner>>();
 
     auto block_tree_res =
         blockchain::BlockTreeImpl::create(std::move(header_repo),
@@ -668,7 +925,9 @@ namespace {
                                           std::move(ext_events_key_repo),
                                           std::move(runtime_core),
                                           std::move(babe_configuration),
-                                          std::move(babe_util));
+                                          std::move(babe_util),
+                                          std::move(flat_state),
+                                          std::move(state_pruner));
     if (not block_tree_res.has_value()) {
       common::raise(block_tree_res.error());
     }
@@ -910,7 +1169,13 @@ namespace {
               injector.template create<sptr<storage::trie::TrieStorage>>();
           const auto &grandpa_api =
               injector.template create<sptr<runtime::GrandpaApi>>();
-          return get_block_storage(hasher, db, trie_storage, grandpa_api);
+          const auto &header_cache =
+              injector.template create<sptr<blockchain::BlockHeaderCache>>();
+          return get_block_storage(
+              hasher, db, trie_storage, grandpa_api, header_cache);
+        }),
+        di::bind<blockchain::BlockHeaderCache>.to([](auto const &injector) {
+          return get_block_header_cache();
         }),
         di::bind<blockchain::BlockTree>.to(
             [](auto const &injector) { return get_block_tree(injector); }),
@@ -976,9 +1241,32 @@ namespace {
           return get_sync_observer_impl(injector);
         }),
         di::bind<runtime::binaryen::WasmModule>.template to<runtime::binaryen::WasmModuleImpl>(),
-        di::bind<runtime::binaryen::WasmModuleFactory>.template to<runtime::binaryen::WasmModuleFactoryImpl>(),
+        di::bind<runtime::binaryen::WasmModuleFactory>.to(
+            [](auto const &injector) {
+              const application::AppConfiguration &config =
+                  injector.template create<
+                      application::AppConfiguration const &>();
+              auto chain_spec =
+                  injector.template create<sptr<application::ChainSpec>>();
+              auto hasher = injector.template create<sptr<crypto::Hasher>>();
+              return get_wasm_module_factory(config, chain_spec, hasher);
+            }),
         di::bind<runtime::binaryen::CoreFactory>.template to<runtime::binaryen::CoreFactoryImpl>(),
         di::bind<runtime::binaryen::RuntimeEnvironmentFactory>.template to<runtime::binaryen::RuntimeEnvironmentFactoryImpl>(),
+        di::bind<runtime::binaryen::WasmModuleInstancePool>.to(
+            [](auto const &injector) {
+              const application::AppConfiguration &config =
+                  injector.template create<
+                      application::AppConfiguration const &>();
+              return get_wasm_module_instance_pool(config);
+            }),
+        di::bind<runtime::binaryen::RuntimeCallCache>.to(
+            [](auto const &injector) {
+              const application::AppConfiguration &config =
+                  injector.template create<
+                      application::AppConfiguration const &>();
+              return get_runtime_call_cache(config);
+            }),
         di::bind<runtime::TaggedTransactionQueue>.template to<runtime::binaryen::TaggedTransactionQueueImpl>(),
         di::bind<runtime::ParachainHost>.template to<runtime::binaryen::ParachainHostImpl>(),
         di::bind<runtime::OffchainWorker>.template to<runtime::binaryen::OffchainWorkerImpl>(),
@@ -1008,18 +1296,62 @@ namespace {
               injector.template create<sptr<storage::trie::TrieSerializer>>();
           auto tracker = injector.template create<
               sptr<storage::changes_trie::ChangesTracker>>();
-          return get_trie_storage_impl(factory, codec, serializer, tracker);
+          auto flat_state =
+              injector.template create<sptr<storage::trie::FlatState>>();
+          return get_trie_storage_impl(
+              factory, codec, serializer, tracker, flat_state);
         }),
         di::bind<storage::trie::TrieStorage>.to([](auto const &injector) {
           auto configuration_storage =
               injector.template create<sptr<application::ChainSpec>>();
           auto trie_storage =
               injector.template create<sptr<storage::trie::TrieStorageImpl>>();
-          return get_trie_storage(configuration_storage, trie_storage);
+          auto serializer =
+              injector.template create<sptr<storage::trie::TrieSerializer>>();
+          auto flat_state =
+              injector.template create<sptr<storage::trie::FlatState>>();
+          auto state_pruner =
+              injector.template create<sptr<storage::trie::TriePruner>>();
+          return get_trie_storage(configuration_storage,
+                                  trie_storage,
+                                  serializer,
+                                  flat_state,
+                                  state_pruner);
+        }),
+        di::bind<storage::trie::FlatState>.to([](auto const &injector) {
+          const application::AppConfiguration &config =
+              injector.template create<application::AppConfiguration const &>();
+          auto storage =
+              injector.template create<sptr<storage::BufferStorage>>();
+          auto serializer =
+              injector.template create<sptr<storage::trie::TrieSerializer>>();
+          return get_flat_state(config, storage, serializer);
+        }),
+        di::bind<storage::trie::TriePruner>.to([](auto const &injector) {
+          const application::AppConfiguration &config =
+              injector.template create<application::AppConfiguration const &>();
+          auto storage =
+              injector.template create<sptr<storage::BufferStorage>>();
+          auto backend = injector.template create<
+              sptr<storage::trie::TrieStorageBackend>>();
+          auto codec = injector.template create<sptr<storage::trie::Codec>>();
+          return get_trie_pruner(config, storage, backend, codec);
         }),
         di::bind<storage::trie::PolkadotTrieFactory>.template to<storage::trie::PolkadotTrieFactoryImpl>(),
         di::bind<storage::trie::Codec>.template to<storage::trie::PolkadotCodec>(),
         di::bind<storage::trie::TrieSerializer>.template to<storage::trie::TrieSerializerImpl>(),
+        di::bind<storage::trie::TrieNodeCache>.to([](auto const &injector) {
+          const application::AppConfiguration &config =
+              injector.template create<application::AppConfiguration const &>();
+          return get_trie_node_cache(config);
+        }),
+        di::bind<storage::trie::TrieCommitWorkers>.to(
+            [](auto const &injector) {
+              const application::AppConfiguration &config =
+                  injector.template create<
+                      application::AppConfiguration const &>();
+              return get_trie_commit_workers(config);
+            }),
         di::bind<runtime::WasmProvider>.template to<runtime::StorageWasmProvider>(),
         di::bind<application::ChainSpec>.to([](const auto &injector) {
           const application::AppConfiguration &config =
@@ -12,7 +12,7 @@
 #include "network/protocols/block_announce_protocol.hpp"
 #include "network/protocols/grandpa_protocol.hpp"
 #include "network/protocols/propagate_transactions_protocol.hpp"
-#include "network/protocols/sync_protocol.hpp"
+#include "network/protocols/sync_protocol_impl.hpp"
 #include "primitives/event_types.hpp"
 
 namespace kagome::network {
@@ -3,7 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include "network/protocols/sync_protocol.hpp"
+#include "network/protocols/sync_protocol_impl.hpp"
 
 #include "common/visitor.hpp"
 #include "network/adapters/protobuf_block_request.hpp"
@@ -17,7 +17,7 @@
 
 namespace kagome::network {
 
-  SyncProtocol::SyncProtocol(
+  SyncProtocolImpl::SyncProtocolImpl(
       libp2p::Host &host,
       const application::ChainSpec &chain_spec,
       std::shared_ptr<SyncProtocolObserver> sync_observer)
@@ -27,7 +27,7 @@ namespace kagome::network {
         fmt::format(kSyncProtocol.data(), chain_spec.protocolId());
   }
 
-  bool SyncProtocol::start() {
+  bool SyncProtocolImpl::start() {
     host_.setProtocolHandler(protocol_, [wp = weak_from_this()](auto &&stream) {
       if (auto self = wp.lock()) {
         if (auto peer_id = stream->remotePeerId()) {
@@ -45,17 +45,17 @@ namespace kagome::network {
     return true;
   }
 
-  bool SyncProtocol::stop() {
+  bool SyncProtocolImpl::stop() {
     return true;
   }
 
-  void SyncProtocol::onIncomingStream(std::shared_ptr<Stream> stream) {
+  void SyncProtocolImpl::onIncomingStream(std::shared_ptr<Stream> stream) {
     BOOST_ASSERT(stream->remotePeerId().has_value());
 
     readRequest(stream);
   }
 
-  void SyncProtocol::newOutgoingStream(
+  void SyncProtocolImpl::newOutgoingStream(
       const PeerInfo &peer_info,
       std::function<void(outcome::result<std::shared_ptr<Stream>>)> &&cb) {
     SL_DEBUG(log_,
@@ -95,7 +95,7 @@ namespace kagome::network {
         });
   }
 
-  void SyncProtocol::readRequest(std::shared_ptr<Stream> stream) {
+  void SyncProtocolImpl::readRequest(std::shared_ptr<Stream> stream) {
     auto read_writer = std::make_shared<ProtobufMessageReadWriter>(stream);
 
     SL_DEBUG(log_,
@@ -143,7 +143,7 @@ namespace kagome::network {
     });
   }
 
-  void SyncProtocol::writeResponse(std::shared_ptr<Stream> stream,
+  void SyncProtocolImpl::writeResponse(std::shared_ptr<Stream> stream,
                                    const BlocksResponse &block_response) {
     auto read_writer = std::make_shared<ProtobufMessageReadWriter>(stream);
 
@@ -172,7 +172,7 @@ namespace kagome::network {
         });
   }
 
-  void SyncProtocol::writeRequest(
+  void SyncProtocolImpl::writeRequest(
       std::shared_ptr<Stream> stream,
       BlocksRequest block_request,
       std::function<void(outcome::result<void>)> &&cb) {
@@ -218,7 +218,7 @@ namespace kagome::network {
         });
   }
 
-  void SyncProtocol::readResponse(
+  void SyncProtocolImpl::readResponse(
       std::shared_ptr<Stream> stream,
       std::function<void(outcome::result<BlocksResponse>)> &&response_handler) {
     auto read_writer = std::make_shared<ProtobufMessageReadWriter>(stream);
@@ -263,7 +263,7 @@ namespace kagome::network {
     });
   }
 
-  void SyncProtocol::request(
+  void SyncProtocolImpl::request(
       const PeerId &peer_id,
       BlocksRequest block_request,
       std::function<void(outcome::result<BlocksResponse>)> &&response_handler) {
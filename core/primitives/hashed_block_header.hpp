@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_PRIMITIVES_HASHED_BLOCK_HEADER_HPP
+#define KAGOME_PRIMITIVES_HASHED_BLOCK_HEADER_HPP
+
+#include "common/buffer.hpp"
+#include "crypto/hasher.hpp"
+#include "primitives/block_header.hpp"
+#include "scale/scale.hpp"
+
+namespace kagome::primitives {
+
+  /**
+   * Block header together with its SCALE encoding and its hash, which are
+   * calculated once on construction, so that the header passed through the
+   * block import is not encoded and hashed again at every step
+   */
+  class HashedBlockHeader {
+   public:
+    HashedBlockHeader(BlockHeader header, const crypto::Hasher &hasher)
+        : header_{std::move(header)},
+          encoded_{scale::encode(header_).value()},
+          hash_{hasher.blake2b_256(encoded_)} {}
+
+    const BlockHeader &header() const {
+      return header_;
+    }
+
+    const BlockHash &hash() const {
+      return hash_;
+    }
+
+    const common::Buffer &encoded() const {
+      return encoded_;
+    }
+
+   private:
+    BlockHeader header_;
+    common::Buffer encoded_;
+    BlockHash hash_;
+  };
+
+}  // namespace kagome::primitives
+
+#endif  // KAGOME_PRIMITIVES_HASHED_BLOCK_HEADER_HPP
@@ -0,0 +1,34 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_PRIMITIVES_STORAGE_CHANGE_SET_HPP
+#define KAGOME_CORE_PRIMITIVES_STORAGE_CHANGE_SET_HPP
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::primitives {
+
+  /**
+   * Values of a set of storage keys at a block, as reported via RPC
+   */
+  struct StorageChangeSet {
+    struct Change {
+      common::Buffer key;
+      /// none if the key has no value at the block
+      boost::optional<common::Buffer> data;
+    };
+
+    BlockHash block;
+    std::vector<Change> changes;
+  };
+
+}  // namespace kagome::primitives
+
+#endif  // KAGOME_CORE_PRIMITIVES_STORAGE_CHANGE_SET_HPP
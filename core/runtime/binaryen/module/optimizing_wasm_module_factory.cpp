@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/optimizing_wasm_module_factory.hpp"
+
+#include <binaryen/pass.h>
+
+#include "runtime/binaryen/module/wasm_module_impl.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  namespace {
+    const std::string kCacheKind =
+        "O" + std::to_string(OptimizingWasmModuleFactory::kOptimizeLevel);
+  }
+
+  OptimizingWasmModuleFactory::OptimizingWasmModuleFactory(
+      std::shared_ptr<WasmModuleCache> cache,
+      std::shared_ptr<crypto::Hasher> hasher)
+      : cache_{std::move(cache)},
+        hasher_{std::move(hasher)},
+        logger_{log::createLogger("OptimizingWasmModuleFactory", "wasm")} {
+    BOOST_ASSERT(cache_ != nullptr);
+    BOOST_ASSERT(hasher_ != nullptr);
+  }
+
+  outcome::result<std::unique_ptr<WasmModule>>
+  OptimizingWasmModuleFactory::createModule(
+      const common::Buffer &code,
+      std::shared_ptr<RuntimeExternalInterface> rei,
+      std::shared_ptr<TrieStorageProvider> storage_provider) const {
+    if (code.empty()) {
+      return WasmModuleImpl::Error::EMPTY_STATE_CODE;
+    }
+    auto code_hash = hasher_->twox_256(code);
+
+    if (auto optimized = cache_->load(code_hash, kCacheKind);
+        optimized.has_value()) {
+      auto module = WasmModuleImpl::createFromCode(
+          optimized.value(), rei, storage_provider);
+      if (module.has_value()) {
+        return std::unique_ptr<WasmModule>(std::move(module.value()));
+      }
+      // a damaged module is replaced by the code optimized again
+      logger_->warn("Could not load optimized runtime {}: {}",
+                    code_hash.toHex(),
+                    module.error().message());
+      cache_->remove(code_hash, kCacheKind);
+    }
+
+    OUTCOME_TRY(parsed, WasmModuleImpl::parseCode(code));
+    logger_->info("Optimizing runtime {}", code_hash.toHex());
+    {
+      wasm::PassOptions options;
+      options.optimizeLevel = kOptimizeLevel;
+      wasm::PassRunner runner(parsed.get(), options);
+      runner.addDefaultOptimizationPasses();
+      runner.run();
+    }
+    cache_->store(code_hash, kCacheKind, *parsed);
+
+    OUTCOME_TRY(module,
+                WasmModuleImpl::createFromModule(std::move(parsed),
+                                                 storage_provider));
+    return std::unique_ptr<WasmModule>(std::move(module));
+  }
+
+}  // namespace kagome::runtime::binaryen
@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_MODULE_OPTIMIZING_WASM_MODULE_FACTORY
+#define KAGOME_CORE_RUNTIME_BINARYEN_MODULE_OPTIMIZING_WASM_MODULE_FACTORY
+
+#include "runtime/binaryen/module/wasm_module_factory.hpp"
+
+#include "crypto/hasher.hpp"
+#include "log/logger.hpp"
+#include "runtime/binaryen/module/wasm_module_cache.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Produces modules whose code is optimized ahead of the calls by the
+   * optimization passes of Binaryen, which fold the constants, inline the
+   * small functions and drop the redundant locals and blocks, so that the
+   * interpreter has much less to walk through. The code is still interpreted,
+   * not compiled to machine code. Each runtime code is optimized once: the
+   * optimized module is kept in the cache and is loaded from there after a
+   * restart, unless it cannot be parsed
+   */
+  class OptimizingWasmModuleFactory final : public WasmModuleFactory {
+   public:
+    /// Binaryen optimization level, the same as -O2 of wasm-opt
+    static constexpr int kOptimizeLevel = 2;
+
+    OptimizingWasmModuleFactory(std::shared_ptr<WasmModuleCache> cache,
+                                std::shared_ptr<crypto::Hasher> hasher);
+    ~OptimizingWasmModuleFactory() override = default;
+
+    outcome::result<std::unique_ptr<WasmModule>> createModule(
+        const common::Buffer &code,
+        std::shared_ptr<RuntimeExternalInterface> rei,
+        std::shared_ptr<TrieStorageProvider> storage_provider) const override;
+
+   private:
+    std::shared_ptr<WasmModuleCache> cache_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    log::Logger logger_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_MODULE_OPTIMIZING_WASM_MODULE_FACTORY
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_cache.hpp"
+
+#include <fstream>
+#include <vector>
+
+#include <binaryen/wasm-binary.h>
+#include <boost/filesystem/operations.hpp>
+
+namespace kagome::runtime::binaryen {
+
+  namespace fs = boost::filesystem;
+
+  WasmModuleCache::WasmModuleCache(fs::path cache_dir)
+      : dir_{cache_dir / kExecutorVersion},
+        logger_{log::createLogger("WasmModuleCache", "wasm")} {
+    removeOtherVersions(cache_dir);
+  }
+
+  boost::optional<common::Buffer> WasmModuleCache::load(
+      const common::Hash256 &code_hash, const std::string &kind) const {
+    auto path = modulePath(code_hash, kind);
+    std::ifstream file(path.native(), std::ios::binary | std::ios::ate);
+    if (not file.is_open()) {
+      return boost::none;
+    }
+    common::Buffer module(static_cast<size_t>(file.tellg()), 0);
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char *>(module.data()),  // NOLINT
+              module.size());
+    if (not file or module.empty()) {
+      logger_->warn("Could not read cached runtime module {}", path.native());
+      return boost::none;
+    }
+    logger_->debug("Loaded cached runtime module {}", path.native());
+    return module;
+  }
+
+  void WasmModuleCache::store(const common::Hash256 &code_hash,
+                              const std::string &kind,
+                              wasm::Module &module) const {
+    boost::system::error_code ec;
+    fs::create_directories(dir_, ec);
+    if (ec) {
+      logger_->warn("Could not create directory {} for runtime modules: {}",
+                    dir_.native(),
+                    ec.message());
+      return;
+    }
+
+    // the custom sections are not used for execution, and the names of the
+    // functions are not written by default
+    auto user_sections = std::move(module.userSections);
+    module.userSections.clear();
+    wasm::BufferWithRandomAccess buffer;
+    wasm::WasmBinaryWriter writer(&module, buffer);
+    writer.write();
+    module.userSections = std::move(user_sections);
+
+    // written aside and renamed, so that a crash leaves no partial module
+    auto path = modulePath(code_hash, kind);
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+      std::ofstream file(tmp_path.native(),
+                         std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char *>(buffer.data()),  // NOLINT
+                 buffer.size());
+      if (not file) {
+        logger_->warn("Could not write runtime module {}", tmp_path.native());
+        return;
+      }
+    }
+    fs::rename(tmp_path, path, ec);
+    if (ec) {
+      logger_->warn("Could not store runtime module {}: {}",
+                    path.native(),
+                    ec.message());
+    }
+  }
+
+  void WasmModuleCache::remove(const common::Hash256 &code_hash,
+                               const std::string &kind) const {
+    auto path = modulePath(code_hash, kind);
+    boost::system::error_code ec;
+    fs::remove(path, ec);
+    if (ec) {
+      logger_->warn("Could not remove runtime module {}: {}",
+                    path.native(),
+                    ec.message());
+    }
+  }
+
+  fs::path WasmModuleCache::modulePath(const common::Hash256 &code_hash,
+                                       const std::string &kind) const {
+    return dir_ / (code_hash.toHex() + "." + kind + ".wasm");
+  }
+
+  void WasmModuleCache::removeOtherVersions(const fs::path &cache_dir) const {
+    boost::system::error_code ec;
+    std::vector<fs::path> stale;
+    for (fs::directory_iterator it{cache_dir, ec}, end; not ec and it != end;
+         it.increment(ec)) {
+      // the directories of the executor versions and the modules kept
+      // before the versions are the only entries here
+      if (it->path() == dir_) {
+        continue;
+      }
+      boost::system::error_code dir_ec;
+      if (fs::is_directory(it->path(), dir_ec)
+          or it->path().extension() == ".wasm") {
+        stale.push_back(it->path());
+      }
+    }
+    for (auto &path : stale) {
+      logger_->info("Removing stale runtime modules {}", path.native());
+      fs::remove_all(path, ec);
+      if (ec) {
+        logger_->warn("Could not remove {}: {}", path.native(), ec.message());
+      }
+    }
+  }
+
+}  // namespace kagome::runtime::binaryen
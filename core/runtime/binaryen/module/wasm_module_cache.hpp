@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_CACHE
+#define KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_CACHE
+
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "log/logger.hpp"
+
+namespace wasm {
+  class Module;
+}  // namespace wasm
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Keeps the modules prepared from the runtime codes on disk, so that a
+   * restart loads them instead of preparing them again. A module is kept in
+   * the binary form Binaryen writes it in, without the custom sections,
+   * which are not used for execution. The modules of another executor
+   * version, as well as the ones kept before the modules were versioned, are
+   * removed once the cache is created
+   */
+  class WasmModuleCache {
+   public:
+    /**
+     * Version of the way the modules are prepared, to be increased along
+     * with the Binaryen version or a change of the preparation
+     */
+    static constexpr auto kExecutorVersion = "binaryen-v1";
+
+    /**
+     * @param cache_dir directory to keep the modules in
+     */
+    explicit WasmModuleCache(boost::filesystem::path cache_dir);
+
+    /**
+     * @param kind of the preparation of the module, e.g. the optimization
+     * level
+     * @return the binary of the module prepared from the code with \arg
+     * code_hash, if there is one
+     */
+    boost::optional<common::Buffer> load(const common::Hash256 &code_hash,
+                                         const std::string &kind) const;
+
+    /**
+     * Keeps \arg module prepared from the code with \arg code_hash; a failure
+     * to write it is logged only
+     */
+    void store(const common::Hash256 &code_hash,
+               const std::string &kind,
+               wasm::Module &module) const;
+
+    /**
+     * Forgets the module prepared from the code with \arg code_hash, e.g. a
+     * damaged one
+     */
+    void remove(const common::Hash256 &code_hash,
+                const std::string &kind) const;
+
+   private:
+    boost::filesystem::path modulePath(const common::Hash256 &code_hash,
+                                       const std::string &kind) const;
+    void removeOtherVersions(const boost::filesystem::path &cache_dir) const;
+
+    boost::filesystem::path dir_;
+    log::Logger logger_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_CACHE
@@ -44,7 +44,12 @@ namespace kagome::runtime::binaryen {
       const common::Buffer &code,
       const std::shared_ptr<RuntimeExternalInterface> &rei,
       const std::shared_ptr<TrieStorageProvider> &storage_provider) {
-    auto log = log::createLogger("wasm_module", "wasm");
+    OUTCOME_TRY(module, parseCode(code));
+    return createFromModule(std::move(module), storage_provider);
+  }
+
+  outcome::result<std::unique_ptr<wasm::Module>> WasmModuleImpl::parseCode(
+      const common::Buffer &code) {
     // that nolint suppresses false positive in a library function
     // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
     if (code.empty()) {
@@ -64,11 +69,18 @@ namespace kagome::runtime::binaryen {
       } catch (wasm::ParseException &e) {
         std::ostringstream msg;
         e.dump(msg);
-        log->error(msg.str());
+        log::createLogger("wasm_module", "wasm")->error(msg.str());
         return Error::INVALID_STATE_CODE;
       }
     }
+    return std::move(module);
+  }
 
+  outcome::result<std::unique_ptr<WasmModuleImpl>>
+  WasmModuleImpl::createFromModule(
+      std::unique_ptr<wasm::Module> module,
+      const std::shared_ptr<TrieStorageProvider> &storage_provider) {
+    auto log = log::createLogger("wasm_module", "wasm");
     module->memory.initial = kDefaultHeappages;
     OUTCOME_TRY(heappages_key, common::Buffer::fromString(":heappages"));
     auto heappages_res =
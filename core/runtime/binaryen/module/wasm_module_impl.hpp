@@ -38,6 +38,20 @@ namespace kagome::runtime::binaryen {
         const std::shared_ptr<RuntimeExternalInterface> &rei,
         const std::shared_ptr<TrieStorageProvider> &storage_provider);
 
+    /**
+     * Parses the binary \arg code of a module
+     */
+    static outcome::result<std::unique_ptr<wasm::Module>> parseCode(
+        const common::Buffer &code);
+
+    /**
+     * Creates the module from the parsed \arg module, its memory size is
+     * read from the state of \arg storage_provider
+     */
+    static outcome::result<std::unique_ptr<WasmModuleImpl>> createFromModule(
+        std::unique_ptr<wasm::Module> module,
+        const std::shared_ptr<TrieStorageProvider> &storage_provider);
+
     std::unique_ptr<WasmModuleInstance> instantiate(
         const std::shared_ptr<RuntimeExternalInterface> &externalInterface)
         const override;
@@ -37,6 +37,12 @@ namespace kagome::runtime::binaryen {
      * Resets Host API state, preparing it for the next runtime call
      */
     virtual void reset() = 0;
+
+    /**
+     * Restores the globals to their values right after instantiation, so
+     * that the instance could serve another runtime call
+     */
+    virtual void restoreGlobals() = 0;
   };
 }  // namespace kagome::runtime::binaryen
 
@@ -12,18 +12,26 @@
 
 namespace kagome::runtime::binaryen {
 
+  struct WasmModuleInstanceImpl::Globals {
+    decltype(wasm::ModuleInstance::globals) values;
+  };
+
   WasmModuleInstanceImpl::WasmModuleInstanceImpl(
       std::shared_ptr<wasm::Module> parent,
       const std::shared_ptr<RuntimeExternalInterface> &rei)
       : parent_{std::move(parent)},
         rei_{rei},
         module_instance_{
-            std::make_unique<wasm::ModuleInstance>(*parent_, rei.get())} {
+            std::make_unique<wasm::ModuleInstance>(*parent_, rei.get())},
+        initial_globals_{
+            std::make_unique<Globals>(Globals{module_instance_->globals})} {
     BOOST_ASSERT(parent_);
     BOOST_ASSERT(rei_);
     BOOST_ASSERT(module_instance_);
   }
 
+  WasmModuleInstanceImpl::~WasmModuleInstanceImpl() = default;
+
   wasm::Literal WasmModuleInstanceImpl::callExportFunction(
       wasm::Name name, const wasm::LiteralList &arguments) {
     return module_instance_->callExport(name, arguments);
@@ -37,4 +45,8 @@ namespace kagome::runtime::binaryen {
     rei_->reset();
   }
 
+  void WasmModuleInstanceImpl::restoreGlobals() {
+    module_instance_->globals = initial_globals_->values;
+  }
+
 }  // namespace kagome::runtime::binaryen
@@ -23,6 +23,7 @@ namespace kagome::runtime::binaryen {
     WasmModuleInstanceImpl(
         std::shared_ptr<wasm::Module> parent,
         const std::shared_ptr<RuntimeExternalInterface> &rei);
+    ~WasmModuleInstanceImpl() override;
 
     wasm::Literal callExportFunction(
         wasm::Name name, const std::vector<wasm::Literal> &arguments) override;
@@ -31,12 +32,17 @@ namespace kagome::runtime::binaryen {
 
     void reset() override;
 
+    void restoreGlobals() override;
+
    private:
+    struct Globals;
+
     std::shared_ptr<wasm::Module>
         parent_;  // must be kept alive because binaryen's module instance keeps
                   // a reference to it
     std::shared_ptr<RuntimeExternalInterface> rei_;
     std::unique_ptr<wasm::ModuleInstance> module_instance_;
+    std::unique_ptr<Globals> initial_globals_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
+
+#include <boost/optional.hpp>
+
+#include "runtime/binaryen/module/wasm_module.hpp"
+#include "runtime/binaryen/runtime_environment.hpp"
+#include "runtime/binaryen/runtime_external_interface.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  WasmModuleInstancePool::WasmModuleInstancePool(size_t capacity)
+      : capacity_{capacity} {}
+
+  WasmModuleInstancePool::~WasmModuleInstancePool() = default;
+
+  outcome::result<RuntimeEnvironment> WasmModuleInstancePool::acquire(
+      const common::Hash256 &code_hash,
+      const WasmModule &module,
+      const InterfaceMaker &make_interface) {
+    boost::optional<Instance> idle;
+    {
+      std::lock_guard lock{mutex_};
+      auto &code_idle = idle_[code_hash];
+      code_idle.last_acquired = ++acquisitions_;
+      if (not code_idle.instances.empty()) {
+        idle = std::move(code_idle.instances.back());
+        code_idle.instances.pop_back();
+        --idle_count_;
+      }
+    }
+
+    const bool is_new = not idle.has_value();
+    if (is_new) {
+      auto rei = make_interface();
+      auto module_instance = module.instantiate(rei);
+      idle = Instance{std::move(rei), std::move(module_instance)};
+    }
+
+    auto rei = idle->rei;
+    std::shared_ptr<WasmModuleInstance> module_instance(
+        idle->module_instance.release(),
+        [weak_self = weak_from_this(), code_hash, rei](
+            WasmModuleInstance *released) {
+          Instance instance{rei,
+                            std::unique_ptr<WasmModuleInstance>(released)};
+          if (auto self = weak_self.lock()) {
+            self->release(code_hash, std::move(instance));
+          }
+        });
+
+    OUTCOME_TRY(env,
+                RuntimeEnvironment::create(rei, std::move(module_instance)));
+    if (is_new) {
+      // the heap base is known and the memory is not touched by a call yet
+      rei->snapshotMemory();
+    }
+    return std::move(env);
+  }
+
+  void WasmModuleInstancePool::release(const common::Hash256 &code_hash,
+                                       Instance instance) {
+    instance.module_instance->restoreGlobals();
+    instance.rei->restoreMemory();
+
+    std::lock_guard lock{mutex_};
+    auto &code_idle = idle_[code_hash];
+    if (idle_count_ >= capacity_) {
+      // an instance of the code used least recently is dropped to make room,
+      // unless it is the code of the released instance
+      auto oldest = idle_.end();
+      for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+        if (not it->second.instances.empty()
+            and (oldest == idle_.end()
+                 or it->second.last_acquired
+                        < oldest->second.last_acquired)) {
+          oldest = it;
+        }
+      }
+      if (oldest == idle_.end()
+          or oldest->second.last_acquired >= code_idle.last_acquired) {
+        return;
+      }
+      oldest->second.instances.pop_back();
+      --idle_count_;
+      if (oldest->second.instances.empty()) {
+        idle_.erase(oldest);
+      }
+    }
+    code_idle.instances.emplace_back(std::move(instance));
+    ++idle_count_;
+  }
+
+}  // namespace kagome::runtime::binaryen
@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_INSTANCE_POOL
+#define KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_INSTANCE_POOL
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/blob.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  class RuntimeEnvironment;
+  class RuntimeExternalInterface;
+  class WasmModule;
+  class WasmModuleInstance;
+
+  /**
+   * Keeps instantiated wasm modules ready for runtime calls, so that a call
+   * does not instantiate its module and initialize the memory of it again.
+   * Each instance has its own external interface and memory. Once a call
+   * releases the instance, its globals and the memory below the heap base
+   * are restored, and it returns to the pool.
+   * The number of idle instances is bounded in total rather than per runtime
+   * code: when the pool is full, the instances of the code acquired least
+   * recently are dropped first, so the ones of a replaced code go away after
+   * a runtime upgrade
+   */
+  class WasmModuleInstancePool
+      : public std::enable_shared_from_this<WasmModuleInstancePool> {
+   public:
+    using InterfaceMaker =
+        std::function<std::shared_ptr<RuntimeExternalInterface>()>;
+
+    /**
+     * @param capacity max number of idle instances kept
+     */
+    explicit WasmModuleInstancePool(size_t capacity);
+    ~WasmModuleInstancePool();
+
+    /**
+     * @param code_hash hash of the code of \arg module
+     * @param make_interface makes the external interface of a new instance,
+     * when there is no idle one
+     * @return environment with an instance of \arg module, which is taken
+     * from the pool until the environment is destroyed
+     */
+    outcome::result<RuntimeEnvironment> acquire(
+        const common::Hash256 &code_hash,
+        const WasmModule &module,
+        const InterfaceMaker &make_interface);
+
+   private:
+    struct Instance {
+      std::shared_ptr<RuntimeExternalInterface> rei;
+      std::unique_ptr<WasmModuleInstance> module_instance;
+    };
+
+    struct IdleInstances {
+      std::vector<Instance> instances;
+      // number of the acquisition the code was used last by
+      uint64_t last_acquired = 0;
+    };
+
+    void release(const common::Hash256 &code_hash, Instance instance);
+
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::map<common::Hash256, IdleInstances> idle_;
+    // total number of the instances in idle_
+    size_t idle_count_ = 0;
+    uint64_t acquisitions_ = 0;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_MODULE_WASM_MODULE_INSTANCE_POOL
@@ -8,12 +8,17 @@
 namespace kagome::runtime::binaryen {
 
   BabeApiImpl::BabeApiImpl(
-      const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory)
-      : RuntimeApi(runtime_env_factory) {}
+      const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
+      std::shared_ptr<RuntimeCallCache> call_cache)
+      : RuntimeApi(runtime_env_factory), call_cache_{std::move(call_cache)} {}
 
   outcome::result<primitives::BabeConfiguration> BabeApiImpl::configuration() {
-    return execute<primitives::BabeConfiguration>(
+    auto state_root = latestStateRoot();
+    return executeCached<primitives::BabeConfiguration>(
+        call_cache_.get(),
+        state_root,
         "BabeApi_configuration",
+        state_root,
         CallConfig{.persistency = CallPersistency::EPHEMERAL});
   }
 
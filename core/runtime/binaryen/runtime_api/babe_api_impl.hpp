@@ -16,9 +16,13 @@ namespace kagome::runtime::binaryen {
     ~BabeApiImpl() override = default;
 
     explicit BabeApiImpl(
-        const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory);
+        const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
+        std::shared_ptr<RuntimeCallCache> call_cache = nullptr);
 
     outcome::result<primitives::BabeConfiguration> configuration() override;
+
+   private:
+    std::shared_ptr<RuntimeCallCache> call_cache_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -29,7 +29,8 @@ namespace kagome::runtime::binaryen {
   outcome::result<BlockHeader> BlockBuilderImpl::finalise_block() {
     return execute<BlockHeader>(
         "BlockBuilder_finalize_block",
-        CallConfig{.persistency = CallPersistency::PERSISTENT});
+        CallConfig{.persistency = CallPersistency::PERSISTENT,
+                   .commit_state = true});
   }
 
   outcome::result<std::vector<Extrinsic>> BlockBuilderImpl::inherent_extrinsics(
@@ -18,11 +18,13 @@ namespace kagome::runtime::binaryen {
       const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
       std::shared_ptr<WasmProvider> wasm_provider,
       std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker,
-      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo)
+      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+      std::shared_ptr<RuntimeCallCache> call_cache)
       : RuntimeApi(runtime_env_factory),
         wasm_provider_{std::move(wasm_provider)},
         changes_tracker_{std::move(changes_tracker)},
-        header_repo_{std::move(header_repo)} {
+        header_repo_{std::move(header_repo)},
+        call_cache_{std::move(call_cache)} {
     BOOST_ASSERT(wasm_provider_ != nullptr);
     BOOST_ASSERT(changes_tracker_ != nullptr);
     BOOST_ASSERT(header_repo_ != nullptr);
@@ -30,17 +32,19 @@ namespace kagome::runtime::binaryen {
 
   outcome::result<Version> CoreImpl::version(
       const boost::optional<primitives::BlockHash> &block_hash) {
+    storage::trie::RootHash state_root;
     if (block_hash) {
       OUTCOME_TRY(header, header_repo_->getBlockHeader(block_hash.value()));
-      return executeAt<Version>(
-          "Core_version",
-          header.state_root,
-          CallConfig{.persistency = CallPersistency::ISOLATED,
-                     .runtime_env_config = RuntimeEnvironmentFactory::Config{
-                         .wasm_provider = wasm_provider_}});
+      state_root = header.state_root;
+    } else {
+      state_root = latestStateRoot();
     }
-    return execute<Version>(
+    // the version depends on the runtime code only
+    return executeCached<Version>(
+        call_cache_.get(),
+        wasm_provider_->getStateCodeHashAt(state_root),
         "Core_version",
+        state_root,
         CallConfig{.persistency = CallPersistency::ISOLATED,
                    .runtime_env_config = RuntimeEnvironmentFactory::Config{
                        .wasm_provider = wasm_provider_}});
@@ -55,7 +59,8 @@ namespace kagome::runtime::binaryen {
     return executeAt<void>(
         "Core_execute_block",
         parent.state_root,
-        CallConfig{.persistency = CallPersistency::PERSISTENT},
+        CallConfig{.persistency = CallPersistency::PERSISTENT,
+                   .commit_state = true},
         block);
   }
 
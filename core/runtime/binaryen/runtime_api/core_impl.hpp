@@ -20,7 +20,8 @@ namespace kagome::runtime::binaryen {
         const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
         std::shared_ptr<WasmProvider> wasm_provider,
         std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker,
-        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo);
+        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+        std::shared_ptr<RuntimeCallCache> call_cache = nullptr);
 
     ~CoreImpl() override = default;
 
@@ -40,6 +41,7 @@ namespace kagome::runtime::binaryen {
     std::shared_ptr<WasmProvider> wasm_provider_;
     std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker_;
     std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    std::shared_ptr<RuntimeCallCache> call_cache_;
   };
 }  // namespace kagome::runtime::binaryen
 
@@ -17,8 +17,11 @@ namespace kagome::runtime::binaryen {
 
   GrandpaApiImpl::GrandpaApiImpl(
       const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
-      const std::shared_ptr<blockchain::BlockHeaderRepository> &header_repo)
-      : RuntimeApi(runtime_env_factory), header_repo_{header_repo} {
+      const std::shared_ptr<blockchain::BlockHeaderRepository> &header_repo,
+      std::shared_ptr<RuntimeCallCache> call_cache)
+      : RuntimeApi(runtime_env_factory),
+        header_repo_{header_repo},
+        call_cache_{std::move(call_cache)} {
     BOOST_ASSERT(header_repo_ != nullptr);
   }
 
@@ -41,7 +44,9 @@ namespace kagome::runtime::binaryen {
   outcome::result<primitives::AuthorityList> GrandpaApiImpl::authorities(
       const primitives::BlockId &block_id) {
     OUTCOME_TRY(header, header_repo_->getBlockHeader(block_id));
-    return executeAt<primitives::AuthorityList>(
+    return executeCached<primitives::AuthorityList>(
+        call_cache_.get(),
+        header.state_root,
         "GrandpaApi_grandpa_authorities",
         header.state_root,
         CallConfig{.persistency = CallPersistency::EPHEMERAL});
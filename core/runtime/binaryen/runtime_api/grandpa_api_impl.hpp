@@ -17,7 +17,8 @@ namespace kagome::runtime::binaryen {
    public:
     explicit GrandpaApiImpl(
         const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
-        const std::shared_ptr<blockchain::BlockHeaderRepository> &header_repo);
+        const std::shared_ptr<blockchain::BlockHeaderRepository> &header_repo,
+        std::shared_ptr<RuntimeCallCache> call_cache = nullptr);
 
     ~GrandpaApiImpl() override = default;
 
@@ -32,6 +33,7 @@ namespace kagome::runtime::binaryen {
 
    private:
     std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    std::shared_ptr<RuntimeCallCache> call_cache_;
   };
 }  // namespace kagome::runtime::binaryen
 
@@ -10,22 +10,32 @@ namespace kagome::runtime::binaryen {
 
   MetadataImpl::MetadataImpl(
       const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
-      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo)
-      : RuntimeApi(runtime_env_factory), header_repo_(std::move(header_repo)) {
+      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+      std::shared_ptr<WasmProvider> wasm_provider,
+      std::shared_ptr<RuntimeCallCache> call_cache)
+      : RuntimeApi(runtime_env_factory),
+        header_repo_(std::move(header_repo)),
+        wasm_provider_(std::move(wasm_provider)),
+        call_cache_(std::move(call_cache)) {
     BOOST_ASSERT(header_repo_ != nullptr);
+    BOOST_ASSERT(wasm_provider_ != nullptr);
   }
 
   outcome::result<OpaqueMetadata> MetadataImpl::metadata(
       const boost::optional<primitives::BlockHash> &block_hash) {
+    storage::trie::RootHash state_root;
     if (block_hash) {
       OUTCOME_TRY(header, header_repo_->getBlockHeader(block_hash.value()));
-      return executeAt<OpaqueMetadata>(
-          "Metadata_metadata",
-          header.state_root,
-          CallConfig{.persistency = CallPersistency::EPHEMERAL});
+      state_root = header.state_root;
+    } else {
+      state_root = latestStateRoot();
     }
-    return execute<OpaqueMetadata>(
+    // the metadata depends on the runtime code only
+    return executeCached<OpaqueMetadata>(
+        call_cache_.get(),
+        wasm_provider_->getStateCodeHashAt(state_root),
         "Metadata_metadata",
+        state_root,
         CallConfig{.persistency = CallPersistency::EPHEMERAL});
   }
 }  // namespace kagome::runtime::binaryen
@@ -8,6 +8,7 @@
 
 #include "runtime/binaryen/runtime_api/runtime_api.hpp"
 #include "runtime/metadata.hpp"
+#include "runtime/wasm_provider.hpp"
 
 #include "blockchain/block_header_repository.hpp"
 
@@ -17,7 +18,9 @@ namespace kagome::runtime::binaryen {
    public:
     explicit MetadataImpl(
         const std::shared_ptr<RuntimeEnvironmentFactory> &runtime_env_factory,
-        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo);
+        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+        std::shared_ptr<WasmProvider> wasm_provider,
+        std::shared_ptr<RuntimeCallCache> call_cache = nullptr);
 
     ~MetadataImpl() override = default;
 
@@ -26,6 +29,8 @@ namespace kagome::runtime::binaryen {
 
    private:
     std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    std::shared_ptr<WasmProvider> wasm_provider_;
+    std::shared_ptr<RuntimeCallCache> call_cache_;
   };
 }  // namespace kagome::runtime::binaryen
 
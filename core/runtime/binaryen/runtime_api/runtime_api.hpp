@@ -15,6 +15,7 @@
 #include "common/buffer.hpp"
 #include "host_api/host_api_factory.hpp"
 #include "log/logger.hpp"
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
 #include "runtime/binaryen/runtime_environment.hpp"
 #include "runtime/binaryen/runtime_environment_factory_impl.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
@@ -49,6 +50,10 @@ namespace kagome::runtime::binaryen {
     struct CallConfig {
       CallPersistency persistency;
       RuntimeEnvironmentFactory::Config runtime_env_config{};
+      // whether the state changes are written to the storage once a
+      // persistent call succeeds; set for the calls which complete a block,
+      // before that the changes are kept in memory
+      bool commit_state = false;
     };
 
    private:
@@ -125,6 +130,53 @@ namespace kagome::runtime::binaryen {
           name, boost::none, std::move(config), std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief executes wasm export method like execute() or executeAt(),
+     * unless the result of the same call is kept in \arg cache
+     * @param cache keeps the encoded results of the calls, none is kept if it
+     * is null
+     * @param scope hash of the runtime code or the state root, the only ones
+     * the result of the method depends on besides \arg args
+     * @param state_root the state to execute the method at, the current state
+     * if none
+     */
+    template <typename R, typename... Args>
+    outcome::result<R> executeCached(
+        RuntimeCallCache *cache,
+        const common::Hash256 &scope,
+        std::string_view name,
+        boost::optional<storage::trie::RootHash> state_root,
+        CallConfig config,
+        Args &&... args) {
+      if (cache == nullptr) {
+        return executeInternal<R>(name,
+                                  std::move(state_root),
+                                  std::move(config),
+                                  std::forward<Args>(args)...);
+      }
+      OUTCOME_TRY(encoded_args, scale::encode(args...));
+      auto key =
+          RuntimeCallCache::makeKey(scope, name, common::Buffer{encoded_args});
+      if (auto cached = cache->get(key); cached != nullptr) {
+        return scale::decode<R>(*cached);
+      }
+      OUTCOME_TRY(result,
+                  executeInternal<R>(name,
+                                     std::move(state_root),
+                                     std::move(config),
+                                     std::forward<Args>(args)...));
+      OUTCOME_TRY(encoded_result, scale::encode(result));
+      cache->put(key, common::Buffer{std::move(encoded_result)});
+      return std::move(result);
+    }
+
+    /**
+     * @returns the state root execute() calls methods at
+     */
+    storage::trie::RootHash latestStateRoot() const {
+      return runtime_env_factory_->latestStateRoot();
+    }
+
    private:
     /**
      * If \arg state_root contains a value, then the state will be reset to the
@@ -143,7 +195,7 @@ namespace kagome::runtime::binaryen {
         SL_DEBUG(logger_, "Resetting state to: {}", state_root.value().toHex());
       }
 
-      auto &&[module_instance, memory, opt_batch] =
+      auto &&[module_instance, memory, opt_batch, persistent_batch] =
           createRuntimeEnvironment(config, state_root);
 
       gsl::final_action dispose(
@@ -171,12 +223,28 @@ namespace kagome::runtime::binaryen {
       if constexpr (!std::is_same_v<void, R>) {
         WasmResult r(res.geti64());
         auto buffer = memory->loadN(r.address, r.length);
+        OUTCOME_TRY(commitState(config, persistent_batch));
         return scale::decode<R>(std::move(buffer));
       }
 
       if (opt_batch) {
         OUTCOME_TRY(opt_batch.value()->writeBack());
       }
+      OUTCOME_TRY(commitState(config, persistent_batch));
+      return outcome::success();
+    }
+
+    /**
+     * Writes the changes of a call to the storage if \arg config requires so.
+     * The runtime only calculates the storage root while a block is executed
+     * or built, so all the nodes changed in the block are written once
+     */
+    static outcome::result<void> commitState(
+        const CallConfig &config,
+        const std::shared_ptr<storage::trie::PersistentTrieBatch> &batch) {
+      if (config.commit_state and batch != nullptr) {
+        OUTCOME_TRY(batch->commit());
+      }
       return outcome::success();
     }
 
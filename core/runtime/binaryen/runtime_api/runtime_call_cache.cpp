@@ -0,0 +1,58 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  RuntimeCallCache::RuntimeCallCache(size_t max_entries, size_t max_size)
+      : cache_{max_entries, max_size} {}
+
+  common::Buffer RuntimeCallCache::makeKey(const common::Hash256 &scope,
+                                           std::string_view name,
+                                           const common::Buffer &encoded_args) {
+    common::Buffer key;
+    key.reserve(scope.size() + name.size() + 1 + encoded_args.size());
+    key.put(scope);
+    key.put(name);
+    // method names contain no zero bytes, so the separator tells where the
+    // arguments start
+    key.putUint8(0);
+    key.putBuffer(encoded_args);
+    return key;
+  }
+
+  std::shared_ptr<const common::Buffer> RuntimeCallCache::get(
+      const common::Buffer &key) {
+    return cache_.get(key);
+  }
+
+  void RuntimeCallCache::put(const common::Buffer &key,
+                             common::Buffer encoded_result) {
+    auto size = encoded_result.size();
+    // the same key always denotes the same result
+    cache_.put(
+        key,
+        std::make_shared<const common::Buffer>(std::move(encoded_result)),
+        size);
+  }
+
+  size_t RuntimeCallCache::entries() const {
+    return cache_.entries();
+  }
+
+  size_t RuntimeCallCache::size() const {
+    return cache_.size();
+  }
+
+  uint64_t RuntimeCallCache::hits() const {
+    return cache_.hits();
+  }
+
+  uint64_t RuntimeCallCache::misses() const {
+    return cache_.misses();
+  }
+
+}  // namespace kagome::runtime::binaryen
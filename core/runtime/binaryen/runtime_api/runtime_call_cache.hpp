@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_CALL_CACHE
+#define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_CALL_CACHE
+
+#include <memory>
+#include <string_view>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "common/lru_cache.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Bounded LRU cache of the SCALE encoded results of runtime calls, which
+   * depend on nothing but their arguments and either the runtime code or the
+   * state. A result is keyed by the name of the called method, its encoded
+   * arguments and the hash of the code or the state root, so an entry never
+   * becomes stale.
+   * Thread-safe.
+   */
+  class RuntimeCallCache {
+   public:
+    static constexpr size_t kDefaultMaxEntries = 1024;
+    static constexpr size_t kDefaultMaxSize = 32 * 1024 * 1024;
+
+    /**
+     * @param max_entries max number of the kept results
+     * @param max_size max total size of the kept results in bytes; a result
+     * larger than that is not kept at all
+     */
+    explicit RuntimeCallCache(size_t max_entries = kDefaultMaxEntries,
+                              size_t max_size = kDefaultMaxSize);
+
+    /**
+     * @param scope hash of the runtime code or the state root the result of
+     * the call depends on
+     * @returns key of the call of method \arg name with \arg encoded_args
+     */
+    static common::Buffer makeKey(const common::Hash256 &scope,
+                                  std::string_view name,
+                                  const common::Buffer &encoded_args);
+
+    /**
+     * @returns the encoded result of the call under \arg key, or nullptr if
+     * there is no such call in the cache
+     */
+    std::shared_ptr<const common::Buffer> get(const common::Buffer &key);
+
+    /**
+     * Puts the \arg encoded_result of the call under \arg key to the cache,
+     * evicting the least recently used results to stay within the bounds
+     */
+    void put(const common::Buffer &key, common::Buffer encoded_result);
+
+    size_t entries() const;
+    size_t size() const;
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+   private:
+    common::LruCache<common::Buffer, common::Buffer> cache_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_CALL_CACHE
@@ -17,6 +17,7 @@ namespace kagome::common {
 }
 
 namespace kagome::storage::trie {
+  class PersistentTrieBatch;
   class TopperTrieBatch;
   class TrieBatch;
 }  // namespace kagome::storage::trie
@@ -40,6 +41,14 @@ namespace kagome::runtime::binaryen {
         const std::shared_ptr<RuntimeExternalInterface> &rei,
         const std::shared_ptr<WasmModule> &module);
 
+    /**
+     * Makes an environment of an existing \arg module_instance, which uses
+     * the memory of \arg rei
+     */
+    static outcome::result<RuntimeEnvironment> create(
+        const std::shared_ptr<RuntimeExternalInterface> &rei,
+        std::shared_ptr<WasmModuleInstance> module_instance);
+
     RuntimeEnvironment(RuntimeEnvironment &&) = default;
     RuntimeEnvironment &operator=(RuntimeEnvironment &&) = default;
 
@@ -53,6 +62,9 @@ namespace kagome::runtime::binaryen {
     boost::optional<std::shared_ptr<storage::trie::TopperTrieBatch>>
         batch{};  // in persistent environments all changes of a call must be
                   // either applied together or discarded in case of failure
+    std::shared_ptr<storage::trie::PersistentTrieBatch>
+        persistent_batch{};  // the batch the changes are applied to, set in
+                             // persistent environments only
   };
 
 }  // namespace kagome::runtime::binaryen
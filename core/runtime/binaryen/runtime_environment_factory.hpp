@@ -53,6 +53,12 @@ namespace kagome::runtime::binaryen {
 
     virtual outcome::result<RuntimeEnvironment> makeEphemeralAt(
         const storage::trie::RootHash &state_root) = 0;
+
+    /**
+     * @returns the state root the environments made without an explicit
+     * state root are at
+     */
+    virtual storage::trie::RootHash latestStateRoot() const = 0;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -5,6 +5,8 @@
 
 #include "runtime/binaryen/runtime_environment_factory_impl.hpp"
 
+#include <chrono>
+
 #include <gsl/gsl>
 
 #include "crypto/hasher/hasher_impl.hpp"
@@ -35,14 +37,16 @@ namespace kagome::runtime::binaryen {
       std::shared_ptr<WasmModuleFactory> module_factory,
       std::shared_ptr<WasmProvider> wasm_provider,
       std::shared_ptr<TrieStorageProvider> storage_provider,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<WasmModuleInstancePool> instance_pool)
       : core_factory_{std::move(core_factory)},
         memory_factory_{std::move(memory_factory)},
         storage_provider_{std::move(storage_provider)},
         wasm_provider_{std::move(wasm_provider)},
         host_api_factory_{std::move(host_api_factory)},
         module_factory_{std::move(module_factory)},
-        hasher_{std::move(hasher)} {
+        hasher_{std::move(hasher)},
+        instance_pool_{std::move(instance_pool)} {
     BOOST_ASSERT(core_factory_);
     BOOST_ASSERT(memory_factory_);
     BOOST_ASSERT(wasm_provider_);
@@ -75,10 +79,10 @@ namespace kagome::runtime::binaryen {
     auto persistent_batch = storage_provider_->tryGetPersistentBatch();
     if (!persistent_batch) return Error::NO_PERSISTENT_BATCH;
 
-    auto env = createRuntimeEnvironment(
-        wasm_provider_->getStateCodeAt(state_root));
+    auto env = createRuntimeEnvironment(state_root);
     if (env.has_value()) {
       env.value().batch = (*persistent_batch)->batchOnTop();
+      env.value().persistent_batch = *persistent_batch;
     }
 
     return env;
@@ -88,7 +92,7 @@ namespace kagome::runtime::binaryen {
   RuntimeEnvironmentFactoryImpl::makeEphemeralAt(
       const storage::trie::RootHash &state_root) {
     OUTCOME_TRY(storage_provider_->setToEphemeralAt(state_root));
-    return createRuntimeEnvironment(wasm_provider_->getStateCodeAt(state_root));
+    return createRuntimeEnvironment(state_root);
   }
 
   outcome::result<RuntimeEnvironment>
@@ -98,10 +102,10 @@ namespace kagome::runtime::binaryen {
     auto persistent_batch = storage_provider_->tryGetPersistentBatch();
     if (!persistent_batch) return Error::NO_PERSISTENT_BATCH;
 
-    auto env = createRuntimeEnvironment(
-        wasm_provider_->getStateCodeAt(storage_provider_->getLatestRoot()));
+    auto env = createRuntimeEnvironment(storage_provider_->getLatestRoot());
     if (env.has_value()) {
       env.value().batch = (*persistent_batch)->batchOnTop();
+      env.value().persistent_batch = *persistent_batch;
     }
 
     return env;
@@ -110,18 +114,29 @@ namespace kagome::runtime::binaryen {
   outcome::result<RuntimeEnvironment>
   RuntimeEnvironmentFactoryImpl::makeEphemeral() {
     OUTCOME_TRY(storage_provider_->setToEphemeral());
-    return createRuntimeEnvironment(
-        wasm_provider_->getStateCodeAt(storage_provider_->getLatestRoot()));
+    return createRuntimeEnvironment(storage_provider_->getLatestRoot());
+  }
+
+  storage::trie::RootHash RuntimeEnvironmentFactoryImpl::latestStateRoot()
+      const {
+    return storage_provider_->getLatestRoot();
+  }
+
+  std::shared_ptr<RuntimeExternalInterface>
+  RuntimeEnvironmentFactoryImpl::makeExternalInterface() {
+    return std::make_shared<RuntimeExternalInterface>(core_factory_,
+                                                      shared_from_this(),
+                                                      memory_factory_,
+                                                      host_api_factory_,
+                                                      storage_provider_);
   }
 
   outcome::result<RuntimeEnvironment>
   RuntimeEnvironmentFactoryImpl::createRuntimeEnvironment(
-      const common::Buffer &state_code) {
-    if (state_code.empty()) {
-      return Error::EMPTY_STATE_CODE;
-    }
-
-    auto hash = hasher_->twox_256(state_code);
+      const storage::trie::RootHash &state_root) {
+    // the provider hashes the code once per runtime upgrade, so the code
+    // itself is needed only to prepare a new module
+    auto hash = wasm_provider_->getStateCodeHashAt(state_root);
 
     std::shared_ptr<WasmModule> module;
 
@@ -135,19 +150,26 @@ namespace kagome::runtime::binaryen {
     }
 
     if (external_interface_ == nullptr) {
-      external_interface_ =
-          std::make_shared<RuntimeExternalInterface>(core_factory_,
-                                                     shared_from_this(),
-                                                     memory_factory_,
-                                                     host_api_factory_,
-                                                     storage_provider_);
+      external_interface_ = makeExternalInterface();
     }
 
     if (!module) {
+      const auto &state_code = wasm_provider_->getStateCodeAt(state_root);
+      if (state_code.empty()) {
+        return Error::EMPTY_STATE_CODE;
+      }
+
       // Prepare new module
+      auto start = std::chrono::steady_clock::now();
       OUTCOME_TRY(new_module,
                   module_factory_->createModule(
                       state_code, external_interface_, storage_provider_));
+      logger_->info(
+          "Runtime module {} is prepared in {} ms",
+          hash.toHex(),
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count());
 
       // Trying to safe emplace new module, and use existed one
       //  if it already emplaced in another thread
@@ -155,6 +177,10 @@ namespace kagome::runtime::binaryen {
       module = modules_.emplace(hash, std::move(new_module)).first->second;
     }
 
+    if (instance_pool_) {
+      return instance_pool_->acquire(
+          hash, *module, [this] { return makeExternalInterface(); });
+    }
     return RuntimeEnvironment::create(external_interface_, module);
   }
 
@@ -162,12 +188,7 @@ namespace kagome::runtime::binaryen {
   RuntimeEnvironmentFactoryImpl::createIsolatedRuntimeEnvironment(
       const common::Buffer &state_code) {
     // TODO(Harrm): for review; doubt, maybe need a separate storage provider
-    auto external_interface =
-        std::make_shared<RuntimeExternalInterface>(core_factory_,
-                                                   shared_from_this(),
-                                                   memory_factory_,
-                                                   host_api_factory_,
-                                                   storage_provider_);
+    auto external_interface = makeExternalInterface();
 
     OUTCOME_TRY(module,
                 module_factory_->createModule(
@@ -14,6 +14,7 @@
 #include "log/logger.hpp"
 #include "outcome/outcome.hpp"
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
 #include "runtime/binaryen/runtime_environment.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
 #include "runtime/trie_storage_provider.hpp"
@@ -43,7 +44,8 @@ namespace kagome::runtime::binaryen {
         std::shared_ptr<WasmModuleFactory> module_factory,
         std::shared_ptr<WasmProvider> wasm_provider,
         std::shared_ptr<TrieStorageProvider> storage_provider,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<WasmModuleInstancePool> instance_pool = nullptr);
 
     outcome::result<RuntimeEnvironment> makeIsolated(
         const Config &config) override;
@@ -66,9 +68,13 @@ namespace kagome::runtime::binaryen {
     outcome::result<RuntimeEnvironment> makeEphemeralAt(
         const storage::trie::RootHash &state_root) override;
 
+    storage::trie::RootHash latestStateRoot() const override;
+
    private:
+    std::shared_ptr<RuntimeExternalInterface> makeExternalInterface();
+
     outcome::result<RuntimeEnvironment> createRuntimeEnvironment(
-        const common::Buffer &state_code);
+        const storage::trie::RootHash &state_root);
 
     outcome::result<RuntimeEnvironment> createIsolatedRuntimeEnvironment(
         const common::Buffer &state_code);
@@ -83,6 +89,7 @@ namespace kagome::runtime::binaryen {
     std::shared_ptr<host_api::HostApiFactory> host_api_factory_;
     std::shared_ptr<WasmModuleFactory> module_factory_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<WasmModuleInstancePool> instance_pool_;
 
     std::mutex modules_mutex_;
     std::map<common::Hash256, std::shared_ptr<WasmModule>> modules_;
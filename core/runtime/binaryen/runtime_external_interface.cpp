@@ -171,11 +171,38 @@ namespace kagome::runtime::binaryen {
                      "host api factory is nullptr");
     BOOST_ASSERT_MSG(storage_provider != nullptr,
                      "storage provider is nullptr");
-    host_api_ = host_api_factory->make(
-        core_factory,
-        runtime_env_factory,
-        wasm_memory_factory->make(&(ShellExternalInterface::memory)),
-        std::move(storage_provider));
+    auto memory = wasm_memory_factory->make(&(ShellExternalInterface::memory));
+    memory_impl_ = memory.get();
+    host_api_ = host_api_factory->make(core_factory,
+                                       runtime_env_factory,
+                                       std::move(memory),
+                                       std::move(storage_provider));
+  }
+
+  void RuntimeExternalInterface::store8(wasm::Address addr, int8_t value) {
+    memory_impl_->markWritten(addr, sizeof(value));
+    ShellExternalInterface::store8(addr, value);
+  }
+
+  void RuntimeExternalInterface::store16(wasm::Address addr, int16_t value) {
+    memory_impl_->markWritten(addr, sizeof(value));
+    ShellExternalInterface::store16(addr, value);
+  }
+
+  void RuntimeExternalInterface::store32(wasm::Address addr, int32_t value) {
+    memory_impl_->markWritten(addr, sizeof(value));
+    ShellExternalInterface::store32(addr, value);
+  }
+
+  void RuntimeExternalInterface::store64(wasm::Address addr, int64_t value) {
+    memory_impl_->markWritten(addr, sizeof(value));
+    ShellExternalInterface::store64(addr, value);
+  }
+
+  void RuntimeExternalInterface::store128(
+      wasm::Address addr, const std::array<uint8_t, 16> &value) {
+    memory_impl_->markWritten(addr, sizeof(value));
+    ShellExternalInterface::store128(addr, value);
   }
 
   wasm::Literal RuntimeExternalInterface::callImport(
@@ -773,4 +800,12 @@ namespace kagome::runtime::binaryen {
     return host_api_->reset();
   }
 
+  void RuntimeExternalInterface::snapshotMemory() const {
+    memory_impl_->takeSnapshot();
+  }
+
+  void RuntimeExternalInterface::restoreMemory() const {
+    memory_impl_->restoreSnapshot();
+  }
+
 }  // namespace kagome::runtime::binaryen
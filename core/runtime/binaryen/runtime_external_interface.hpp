@@ -50,10 +50,32 @@ namespace kagome::runtime::binaryen {
     wasm::Literal callImport(wasm::Function *import,
                              wasm::LiteralList &arguments) override;
 
+    /**
+     * The stores of wasm code are passed on to the memory to let it know the
+     * written pages
+     */
+    void store8(wasm::Address addr, int8_t value) override;
+    void store16(wasm::Address addr, int16_t value) override;
+    void store32(wasm::Address addr, int32_t value) override;
+    void store64(wasm::Address addr, int64_t value) override;
+    void store128(wasm::Address addr,
+                  const std::array<uint8_t, 16> &value) override;
+
     std::shared_ptr<WasmMemory> memory() const;
 
     void reset() const;
 
+    /**
+     * Saves the memory below the heap base to restore it after a runtime call
+     * with restoreMemory()
+     */
+    void snapshotMemory() const;
+
+    /**
+     * Restores the memory saved with snapshotMemory()
+     */
+    void restoreMemory() const;
+
    private:
     /**
      * Checks that the number of arguments is as expected and terminates the
@@ -64,6 +86,7 @@ namespace kagome::runtime::binaryen {
                         size_t actual);
 
     std::unique_ptr<host_api::HostApi> host_api_;
+    WasmMemoryImpl *memory_impl_;  // owned by host_api_
     log::Logger logger_ = log::createLogger("RuntimeExternalInterface", "wasm");
   };
 
@@ -7,6 +7,31 @@
 
 #include "runtime/wasm_result.hpp"
 
+namespace {
+  // Mark of the end of a free list
+  constexpr kagome::runtime::WasmPointer kEmptyFreeList =
+      std::numeric_limits<kagome::runtime::WasmPointer>::max();
+
+  // Header of an allocated chunk has this bit set and its order in the lower
+  // bits, header of a free chunk has the pointer to the next free chunk there
+  constexpr uint64_t kOccupiedFlag = uint64_t{1} << 32;
+
+  /**
+   * @return order of the minimal power of two chunk, which fits \arg size
+   * bytes; the chunk size is kMinAllocationSize << order
+   */
+  uint32_t orderOf(kagome::runtime::WasmSize size) {
+    using kagome::runtime::binaryen::kMinAllocationSize;
+    if (size <= kMinAllocationSize) {
+      return 0;
+    }
+    // number of bits needed for (size - 1), i.e. log2 of the power of two
+    // which is not less than size
+    auto log2 = 32 - __builtin_clz(size - 1);
+    return log2 - __builtin_ctz(kMinAllocationSize);
+  }
+}  // namespace
+
 namespace kagome::runtime::binaryen {
   WasmMemoryImpl::WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory)
       : memory_(memory),
@@ -19,6 +44,8 @@ namespace kagome::runtime::binaryen {
     // means that wasm memory was exhausted
     BOOST_ASSERT(heap_base_ > 0);
 
+    free_lists_.fill(kEmptyFreeList);
+
     size_ = std::max(size_, offset_);
 
     WasmMemoryImpl::resize(size_);
@@ -31,8 +58,7 @@ namespace kagome::runtime::binaryen {
 
   void WasmMemoryImpl::reset() {
     offset_ = heap_base_;
-    allocated_.clear();
-    deallocated_.clear();
+    free_lists_.fill(kEmptyFreeList);
     if (size_ < offset_) {
       size_ = offset_;
       resize(size_);
@@ -45,10 +71,6 @@ namespace kagome::runtime::binaryen {
   }
 
   void WasmMemoryImpl::resize(runtime::WasmSize new_size) {
-    /**
-     * We use this condition to avoid deallocated_ pointers fixup
-     */
-    BOOST_ASSERT(offset_ <= kMaxMemorySize - new_size);
     if (new_size >= size_) {
       size_ = new_size;
       memory_->resize(new_size);
@@ -59,132 +81,80 @@ namespace kagome::runtime::binaryen {
     if (size == 0) {
       return 0;
     }
-    const auto ptr = offset_;
-    const auto new_offset = roundUpAlign(ptr + size);  // align
-
-    // Round up allocating chunk of memory
-    size = new_offset - ptr;
-
-    BOOST_ASSERT(allocated_.find(ptr) == allocated_.end());
-    if (kMaxMemorySize - offset_ < size) {  // overflow
+    if (size > kMaxAllocationSize) {
       logger_->error(
-          "overflow occured while trying to allocate {} bytes at offset 0x{:x}",
+          "requested allocation of {} bytes is bigger than max allowed {}",
           size,
-          offset_);
+          kMaxAllocationSize);
       return 0;
     }
-    if (new_offset <= size_) {
-      offset_ = new_offset;
-      allocated_[ptr] = size;
-      return ptr;
+    auto order = orderOf(size);
+
+    WasmPointer header_ptr = free_lists_[order];
+    if (header_ptr != kEmptyFreeList) {
+      // header of a free chunk holds the next free chunk of its order
+      free_lists_[order] =
+          static_cast<WasmPointer>(memory_->get<uint64_t>(header_ptr));
+    } else {
+      header_ptr = bumpAlloc(order);
+      if (header_ptr == 0) {
+        return 0;
+      }
     }
 
-    return freealloc(size);
+    memory_->set<uint64_t>(header_ptr, kOccupiedFlag | order);
+    return header_ptr + kAllocationHeaderSize;
   }
 
   boost::optional<WasmSize> WasmMemoryImpl::deallocate(WasmPointer ptr) {
-    auto a_it = allocated_.find(ptr);
-    if (a_it == allocated_.end()) {
+    auto order = allocatedOrder(ptr);
+    if (not order) {
       return boost::none;
     }
 
-    auto a_node = allocated_.extract(a_it);
-    auto size = a_node.mapped();
-    auto [d_it, is_emplaced] = deallocated_.emplace(ptr, size);
-    BOOST_ASSERT(is_emplaced);
+    auto header_ptr = ptr - kAllocationHeaderSize;
+    memory_->set<uint64_t>(header_ptr, free_lists_[*order]);
+    free_lists_[*order] = header_ptr;
 
-    // Combine with next chunk if it adjacent
-    while (true) {
-      auto node = deallocated_.extract(ptr + size);
-      if (not node) break;
-      d_it->second += node.mapped();
-    }
-
-    // Combine with previous chunk if it adjacent
-    while (deallocated_.begin() != d_it) {
-      auto d_it_prev = std::prev(d_it);
-      if (d_it_prev->first + d_it_prev->second != d_it->first) {
-        break;
-      }
-      d_it_prev->second += d_it->second;
-      deallocated_.erase(d_it);
-      d_it = d_it_prev;
-    }
-
-    auto d_it_next = std::next(d_it);
-    if (d_it_next == deallocated_.end()) {
-      if (d_it->first + d_it->second == offset_) {
-        offset_ = d_it->first;
-        deallocated_.erase(d_it);
-      }
-    }
-
-    return size;
+    return kMinAllocationSize << *order;
   }
 
-  WasmPointer WasmMemoryImpl::freealloc(WasmSize size) {
-    if (size == 0) {
-      return 0;
-    }
-
-    // Round up size of allocating memory chunk
-    size = roundUpAlign(size);
-
-    auto min_chunk_size = std::numeric_limits<WasmPointer>::max();
-    WasmPointer ptr = 0;
-    for (const auto &[chunk_ptr, chunk_size] : deallocated_) {
-      BOOST_ASSERT(chunk_size > 0);
-      if (chunk_size >= size and chunk_size < min_chunk_size) {
-        min_chunk_size = chunk_size;
-        ptr = chunk_ptr;
-        if (min_chunk_size == size) {
-          break;
-        }
-      }
-    }
-    if (ptr == 0) {
-      // if did not find available space among deallocated memory chunks,
-      // then grow memory and allocate in new space
-      return growAlloc(size);
+  boost::optional<uint32_t> WasmMemoryImpl::allocatedOrder(
+      WasmPointer ptr) const {
+    if (ptr < heap_base_ + kAllocationHeaderSize or ptr >= offset_
+        or (ptr - heap_base_) % kAlignment != 0) {
+      return boost::none;
     }
-
-    const auto node = deallocated_.extract(ptr);
-    BOOST_ASSERT(node);
-
-    auto old_size = node.mapped();
-    if (old_size > size) {
-      auto new_ptr = ptr + size;
-      auto new_size = old_size - size;
-      BOOST_ASSERT(new_size > 0);
-
-      deallocated_[new_ptr] = new_size;
+    auto header = memory_->get<uint64_t>(ptr - kAllocationHeaderSize);
+    auto order = static_cast<uint32_t>(header);
+    if ((header & kOccupiedFlag) == 0 or order >= kAllocationOrdersNum) {
+      return boost::none;
     }
-
-    allocated_[ptr] = size;
-
-    return ptr;
+    return order;
   }
 
-  WasmPointer WasmMemoryImpl::growAlloc(WasmSize size) {
-    // check that we do not exceed max memory size
-    if (kMaxMemorySize - offset_ < size) {
+  WasmPointer WasmMemoryImpl::bumpAlloc(uint32_t order) {
+    const uint64_t chunk_size = kMinAllocationSize << order;
+    const uint64_t new_offset = uint64_t{offset_} + kAllocationHeaderSize
+                                + chunk_size;
+    if (new_offset > kMaxMemorySize) {
       logger_->error(
-          "Memory size exceeded when growing it on {} bytes, offset was 0x{:x}",
-          size,
+          "Memory size exceeded when allocating {} bytes, offset was 0x{:x}",
+          chunk_size,
           offset_);
       return 0;
     }
-    // try to increase memory size up to offset + size * 4 (we multiply by 4
-    // to have more memory than currently needed to avoid resizing every time
-    // when we exceed current memory)
-    if ((kMaxMemorySize - offset_) / 4 > size) {
-      resize(offset_ + size * 4);
-    } else {
-      // if we can't increase by size * 4 then increase memory size by
-      // provided size
-      resize(offset_ + size);
+    if (new_offset > size_) {
+      // try to increase memory size up to offset + size * 4 (we multiply by 4
+      // to have more memory than currently needed to avoid resizing every
+      // time when we exceed current memory)
+      auto grown_size = uint64_t{offset_} + (new_offset - offset_) * 4;
+      resize(static_cast<WasmSize>(
+          std::min<uint64_t>(grown_size, kMaxMemorySize)));
     }
-    return allocate(size);
+    const auto header_ptr = offset_;
+    offset_ = static_cast<WasmPointer>(new_offset);
+    return header_ptr;
   }
 
   int8_t WasmMemoryImpl::load8s(WasmPointer addr) const {
@@ -249,29 +219,35 @@ namespace kagome::runtime::binaryen {
 
   void WasmMemoryImpl::store8(WasmPointer addr, int8_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int8_t));
+    markWritten(addr, sizeof(int8_t));
     memory_->set<int8_t>(addr, value);
   }
   void WasmMemoryImpl::store16(WasmPointer addr, int16_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int16_t));
+    markWritten(addr, sizeof(int16_t));
     memory_->set<int16_t>(addr, value);
   }
   void WasmMemoryImpl::store32(WasmPointer addr, int32_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int32_t));
+    markWritten(addr, sizeof(int32_t));
     memory_->set<int32_t>(addr, value);
   }
   void WasmMemoryImpl::store64(WasmPointer addr, int64_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int64_t));
+    markWritten(addr, sizeof(int64_t));
     memory_->set<int64_t>(addr, value);
   }
   void WasmMemoryImpl::store128(WasmPointer addr,
                                 const std::array<uint8_t, 16> &value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(value));
+    markWritten(addr, sizeof(value));
     memory_->set<std::array<uint8_t, 16>>(addr, value);
   }
   void WasmMemoryImpl::storeBuffer(kagome::runtime::WasmPointer addr,
                                    gsl::span<const uint8_t> value) {
     const auto size = static_cast<size_t>(value.size());
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= size);
+    markWritten(addr, size);
     for (size_t i = addr, j = 0; i < addr + size; i++, j++) {
       memory_->set(i, value[j]);
     }
@@ -288,26 +264,44 @@ namespace kagome::runtime::binaryen {
     return WasmResult(wasm_pointer, value.size()).combine();
   }
 
-  boost::optional<WasmSize> WasmMemoryImpl::getDeallocatedChunkSize(
-      WasmPointer ptr) const {
-    auto it = deallocated_.find(ptr);
-    return it != deallocated_.cend() ? boost::make_optional(it->second)
-                                     : boost::none;
+  void WasmMemoryImpl::takeSnapshot() {
+    auto size = std::min(heap_base_, size_);
+    snapshot_.resize(size);
+    for (WasmPointer i = 0; i < size; i++) {
+      snapshot_[i] = memory_->get<uint8_t>(i);
+    }
+    written_pages_.assign(
+        (size + kSnapshotPageSize - 1) / kSnapshotPageSize, false);
   }
 
-  boost::optional<WasmSize> WasmMemoryImpl::getAllocatedChunkSize(
-      WasmPointer ptr) const {
-    auto it = allocated_.find(ptr);
-    return it != allocated_.cend() ? boost::make_optional(it->second)
-                                   : boost::none;
+  void WasmMemoryImpl::restoreSnapshot() {
+    for (size_t page = 0; page < written_pages_.size(); page++) {
+      if (not written_pages_[page]) {
+        continue;
+      }
+      auto begin = page * kSnapshotPageSize;
+      auto end = std::min(begin + kSnapshotPageSize, snapshot_.size());
+      for (auto i = begin; i < end; i++) {
+        memory_->set<uint8_t>(i, snapshot_[i]);
+      }
+      written_pages_[page] = false;
+    }
   }
 
-  size_t WasmMemoryImpl::getAllocatedChunksNum() const {
-    return allocated_.size();
+  boost::optional<WasmSize> WasmMemoryImpl::getAllocatedChunkSize(
+      WasmPointer ptr) const {
+    auto order = allocatedOrder(ptr);
+    return order ? boost::make_optional(kMinAllocationSize << *order)
+                 : boost::none;
   }
 
-  size_t WasmMemoryImpl::getDeallocatedChunksNum() const {
-    return deallocated_.size();
+  size_t WasmMemoryImpl::getFreeChunksNum(WasmSize size) const {
+    size_t num = 0;
+    for (auto ptr = free_lists_[orderOf(size)]; ptr != kEmptyFreeList;
+         ptr = static_cast<WasmPointer>(memory_->get<uint64_t>(ptr))) {
+      ++num;
+    }
+    return num;
   }
 
 }  // namespace kagome::runtime::binaryen
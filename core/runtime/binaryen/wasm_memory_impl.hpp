@@ -8,10 +8,11 @@
 
 #include <binaryen/shell-interface.h>
 
+#include <algorithm>
 #include <array>
 #include <cstring>  // for std::memset in gcc
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -29,6 +30,15 @@ namespace kagome::runtime::binaryen {
   inline const uint8_t kAlignment = sizeof(size_t);
   inline const size_t kInitialMemorySize = 2_MB;  // 2Mb
   inline const size_t kDefaultHeapBase = 1_MB;    // 1Mb
+  inline const size_t kSnapshotPageSize = 4_kB;
+
+  // Allocator parameters, same with substrate:
+  // https://github.com/paritytech/substrate/blob/743981a083f244a090b40ccfb5ce902199b55334/primitives/allocator/src/freeing_bump.rs
+  inline const WasmSize kMinAllocationSize = 8;
+  inline const size_t kAllocationOrdersNum = 23;
+  inline const WasmSize kMaxAllocationSize = kMinAllocationSize
+                                             << (kAllocationOrdersNum - 1);
+  inline const WasmSize kAllocationHeaderSize = 8;
 
   /**
    * Obtain closest multiple of kAllignment that is greater or equal to given
@@ -46,6 +56,8 @@ namespace kagome::runtime::binaryen {
                 "Heap base must be aligned");
   static_assert(kDefaultHeapBase < kInitialMemorySize,
                 "Heap base must be in border of memory");
+  static_assert(kMaxAllocationSize == 32_MB,
+                "Max allocation size must be the same as in substrate");
 
   /**
    * Memory implementation for wasm environment
@@ -53,6 +65,14 @@ namespace kagome::runtime::binaryen {
    * https://github.com/WebAssembly/binaryen/blob/master/src/shell-interface.h#L37
    * @note Memory size of this implementation is at least of the size of one
    * wasm page (4096 bytes)
+   *
+   * Heap is managed by the freeing bump allocator, compatible with the
+   * substrate one: every allocation is rounded up to a power of two (its
+   * order) and preceded by an 8-byte header in the wasm memory itself. The
+   * header of an allocated chunk holds its order, the header of a freed chunk
+   * holds the pointer to the next free chunk of the same order. Thus both
+   * allocation and deallocation take constant time: a chunk is taken from the
+   * free list of its order, or else is bumped from the end of the heap
    */
   class WasmMemoryImpl final : public WasmMemory {
    public:
@@ -98,11 +118,38 @@ namespace kagome::runtime::binaryen {
 
     WasmSpan storeBuffer(gsl::span<const uint8_t> value) override;
 
+    /**
+     * Saves the memory below the heap base, which holds the data segments
+     * and the stack, so that it could be restored after a runtime call. Only
+     * the pages written since the last restore are copied back
+     */
+    void takeSnapshot();
+
+    /**
+     * Copies the pages written since the snapshot was taken or last restored
+     * back from the snapshot
+     */
+    void restoreSnapshot();
+
+    /**
+     * Marks the snapshot pages of \arg size bytes at \arg addr as written,
+     * for the writes to the underlying memory that bypass this class
+     */
+    void markWritten(WasmPointer addr, WasmSize size) {
+      if (addr >= snapshot_.size() or size == 0) {
+        return;
+      }
+      auto last = std::min<size_t>(size_t{addr} + size, snapshot_.size()) - 1;
+      for (auto page = addr / kSnapshotPageSize;
+           page <= last / kSnapshotPageSize;
+           ++page) {
+        written_pages_[page] = true;
+      }
+    }
+
     /// following methods are needed mostly for testing purposes
-    boost::optional<WasmSize> getDeallocatedChunkSize(WasmPointer ptr) const;
     boost::optional<WasmSize> getAllocatedChunkSize(WasmPointer ptr) const;
-    size_t getAllocatedChunksNum() const;
-    size_t getDeallocatedChunksNum() const;
+    size_t getFreeChunksNum(WasmSize size) const;
 
    private:
     wasm::ShellExternalInterface::Memory *memory_;
@@ -116,11 +163,11 @@ namespace kagome::runtime::binaryen {
 
     log::Logger logger_;
 
-    // map containing addresses of allocated MemoryImpl chunks
-    std::unordered_map<WasmPointer, WasmSize> allocated_;
+    // heads of the lists of free chunk headers, one per allocation order
+    std::array<WasmPointer, kAllocationOrdersNum> free_lists_;
 
-    // map containing addresses to the deallocated MemoryImpl chunks
-    std::map<WasmPointer, WasmSize> deallocated_;
+    std::vector<uint8_t> snapshot_;
+    std::vector<bool> written_pages_;
 
     template <typename T>
     static bool aligned(const char *address) {
@@ -130,21 +177,18 @@ namespace kagome::runtime::binaryen {
     }
 
     /**
-     * Finds memory segment of given size among deallocated pieces of memory
-     * and allocates a memory there
-     * @param size of target memory
-     * @return address of memory of given size, or -1 if it is impossible to
-     * allocate this amount of memory
+     * Reads the header of the chunk at \arg ptr
+     * @return order of the chunk, or none if there is no allocated chunk
      */
-    WasmPointer freealloc(WasmSize size);
+    boost::optional<uint32_t> allocatedOrder(WasmPointer ptr) const;
 
     /**
-     * Resize memory and allocate memory segment of given size
-     * @param size memory size to be allocated
-     * @return pointer to the allocated memory @or 0 if it is impossible to
+     * Bumps a chunk of given order from the end of the heap, growing memory
+     * if needed
+     * @return address of the chunk header, or 0 if it is impossible to
      * allocate this amount of memory
      */
-    WasmPointer growAlloc(WasmSize size);
+    WasmPointer bumpAlloc(uint32_t order);
   };
 }  // namespace kagome::runtime::binaryen
 
@@ -5,6 +5,8 @@
 
 #include "runtime/common/const_wasm_provider.hpp"
 
+#include "crypto/twox/twox.hpp"
+
 namespace kagome::runtime {
 
   ConstWasmProvider::ConstWasmProvider(common::Buffer code)
@@ -15,4 +17,12 @@ namespace kagome::runtime {
     return code_;
   }
 
+  const common::Hash256 &ConstWasmProvider::getStateCodeHashAt(
+      const primitives::BlockHash &at) const {
+    if (not code_hash_) {
+      code_hash_ = crypto::make_twox256(code_);
+    }
+    return *code_hash_;
+  }
+
 }  // namespace kagome::runtime
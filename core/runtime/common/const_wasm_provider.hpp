@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_RUNTIME_COMMON_CONST_WASM_PROVIDER
 #define KAGOME_CORE_RUNTIME_COMMON_CONST_WASM_PROVIDER
 
+#include <boost/optional.hpp>
+
 #include "runtime/wasm_provider.hpp"
 
 namespace kagome::runtime {
@@ -17,8 +19,13 @@ namespace kagome::runtime {
     const common::Buffer &getStateCodeAt(
         const primitives::BlockHash &at) const override;
 
+    const common::Hash256 &getStateCodeHashAt(
+        const primitives::BlockHash &at) const override;
+
    private:
     common::Buffer code_;
+    // computed on demand, as the code is often only called in isolation
+    mutable boost::optional<common::Hash256> code_hash_;
   };
 
 }  // namespace kagome::runtime
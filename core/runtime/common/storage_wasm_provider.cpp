@@ -5,9 +5,11 @@
 
 #include "runtime/common/storage_wasm_provider.hpp"
 
+#include "crypto/twox/twox.hpp"
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::runtime {
+  using common::Buffer;
 
   StorageWasmProvider::StorageWasmProvider(
       std::shared_ptr<const storage::trie::TrieStorage> storage)
@@ -17,26 +19,48 @@ namespace kagome::runtime {
     last_state_root_ = storage_->getRootHash();
     auto batch = storage_->getEphemeralBatch();
     BOOST_ASSERT_MSG(batch.has_value(), "Error getting a batch of the storage");
-    auto state_code_res = batch.value()->get(kRuntimeCodeKey);
-    BOOST_ASSERT_MSG(state_code_res.has_value(),
-                     "Runtime code does not exist in the storage");
-    state_code_ = state_code_res.value();
+    loadStateCode(*batch.value());
   }
 
   const common::Buffer &StorageWasmProvider::getStateCodeAt(
       const storage::trie::RootHash &at) const {
+    updateStateCodeAt(at);
+    return state_code_;
+  }
+
+  const common::Hash256 &StorageWasmProvider::getStateCodeHashAt(
+      const storage::trie::RootHash &at) const {
+    updateStateCodeAt(at);
+    return state_code_hash_;
+  }
+
+  void StorageWasmProvider::updateStateCodeAt(
+      const storage::trie::RootHash &at) const {
     if (last_state_root_ == at) {
-      return state_code_;
+      return;
     }
     last_state_root_ = at;
 
     auto batch = storage_->getEphemeralBatchAt(at);
     BOOST_ASSERT_MSG(batch.has_value(), "Error getting a batch of the storage");
-    auto state_code_res = batch.value()->get(kRuntimeCodeKey);
-    BOOST_ASSERT_MSG(state_code_res.has_value(),
+    loadStateCode(*batch.value());
+  }
+
+  void StorageWasmProvider::loadStateCode(
+      const storage::trie::EphemeralTrieBatch &batch) const {
+    // the node with the code is not even retrieved from the storage while
+    // the code stays the same
+    auto stored_res =
+        batch.getStoredValue(kRuntimeCodeKey, state_code_db_key_);
+    BOOST_ASSERT_MSG(stored_res.has_value(),
                      "Runtime code does not exist in the storage");
-    state_code_ = state_code_res.value();
-    return state_code_;
+    auto &stored = stored_res.value();
+    if (stored.value) {
+      state_code_ = std::move(stored.value.value());
+      state_code_hash_ = crypto::make_twox256(state_code_);
+    }
+    // a code modified in memory has no node in the storage yet
+    state_code_db_key_ = stored.db_key ? std::move(*stored.db_key) : Buffer{};
   }
 
 }  // namespace kagome::runtime
@@ -9,6 +9,7 @@
 #include "runtime/wasm_provider.hpp"
 
 namespace kagome::storage::trie {
+  class EphemeralTrieBatch;
   class TrieStorage;
 }
 
@@ -26,9 +27,19 @@ namespace kagome::runtime {
     const common::Buffer &getStateCodeAt(
         const storage::trie::RootHash &at) const override;
 
+    const common::Hash256 &getStateCodeHashAt(
+        const storage::trie::RootHash &at) const override;
+
    private:
+    void updateStateCodeAt(const storage::trie::RootHash &at) const;
+    void loadStateCode(const storage::trie::EphemeralTrieBatch &batch) const;
+
     std::shared_ptr<const storage::trie::TrieStorage> storage_;
     mutable common::Buffer state_code_;
+    mutable common::Hash256 state_code_hash_;
+    // key of the trie node with the code in the storage, which is the same
+    // for all the states until the runtime is upgraded
+    mutable common::Buffer state_code_db_key_;
     mutable storage::trie::RootHash last_state_root_;
   };
 
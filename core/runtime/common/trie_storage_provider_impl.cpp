@@ -9,7 +9,6 @@
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 
 namespace kagome::runtime {
-  using storage::trie::TopperTrieBatch;
   using storage::trie::TopperTrieBatchImpl;
   using storage::trie::TrieStorage;
 
@@ -73,34 +72,49 @@ namespace kagome::runtime {
   }
 
   outcome::result<void> TrieStorageProviderImpl::startTransaction() {
-    stack_of_batches_.emplace(current_batch_);
-    current_batch_ =
-        std::make_shared<TopperTrieBatchImpl>(std::move(current_batch_));
+    // the outermost transaction is a batch on top of the current one, the
+    // nested ones are layers of that batch
+    if (transactions_num_ == 0) {
+      transaction_base_batch_ = current_batch_;
+      transaction_batch_ =
+          std::make_shared<TopperTrieBatchImpl>(transaction_base_batch_);
+      current_batch_ = transaction_batch_;
+    } else {
+      transaction_batch_->startTransaction();
+    }
+    ++transactions_num_;
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::rollbackTransaction() {
-    if (stack_of_batches_.empty()) {
+    if (transactions_num_ == 0) {
       return RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED;
     }
 
-    current_batch_ = std::move(stack_of_batches_.top());
-    stack_of_batches_.pop();
+    --transactions_num_;
+    if (transactions_num_ > 0) {
+      transaction_batch_->rollbackTransaction();
+      return outcome::success();
+    }
+    current_batch_ = std::move(transaction_base_batch_);
+    transaction_batch_.reset();
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::commitTransaction() {
-    if (stack_of_batches_.empty()) {
+    if (transactions_num_ == 0) {
       return RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED;
     }
 
-    auto commitee_batch =
-        std::dynamic_pointer_cast<TopperTrieBatch>(current_batch_);
-    BOOST_ASSERT(commitee_batch != nullptr);
-    OUTCOME_TRY(commitee_batch->writeBack());
-
-    current_batch_ = std::move(stack_of_batches_.top());
-    stack_of_batches_.pop();
+    if (transactions_num_ > 1) {
+      transaction_batch_->commitTransaction();
+      --transactions_num_;
+      return outcome::success();
+    }
+    OUTCOME_TRY(transaction_batch_->writeBack());
+    --transactions_num_;
+    current_batch_ = std::move(transaction_base_batch_);
+    transaction_batch_.reset();
     return outcome::success();
   }
 
@@ -8,8 +8,6 @@
 
 #include "runtime/trie_storage_provider.hpp"
 
-#include <stack>
-
 #include "common/buffer.hpp"
 #include "runtime/common/runtime_transaction_error.hpp"
 #include "storage/trie/trie_storage.hpp"
@@ -47,10 +45,15 @@ namespace kagome::runtime {
    private:
     std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
 
-    std::stack<std::shared_ptr<Batch>> stack_of_batches_;
-
     std::shared_ptr<Batch> current_batch_;
 
+    // the batch changed by the started transactions, with a nested
+    // transaction per each but the outermost one
+    std::shared_ptr<storage::trie::TopperTrieBatch> transaction_batch_;
+    // the batch the outermost transaction was started on top of
+    std::shared_ptr<Batch> transaction_base_batch_;
+    size_t transactions_num_ = 0;
+
     // need to store it because it has to be the same in different runtime calls
     // to keep accumulated changes for commit to the main storage
     std::shared_ptr<PersistentBatch> persistent_batch_;
@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_RUNTIME_WASM_PROVIDER_HPP
 #define KAGOME_CORE_RUNTIME_WASM_PROVIDER_HPP
 
+#include "common/blob.hpp"
 #include "common/buffer.hpp"
 #include "primitives/block_id.hpp"
 #include "storage/trie/types.hpp"
@@ -20,6 +21,13 @@ namespace kagome::runtime {
 
     virtual const common::Buffer &getStateCodeAt(
         const storage::trie::RootHash &at) const = 0;
+
+    /**
+     * @return hash of the code returned by getStateCodeAt() for \arg at,
+     * which is not computed again until the code changes
+     */
+    virtual const common::Hash256 &getStateCodeHashAt(
+        const storage::trie::RootHash &at) const = 0;
   };
 
 }  // namespace kagome::runtime
@@ -70,4 +70,48 @@ namespace kagome::scale {
         self_encoded.end(), opaque_value.v.begin(), opaque_value.v.end());
     return outcome::success();
   }
+
+  outcome::result<void> append_or_new_vec(
+      std::vector<uint8_t> &self_encoded,
+      const std::vector<gsl::span<const uint8_t>> &inputs) {
+    if (inputs.empty()) {
+      return outcome::success();
+    }
+
+    CompactInteger len = 0;
+    size_t encoded_len = 0;
+    if (not self_encoded.empty()) {
+      OUTCOME_TRY(current_len, scale::decode<CompactInteger>(self_encoded));
+      len = std::move(current_len);
+      encoded_len = compact::compactLen(len.convert_to<uint32_t>());
+    }
+    OUTCOME_TRY(encoded_new_len,
+                scale::encode(CompactInteger{len + inputs.size()}));
+
+    size_t inputs_size = 0;
+    for (auto &input : inputs) {
+      inputs_size += input.size();
+    }
+
+    if (encoded_len == encoded_new_len.size()) {
+      self_encoded.reserve(self_encoded.size() + inputs_size);
+      std::copy(encoded_new_len.begin(),
+                encoded_new_len.end(),
+                self_encoded.begin());
+    } else {
+      std::vector<uint8_t> result;
+      result.reserve(encoded_new_len.size() + self_encoded.size()
+                     - encoded_len + inputs_size);
+      result.insert(
+          result.end(), encoded_new_len.begin(), encoded_new_len.end());
+      result.insert(result.end(),
+                    self_encoded.begin() + encoded_len,
+                    self_encoded.end());
+      self_encoded = std::move(result);
+    }
+    for (auto &input : inputs) {
+      self_encoded.insert(self_encoded.end(), input.begin(), input.end());
+    }
+    return outcome::success();
+  }
 }  // namespace kagome::scale
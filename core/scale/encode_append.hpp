@@ -44,6 +44,18 @@ namespace kagome::scale {
    */
   outcome::result<void> append_or_new_vec(std::vector<uint8_t> &self_encoded,
                                           gsl::span<const uint8_t> input);
+
+  /**
+   * Same as append_or_new_vec() called for every one of \arg inputs in turn,
+   * but the already encoded items are moved at most once
+   * @param self_encoded Current encoded vector of EncodeOpaqueValue
+   * @param inputs vectors to be added to @param self_encoded as
+   * EncodeOpaqueValues
+   * @return success inputs were appended to self_encoded, failure otherwise
+   */
+  outcome::result<void> append_or_new_vec(
+      std::vector<uint8_t> &self_encoded,
+      const std::vector<gsl::span<const uint8_t>> &inputs);
 }  // namespace kagome::scale
 
 #endif  // KAGOME_CORE_SCALE_ENCODE_APPEND_HPP
@@ -6,6 +6,10 @@
 #ifndef KAGOME_READABLE_HPP
 #define KAGOME_READABLE_HPP
 
+#include <functional>
+#include <vector>
+
+#include <gsl/span>
 #include <outcome/outcome.hpp>
 #include "storage/face/map_cursor.hpp"
 
@@ -18,6 +22,9 @@ namespace kagome::storage::face {
    */
   template <typename K, typename V>
   struct Readable {
+    using ValueView = gsl::span<const typename V::value_type>;
+    using ViewConsumer = std::function<outcome::result<void>(ValueView)>;
+
     virtual ~Readable() = default;
 
     /**
@@ -27,6 +34,37 @@ namespace kagome::storage::face {
      */
     virtual outcome::result<V> get(const K &key) const = 0;
 
+    /**
+     * @brief Pass the value of a key to \arg consumer. Storages override it
+     * to give out a view of the memory they have read the value to instead
+     * of copying it, so the value is valid only during the call.
+     * @param key K
+     * @param consumer function to process the value, its error is returned
+     * @return error of the lookup or of \arg consumer
+     */
+    virtual outcome::result<void> view(const K &key,
+                                       const ViewConsumer &consumer) const {
+      OUTCOME_TRY(value, get(key));
+      return consumer(value);
+    }
+
+    /**
+     * @brief Get values of several keys at once. Storages override it to
+     * share the work among the keys, e.g. to visit the common part of the
+     * paths to them once.
+     * @param keys keys to look up, in any order
+     * @return results of get() for each of \arg keys, in the same order
+     */
+    virtual std::vector<outcome::result<V>> getMany(
+        const std::vector<K> &keys) const {
+      std::vector<outcome::result<V>> values;
+      values.reserve(keys.size());
+      for (auto &key : keys) {
+        values.emplace_back(get(key));
+      }
+      return values;
+    }
+
     /**
      * @brief Returns true if given key-value binding exists in the storage.
      * @param key K
@@ -5,8 +5,11 @@
 
 #include "storage/leveldb/leveldb.hpp"
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <iostream>
+#include <numeric>
+#include <sstream>
 #include <utility>
 
 #include "filesystem/common.hpp"
@@ -15,9 +18,54 @@
 #include "storage/leveldb/leveldb_cursor.hpp"
 #include "storage/leveldb/leveldb_util.hpp"
 
+namespace {
+  constexpr auto kLevelFilesGaugeName = "kagome_leveldb_level_files";
+  constexpr auto kLevelSizeGaugeName = "kagome_leveldb_level_size_bytes";
+  constexpr auto kCompactionReadGaugeName =
+      "kagome_leveldb_compaction_read_bytes";
+  constexpr auto kCompactionWrittenGaugeName =
+      "kagome_leveldb_compaction_written_bytes";
+  constexpr auto kMemoryUsageGaugeName = "kagome_leveldb_memory_usage_bytes";
+  constexpr auto kApproximateSizeGaugeName =
+      "kagome_leveldb_approximate_size_bytes";
+
+  // the stats take a lock in LevelDB and the approximate size looks into
+  // every level, so they are not gathered on each write
+  constexpr std::chrono::seconds kMetricsUpdatePeriod{10};
+
+  // leveldb.stats gives sizes in megabytes
+  constexpr double kMegabyte = 1048576.;
+}  // namespace
+
 namespace kagome::storage {
   namespace fs = boost::filesystem;
 
+  outcome::result<std::shared_ptr<LevelDB>> LevelDB::create(
+      const filesystem::path &path,
+      const LevelDBConfig &config,
+      leveldb::Options options) {
+    std::unique_ptr<leveldb::Cache> block_cache{
+        leveldb::NewLRUCache(config.block_cache_size)};
+    options.block_cache = block_cache.get();
+
+    std::unique_ptr<const leveldb::FilterPolicy> filter_policy;
+    if (config.bloom_filter_bits > 0) {
+      filter_policy.reset(
+          leveldb::NewBloomFilterPolicy(config.bloom_filter_bits));
+    }
+    options.filter_policy = filter_policy.get();
+
+    options.write_buffer_size = config.write_buffer_size;
+    options.max_open_files = config.max_open_files;
+    options.compression = config.compression ? leveldb::kSnappyCompression
+                                             : leveldb::kNoCompression;
+
+    OUTCOME_TRY(db, create(path, options));
+    db->block_cache_ = std::move(block_cache);
+    db->filter_policy_ = std::move(filter_policy);
+    return std::move(db);
+  }
+
   outcome::result<std::shared_ptr<LevelDB>> LevelDB::create(
       const filesystem::path &path, leveldb::Options options) {
     if (!filesystem::createDirectoryRecursive(path))
@@ -47,6 +95,8 @@ namespace kagome::storage {
       auto l = std::make_unique<LevelDB>();
       l->db_ = std::unique_ptr<leveldb::DB>(db);
       l->logger_ = std::move(log);
+      l->registerMetrics();
+      l->updateMetrics();
       return l;
     }
 
@@ -77,7 +127,7 @@ namespace kagome::storage {
     std::string value;
     auto status = db_->Get(ro_, make_slice(key), &value);
     if (status.ok()) {
-      // FIXME: is it possible to avoid copying string -> Buffer?
+      // the readers which do not need a Buffer avoid this copy with view()
       return Buffer{}.put(value);
     }
 
@@ -89,6 +139,47 @@ namespace kagome::storage {
     return error_as_result<Buffer>(status, logger_);
   }
 
+  outcome::result<void> LevelDB::view(const Buffer &key,
+                                      const ViewConsumer &consumer) const {
+    // LevelDB has no way to pin a value in its own memory except for an
+    // iterator, which does not use the bloom filters, so the value is read
+    // to a string once and then viewed in place
+    std::string value;
+    auto status = db_->Get(ro_, make_slice(key), &value);
+    if (status.ok()) {
+      return consumer(make_span(leveldb::Slice{value}));
+    }
+    if (status.IsNotFound()) {
+      return error_as_result<void>(status);
+    }
+    return error_as_result<void>(status, logger_);
+  }
+
+  std::vector<outcome::result<Buffer>> LevelDB::getMany(
+      const std::vector<Buffer> &keys) const {
+    std::vector<outcome::result<Buffer>> values(keys.size(),
+                                                DatabaseError::NOT_FOUND);
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) {
+      return keys[lhs] < keys[rhs];
+    });
+
+    auto it = std::unique_ptr<leveldb::Iterator>(db_->NewIterator(ro_));
+    for (auto i : order) {
+      auto key = make_slice(keys[i]);
+      it->Seek(key);
+      if (it->Valid()) {
+        if (it->key() == key) {
+          values[i] = make_buffer(it->value());
+        }
+      } else if (not it->status().ok()) {
+        values[i] = error_as_result<Buffer>(it->status(), logger_);
+      }
+    }
+    return values;
+  }
+
   bool LevelDB::contains(const Buffer &key) const {
     // here we interpret all kinds of errors as "not found".
     // is there a better way?
@@ -104,6 +195,7 @@ namespace kagome::storage {
   outcome::result<void> LevelDB::put(const Buffer &key, const Buffer &value) {
     auto status = db_->Put(wo_, make_slice(key), make_slice(value));
     if (status.ok()) {
+      updateMetricsIfDue();
       return outcome::success();
     }
 
@@ -111,17 +203,120 @@ namespace kagome::storage {
   }
 
   outcome::result<void> LevelDB::put(const Buffer &key, Buffer &&value) {
-    Buffer copy(std::move(value));
-    return put(key, copy);
+    return put(key, static_cast<const Buffer &>(value));
   }
 
   outcome::result<void> LevelDB::remove(const Buffer &key) {
     auto status = db_->Delete(wo_, make_slice(key));
     if (status.ok()) {
+      updateMetricsIfDue();
       return outcome::success();
     }
 
     return error_as_result<void>(status, logger_);
   }
 
+  void LevelDB::registerMetrics() {
+    registry_->registerGaugeFamily(kLevelFilesGaugeName,
+                                   "Number of LevelDB table files per level");
+    registry_->registerGaugeFamily(kLevelSizeGaugeName,
+                                   "Size of LevelDB tables per level");
+    registry_->registerGaugeFamily(
+        kCompactionReadGaugeName,
+        "Amount of data read by LevelDB compactions per level");
+    registry_->registerGaugeFamily(
+        kCompactionWrittenGaugeName,
+        "Amount of data written by LevelDB compactions per level");
+    registry_->registerGaugeFamily(
+        kMemoryUsageGaugeName,
+        "Approximate memory used by LevelDB memtables and block cache");
+    registry_->registerGaugeFamily(
+        kApproximateSizeGaugeName,
+        "Approximate size on disk of the whole LevelDB key range");
+
+    for (size_t level = 0; level < kLevels; ++level) {
+      std::map<std::string, std::string> labels{
+          {"level", std::to_string(level)}};
+      level_gauges_[level] = LevelGauges{
+          registry_->registerGaugeMetric(kLevelFilesGaugeName, labels),
+          registry_->registerGaugeMetric(kLevelSizeGaugeName, labels),
+          registry_->registerGaugeMetric(kCompactionReadGaugeName, labels),
+          registry_->registerGaugeMetric(kCompactionWrittenGaugeName, labels),
+      };
+    }
+    memory_usage_ = registry_->registerGaugeMetric(kMemoryUsageGaugeName);
+    approximate_size_ =
+        registry_->registerGaugeMetric(kApproximateSizeGaugeName);
+  }
+
+  void LevelDB::updateMetricsIfDue() {
+    std::unique_lock lock{metrics_mutex_, std::try_to_lock};
+    if (not lock) {
+      // being updated by another writer right now
+      return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now - metrics_updated_at_ < kMetricsUpdatePeriod) {
+      return;
+    }
+    metrics_updated_at_ = now;
+    updateMetrics();
+  }
+
+  void LevelDB::updateMetrics() {
+    // leveldb.stats is a table with a row per non-empty level:
+    // Level Files Size(MB) Time(sec) Read(MB) Write(MB)
+    struct LevelStats {
+      double files = 0;
+      double size_mb = 0;
+      double read_mb = 0;
+      double written_mb = 0;
+    };
+    std::array<LevelStats, kLevels> levels{};
+    std::string stats;
+    if (db_->GetProperty("leveldb.stats", &stats)) {
+      std::istringstream lines{stats};
+      std::string line;
+      while (std::getline(lines, line)) {
+        std::istringstream row{line};
+        size_t level = 0;
+        LevelStats level_stats;
+        double time_sec = 0;
+        if (row >> level >> level_stats.files >> level_stats.size_mb
+                >> time_sec >> level_stats.read_mb >> level_stats.written_mb
+            and level < kLevels) {
+          levels[level] = level_stats;
+        }
+      }
+    }
+    for (size_t level = 0; level < kLevels; ++level) {
+      auto &gauges = level_gauges_[level];
+      gauges.files->set(levels[level].files);
+      gauges.size->set(levels[level].size_mb * kMegabyte);
+      gauges.compaction_read->set(levels[level].read_mb * kMegabyte);
+      gauges.compaction_written->set(levels[level].written_mb * kMegabyte);
+    }
+
+    std::string memory_usage;
+    if (db_->GetProperty("leveldb.approximate-memory-usage", &memory_usage)) {
+      memory_usage_->set(std::stod(memory_usage));
+    }
+
+    // the range from the first key to right past the last one
+    auto it = std::unique_ptr<leveldb::Iterator>(db_->NewIterator(ro_));
+    it->SeekToFirst();
+    if (not it->Valid()) {
+      approximate_size_->set(0);
+      return;
+    }
+    auto first = it->key().ToString();
+    it->SeekToLast();
+    auto past_last = it->key().ToString();
+    past_last.push_back('\0');
+    leveldb::Range range{first, past_last};
+    uint64_t size = 0;
+    db_->GetApproximateSizes(&range, 1, &size);
+    approximate_size_->set(static_cast<double>(size));
+  }
+
 }  // namespace kagome::storage
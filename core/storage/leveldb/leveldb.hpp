@@ -6,12 +6,19 @@
 #ifndef KAGOME_LEVELDB_HPP
 #define KAGOME_LEVELDB_HPP
 
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
 #include <leveldb/write_batch.h>
+#include <array>
 #include <boost/filesystem/path.hpp>
+#include <chrono>
+#include <mutex>
 
 #include "log/logger.hpp"
+#include "metrics/metrics.hpp"
 #include "storage/buffer_map_types.hpp"
+#include "storage/leveldb/leveldb_config.hpp"
 
 namespace kagome::storage {
 
@@ -36,6 +43,19 @@ namespace kagome::storage {
         const boost::filesystem::path &path,
         leveldb::Options options = leveldb::Options());
 
+    /**
+     * @brief Factory method to create an instance of LevelDB class, which
+     * owns the block cache and the filter policy made after \arg config
+     * @param path filesystem path where database is going to be
+     * @param config sizes of the caches and buffers of the database
+     * @param options leveldb options to set the ones from \arg config into
+     * @return instance of LevelDB
+     */
+    static outcome::result<std::shared_ptr<LevelDB>> create(
+        const boost::filesystem::path &path,
+        const LevelDBConfig &config,
+        leveldb::Options options = leveldb::Options());
+
     /**
      * @brief Set read options, which are used in @see LevelDB#get
      * @param ro options
@@ -54,22 +74,69 @@ namespace kagome::storage {
 
     outcome::result<Buffer> get(const Buffer &key) const override;
 
+    /**
+     * Gives out the string LevelDB has read the value to, saving the copy
+     * of it to a Buffer
+     */
+    outcome::result<void> view(const Buffer &key,
+                               const ViewConsumer &consumer) const override;
+
+    /**
+     * Reads the keys in their sorted order with a single iterator, so that
+     * the values are taken from one snapshot of the database and the
+     * neighbouring keys are found in the already loaded blocks
+     */
+    std::vector<outcome::result<Buffer>> getMany(
+        const std::vector<Buffer> &keys) const override;
+
     bool contains(const Buffer &key) const override;
 
     bool empty() const override;
 
     outcome::result<void> put(const Buffer &key, const Buffer &value) override;
 
-    // value will be copied, not moved, due to internal structure of LevelDB
+    // value will be copied to the write batch of LevelDB anyway
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
 
     outcome::result<void> remove(const Buffer &key) override;
 
    private:
+    /// LevelDB has 7 levels of tables, which is not a part of its public API
+    static constexpr size_t kLevels = 7;
+
+    struct LevelGauges {
+      metrics::Gauge *files;
+      metrics::Gauge *size;
+      metrics::Gauge *compaction_read;
+      metrics::Gauge *compaction_written;
+    };
+
+    void registerMetrics();
+
+    /**
+     * Exports the internal stats of LevelDB, if they have not been exported
+     * for some time, to be called after the writes which change them
+     */
+    void updateMetricsIfDue();
+
+    void updateMetrics();
+
+    // must outlive db_, which refers to them
+    std::unique_ptr<leveldb::Cache> block_cache_;
+    std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
+
     std::unique_ptr<leveldb::DB> db_;
     leveldb::ReadOptions ro_;
     leveldb::WriteOptions wo_;
     log::Logger logger_;
+
+    // metrics
+    metrics::RegistryPtr registry_ = metrics::createRegistry();
+    std::array<LevelGauges, kLevels> level_gauges_{};
+    metrics::Gauge *memory_usage_ = nullptr;
+    metrics::Gauge *approximate_size_ = nullptr;
+    std::mutex metrics_mutex_;
+    std::chrono::steady_clock::time_point metrics_updated_at_;
   };
 
 }  // namespace kagome::storage
@@ -30,6 +30,7 @@ namespace kagome::storage {
   outcome::result<void> LevelDB::Batch::commit() {
     auto status = db_.db_->Write(db_.wo_, &batch_);
     if (status.ok()) {
+      db_.updateMetricsIfDue();
       return outcome::success();
     }
 
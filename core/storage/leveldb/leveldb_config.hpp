@@ -0,0 +1,35 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_LEVELDB_CONFIG_HPP
+#define KAGOME_LEVELDB_CONFIG_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kagome::storage {
+
+  struct LevelDBConfig {
+    /// Size in bytes of the cache of uncompressed blocks shared by all reads
+    size_t block_cache_size = 64 * 1024 * 1024;
+
+    /// Bits per key of the bloom filters, which let a read skip the tables
+    /// without the key; 0 disables the filters
+    uint32_t bloom_filter_bits = 10;
+
+    /// Size in bytes of the writes kept in memory before they are sorted into
+    /// a table on disk
+    size_t write_buffer_size = 16 * 1024 * 1024;
+
+    /// Max number of table files kept open at once
+    uint32_t max_open_files = 1000;
+
+    /// Whether the blocks are compressed with Snappy
+    bool compression = true;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_LEVELDB_CONFIG_HPP
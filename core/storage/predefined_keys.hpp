@@ -23,6 +23,12 @@ namespace kagome::storage {
   inline const common::Buffer kLastBabeEpochNumberLookupKey =
       common::Buffer().put(":kagome:last_babe_epoch_number");
 
+  inline const common::Buffer kFlatStateRootLookupKey =
+      common::Buffer().put(":kagome:flat_state_root");
+
+  inline const common::Buffer kTriePrunerStateLookupKey =
+      common::Buffer().put(":kagome:trie_pruner_state");
+
   inline const common::Buffer kActivePeersKey =
       common::Buffer().put(":kagome:last_active_peers");
 }  // namespace kagome::storage
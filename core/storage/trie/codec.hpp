@@ -30,11 +30,12 @@ namespace kagome::storage::trie {
 
     /**
      * @brief Decode node from bytes
-     * @param encoded_data a buffer containing encoded representation of a node
+     * @param encoded_data encoded representation of a node, which is not
+     * referred to by the decoded node
      * @return a node in the trie
      */
     virtual outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const = 0;
+        gsl::span<const uint8_t> encoded_data) const = 0;
 
     /**
      * @brief Get the merkle value of a node
@@ -5,26 +5,81 @@
 
 #include "storage/trie/impl/ephemeral_trie_batch_impl.hpp"
 
+#include "scale/encode_append.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor_impl.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
 
 namespace kagome::storage::trie {
 
   EphemeralTrieBatchImpl::EphemeralTrieBatchImpl(
-      std::shared_ptr<Codec> codec, std::shared_ptr<PolkadotTrie> trie)
-      : codec_{std::move(codec)}, trie_{std::move(trie)} {
+      std::shared_ptr<Codec> codec,
+      std::shared_ptr<PolkadotTrie> trie,
+      std::shared_ptr<FlatState> flat_state,
+      RootHash state_root)
+      : codec_{std::move(codec)},
+        trie_{std::move(trie)},
+        flat_state_{std::move(flat_state)},
+        state_root_{std::move(state_root)} {
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(trie_ != nullptr);
   }
 
   outcome::result<Buffer> EphemeralTrieBatchImpl::get(const Buffer &key) const {
+    if (flat_state_ != nullptr and not isChanged(key)) {
+      auto res = flat_state_->get(state_root_, key);
+      if (res or res.error() == TrieError::NO_VALUE) {
+        return res;
+      }
+    }
     return trie_->get(key);
   }
 
+  std::vector<outcome::result<Buffer>> EphemeralTrieBatchImpl::getMany(
+      const std::vector<Buffer> &keys) const {
+    if (flat_state_ == nullptr) {
+      return trie_->getMany(keys);
+    }
+    std::vector<outcome::result<Buffer>> values;
+    values.reserve(keys.size());
+    // the keys the flat state cannot answer for are looked up in the trie
+    std::vector<size_t> missed;
+    std::vector<Buffer> missed_keys;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (not isChanged(keys[i])) {
+        auto res = flat_state_->get(state_root_, keys[i]);
+        if (res or res.error() == TrieError::NO_VALUE) {
+          values.emplace_back(std::move(res));
+          continue;
+        }
+      }
+      values.emplace_back(TrieError::NO_VALUE);
+      missed.push_back(i);
+      missed_keys.push_back(keys[i]);
+    }
+    auto found = trie_->getMany(missed_keys);
+    for (size_t i = 0; i < missed.size(); ++i) {
+      values[missed[i]] = std::move(found[i]);
+    }
+    return values;
+  }
+
+  outcome::result<PolkadotTrie::StoredValue>
+  EphemeralTrieBatchImpl::getStoredValue(const Buffer &key,
+                                         const Buffer &known_db_key) const {
+    // the flat state knows nothing of the nodes, so the trie is used
+    return trie_->getStoredValue(key, known_db_key);
+  }
+
   std::unique_ptr<PolkadotTrieCursor> EphemeralTrieBatchImpl::trieCursor() {
     return std::make_unique<PolkadotTrieCursorImpl>(*trie_);
   }
 
   bool EphemeralTrieBatchImpl::contains(const Buffer &key) const {
+    if (flat_state_ != nullptr and not isChanged(key)) {
+      if (auto res = flat_state_->contains(state_root_, key); res) {
+        return res.value();
+      }
+    }
     return trie_->contains(key);
   }
 
@@ -34,22 +89,60 @@ namespace kagome::storage::trie {
 
   outcome::result<std::tuple<bool, uint32_t>> EphemeralTrieBatchImpl::clearPrefix(
       const Buffer &prefix, boost::optional<uint64_t> limit) {
-    return trie_->clearPrefix(prefix, limit, [](const auto &, auto &&) {
-      return outcome::success();
-    });
+    // the keys passed to the detach callback are not the full ones, so the
+    // removed keys are collected beforehand
+    std::vector<Buffer> keys;
+    if (flat_state_ != nullptr) {
+      OUTCOME_TRY(collected,
+                  PolkadotTrieCursorImpl::collectKeys(*trie_, prefix));
+      keys = std::move(collected);
+    }
+    OUTCOME_TRY(res,
+                trie_->clearPrefix(prefix, limit, [](const auto &, auto &&) {
+                  return outcome::success();
+                }));
+    // a limited removal may leave some of the keys
+    for (auto &key : keys) {
+      if (not trie_->contains(key)) {
+        onChange(key);
+      }
+    }
+    return res;
   }
 
   outcome::result<void> EphemeralTrieBatchImpl::put(const Buffer &key,
                                                     const Buffer &value) {
+    onChange(key);
     return trie_->put(key, value);
   }
 
   outcome::result<void> EphemeralTrieBatchImpl::put(const Buffer &key,
                                                     Buffer &&value) {
+    onChange(key);
     return trie_->put(key, std::move(value));
   }
 
   outcome::result<void> EphemeralTrieBatchImpl::remove(const Buffer &key) {
+    onChange(key);
     return trie_->remove(key);
   }
+
+  outcome::result<void> EphemeralTrieBatchImpl::append(const Buffer &key,
+                                                       const Buffer &item) {
+    auto value_res = get(key);
+    auto value = value_res ? std::move(value_res.value()) : Buffer{};
+    OUTCOME_TRY(scale::append_or_new_vec(value.asVector(), item));
+    return put(key, std::move(value));
+  }
+
+  bool EphemeralTrieBatchImpl::isChanged(const Buffer &key) const {
+    return changed_keys_.find(key) != changed_keys_.end();
+  }
+
+  void EphemeralTrieBatchImpl::onChange(const Buffer &key) {
+    if (flat_state_ != nullptr) {
+      changed_keys_.insert(key);
+    }
+  }
+
 }  // namespace kagome::storage::trie
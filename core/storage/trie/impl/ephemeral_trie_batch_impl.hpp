@@ -6,7 +6,10 @@
 #ifndef KAGOME_STORAGE_TRIE_IMPL_EPHEMERAL_TRIE_BATCH
 #define KAGOME_STORAGE_TRIE_IMPL_EPHEMERAL_TRIE_BATCH
 
+#include <set>
+
 #include "storage/trie/codec.hpp"
+#include "storage/trie/impl/flat_state.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 #include "storage/trie/trie_batches.hpp"
 
@@ -14,11 +17,23 @@ namespace kagome::storage::trie {
 
   class EphemeralTrieBatchImpl : public EphemeralTrieBatch {
    public:
+    /**
+     * @param flat_state optional flat snapshot of the finalized state, which
+     * is used for reads if the batch is at that state
+     * @param state_root the state \arg trie corresponds to, used only along
+     * with \arg flat_state
+     */
     EphemeralTrieBatchImpl(std::shared_ptr<Codec> codec,
-                           std::shared_ptr<PolkadotTrie> trie);
+                           std::shared_ptr<PolkadotTrie> trie,
+                           std::shared_ptr<FlatState> flat_state = nullptr,
+                           RootHash state_root = {});
     ~EphemeralTrieBatchImpl() override = default;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    std::vector<outcome::result<Buffer>> getMany(
+        const std::vector<Buffer> &keys) const override;
+    outcome::result<PolkadotTrie::StoredValue> getStoredValue(
+        const Buffer &key, const Buffer &known_db_key) const override;
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
@@ -28,10 +43,21 @@ namespace kagome::storage::trie {
     outcome::result<void> put(const Buffer &key, const Buffer &value) override;
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
+    outcome::result<void> append(const Buffer &key,
+                                 const Buffer &item) override;
 
    private:
+    // whether the value of the key in the batch may differ from the one in
+    // the flat state
+    bool isChanged(const Buffer &key) const;
+    void onChange(const Buffer &key);
+
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<PolkadotTrie> trie_;
+    std::shared_ptr<FlatState> flat_state_;
+    RootHash state_root_;
+    // keys changed in the batch, tracked only for the flat state
+    std::set<Buffer> changed_keys_;
   };
 
 }  // namespace kagome::storage::trie
@@ -0,0 +1,210 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/flat_state.hpp"
+
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
+#include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+#include "storage/predefined_keys.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, FlatState::Error, e) {
+  using E = kagome::storage::trie::FlatState::Error;
+  switch (e) {
+    case E::OUTDATED:
+      return "Flat state does not correspond to the requested state";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::storage::trie {
+
+  outcome::result<std::shared_ptr<FlatState>> FlatState::create(
+      std::shared_ptr<BufferStorage> storage,
+      common::Buffer values_prefix,
+      common::Buffer journal_prefix,
+      const RootHash &empty_root) {
+    BOOST_ASSERT(storage != nullptr);
+    RootHash root = empty_root;
+    auto root_res = storage->get(kFlatStateRootLookupKey);
+    if (root_res) {
+      OUTCOME_TRY(stored_root, RootHash::fromSpan(root_res.value()));
+      root = stored_root;
+    } else if (root_res.error() != DatabaseError::NOT_FOUND) {
+      return root_res.error();
+    }
+    // if there is no root in the database, the snapshot has never been
+    // written to, so it is empty and reflects the empty trie
+    return std::shared_ptr<FlatState>(new FlatState(std::move(storage),
+                                                    std::move(values_prefix),
+                                                    std::move(journal_prefix),
+                                                    root));
+  }
+
+  FlatState::FlatState(std::shared_ptr<BufferStorage> storage,
+                       common::Buffer values_prefix,
+                       common::Buffer journal_prefix,
+                       RootHash root)
+      : storage_{std::move(storage)},
+        values_prefix_{std::move(values_prefix)},
+        journal_prefix_{std::move(journal_prefix)},
+        root_{root},
+        logger_{log::createLogger("FlatState", "storage")} {
+    logger_->info("Initialize flat state with root: {}", root_.toHex());
+  }
+
+  RootHash FlatState::root() const {
+    std::shared_lock lock{mutex_};
+    return root_;
+  }
+
+  outcome::result<common::Buffer> FlatState::get(
+      const RootHash &state_root, const common::Buffer &key) const {
+    std::shared_lock lock{mutex_};
+    if (state_root != root_) {
+      return Error::OUTDATED;
+    }
+    auto res = storage_->get(valueKey(key));
+    if (not res and res.error() == DatabaseError::NOT_FOUND) {
+      return TrieError::NO_VALUE;
+    }
+    return res;
+  }
+
+  outcome::result<bool> FlatState::contains(const RootHash &state_root,
+                                            const common::Buffer &key) const {
+    std::shared_lock lock{mutex_};
+    if (state_root != root_) {
+      return Error::OUTDATED;
+    }
+    return storage_->contains(valueKey(key));
+  }
+
+  outcome::result<void> FlatState::onCommit(const RootHash &parent_root,
+                                            const RootHash &root,
+                                            const StateChanges &changes) {
+    if (parent_root == root) {
+      return outcome::success();
+    }
+    std::unique_lock lock{mutex_};
+    // the same root always denotes the same state, so the first path that
+    // leads to it is as good as any other
+    if (detached_ or parents_.count(root) != 0) {
+      return outcome::success();
+    }
+    // the changes on top of a state which is neither the snapshot nor
+    // journaled can never be applied, e.g. the genesis state committed again
+    // on each start after the snapshot has moved past it
+    if (parent_root != root_ and parents_.count(parent_root) == 0) {
+      if (not storage_->contains(journalKey(parent_root))) {
+        return outcome::success();
+      }
+    }
+    OUTCOME_TRY(enc, scale::encode(parent_root, changes));
+    OUTCOME_TRY(storage_->put(journalKey(root), common::Buffer{std::move(enc)}));
+    parents_.emplace(root, parent_root);
+    return outcome::success();
+  }
+
+  outcome::result<void> FlatState::finalize(const RootHash &root) {
+    std::unique_lock lock{mutex_};
+    if (detached_) {
+      return outcome::success();
+    }
+    if (root == root_) {
+      return pruneJournal();
+    }
+
+    // collect the changes from the finalized state back to the current one
+    std::vector<std::pair<RootHash, StateChanges>> path;
+    for (auto current = root; current != root_;) {
+      auto enc = storage_->get(journalKey(current));
+      if (not enc) {
+        if (enc.error() != DatabaseError::NOT_FOUND) {
+          return enc.error();
+        }
+        logger_->warn(
+            "Flat state cannot be moved from {} to {}, as the changes "
+            "between them are unknown; it will not be updated any more",
+            root_.toHex(),
+            root.toHex());
+        detached_ = true;
+        parents_.clear();
+        return outcome::success();
+      }
+      OUTCOME_TRY(entry,
+                  scale::decode<std::pair<RootHash, StateChanges>>(enc.value()));
+      path.emplace_back(current, std::move(entry.second));
+      current = entry.first;
+    }
+
+    // merge the changes, so that each key is written only once
+    std::map<common::Buffer, boost::optional<common::Buffer>> merged;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+      for (auto &[key, value] : it->second) {
+        merged[key] = std::move(value);
+      }
+    }
+
+    auto batch = storage_->batch();
+    for (auto &[key, value] : merged) {
+      if (value) {
+        OUTCOME_TRY(batch->put(valueKey(key), std::move(value.value())));
+      } else {
+        OUTCOME_TRY(batch->remove(valueKey(key)));
+      }
+    }
+    for (auto &[state_root, _] : path) {
+      OUTCOME_TRY(batch->remove(journalKey(state_root)));
+      parents_.erase(state_root);
+    }
+    OUTCOME_TRY(batch->put(kFlatStateRootLookupKey, common::Buffer{root}));
+    OUTCOME_TRY(batch->commit());
+
+    SL_DEBUG(logger_,
+             "Flat state moved to root {}, {} entries updated",
+             root.toHex(),
+             merged.size());
+    root_ = root;
+    return pruneJournal();
+  }
+
+  outcome::result<void> FlatState::pruneJournal() {
+    std::unordered_set<RootHash> descendants{root_};
+    bool found_new = true;
+    while (found_new) {
+      found_new = false;
+      for (auto &[state_root, parent_root] : parents_) {
+        if (descendants.count(parent_root) != 0
+            and descendants.insert(state_root).second) {
+          found_new = true;
+        }
+      }
+    }
+    auto batch = storage_->batch();
+    for (auto it = parents_.begin(); it != parents_.end();) {
+      if (descendants.count(it->first) == 0) {
+        OUTCOME_TRY(batch->remove(journalKey(it->first)));
+        it = parents_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return batch->commit();
+  }
+
+  common::Buffer FlatState::valueKey(const common::Buffer &key) const {
+    return common::Buffer{values_prefix_}.put(key);
+  }
+
+  common::Buffer FlatState::journalKey(const RootHash &root) const {
+    return common::Buffer{journal_prefix_}.put(root);
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_FLAT_STATE
+#define KAGOME_STORAGE_TRIE_IMPL_FLAT_STATE
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "log/logger.hpp"
+#include "outcome/outcome.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/trie/types.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Flat key-value snapshot of the last finalized state.
+   * Maps raw storage keys to their values, so that a read at the finalized
+   * state costs a single database lookup instead of a trie walk.
+   * Changes committed by persistent batches are journaled in the database and
+   * applied to the snapshot once the state they lead to is finalized.
+   * Thread-safe.
+   */
+  class FlatState {
+   public:
+    enum class Error {
+      // the snapshot does not correspond to the requested state
+      OUTDATED = 1,
+    };
+
+    /**
+     * Changes of a state made by a persistent batch, sorted by key;
+     * boost::none stands for a removed entry
+     */
+    using StateChanges =
+        std::vector<std::pair<common::Buffer, boost::optional<common::Buffer>>>;
+
+    /**
+     * @param storage the database to keep the snapshot in
+     * @param values_prefix key space of the snapshot entries
+     * @param journal_prefix key space of the journaled changes
+     * @param empty_root root of an empty trie, which is the state of the
+     * snapshot if the database has no snapshot yet
+     */
+    static outcome::result<std::shared_ptr<FlatState>> create(
+        std::shared_ptr<BufferStorage> storage,
+        common::Buffer values_prefix,
+        common::Buffer journal_prefix,
+        const RootHash &empty_root);
+
+    /**
+     * @returns root of the state that the snapshot reflects
+     */
+    RootHash root() const;
+
+    /**
+     * @returns value stored under \arg key in the state \arg state_root,
+     * TrieError::NO_VALUE if there is no such value, or Error::OUTDATED if the
+     * snapshot does not reflect the requested state
+     */
+    outcome::result<common::Buffer> get(const RootHash &state_root,
+                                        const common::Buffer &key) const;
+
+    /**
+     * @returns whether the state \arg state_root contains \arg key, or
+     * Error::OUTDATED if the snapshot does not reflect the requested state
+     */
+    outcome::result<bool> contains(const RootHash &state_root,
+                                   const common::Buffer &key) const;
+
+    /**
+     * Journals \arg changes, which turn the state \arg parent_root into the
+     * state \arg root, unless \arg parent_root is neither the state of the
+     * snapshot nor a journaled one, so that the changes could never be applied
+     */
+    outcome::result<void> onCommit(const RootHash &parent_root,
+                                   const RootHash &root,
+                                   const StateChanges &changes);
+
+    /**
+     * Moves the snapshot to the state \arg root, applying the journaled
+     * changes that lead to it, and drops the changes of the abandoned forks.
+     * If the state cannot be reached from the current one through the
+     * journal (e.g. the database was created before the snapshot was
+     * enabled), the snapshot is left as is and stops following the finalized
+     * state
+     */
+    outcome::result<void> finalize(const RootHash &root);
+
+   private:
+    FlatState(std::shared_ptr<BufferStorage> storage,
+              common::Buffer values_prefix,
+              common::Buffer journal_prefix,
+              RootHash root);
+
+    common::Buffer valueKey(const common::Buffer &key) const;
+    common::Buffer journalKey(const RootHash &root) const;
+
+    /**
+     * Removes the journaled changes which do not lead to the descendants of
+     * the current state.
+     * Only the changes committed since the start are known, so the abandoned
+     * forks committed before a restart stay in the database
+     */
+    outcome::result<void> pruneJournal();
+
+    std::shared_ptr<BufferStorage> storage_;
+    common::Buffer values_prefix_;
+    common::Buffer journal_prefix_;
+
+    mutable std::shared_mutex mutex_;
+    RootHash root_;
+    // state root -> its parent state root, for the journaled changes
+    std::unordered_map<RootHash, RootHash> parents_;
+    // set when the snapshot cannot follow the finalized state any more
+    bool detached_ = false;
+
+    log::Logger logger_;
+  };
+
+}  // namespace kagome::storage::trie
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::storage::trie, FlatState::Error);
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_FLAT_STATE
@@ -5,8 +5,10 @@
 
 #include "storage/trie/impl/persistent_trie_batch_impl.hpp"
 
+#include <algorithm>
 #include <memory>
 
+#include "scale/encode_append.hpp"
 #include "scale/scale.hpp"
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor_impl.hpp"
@@ -37,13 +39,17 @@ namespace kagome::storage::trie {
       std::shared_ptr<TrieSerializer> serializer,
       boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
       std::shared_ptr<PolkadotTrie> trie,
-      RootChangedEventHandler &&handler) {
+      RootChangedEventHandler &&handler,
+      std::shared_ptr<FlatState> flat_state,
+      RootHash state_root) {
     std::unique_ptr<PersistentTrieBatchImpl> ptr(
         new PersistentTrieBatchImpl(std::move(codec),
                                     std::move(serializer),
                                     std::move(changes),
                                     std::move(trie),
-                                    std::move(handler)));
+                                    std::move(handler),
+                                    std::move(flat_state),
+                                    std::move(state_root)));
     ptr->init();
     return ptr;
   }
@@ -53,12 +59,16 @@ namespace kagome::storage::trie {
       std::shared_ptr<TrieSerializer> serializer,
       boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
       std::shared_ptr<PolkadotTrie> trie,
-      RootChangedEventHandler &&handler)
+      RootChangedEventHandler &&handler,
+      std::shared_ptr<FlatState> flat_state,
+      RootHash state_root)
       : codec_{std::move(codec)},
         serializer_{std::move(serializer)},
         changes_{std::move(changes)},
         trie_{std::move(trie)},
-        root_changed_handler_{std::move(handler)} {
+        root_changed_handler_{std::move(handler)},
+        flat_state_{std::move(flat_state)},
+        state_root_{std::move(state_root)} {
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(serializer_ != nullptr);
     BOOST_ASSERT((changes_.has_value() && changes_.value() != nullptr)
@@ -84,7 +94,18 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<RootHash> PersistentTrieBatchImpl::commit() {
+    OUTCOME_TRY(applyAppends());
     OUTCOME_TRY(root, serializer_->storeTrie(*trie_));
+    if (flat_state_ != nullptr) {
+      FlatState::StateChanges changes;
+      changes.reserve(flat_changes_.size());
+      for (auto &[key, value] : flat_changes_) {
+        changes.emplace_back(key, std::move(value));
+      }
+      OUTCOME_TRY(flat_state_->onCommit(state_root_, root, changes));
+      flat_changes_.clear();
+      state_root_ = root;
+    }
     root_changed_handler_(root);
     if (changes_.has_value()) {
       changes_.value()->onCommit();
@@ -92,44 +113,136 @@ namespace kagome::storage::trie {
     return std::move(root);
   }
 
+  outcome::result<RootHash> PersistentTrieBatchImpl::calculateRoot() {
+    OUTCOME_TRY(applyAppends());
+    return serializer_->calculateRootHash(*trie_);
+  }
+
   std::unique_ptr<TopperTrieBatch> PersistentTrieBatchImpl::batchOnTop() {
     return std::make_unique<TopperTrieBatchImpl>(shared_from_this());
   }
 
   outcome::result<Buffer> PersistentTrieBatchImpl::get(
       const Buffer &key) const {
+    if (auto it = pending_appends_.find(key); it != pending_appends_.end()) {
+      materialize(it->second);
+      return it->second.value;
+    }
+    if (flat_state_ != nullptr and not isChanged(key)) {
+      auto res = flat_state_->get(state_root_, key);
+      if (res or res.error() == TrieError::NO_VALUE) {
+        return res;
+      }
+    }
     return trie_->get(key);
   }
 
+  std::vector<outcome::result<Buffer>> PersistentTrieBatchImpl::getMany(
+      const std::vector<Buffer> &keys) const {
+    if (std::any_of(keys.begin(), keys.end(), [this](const Buffer &key) {
+          return pending_appends_.count(key) != 0;
+        })) {
+      // the appended vectors are few, so such keys are not batched
+      std::vector<outcome::result<Buffer>> values;
+      values.reserve(keys.size());
+      for (const auto &key : keys) {
+        values.emplace_back(get(key));
+      }
+      return values;
+    }
+    if (flat_state_ == nullptr) {
+      return trie_->getMany(keys);
+    }
+    std::vector<outcome::result<Buffer>> values;
+    values.reserve(keys.size());
+    // the keys the flat state cannot answer for are looked up in the trie
+    std::vector<size_t> missed;
+    std::vector<Buffer> missed_keys;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (not isChanged(keys[i])) {
+        auto res = flat_state_->get(state_root_, keys[i]);
+        if (res or res.error() == TrieError::NO_VALUE) {
+          values.emplace_back(std::move(res));
+          continue;
+        }
+      }
+      values.emplace_back(TrieError::NO_VALUE);
+      missed.push_back(i);
+      missed_keys.push_back(keys[i]);
+    }
+    auto found = trie_->getMany(missed_keys);
+    for (size_t i = 0; i < missed.size(); ++i) {
+      values[missed[i]] = std::move(found[i]);
+    }
+    return values;
+  }
+
   std::unique_ptr<PolkadotTrieCursor> PersistentTrieBatchImpl::trieCursor() {
+    if (auto res = applyAppends(); not res) {
+      logger_->error("Could not write the appended values: {}",
+                     res.error().message());
+    }
     return std::make_unique<PolkadotTrieCursorImpl>(*trie_);
   }
 
   bool PersistentTrieBatchImpl::contains(const Buffer &key) const {
+    if (pending_appends_.count(key) != 0) {
+      return true;
+    }
+    if (flat_state_ != nullptr and not isChanged(key)) {
+      if (auto res = flat_state_->contains(state_root_, key); res) {
+        return res.value();
+      }
+    }
     return trie_->contains(key);
   }
 
   bool PersistentTrieBatchImpl::empty() const {
-    return trie_->empty();
+    return pending_appends_.empty() and trie_->empty();
   }
 
   outcome::result<std::tuple<bool, uint32_t>>
   PersistentTrieBatchImpl::clearPrefix(const Buffer &prefix,
                                        boost::optional<uint64_t> limit) {
+    OUTCOME_TRY(applyAppends());
     if (changes_.has_value()) changes_.value()->onClearPrefix(prefix);
-    return trie_->clearPrefix(
-        prefix, limit, [&](const auto &key, auto &&) -> outcome::result<void> {
-          if (changes_.has_value()) {
-            OUTCOME_TRY(changes_.value()->onRemove(key));
-          }
-          return outcome::success();
-        });
+    // the keys passed to the detach callback are not the full ones, so the
+    // removed keys are collected beforehand
+    std::vector<Buffer> keys;
+    if (flat_state_ != nullptr) {
+      OUTCOME_TRY(collected,
+                  PolkadotTrieCursorImpl::collectKeys(*trie_, prefix));
+      keys = std::move(collected);
+    }
+    OUTCOME_TRY(res,
+                trie_->clearPrefix(
+                    prefix,
+                    limit,
+                    [&](const auto &key, auto &&) -> outcome::result<void> {
+                      if (changes_.has_value()) {
+                        OUTCOME_TRY(changes_.value()->onRemove(key));
+                      }
+                      return outcome::success();
+                    }));
+    // a limited removal may leave some of the keys
+    for (auto &key : keys) {
+      if (not trie_->contains(key)) {
+        onChange(key, boost::none);
+      }
+    }
+    return res;
   }
 
   outcome::result<void> PersistentTrieBatchImpl::put(const Buffer &key,
                                                      const Buffer &value) {
+    // the appends are reported to the changes tracker before the extrinsic
+    // index changes
+    OUTCOME_TRY(key == EXTRINSIC_INDEX_KEY ? applyAppends() : applyAppend(key));
     bool is_new_entry = not trie_->contains(key);
     auto res = trie_->put(key, value);
+    if (res) {
+      onChange(key, value);
+    }
     if (res and changes_.has_value()) {
       OUTCOME_TRY(changes_.value()->onPut(key, value, is_new_entry));
     }
@@ -143,11 +256,94 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<void> PersistentTrieBatchImpl::remove(const Buffer &key) {
+    OUTCOME_TRY(key == EXTRINSIC_INDEX_KEY ? applyAppends() : applyAppend(key));
     auto res = trie_->remove(key);
+    if (res) {
+      onChange(key, boost::none);
+    }
     if (res and changes_.has_value()) {
       OUTCOME_TRY(changes_.value()->onRemove(key));
     }
     return res;
   }
 
+  outcome::result<void> PersistentTrieBatchImpl::append(const Buffer &key,
+                                                        const Buffer &item) {
+    auto it = pending_appends_.find(key);
+    if (it == pending_appends_.end()) {
+      PendingAppend append;
+      auto value_res = get(key);
+      if (value_res) {
+        append.value = std::move(value_res.value());
+        // the value is checked to be an encoded vector once, on the first
+        // append
+        if (not append.value.empty()) {
+          OUTCOME_TRY(scale::decode<scale::CompactInteger>(append.value));
+        }
+      } else if (value_res.error() == TrieError::NO_VALUE) {
+        append.is_new_entry = true;
+      } else {
+        return value_res.as_failure();
+      }
+      it = pending_appends_.emplace(key, std::move(append)).first;
+    }
+    it->second.items.push_back(item);
+    ++it->second.appends_num;
+    return outcome::success();
+  }
+
+  void PersistentTrieBatchImpl::materialize(PendingAppend &append) {
+    if (append.items.empty()) {
+      return;
+    }
+    std::vector<gsl::span<const uint8_t>> items(append.items.begin(),
+                                                append.items.end());
+    // the value is checked to be an encoded vector on the first append
+    [[maybe_unused]] auto res =
+        scale::append_or_new_vec(append.value.asVector(), items);
+    BOOST_ASSERT(res);
+    append.items.clear();
+  }
+
+  outcome::result<void> PersistentTrieBatchImpl::applyAppend(
+      const Buffer &key) {
+    auto it = pending_appends_.find(key);
+    if (it == pending_appends_.end()) {
+      return outcome::success();
+    }
+    auto &append = it->second;
+    materialize(append);
+    OUTCOME_TRY(trie_->put(key, append.value));
+    onChange(key, append.value);
+    if (changes_.has_value()) {
+      // every append is reported as a put of the vector
+      for (size_t i = 0; i < append.appends_num; ++i) {
+        OUTCOME_TRY(
+            changes_.value()->onPut(key, append.value, append.is_new_entry));
+      }
+    }
+    pending_appends_.erase(it);
+    return outcome::success();
+  }
+
+  outcome::result<void> PersistentTrieBatchImpl::applyAppends() {
+    while (not pending_appends_.empty()) {
+      // the key is copied, as the entry is erased once written
+      auto key = pending_appends_.begin()->first;
+      OUTCOME_TRY(applyAppend(key));
+    }
+    return outcome::success();
+  }
+
+  bool PersistentTrieBatchImpl::isChanged(const Buffer &key) const {
+    return flat_changes_.find(key) != flat_changes_.end();
+  }
+
+  void PersistentTrieBatchImpl::onChange(const Buffer &key,
+                                         boost::optional<Buffer> value) {
+    if (flat_state_ != nullptr) {
+      flat_changes_[key] = std::move(value);
+    }
+  }
+
 }  // namespace kagome::storage::trie
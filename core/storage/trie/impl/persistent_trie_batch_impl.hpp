@@ -6,12 +6,15 @@
 #ifndef KAGOME_STORAGE_TRIE_IMPL_PERSISTENT_TRIE_BATCH
 #define KAGOME_STORAGE_TRIE_IMPL_PERSISTENT_TRIE_BATCH
 
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "log/logger.hpp"
 #include "primitives/event_types.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 #include "storage/trie/codec.hpp"
+#include "storage/trie/impl/flat_state.hpp"
 #include "storage/trie/serialization/trie_serializer.hpp"
 #include "storage/trie/trie_batches.hpp"
 
@@ -24,18 +27,30 @@ namespace kagome::storage::trie {
       NO_TRIE = 1,
     };
 
+    /**
+     * @param flat_state optional flat snapshot of the finalized state, which
+     * is used for reads if the batch is at that state, and which is notified
+     * of the changes on commit
+     * @param state_root the state \arg trie corresponds to, used only along
+     * with \arg flat_state
+     */
     static std::unique_ptr<PersistentTrieBatchImpl> create(
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
         boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
         std::shared_ptr<PolkadotTrie> trie,
-        RootChangedEventHandler &&handler);
+        RootChangedEventHandler &&handler,
+        std::shared_ptr<FlatState> flat_state = nullptr,
+        RootHash state_root = {});
     ~PersistentTrieBatchImpl() override = default;
 
     outcome::result<RootHash> commit() override;
+    outcome::result<RootHash> calculateRoot() override;
     std::unique_ptr<TopperTrieBatch> batchOnTop() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    std::vector<outcome::result<Buffer>> getMany(
+        const std::vector<Buffer> &keys) const override;
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
@@ -46,21 +61,66 @@ namespace kagome::storage::trie {
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
 
+    /**
+     * The vector is read from the trie only on the first append, the appended
+     * items are put into it when it is read, and it is written to the trie
+     * when the key is changed otherwise, the extrinsic index changes, or the
+     * batch is committed
+     */
+    outcome::result<void> append(const Buffer &key,
+                                 const Buffer &item) override;
+
    private:
+    // a vector appended to in the batch and not yet written to the trie
+    struct PendingAppend {
+      // the vector with the items appended so far except the ones in items
+      Buffer value;
+      std::vector<Buffer> items;
+      // number of appends, each one is reported to the changes tracker
+      size_t appends_num = 0;
+      bool is_new_entry = false;
+    };
+    using PendingAppends = std::unordered_map<Buffer, PendingAppend>;
+
     PersistentTrieBatchImpl(
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
         boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
         std::shared_ptr<PolkadotTrie> trie,
-        RootChangedEventHandler &&handler);
+        RootChangedEventHandler &&handler,
+        std::shared_ptr<FlatState> flat_state,
+        RootHash state_root);
 
     void init();
 
+    // whether the value of the key in the batch may differ from the one in
+    // the flat state
+    bool isChanged(const Buffer &key) const;
+    void onChange(const Buffer &key, boost::optional<Buffer> value);
+
+    /**
+     * Puts the items appended to \arg append into its value
+     */
+    static void materialize(PendingAppend &append);
+
+    /**
+     * Writes the vector appended to under \arg key to the trie, if any
+     */
+    outcome::result<void> applyAppend(const Buffer &key);
+    outcome::result<void> applyAppends();
+
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieSerializer> serializer_;
     boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes_;
     std::shared_ptr<PolkadotTrie> trie_;
     RootChangedEventHandler root_changed_handler_;
+    std::shared_ptr<FlatState> flat_state_;
+    // the last committed state of the batch
+    RootHash state_root_;
+    // changes made since the last commit, tracked only for the flat state
+    std::map<Buffer, boost::optional<Buffer>> flat_changes_;
+    // materialized on read
+    mutable PendingAppends pending_appends_;
 
     log::Logger logger_ =
         log::createLogger("PersistentTrieBatch", "changes_trie");
@@ -0,0 +1,227 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/storage_overlay.hpp"
+
+#include <algorithm>
+
+#include "scale/encode_append.hpp"
+#include "storage/trie/trie_batches.hpp"
+
+namespace kagome::storage::trie {
+
+  const boost::optional<common::Buffer> *StorageOverlay::find(
+      const Buffer &key) const {
+    static const boost::optional<Buffer> kRemoved{};
+
+    auto cleared = clearedAt(key);
+    if (auto it = changes_.find(key); it != changes_.end()) {
+      if (not cleared or it->second.seq > *cleared) {
+        materialize(it->second);
+        return &it->second.value;
+      }
+    }
+    return cleared ? &kRemoved : nullptr;
+  }
+
+  bool StorageOverlay::hasValues() const {
+    return std::any_of(changes_.begin(), changes_.end(), [this](auto &p) {
+      auto cleared = clearedAt(p.first);
+      return (p.second.value.has_value() or not p.second.appended.empty())
+             and (not cleared or p.second.seq > *cleared);
+    });
+  }
+
+  void StorageOverlay::put(const Buffer &key, Buffer &&value) {
+    set(key, std::move(value));
+  }
+
+  void StorageOverlay::remove(const Buffer &key) {
+    set(key, boost::none);
+  }
+
+  void StorageOverlay::set(const Buffer &key,
+                           boost::optional<Buffer> &&value) {
+    auto seq = next_seq_++;
+    auto [it, is_new] = changes_.try_emplace(key, Entry{boost::none, {}, seq});
+    auto &entry = it->second;
+    if (is_new) {
+      if (needsJournal(boost::none)) {
+        journal_.emplace_back(KeyRecord{key, boost::none});
+      }
+    } else if (needsJournal(entry.seq)) {
+      journal_.emplace_back(KeyRecord{key, std::move(entry)});
+    }
+    entry.value = std::move(value);
+    entry.appended.clear();
+    entry.seq = seq;
+  }
+
+  outcome::result<void> StorageOverlay::append(
+      const Buffer &key,
+      const Buffer &item,
+      const std::function<outcome::result<boost::optional<Buffer>>()> &base) {
+    auto cleared = clearedAt(key);
+    auto it = changes_.find(key);
+    if (it == changes_.end() or (cleared and it->second.seq < *cleared)) {
+      // the vector is started from the value below the overlay
+      boost::optional<Buffer> value;
+      if (not cleared) {
+        OUTCOME_TRY(base_value, base());
+        value = std::move(base_value);
+      }
+      if (value and not value->empty()) {
+        OUTCOME_TRY(scale::decode<scale::CompactInteger>(*value));
+      }
+      set(key, std::move(value));
+      it = changes_.find(key);
+    } else {
+      auto &entry = it->second;
+      if (entry.value and not entry.value->empty() and entry.appended.empty()) {
+        OUTCOME_TRY(scale::decode<scale::CompactInteger>(*entry.value));
+      }
+      if (needsJournal(entry.seq)) {
+        journal_.emplace_back(KeyRecord{key, entry});
+      }
+      entry.seq = next_seq_++;
+    }
+    it->second.appended.push_back(item);
+    return outcome::success();
+  }
+
+  void StorageOverlay::materialize(Entry &entry) {
+    if (entry.appended.empty()) {
+      return;
+    }
+    std::vector<gsl::span<const uint8_t>> items(entry.appended.begin(),
+                                                entry.appended.end());
+    std::vector<uint8_t> vec;
+    if (entry.value) {
+      vec = std::move(entry.value->asVector());
+    }
+    // the value is checked to be an encoded vector on the first append
+    [[maybe_unused]] auto res = scale::append_or_new_vec(vec, items);
+    BOOST_ASSERT(res);
+    entry.value = Buffer{std::move(vec)};
+    entry.appended.clear();
+  }
+
+  void StorageOverlay::clearPrefix(const Buffer &prefix) {
+    auto seq = next_seq_++;
+    auto [it, is_new] = cleared_prefixes_.try_emplace(prefix, seq);
+    if (is_new) {
+      ++cleared_prefix_lengths_[prefix.size()];
+    }
+    if (is_new) {
+      if (needsJournal(boost::none)) {
+        journal_.emplace_back(PrefixRecord{prefix, boost::none});
+      }
+    } else if (needsJournal(it->second)) {
+      journal_.emplace_back(PrefixRecord{prefix, it->second});
+    }
+    it->second = seq;
+  }
+
+  boost::optional<uint64_t> StorageOverlay::clearedAt(
+      const Buffer &key) const {
+    boost::optional<uint64_t> cleared;
+    for (auto &[length, _] : cleared_prefix_lengths_) {
+      if (length > key.size()) {
+        break;
+      }
+      auto it = cleared_prefixes_.find(key.subbuffer(0, length));
+      if (it != cleared_prefixes_.end()
+          and (not cleared or it->second > *cleared)) {
+        cleared = it->second;
+      }
+    }
+    return cleared;
+  }
+
+  void StorageOverlay::eraseClearedPrefix(const Buffer &prefix) {
+    cleared_prefixes_.erase(prefix);
+    auto it = cleared_prefix_lengths_.find(prefix.size());
+    BOOST_ASSERT(it != cleared_prefix_lengths_.end());
+    if (--it->second == 0) {
+      cleared_prefix_lengths_.erase(it);
+    }
+  }
+
+  void StorageOverlay::startTransaction() {
+    transactions_.push_back(Transaction{journal_.size(), next_seq_});
+  }
+
+  void StorageOverlay::rollbackTransaction() {
+    BOOST_ASSERT(not transactions_.empty());
+    auto journal_size = transactions_.back().journal_size;
+    transactions_.pop_back();
+
+    struct Undo : boost::static_visitor<> {
+      StorageOverlay &self;
+      explicit Undo(StorageOverlay &self) : self{self} {}
+
+      void operator()(KeyRecord &record) const {
+        if (record.previous) {
+          self.changes_[record.key] = std::move(*record.previous);
+        } else {
+          self.changes_.erase(record.key);
+        }
+      }
+      void operator()(PrefixRecord &record) const {
+        if (record.previous) {
+          self.cleared_prefixes_[record.prefix] = *record.previous;
+        } else {
+          self.eraseClearedPrefix(record.prefix);
+        }
+      }
+    } undo{*this};
+
+    // the records are undone in reverse, so a key gets its earliest state
+    while (journal_.size() > journal_size) {
+      boost::apply_visitor(undo, journal_.back());
+      journal_.pop_back();
+    }
+  }
+
+  void StorageOverlay::commitTransaction() {
+    BOOST_ASSERT(not transactions_.empty());
+    transactions_.pop_back();
+    // the enclosing transaction keeps the records, as its rollback has to
+    // undo the committed changes too
+    if (transactions_.empty()) {
+      journal_.clear();
+    }
+  }
+
+  outcome::result<void> StorageOverlay::applyTo(TrieBatch &batch) const {
+    for (auto &[prefix, _] : cleared_prefixes_) {
+      OUTCOME_TRY(batch.clearPrefix(prefix));
+    }
+
+    // sorted keys are applied to neighbouring trie nodes in a row
+    std::vector<std::pair<const Buffer *, Entry *>> sorted;
+    sorted.reserve(changes_.size());
+    for (auto &[key, entry] : changes_) {
+      auto cleared = clearedAt(key);
+      if (not cleared or entry.seq > *cleared) {
+        sorted.emplace_back(&key, &entry);
+      }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](auto &lhs, auto &rhs) {
+      return *lhs.first < *rhs.first;
+    });
+
+    for (auto &[key, entry] : sorted) {
+      materialize(*entry);
+      if (entry->value.has_value()) {
+        OUTCOME_TRY(batch.put(*key, entry->value.value()));
+      } else {
+        OUTCOME_TRY(batch.remove(*key));
+      }
+    }
+    return outcome::success();
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,162 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_STORAGE_OVERLAY
+#define KAGOME_STORAGE_TRIE_IMPL_STORAGE_OVERLAY
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::storage::trie {
+
+  class TrieBatch;
+
+  /**
+   * Set of storage changes made on top of a trie batch.
+   * Changed keys are kept in a hash map, cleared prefixes are indexed by their
+   * lengths, so that a lookup costs a hash lookup per distinct length of the
+   * cleared prefixes. Every change is ordered by a sequence number, which
+   * tells whether a value was put before or after its prefix was cleared.
+   * Appended items of a SCALE encoded vector are kept apart from the vector
+   * until it is read or applied, so that appending does not copy it.
+   * Nested transactions are layers of a single undo journal: starting and
+   * committing one takes constant time, rolling one back takes the time
+   * proportional to the number of changes made in it.
+   * The journal is kept only while there is a started transaction.
+   */
+  class StorageOverlay {
+   public:
+    using Buffer = common::Buffer;
+
+    /**
+     * @returns the changed value of \arg key, boost::none if the key is
+     * removed, or nullptr if the key is not changed in the overlay; the
+     * pointer is valid until the next change
+     */
+    const boost::optional<Buffer> *find(const Buffer &key) const;
+
+    /**
+     * @returns whether the overlay has at least one put value
+     */
+    bool hasValues() const;
+
+    void put(const Buffer &key, Buffer &&value);
+    void remove(const Buffer &key);
+    void clearPrefix(const Buffer &prefix);
+
+    /**
+     * Appends \arg item to the SCALE encoded vector under \arg key, as
+     * scale::append_or_new_vec() does
+     * @param base provides the value of the key below the overlay, none if
+     * there is no value, it is called only if the key is not changed in the
+     * overlay
+     * @return error if the value the item is appended to is not an encoded
+     * vector, or the error of \arg base
+     */
+    outcome::result<void> append(
+        const Buffer &key,
+        const Buffer &item,
+        const std::function<outcome::result<boost::optional<Buffer>>()> &base);
+
+    /**
+     * Starts a nested transaction: the changes made after it may be rolled
+     * back, or committed to the enclosing transaction
+     */
+    void startTransaction();
+
+    /**
+     * Discards the changes made since the last started transaction
+     */
+    void rollbackTransaction();
+
+    /**
+     * Keeps the changes made since the last started transaction as a part of
+     * the enclosing one
+     */
+    void commitTransaction();
+
+    size_t transactionsNum() const {
+      return transactions_.size();
+    }
+
+    /**
+     * Writes all the changes to \arg batch: clears the prefixes first, then
+     * puts and removes the keys in their sorted order
+     */
+    outcome::result<void> applyTo(TrieBatch &batch) const;
+
+   private:
+    struct Entry {
+      boost::optional<Buffer> value;
+      // items appended to the vector in the value, none value is for a new
+      // vector
+      std::vector<Buffer> appended;
+      uint64_t seq;
+    };
+
+    // previous state of a changed key, none if the key was not changed
+    struct KeyRecord {
+      Buffer key;
+      boost::optional<Entry> previous;
+    };
+
+    // previous state of a cleared prefix, none if it was not cleared
+    struct PrefixRecord {
+      Buffer prefix;
+      boost::optional<uint64_t> previous;
+    };
+
+    struct Transaction {
+      // journal size at the start of the transaction
+      size_t journal_size;
+      // changes with not less sequence number are made in the transaction
+      uint64_t first_seq;
+    };
+
+    void set(const Buffer &key, boost::optional<Buffer> &&value);
+
+    /**
+     * Puts the items appended to the entry into its value
+     */
+    static void materialize(Entry &entry);
+
+    /**
+     * @returns sequence number of the latest clearing of a prefix of \arg key,
+     * if any
+     */
+    boost::optional<uint64_t> clearedAt(const Buffer &key) const;
+
+    // whether the state changed last at sequence number \arg seq (none if
+    // never) must be journaled to be restored on rollback, i.e. the state is
+    // not yet changed in the current transaction
+    bool needsJournal(boost::optional<uint64_t> seq) const {
+      return not transactions_.empty()
+             and (not seq or *seq < transactions_.back().first_seq);
+    }
+
+    void eraseClearedPrefix(const Buffer &prefix);
+
+    // entries are materialized on read
+    mutable std::unordered_map<Buffer, Entry> changes_;
+    std::unordered_map<Buffer, uint64_t> cleared_prefixes_;
+    // number of the cleared prefixes of every length
+    std::map<size_t, size_t> cleared_prefix_lengths_;
+    uint64_t next_seq_ = 0;
+
+    std::vector<boost::variant<KeyRecord, PrefixRecord>> journal_;
+    std::vector<Transaction> transactions_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_STORAGE_OVERLAY
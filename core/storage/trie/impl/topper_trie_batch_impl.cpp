@@ -27,21 +27,50 @@ namespace kagome::storage::trie {
       : parent_(parent) {}
 
   outcome::result<Buffer> TopperTrieBatchImpl::get(const Buffer &key) const {
-    if (auto it = cache_.find(key); it != cache_.end()) {
-      if (it->second.has_value()) {
-        return it->second.value();
+    if (auto change = overlay_.find(key); change != nullptr) {
+      if (change->has_value()) {
+        return change->value();
       }
       return TrieError::NO_VALUE;
     }
-    if (wasClearedByPrefix(key)) {
-      return TrieError::NO_VALUE;
-    }
     if (auto p = parent_.lock(); p != nullptr) {
       return p->get(key);
     }
     return Error::PARENT_EXPIRED;
   }
 
+  std::vector<outcome::result<Buffer>> TopperTrieBatchImpl::getMany(
+      const std::vector<Buffer> &keys) const {
+    std::vector<outcome::result<Buffer>> values;
+    values.reserve(keys.size());
+    // the keys not changed in this batch are looked up in the parent at once
+    std::vector<size_t> missed;
+    std::vector<Buffer> missed_keys;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (auto change = overlay_.find(keys[i]); change != nullptr) {
+        if (change->has_value()) {
+          values.emplace_back(change->value());
+        } else {
+          values.emplace_back(TrieError::NO_VALUE);
+        }
+      } else {
+        values.emplace_back(Error::PARENT_EXPIRED);
+        missed.push_back(i);
+        missed_keys.push_back(keys[i]);
+      }
+    }
+    if (missed.empty()) {
+      return values;
+    }
+    if (auto p = parent_.lock(); p != nullptr) {
+      auto found = p->getMany(missed_keys);
+      for (size_t i = 0; i < missed.size(); ++i) {
+        values[missed[i]] = std::move(found[i]);
+      }
+    }
+    return values;
+  }
+
   std::unique_ptr<PolkadotTrieCursor> TopperTrieBatchImpl::trieCursor() {
     if (auto p = parent_.lock(); p != nullptr) {
       return p->trieCursor();
@@ -50,11 +79,8 @@ namespace kagome::storage::trie {
   }
 
   bool TopperTrieBatchImpl::contains(const Buffer &key) const {
-    if (auto it = cache_.find(key); it != cache_.end()) {
-      return it->second.has_value();
-    }
-    if (wasClearedByPrefix(key)) {
-      return false;
+    if (auto change = overlay_.find(key); change != nullptr) {
+      return change->has_value();
     }
     if (auto p = parent_.lock(); p != nullptr) {
       return p->contains(key);
@@ -63,10 +89,7 @@ namespace kagome::storage::trie {
   }
 
   bool TopperTrieBatchImpl::empty() const {
-    if (not cache_.empty()
-        and std::any_of(cache_.begin(), cache_.end(), [](auto &p) {
-              return p.second.has_value();
-            })) {
+    if (overlay_.hasValues()) {
       return false;
     }
     // TODO(Harrm) PRE-462 consider clearPrefix here. Not an easy thing and is
@@ -84,23 +107,18 @@ namespace kagome::storage::trie {
 
   outcome::result<void> TopperTrieBatchImpl::put(const Buffer &key,
                                                  Buffer &&value) {
-    cache_[key] = std::move(value);
+    overlay_.put(key, std::move(value));
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::remove(const Buffer &key) {
-    cache_[key] = boost::none;
+    overlay_.remove(key);
     return outcome::success();
   }
 
   outcome::result<std::tuple<bool, uint32_t>> TopperTrieBatchImpl::clearPrefix(
       const Buffer &prefix, boost::optional<uint64_t>) {
-    for (auto it = cache_.lower_bound(prefix);
-         it != cache_.end() && it->first.subbuffer(0, prefix.size()) == prefix;
-         ++it)
-      it->second = boost::none;
-
-    cleared_prefixes_.push_back(prefix);
+    overlay_.clearPrefix(prefix);
     if (parent_.lock() != nullptr) {
       return outcome::success(std::make_tuple(true, 0ULL));
     }
@@ -109,29 +127,41 @@ namespace kagome::storage::trie {
 
   outcome::result<void> TopperTrieBatchImpl::writeBack() {
     if (auto p = parent_.lock()) {
-      for (const auto &prefix : cleared_prefixes_) {
-        OUTCOME_TRY(p->clearPrefix(prefix));
-      }
-      for (auto it = cache_.begin(); it != cache_.end(); it++) {
-        if (it->second.has_value()) {
-          OUTCOME_TRY(p->put(it->first, it->second.value()));
-        } else {
-          OUTCOME_TRY(p->remove(it->first));
-        }
-      }
-      return outcome::success();
+      return overlay_.applyTo(*p);
     }
     return Error::PARENT_EXPIRED;
   }
 
-  bool TopperTrieBatchImpl::wasClearedByPrefix(const Buffer &key) const {
-    for (const auto &prefix : cleared_prefixes_) {
-      auto key_end = key.begin();
-      std::advance(key_end, std::min(key.size(), prefix.size()) - 1);
-      auto is_cleared = std::equal(key.begin(), key_end, prefix.begin());
-      if (is_cleared) return true;
+  outcome::result<void> TopperTrieBatchImpl::append(const Buffer &key,
+                                                    const Buffer &item) {
+    auto p = parent_.lock();
+    if (p == nullptr) {
+      return Error::PARENT_EXPIRED;
     }
-    return false;
+    return overlay_.append(
+        key, item, [&]() -> outcome::result<boost::optional<Buffer>> {
+          auto res = p->get(key);
+          if (res) {
+            return boost::make_optional(std::move(res.value()));
+          }
+          // only a missing value starts a new vector, a failed read must not
+          if (res.error() == TrieError::NO_VALUE) {
+            return boost::optional<Buffer>{};
+          }
+          return res.as_failure();
+        });
+  }
+
+  void TopperTrieBatchImpl::startTransaction() {
+    overlay_.startTransaction();
+  }
+
+  void TopperTrieBatchImpl::rollbackTransaction() {
+    overlay_.rollbackTransaction();
+  }
+
+  void TopperTrieBatchImpl::commitTransaction() {
+    overlay_.commitTransaction();
   }
 
 }  // namespace kagome::storage::trie
@@ -8,9 +8,8 @@
 
 #include "storage/trie/trie_batches.hpp"
 
-#include <deque>
-
 #include "outcome/outcome.hpp"
+#include "storage/trie/impl/storage_overlay.hpp"
 
 namespace kagome::storage::trie {
   class PolkadotTrieCursor;
@@ -25,6 +24,8 @@ namespace kagome::storage::trie {
     explicit TopperTrieBatchImpl(const std::shared_ptr<TrieBatch> &parent);
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    std::vector<outcome::result<Buffer>> getMany(
+        const std::vector<Buffer> &keys) const override;
 
     /**
      * Won't consider changes not written back to the parent batch
@@ -41,11 +42,19 @@ namespace kagome::storage::trie {
 
     outcome::result<void> writeBack() override;
 
-   private:
-    bool wasClearedByPrefix(const Buffer &key) const;
+    /**
+     * The vector is read from the parent batch only on the first append, the
+     * appended items are put into it only when it is read or written back
+     */
+    outcome::result<void> append(const Buffer &key,
+                                 const Buffer &item) override;
+
+    void startTransaction() override;
+    void rollbackTransaction() override;
+    void commitTransaction() override;
 
-    std::map<Buffer, boost::optional<Buffer>> cache_;
-    std::deque<Buffer> cleared_prefixes_;
+   private:
+    StorageOverlay overlay_;
     std::weak_ptr<TrieBatch> parent_;
   };
 
@@ -0,0 +1,308 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner.hpp"
+
+#include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+#include "storage/predefined_keys.hpp"
+#include "storage/trie/codec.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  outcome::result<std::shared_ptr<TriePruner>> TriePruner::create(
+      std::shared_ptr<BufferStorage> storage,
+      std::shared_ptr<TrieStorageBackend> node_storage,
+      std::shared_ptr<Codec> codec,
+      common::Buffer node_refs_prefix,
+      common::Buffer state_refs_prefix,
+      uint32_t states_to_keep) {
+    BOOST_ASSERT(storage != nullptr);
+    std::deque<RootHash> finalized_states;
+    auto state_res = storage->get(kTriePrunerStateLookupKey);
+    if (state_res) {
+      OUTCOME_TRY(states,
+                  scale::decode<std::vector<RootHash>>(state_res.value()));
+      finalized_states.assign(states.begin(), states.end());
+    } else if (state_res.error() != DatabaseError::NOT_FOUND) {
+      return state_res.error();
+    } else {
+      // mark the database as the one whose nodes are counted from the start
+      OUTCOME_TRY(enc, scale::encode(std::vector<RootHash>{}));
+      OUTCOME_TRY(storage->put(kTriePrunerStateLookupKey,
+                               common::Buffer{std::move(enc)}));
+    }
+    return std::shared_ptr<TriePruner>(
+        new TriePruner(std::move(storage),
+                       std::move(node_storage),
+                       std::move(codec),
+                       std::move(node_refs_prefix),
+                       std::move(state_refs_prefix),
+                       states_to_keep,
+                       std::move(finalized_states)));
+  }
+
+  TriePruner::TriePruner(std::shared_ptr<BufferStorage> storage,
+                         std::shared_ptr<TrieStorageBackend> node_storage,
+                         std::shared_ptr<Codec> codec,
+                         common::Buffer node_refs_prefix,
+                         common::Buffer state_refs_prefix,
+                         uint32_t states_to_keep,
+                         std::deque<RootHash> finalized_states)
+      : storage_{std::move(storage)},
+        node_storage_{std::move(node_storage)},
+        codec_{std::move(codec)},
+        node_refs_prefix_{std::move(node_refs_prefix)},
+        state_refs_prefix_{std::move(state_refs_prefix)},
+        states_to_keep_{states_to_keep},
+        finalized_states_{std::move(finalized_states)},
+        logger_{log::createLogger("TriePruner", "storage")} {
+    BOOST_ASSERT(node_storage_ != nullptr);
+    BOOST_ASSERT(codec_ != nullptr);
+    logger_->info("State pruning is on, {} finalized states are kept",
+                  states_to_keep_);
+  }
+
+  outcome::result<void> TriePruner::onNodesStored(
+      const std::vector<StoredNode> &nodes, BufferBatch &node_batch) {
+    std::lock_guard lock{mutex_};
+    Changes changes;
+    for (auto &node : nodes) {
+      OUTCOME_TRY(refs, nodeRefs(changes, node.key));
+      // the children of a node which is already stored are counted already
+      if (refs.has_value()) {
+        continue;
+      }
+      changes.node_refs.emplace(node.key, 0);
+      // a node stored again must survive the pending removal of its old copy
+      removed_nodes_.erase(node.key);
+      for (auto &child : node.children) {
+        OUTCOME_TRY(child_refs, nodeRefs(changes, child));
+        changes.node_refs[child] = child_refs.value_or(0) + 1;
+      }
+    }
+    // counters are written first, so that a failure in between may only
+    // leave some nodes in the database forever, but never removes a live one
+    auto batch = storage_->batch();
+    OUTCOME_TRY(writeChanges(changes, *batch));
+    OUTCOME_TRY(batch->commit());
+    OUTCOME_TRY(node_batch.commit());
+    if (not nodes.empty()) {
+      auto root = RootHash::fromSpan(nodes.back().key);
+      if (root) {
+        old_roots_.erase(root.value());
+        new_roots_.insert(root.value());
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePruner::addState(const RootHash &root) {
+    std::lock_guard lock{mutex_};
+    Changes changes;
+    OUTCOME_TRY(state_refs, stateRefs(changes, root));
+    OUTCOME_TRY(node_refs, nodeRefs(changes, common::Buffer{root}));
+    if (not node_refs.has_value()) {
+      // the state was written before pruning was enabled and is never removed
+      return outcome::success();
+    }
+    changes.state_refs[common::Buffer{root}] = state_refs + 1;
+    changes.node_refs[common::Buffer{root}] = node_refs.value() + 1;
+    auto batch = storage_->batch();
+    OUTCOME_TRY(writeChanges(changes, *batch));
+    return batch->commit();
+  }
+
+  outcome::result<bool> TriePruner::hasState(const RootHash &root) const {
+    std::lock_guard lock{mutex_};
+    Changes changes;
+    OUTCOME_TRY(state_refs, stateRefs(changes, root));
+    return state_refs > 0;
+  }
+
+  outcome::result<void> TriePruner::onFinalized(
+      const std::vector<RootHash> &finalized,
+      const std::vector<RootHash> &discarded) {
+    std::lock_guard lock{mutex_};
+    pending_finalized_.insert(
+        pending_finalized_.end(), finalized.begin(), finalized.end());
+    pending_discarded_.insert(
+        pending_discarded_.end(), discarded.begin(), discarded.end());
+
+    // the in-memory state is only updated once the counters are written, so
+    // that a failed call is simply repeated by the next one
+    Changes changes;
+    for (auto &root : pending_discarded_) {
+      OUTCOME_TRY(releaseState(changes, root));
+    }
+    auto finalized_states = finalized_states_;
+    finalized_states.insert(finalized_states.end(),
+                            pending_finalized_.begin(),
+                            pending_finalized_.end());
+    while (finalized_states.size() > states_to_keep_) {
+      OUTCOME_TRY(releaseState(changes, finalized_states.front()));
+      finalized_states.pop_front();
+    }
+
+    // intermediate states are not referenced by any block; a root is given
+    // the time until the next finalization to become a block state
+    for (auto &root : old_roots_) {
+      OUTCOME_TRY(refs, nodeRefs(changes, common::Buffer{root}));
+      if (refs.has_value() and refs.value() == 0) {
+        OUTCOME_TRY(releaseNode(changes, common::Buffer{root}));
+      }
+    }
+
+    auto batch = storage_->batch();
+    OUTCOME_TRY(writeChanges(changes, *batch));
+    OUTCOME_TRY(enc,
+                scale::encode(std::vector<RootHash>{finalized_states.begin(),
+                                                    finalized_states.end()}));
+    OUTCOME_TRY(
+        batch->put(kTriePrunerStateLookupKey, common::Buffer{std::move(enc)}));
+    OUTCOME_TRY(batch->commit());
+
+    finalized_states_ = std::move(finalized_states);
+    pending_finalized_.clear();
+    pending_discarded_.clear();
+    old_roots_ = std::move(new_roots_);
+    new_roots_.clear();
+    removed_nodes_.insert(changes.removed.begin(), changes.removed.end());
+
+    // nodes are removed after their counters for the same reason as they are
+    // written after them
+    auto removed = removed_nodes_.size();
+    OUTCOME_TRY(removeNodes());
+
+    SL_DEBUG(logger_,
+             "{} trie nodes removed, {} finalized states kept",
+             removed,
+             finalized_states_.size());
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePruner::removeNodes() {
+    auto node_batch = node_storage_->batch();
+    for (auto &key : removed_nodes_) {
+      OUTCOME_TRY(node_batch->remove(key));
+    }
+    OUTCOME_TRY(node_batch->commit());
+    removed_nodes_.clear();
+    return outcome::success();
+  }
+
+  outcome::result<boost::optional<uint32_t>> TriePruner::nodeRefs(
+      Changes &changes, const common::Buffer &key) const {
+    if (auto it = changes.node_refs.find(key); it != changes.node_refs.end()) {
+      if (changes.removed.count(key) != 0) {
+        return boost::none;
+      }
+      return it->second;
+    }
+    return loadCounter(common::Buffer{node_refs_prefix_}.put(key));
+  }
+
+  outcome::result<uint32_t> TriePruner::stateRefs(Changes &changes,
+                                                  const RootHash &root) const {
+    common::Buffer key{root};
+    if (auto it = changes.state_refs.find(key);
+        it != changes.state_refs.end()) {
+      return it->second;
+    }
+    OUTCOME_TRY(refs,
+                loadCounter(common::Buffer{state_refs_prefix_}.put(root)));
+    return refs.value_or(0);
+  }
+
+  outcome::result<boost::optional<uint32_t>> TriePruner::loadCounter(
+      const common::Buffer &key) const {
+    auto res = storage_->get(key);
+    if (not res) {
+      if (res.error() == DatabaseError::NOT_FOUND) {
+        return boost::none;
+      }
+      return res.error();
+    }
+    OUTCOME_TRY(counter, scale::decode<uint32_t>(res.value()));
+    return counter;
+  }
+
+  outcome::result<void> TriePruner::releaseState(Changes &changes,
+                                                 const RootHash &root) {
+    OUTCOME_TRY(state_refs, stateRefs(changes, root));
+    // the blocks whose states were not kept do not hold a reference
+    if (state_refs == 0) {
+      return outcome::success();
+    }
+    changes.state_refs[common::Buffer{root}] = state_refs - 1;
+    return releaseNode(changes, common::Buffer{root});
+  }
+
+  outcome::result<void> TriePruner::releaseNode(Changes &changes,
+                                                const common::Buffer &key) {
+    std::vector<common::Buffer> queue{key};
+    while (not queue.empty()) {
+      auto current = std::move(queue.back());
+      queue.pop_back();
+      OUTCOME_TRY(refs, nodeRefs(changes, current));
+      if (not refs.has_value()) {
+        continue;
+      }
+      if (refs.value() > 1) {
+        changes.node_refs[current] = refs.value() - 1;
+        continue;
+      }
+      changes.node_refs[current] = 0;
+      changes.removed.insert(current);
+
+      auto enc = node_storage_->get(current);
+      if (not enc) {
+        // the counter outlived its node after a failure; nothing to follow
+        if (enc.error() == DatabaseError::NOT_FOUND) {
+          continue;
+        }
+        return enc.error();
+      }
+      OUTCOME_TRY(node, codec_->decodeNode(enc.value()));
+      if (auto &decoded = static_cast<const PolkadotNode &>(*node);
+          decoded.isBranch()) {
+        auto &branch = static_cast<const BranchNode &>(decoded);
+        for (auto &child : branch.children) {
+          if (child != nullptr) {
+            queue.push_back(
+                std::static_pointer_cast<DummyNode>(child)->db_key);
+          }
+        }
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePruner::writeChanges(const Changes &changes,
+                                                 BufferBatch &batch) const {
+    for (auto &[key, refs] : changes.node_refs) {
+      auto db_key = common::Buffer{node_refs_prefix_}.put(key);
+      if (changes.removed.count(key) != 0) {
+        OUTCOME_TRY(batch.remove(db_key));
+      } else {
+        OUTCOME_TRY(enc, scale::encode(refs));
+        OUTCOME_TRY(batch.put(db_key, common::Buffer{std::move(enc)}));
+      }
+    }
+    for (auto &[key, refs] : changes.state_refs) {
+      auto db_key = common::Buffer{state_refs_prefix_}.put(key);
+      if (refs == 0) {
+        OUTCOME_TRY(batch.remove(db_key));
+      } else {
+        OUTCOME_TRY(enc, scale::encode(refs));
+        OUTCOME_TRY(batch.put(db_key, common::Buffer{std::move(enc)}));
+      }
+    }
+    return outcome::success();
+  }
+
+}  // namespace kagome::storage::trie
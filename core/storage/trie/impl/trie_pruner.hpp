@@ -0,0 +1,180 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER
+#define KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "log/logger.hpp"
+#include "outcome/outcome.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/trie/types.hpp"
+
+namespace kagome::storage::trie {
+  class Codec;
+  class TrieStorageBackend;
+}  // namespace kagome::storage::trie
+
+namespace kagome::storage::trie {
+
+  /**
+   * Removes trie nodes which are not reachable from the kept states.
+   * Every node written since pruning is enabled is reference counted: a node
+   * is referenced by each stored node that has it as a child and, if it is a
+   * state root, by each block with this state. When a state is released, the
+   * nodes whose counter drops to zero are removed along with their
+   * descendants that become unreferenced.
+   * The states of the blocks discarded on finalization are released at once,
+   * and the states of the finalized blocks are released once there are more
+   * than the configured number of finalized states behind them.
+   * Nodes written before pruning was enabled have no counters and are never
+   * removed.
+   * Thread-safe.
+   */
+  class TriePruner {
+   public:
+    /**
+     * A node written to the storage along with the database keys of its
+     * children
+     */
+    struct StoredNode {
+      common::Buffer key;
+      std::vector<common::Buffer> children;
+    };
+
+    /**
+     * @param storage the database to keep the reference counters in
+     * @param node_storage the storage of trie nodes
+     * @param codec codec to decode the removed nodes with to find their
+     * children
+     * @param node_refs_prefix key space of the node reference counters
+     * @param state_refs_prefix key space of the state reference counters
+     * @param states_to_keep number of finalized states to keep
+     */
+    static outcome::result<std::shared_ptr<TriePruner>> create(
+        std::shared_ptr<BufferStorage> storage,
+        std::shared_ptr<TrieStorageBackend> node_storage,
+        std::shared_ptr<Codec> codec,
+        common::Buffer node_refs_prefix,
+        common::Buffer state_refs_prefix,
+        uint32_t states_to_keep);
+
+    /**
+     * Counts the references of the nodes written to \arg node_batch and
+     * commits it.
+     * @param nodes the written nodes, each one following its children, so
+     * that the last one is the root
+     */
+    outcome::result<void> onNodesStored(const std::vector<StoredNode> &nodes,
+                                        BufferBatch &node_batch);
+
+    /**
+     * Keeps the state \arg root as long as a block with this state exists
+     */
+    outcome::result<void> addState(const RootHash &root);
+
+    /**
+     * @returns true if the state \arg root is kept for some block
+     */
+    outcome::result<bool> hasState(const RootHash &root) const;
+
+    /**
+     * Releases the states of the \arg discarded blocks and of the finalized
+     * blocks that fall out of the kept window, and removes the nodes which are
+     * no more referenced.
+     * Nothing is released if the counters fail to be written: the states are
+     * kept pending and released along with the ones of the next call. The
+     * nodes which fail to be removed are removed on the next call too.
+     * @param finalized the states of the newly finalized blocks, ascending
+     */
+    outcome::result<void> onFinalized(const std::vector<RootHash> &finalized,
+                                      const std::vector<RootHash> &discarded);
+
+   private:
+    /**
+     * Reference counters updated by an operation and the nodes it removes,
+     * which are written to the database at once
+     */
+    struct Changes {
+      std::unordered_map<common::Buffer, uint32_t> node_refs;
+      std::unordered_map<common::Buffer, uint32_t> state_refs;
+      std::unordered_set<common::Buffer> removed;
+    };
+
+    TriePruner(std::shared_ptr<BufferStorage> storage,
+               std::shared_ptr<TrieStorageBackend> node_storage,
+               std::shared_ptr<Codec> codec,
+               common::Buffer node_refs_prefix,
+               common::Buffer state_refs_prefix,
+               uint32_t states_to_keep,
+               std::deque<RootHash> finalized_states);
+
+    /**
+     * @returns the reference counter of the node \arg key, or none if the
+     * node is not counted
+     */
+    outcome::result<boost::optional<uint32_t>> nodeRefs(
+        Changes &changes, const common::Buffer &key) const;
+    outcome::result<uint32_t> stateRefs(Changes &changes,
+                                        const RootHash &root) const;
+    outcome::result<boost::optional<uint32_t>> loadCounter(
+        const common::Buffer &key) const;
+
+    /**
+     * Drops a reference of the block to the state \arg root
+     */
+    outcome::result<void> releaseState(Changes &changes, const RootHash &root);
+
+    /**
+     * Drops a reference to the node \arg key, removing it along with its
+     * unreferenced descendants if it was the last one.
+     * A node which has no references already is removed as is
+     */
+    outcome::result<void> releaseNode(Changes &changes,
+                                      const common::Buffer &key);
+
+    outcome::result<void> writeChanges(const Changes &changes,
+                                       BufferBatch &batch) const;
+
+    /**
+     * Removes the nodes whose counters are removed already
+     */
+    outcome::result<void> removeNodes();
+
+    std::shared_ptr<BufferStorage> storage_;
+    std::shared_ptr<TrieStorageBackend> node_storage_;
+    std::shared_ptr<Codec> codec_;
+    common::Buffer node_refs_prefix_;
+    common::Buffer state_refs_prefix_;
+    uint32_t states_to_keep_;
+
+    mutable std::mutex mutex_;
+    // finalized states which are still kept, ascending
+    std::deque<RootHash> finalized_states_;
+    // roots written since the last finalization; the ones which no block
+    // refers to by the next finalization are intermediate states and removed
+    std::unordered_set<RootHash> new_roots_;
+    std::unordered_set<RootHash> old_roots_;
+    // states of the blocks passed to onFinalized which are not released yet
+    // because of a failure
+    std::vector<RootHash> pending_finalized_;
+    std::vector<RootHash> pending_discarded_;
+    // nodes which are not referenced anymore but still stored
+    std::unordered_set<common::Buffer> removed_nodes_;
+
+    log::Logger logger_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER
@@ -31,6 +31,21 @@ namespace kagome::storage::trie {
     return storage_->get(prefixKey(key));
   }
 
+  outcome::result<void> TrieStorageBackendImpl::view(
+      const Buffer &key, const ViewConsumer &consumer) const {
+    return storage_->view(prefixKey(key), consumer);
+  }
+
+  std::vector<outcome::result<Buffer>> TrieStorageBackendImpl::getMany(
+      const std::vector<Buffer> &keys) const {
+    std::vector<Buffer> prefixed;
+    prefixed.reserve(keys.size());
+    for (auto &key : keys) {
+      prefixed.push_back(prefixKey(key));
+    }
+    return storage_->getMany(prefixed);
+  }
+
   bool TrieStorageBackendImpl::contains(const Buffer &key) const {
     return storage_->contains(prefixKey(key));
   }
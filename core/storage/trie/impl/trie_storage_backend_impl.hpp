@@ -23,6 +23,10 @@ namespace kagome::storage::trie {
     std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<void> view(const Buffer &key,
+                               const ViewConsumer &consumer) const override;
+    std::vector<outcome::result<Buffer>> getMany(
+        const std::vector<Buffer> &keys) const override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
 
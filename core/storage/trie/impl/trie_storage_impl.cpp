@@ -18,7 +18,8 @@ namespace kagome::storage::trie {
       const std::shared_ptr<PolkadotTrieFactory> &trie_factory,
       std::shared_ptr<Codec> codec,
       std::shared_ptr<TrieSerializer> serializer,
-      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes) {
+      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+      std::shared_ptr<FlatState> flat_state) {
     // will never be used, so content of the callback doesn't matter
     auto empty_trie = trie_factory->createEmpty(
         [](const auto &branch, auto idx) { return nullptr; });
@@ -28,7 +29,8 @@ namespace kagome::storage::trie {
         new TrieStorageImpl(std::move(empty_root),
                             std::move(codec),
                             std::move(serializer),
-                            std::move(changes)));
+                            std::move(changes),
+                            std::move(flat_state)));
   }
 
   outcome::result<std::unique_ptr<TrieStorageImpl>>
@@ -36,23 +38,27 @@ namespace kagome::storage::trie {
       const RootHash &root_hash,
       std::shared_ptr<Codec> codec,
       std::shared_ptr<TrieSerializer> serializer,
-      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes) {
+      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+      std::shared_ptr<FlatState> flat_state) {
     return std::unique_ptr<TrieStorageImpl>(
         new TrieStorageImpl(root_hash,
                             std::move(codec),
                             std::move(serializer),
-                            std::move(changes)));
+                            std::move(changes),
+                            std::move(flat_state)));
   }
 
   TrieStorageImpl::TrieStorageImpl(
       RootHash root_hash,
       std::shared_ptr<Codec> codec,
       std::shared_ptr<TrieSerializer> serializer,
-      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes)
+      boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+      std::shared_ptr<FlatState> flat_state)
       : root_hash_{std::move(root_hash)},
         codec_{std::move(codec)},
         serializer_{std::move(serializer)},
         changes_{std::move(changes)},
+        flat_state_{std::move(flat_state)},
         logger_{log::createLogger("TrieStorage", "changes_trie")} {
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(serializer_ != nullptr);
@@ -80,7 +86,9 @@ namespace kagome::storage::trie {
         [this](const auto &new_root) {
           root_hash_ = new_root;
           SL_DEBUG(logger_, "Update state root: {}", root_hash_);
-        });
+        },
+        flat_state_,
+        root_hash_);
   }
 
   outcome::result<std::unique_ptr<EphemeralTrieBatch>>
@@ -89,7 +97,8 @@ namespace kagome::storage::trie {
              "Initialize ephemeral trie batch with root: {}",
              root_hash_.toHex());
     OUTCOME_TRY(trie, serializer_->retrieveTrie(Buffer{root_hash_}));
-    return std::make_unique<EphemeralTrieBatchImpl>(codec_, std::move(trie));
+    return std::make_unique<EphemeralTrieBatchImpl>(
+        codec_, std::move(trie), flat_state_, root_hash_);
   }
 
   outcome::result<std::unique_ptr<PersistentTrieBatch>>
@@ -111,7 +120,9 @@ namespace kagome::storage::trie {
         [this](const auto &new_root) {
           root_hash_ = new_root;
           SL_DEBUG(logger_, "Update state root: {}", root_hash_);
-        });
+        },
+        flat_state_,
+        root);
   }
 
   outcome::result<std::unique_ptr<EphemeralTrieBatch>>
@@ -120,7 +131,8 @@ namespace kagome::storage::trie {
              "Initialize ephemeral trie batch with root: {}",
              root_hash_.toHex());
     OUTCOME_TRY(trie, serializer_->retrieveTrie(Buffer{root}));
-    return std::make_unique<EphemeralTrieBatchImpl>(codec_, std::move(trie));
+    return std::make_unique<EphemeralTrieBatchImpl>(
+        codec_, std::move(trie), flat_state_, root);
   }
 
   RootHash TrieStorageImpl::getRootHash() const noexcept {
@@ -12,6 +12,7 @@
 #include "primitives/event_types.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 #include "storage/trie/codec.hpp"
+#include "storage/trie/impl/flat_state.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
 #include "storage/trie/serialization/trie_serializer.hpp"
 
@@ -23,13 +24,15 @@ namespace kagome::storage::trie {
         const std::shared_ptr<PolkadotTrieFactory> &trie_factory,
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
-        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
+        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+        std::shared_ptr<FlatState> flat_state = nullptr);
 
     static outcome::result<std::unique_ptr<TrieStorageImpl>> createFromStorage(
         const RootHash &root_hash,
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
-        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
+        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+        std::shared_ptr<FlatState> flat_state = nullptr);
 
     TrieStorageImpl(TrieStorageImpl const &) = delete;
     void operator=(const TrieStorageImpl &) = delete;
@@ -55,13 +58,15 @@ namespace kagome::storage::trie {
         RootHash root_hash,
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
-        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
+        boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
+        std::shared_ptr<FlatState> flat_state = nullptr);
 
    private:
     RootHash root_hash_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieSerializer> serializer_;
     boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes_;
+    std::shared_ptr<FlatState> flat_state_;
     log::Logger logger_;
   };
 
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_nibbles.hpp"
+
+namespace kagome::storage::trie {
+
+  size_t NibbleSlice::commonPrefixLength(const NibbleSlice &other) const {
+    auto max = std::min(size_, other.size_);
+    size_t i = 0;
+    if (offset_ % 2 == other.offset_ % 2) {
+      // both slices start in the same half of a byte, so whole bytes are
+      // compared after the first nibble
+      if (offset_ % 2 == 1 and max > 0) {
+        if ((*this)[0] != other[0]) {
+          return 0;
+        }
+        i = 1;
+      }
+      auto *first = data_ + (offset_ + i) / 2;
+      auto *second = other.data_ + (other.offset_ + i) / 2;
+      while (i + 2 <= max and *first == *second) {
+        ++first;
+        ++second;
+        i += 2;
+      }
+    }
+    while (i < max and (*this)[i] == other[i]) {
+      ++i;
+    }
+    return i;
+  }
+
+  KeyNibbles &KeyNibbles::put(const NibbleSlice &nibbles) {
+    size_t i = 0;
+    if (size_ == 0 and nibbles.offset_ % 2 == 1 and not nibbles.empty()) {
+      // start in the same half of a byte as the slice to copy it bytewise
+      offset_ = 1;
+      bytes_.assign(1, nibbles[0]);
+      size_ = 1;
+      i = 1;
+    } else if ((offset_ + size_) % 2 == 1 and not nibbles.empty()) {
+      putUint8(nibbles[0]);
+      i = 1;
+    }
+    // the sequence now ends at a byte boundary
+    if ((nibbles.offset_ + i) % 2 == 0) {
+      auto whole_bytes = (nibbles.size_ - i) / 2;
+      auto *begin = nibbles.data_ + (nibbles.offset_ + i) / 2;
+      bytes_.insert(bytes_.end(), begin, begin + whole_bytes);
+      size_ += whole_bytes * 2;
+      i += whole_bytes * 2;
+    }
+    for (; i < nibbles.size_; ++i) {
+      putUint8(nibbles[i]);
+    }
+    return *this;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,189 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_NIBBLES
+#define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_NIBBLES
+
+#include <algorithm>
+#include <initializer_list>
+
+#include <boost/assert.hpp>
+#include <boost/container/small_vector.hpp>
+#include <gsl/span>
+
+namespace kagome::storage::trie {
+
+  class KeyNibbles;
+
+  /**
+   * Non-owning view of a sequence of nibbles packed two per byte, the high
+   * nibble of a byte going first. The sequence may start in the middle of a
+   * byte, so that a part of a key is referred to without copying it.
+   * The viewed bytes must outlive the slice.
+   */
+  class NibbleSlice {
+   public:
+    NibbleSlice() = default;
+
+    /**
+     * @param data packed nibbles
+     * @param offset number of the nibble in \arg data the slice starts at
+     * @param size number of nibbles in the slice
+     */
+    NibbleSlice(const uint8_t *data, size_t offset, size_t size)
+        : data_{data}, offset_{offset}, size_{size} {}
+
+    /**
+     * @returns the nibbles of the whole \arg key
+     */
+    static NibbleSlice fromKey(gsl::span<const uint8_t> key) {
+      return NibbleSlice{key.data(), 0, static_cast<size_t>(key.size()) * 2};
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    uint8_t operator[](size_t index) const {
+      BOOST_ASSERT(index < size_);
+      auto nibble = offset_ + index;
+      auto byte = data_[nibble / 2];
+      return nibble % 2 == 0 ? byte >> 4u : byte & 0xfu;
+    }
+
+    NibbleSlice subspan(size_t offset = 0, size_t length = -1) const {
+      BOOST_ASSERT(offset <= size_);
+      return NibbleSlice{
+          data_, offset_ + offset, std::min(length, size_ - offset)};
+    }
+
+    /**
+     * @returns the length of the common prefix of the slice and \arg other
+     */
+    size_t commonPrefixLength(const NibbleSlice &other) const;
+
+    bool startsWith(const NibbleSlice &prefix) const {
+      return prefix.size_ <= size_
+             and commonPrefixLength(prefix) == prefix.size_;
+    }
+
+    bool operator==(const NibbleSlice &other) const {
+      return size_ == other.size_ and commonPrefixLength(other) == size_;
+    }
+
+    bool operator!=(const NibbleSlice &other) const {
+      return not(*this == other);
+    }
+
+   private:
+    friend class KeyNibbles;
+
+    const uint8_t *data_ = nullptr;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+  };
+
+  /**
+   * Owning sequence of nibbles of a key, packed two per byte.
+   * The sequence starts either at the beginning or in the middle of its
+   * first byte, which allows to copy both keys and their encoded partial
+   * keys byte by byte. The nibbles of the bytes which are not a part of the
+   * sequence are zero.
+   * Partial keys of the most of the nodes are short, so they are stored inline
+   * without a heap allocation.
+   */
+  class KeyNibbles {
+   public:
+    static constexpr size_t kInlineBytes = 16;
+
+    KeyNibbles() = default;
+
+    explicit KeyNibbles(const NibbleSlice &nibbles) {
+      put(nibbles);
+    }
+
+    /**
+     * Constructs from nibbles stored one per byte
+     */
+    explicit KeyNibbles(gsl::span<const uint8_t> nibbles) {
+      for (auto nibble : nibbles) {
+        putUint8(nibble);
+      }
+    }
+
+    KeyNibbles(std::initializer_list<uint8_t> nibbles) {
+      for (auto nibble : nibbles) {
+        putUint8(nibble);
+      }
+    }
+
+    KeyNibbles &operator=(const NibbleSlice &nibbles) {
+      // the slice may refer to this very sequence
+      *this = KeyNibbles{nibbles};
+      return *this;
+    }
+
+    /**
+     * Assigns nibbles stored one per byte
+     */
+    KeyNibbles &operator=(gsl::span<const uint8_t> nibbles) {
+      *this = KeyNibbles{nibbles};
+      return *this;
+    }
+
+    operator NibbleSlice() const {  // NOLINT
+      return NibbleSlice{bytes_.data(), offset_, size_};
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    uint8_t operator[](size_t index) const {
+      return NibbleSlice{*this}[index];
+    }
+
+    NibbleSlice subspan(size_t offset = 0, size_t length = -1) const {
+      return NibbleSlice{*this}.subspan(offset, length);
+    }
+
+    KeyNibbles &putUint8(uint8_t nibble) {
+      if ((offset_ + size_) % 2 == 0) {
+        bytes_.push_back((nibble & 0xfu) << 4u);
+      } else {
+        bytes_.back() |= nibble & 0xfu;
+      }
+      ++size_;
+      return *this;
+    }
+
+    KeyNibbles &put(const NibbleSlice &nibbles);
+
+    bool operator==(const NibbleSlice &other) const {
+      return NibbleSlice{*this} == other;
+    }
+
+    bool operator!=(const NibbleSlice &other) const {
+      return NibbleSlice{*this} != other;
+    }
+
+   private:
+    boost::container::small_vector<uint8_t, kInlineBytes> bytes_;
+    uint32_t size_ = 0;
+    // 1 if the first nibble is the low half of the first byte
+    uint8_t offset_ = 0;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_NIBBLES
@@ -0,0 +1,68 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/node_arena.hpp"
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+namespace kagome::storage::trie {
+
+  size_t NodeArena::blockSize(size_t size) {
+    auto block_size =
+        (size + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+    return std::max(block_size, sizeof(FreeBlock));
+  }
+
+  void *NodeArena::allocate(size_t size, size_t alignment) {
+    BOOST_ASSERT(alignment <= kBlockAlignment);
+    auto block_size = blockSize(size);
+    std::lock_guard lock{mutex_};
+    ++allocations_;
+    allocated_bytes_ += size;
+
+    for (auto &[free_size, head] : free_lists_) {
+      if (free_size == block_size and head != nullptr) {
+        auto *block = head;
+        head = block->next;
+        ++reused_allocations_;
+        return block;
+      }
+    }
+
+    if (block_size > left_) {
+      // large blocks get a chunk of their own, so that the rest of the
+      // current chunk is not wasted
+      if (block_size > kChunkSize / 4) {
+        chunks_.emplace_back(new uint8_t[block_size]);
+        return chunks_.back().get();
+      }
+      chunks_.emplace_back(new uint8_t[kChunkSize]);
+      current_ = chunks_.back().get();
+      left_ = kChunkSize;
+    }
+    void *ptr = current_;
+    current_ += block_size;
+    left_ -= block_size;
+    return ptr;
+  }
+
+  void NodeArena::deallocate(void *ptr, size_t size) {
+    auto block_size = blockSize(size);
+    auto *block = static_cast<FreeBlock *>(ptr);
+    std::lock_guard lock{mutex_};
+    for (auto &[free_size, head] : free_lists_) {
+      if (free_size == block_size) {
+        block->next = head;
+        head = block;
+        return;
+      }
+    }
+    block->next = nullptr;
+    free_lists_.emplace_back(block_size, block);
+  }
+
+}  // namespace kagome::storage::trie
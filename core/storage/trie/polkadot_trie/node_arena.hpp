@@ -0,0 +1,129 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_POLKADOT_TRIE_NODE_ARENA
+#define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_NODE_ARENA
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace kagome::storage::trie {
+
+  /**
+   * Pooling memory resource for the nodes of a single trie.
+   * Memory is taken from the system in large chunks and handed out
+   * sequentially. A freed block is put to the free list of its size and is
+   * handed out again by the next allocation of that size, so, as the nodes
+   * are of a few fixed sizes, the arena grows with the number of the nodes
+   * alive at once rather than of all the nodes ever made. All the chunks are
+   * returned to the system at once when the arena is destroyed.
+   * Thread-safe, as the nodes which outlive their trie may be released by
+   * another thread.
+   */
+  class NodeArena {
+   public:
+    static constexpr size_t kChunkSize = 64 * 1024;
+    /// every block is aligned to this and its size is a multiple of it
+    static constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+    NodeArena() = default;
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    void *allocate(size_t size, size_t alignment);
+
+    void deallocate(void *ptr, size_t size);
+
+    /// number of blocks handed out by the arena
+    size_t allocations() const {
+      std::lock_guard lock{mutex_};
+      return allocations_;
+    }
+
+    /// number of blocks handed out again after they were freed
+    size_t reusedAllocations() const {
+      std::lock_guard lock{mutex_};
+      return reused_allocations_;
+    }
+
+    /// total size of the blocks handed out by the arena
+    size_t allocatedBytes() const {
+      std::lock_guard lock{mutex_};
+      return allocated_bytes_;
+    }
+
+    /// number of allocations the arena made from the system
+    size_t chunks() const {
+      std::lock_guard lock{mutex_};
+      return chunks_.size();
+    }
+
+   private:
+    struct FreeBlock {
+      FreeBlock *next;
+    };
+
+    static size_t blockSize(size_t size);
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+    uint8_t *current_ = nullptr;
+    size_t left_ = 0;
+    // heads of the lists of the freed blocks by their sizes; there are a few
+    // sizes of nodes, so a lookup is a short linear search
+    std::vector<std::pair<size_t, FreeBlock *>> free_lists_;
+    size_t allocations_ = 0;
+    size_t reused_allocations_ = 0;
+    size_t allocated_bytes_ = 0;
+  };
+
+  /**
+   * Allocator that takes memory from a node arena. Each allocated object
+   * owns a reference to the arena, so nodes may safely outlive the trie
+   * that created them.
+   */
+  template <typename T>
+  class ArenaAllocator {
+   public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<NodeArena> arena)
+        : arena_{std::move(arena)} {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other)  // NOLINT
+        : arena_{other.arena()} {}
+
+    T *allocate(size_t n) {
+      return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) noexcept {
+      arena_->deallocate(ptr, n * sizeof(T));
+    }
+
+    const std::shared_ptr<NodeArena> &arena() const {
+      return arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+      return arena_ == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+      return arena_ != other.arena();
+    }
+
+   private:
+    std::shared_ptr<NodeArena> arena_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_POLKADOT_TRIE_NODE_ARENA
@@ -7,11 +7,6 @@
 
 namespace kagome::storage::trie {
 
-  int BranchNode::getType() const {
-    return static_cast<int>(value ? PolkadotNode::Type::BranchWithValue
-                                  : PolkadotNode::Type::BranchEmptyValue);
-  }
-
   uint16_t BranchNode::childrenBitmap() const {
     uint16_t bitmap = 0u;
     for (auto i = 0u; i < kMaxChildren; i++) {
@@ -29,8 +24,4 @@ namespace kagome::storage::trie {
     ;
   }
 
-  int LeafNode::getType() const {
-    return static_cast<int>(PolkadotNode::Type::Leaf);
-  }
-
 }  // namespace kagome::storage::trie
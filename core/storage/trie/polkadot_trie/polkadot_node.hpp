@@ -10,26 +10,11 @@
 
 #include "common/blob.hpp"
 #include "common/buffer.hpp"
+#include "storage/trie/polkadot_trie/key_nibbles.hpp"
 #include "storage/trie/node.hpp"
 
 namespace kagome::storage::trie {
 
-  struct KeyNibbles : public common::Buffer {
-    KeyNibbles() = default;
-
-    explicit KeyNibbles(common::Buffer b) : Buffer{std::move(b)} {}
-    KeyNibbles(std::initializer_list<uint8_t> b) : Buffer{b} {}
-
-    KeyNibbles &operator=(common::Buffer b) {
-      Buffer::operator=(std::move(b));
-      return *this;
-    }
-
-    KeyNibbles subspan(size_t offset = 0, size_t length = -1) const {
-      return KeyNibbles{Buffer::subbuffer(offset, length)};
-    }
-  };
-
   /**
    * For specification see
    * https://github.com/w3f/polkadot-re-spec/blob/master/polkadot_re_spec.pdf
@@ -37,9 +22,20 @@ namespace kagome::storage::trie {
    */
 
   struct PolkadotNode : public Node {
-    PolkadotNode() = default;
-    PolkadotNode(KeyNibbles key_nibbles, boost::optional<common::Buffer> value)
-        : key_nibbles{std::move(key_nibbles)}, value{std::move(value)} {}
+    /**
+     * The kind of a node is fixed on construction, so that the hot paths
+     * switch on it and downcast statically instead of calling virtual
+     * functions and dynamic casts
+     */
+    enum class Kind : uint8_t { Leaf, Branch, Dummy };
+
+    explicit PolkadotNode(Kind kind) : kind_{kind} {}
+    PolkadotNode(Kind kind,
+                 KeyNibbles key_nibbles,
+                 boost::optional<common::Buffer> value)
+        : key_nibbles{std::move(key_nibbles)},
+          value{std::move(value)},
+          kind_{kind} {}
 
     ~PolkadotNode() override = default;
 
@@ -50,38 +46,62 @@ namespace kagome::storage::trie {
       BranchWithValue = 0b11
     };
 
+    int getType() const final {
+      return static_cast<int>(getTrieType());
+    }
+
+    Kind kind() const noexcept {
+      return kind_;
+    }
+
     // dummy nodes are used to avoid unnecessary reads from the storage
-    virtual bool isDummy() const = 0;
+    bool isDummy() const noexcept {
+      return kind_ == Kind::Dummy;
+    }
 
     // just to avoid static_casts every time you need a switch on a node type
     Type getTrieType() const noexcept {
-      return static_cast<Type>(getType());
+      switch (kind_) {
+        case Kind::Leaf:
+          return Type::Leaf;
+        case Kind::Branch:
+          return value ? Type::BranchWithValue : Type::BranchEmptyValue;
+        case Kind::Dummy:
+          break;
+      }
+      // Special only because a node has to have a type. Actually a dummy node
+      // is not the real node and the type of the underlying node is
+      // inaccessible before reading from the storage
+      return Type::Special;
     }
 
     bool isBranch() const noexcept {
-      auto type = getTrieType();
-      return type == Type::BranchWithValue or type == Type::BranchEmptyValue;
+      return kind_ == Kind::Branch;
     }
 
     KeyNibbles key_nibbles;
     boost::optional<common::Buffer> value;
+
+    // merkle value of the node, known if the node is retrieved from the
+    // storage or its merkle value is calculated, and reset once the node or
+    // any node of its subtree is changed
+    boost::optional<common::Buffer> merkle_value;
+
+   private:
+    Kind kind_;
   };
 
   struct BranchNode : public PolkadotNode {
     static constexpr int kMaxChildren = 16;
 
-    BranchNode() = default;
+    BranchNode() : PolkadotNode{Kind::Branch} {}
     explicit BranchNode(KeyNibbles key_nibbles,
                         boost::optional<common::Buffer> value = boost::none)
-        : PolkadotNode{std::move(key_nibbles), std::move(value)} {}
+        : PolkadotNode{
+            Kind::Branch, std::move(key_nibbles), std::move(value)} {}
 
     ~BranchNode() override = default;
 
-    bool isDummy() const override {
-      return false;
-    }
-    int getType() const override;
-
     uint16_t childrenBitmap() const;
     uint8_t childrenNum() const;
 
@@ -92,16 +112,11 @@ namespace kagome::storage::trie {
   };
 
   struct LeafNode : public PolkadotNode {
-    LeafNode() = default;
+    LeafNode() : PolkadotNode{Kind::Leaf} {}
     LeafNode(KeyNibbles key_nibbles, boost::optional<common::Buffer> value)
-        : PolkadotNode{std::move(key_nibbles), std::move(value)} {}
+        : PolkadotNode{Kind::Leaf, std::move(key_nibbles), std::move(value)} {}
 
     ~LeafNode() override = default;
-
-    bool isDummy() const override {
-      return false;
-    }
-    int getType() const override;
   };
 
   /**
@@ -114,18 +129,8 @@ namespace kagome::storage::trie {
      * @param key a storage key, which is a hash of an encoded node according to
      * PolkaDot specification
      */
-    explicit DummyNode(common::Buffer key) : db_key{std::move(key)} {}
-
-    bool isDummy() const override {
-      return true;
-    }
-
-    int getType() const override {
-      // Special only because a node has to have a type. Actually this is not
-      // the real node and the type of the underlying node is inaccessible
-      // before reading from the storage
-      return static_cast<int>(Type::Special);
-    }
+    explicit DummyNode(common::Buffer key)
+        : PolkadotNode{Kind::Dummy}, db_key{std::move(key)} {}
 
     common::Buffer db_key;
   };
@@ -43,6 +43,25 @@ namespace kagome::storage::trie {
         boost::optional<uint64_t> limit,
         const OnDetachCallback &callback) = 0;
 
+    /**
+     * Value of a key along with the key of the node holding it in the storage
+     */
+    struct StoredValue {
+      /// key of the node in the storage, none if the node is not stored as it
+      /// is in the trie
+      boost::optional<common::Buffer> db_key;
+      /// the value, none if the node is the one known to the caller
+      boost::optional<common::Buffer> value;
+    };
+
+    /**
+     * Looks the value of \arg key up like get(), but does not retrieve the
+     * node of the key from the storage if it is stored under \arg
+     * known_db_key, as the caller already has the value then
+     */
+    virtual outcome::result<StoredValue> getStoredValue(
+        const common::Buffer &key, const common::Buffer &known_db_key) const = 0;
+
     /**
      * @return the root node of the trie
      */
@@ -60,13 +79,13 @@ namespace kagome::storage::trie {
      * \arg key_nibbles (includes parent's key nibbles)
      */
     virtual outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        NodePtr parent, const NibbleSlice &key_nibbles) const = 0;
     /**
      * @returns a sequence of nodes in between \arg parent and the node found by
      * following \arg key_nibbles. The parent is included, the end node isn't.
      */
     virtual outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        NodePtr parent, const NibbleSlice &key_nibbles) const = 0;
 
     virtual std::unique_ptr<PolkadotTrieCursor> trieCursor() = 0;
 
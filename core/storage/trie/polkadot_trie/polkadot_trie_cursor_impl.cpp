@@ -5,6 +5,8 @@
 
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor_impl.hpp"
 
+#include <algorithm>
+
 #include "common/buffer_back_insert_iterator.hpp"
 #include "macro/unreachable.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
@@ -25,13 +27,6 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
 
 namespace kagome::storage::trie {
 
-  size_t getCommonLength(gsl::span<const uint8_t> first,
-                         gsl::span<const uint8_t> second) {
-    auto &&[left_nibbles_mismatch, current_nibbles_mismatch] =
-        std::mismatch(first.begin(), first.end(), second.begin(), second.end());
-    return left_nibbles_mismatch - first.begin();
-  }
-
   PolkadotTrieCursorImpl::PolkadotTrieCursorImpl(const PolkadotTrie &trie)
       : trie_{trie}, current_{nullptr} {}
 
@@ -40,7 +35,7 @@ namespace kagome::storage::trie {
                                    const PolkadotTrie &trie) {
     auto c = std::make_unique<PolkadotTrieCursorImpl>(trie);
     OUTCOME_TRY(node,
-                trie.getNode(trie.getRoot(), c->codec_.keyToNibbles(key)));
+                trie.getNode(trie.getRoot(), NibbleSlice::fromKey(key)));
     c->visited_root_ = true;  // root is always visited first
     c->current_ = node;
     OUTCOME_TRY(last_child_path, c->constructLastVisitedChildPath(key));
@@ -49,6 +44,24 @@ namespace kagome::storage::trie {
     return c;
   }
 
+  outcome::result<std::vector<common::Buffer>>
+  PolkadotTrieCursorImpl::collectKeys(const PolkadotTrie &trie,
+                                      const common::Buffer &prefix) {
+    std::vector<common::Buffer> keys;
+    PolkadotTrieCursorImpl cursor{trie};
+    OUTCOME_TRY(cursor.seekLowerBound(prefix));
+    while (cursor.isValid()) {
+      auto key = cursor.key().value();
+      if (key.size() < prefix.size()
+          or not std::equal(prefix.begin(), prefix.end(), key.begin())) {
+        break;
+      }
+      keys.emplace_back(std::move(key));
+      OUTCOME_TRY(cursor.next());
+    }
+    return keys;
+  }
+
   outcome::result<bool> PolkadotTrieCursorImpl::seekFirst() {
     visited_root_ = false;
     current_ = trie_.getRoot();
@@ -64,8 +77,8 @@ namespace kagome::storage::trie {
     }
     visited_root_ = true;  // root is always visited first
     OUTCOME_TRY(last_child_path, constructLastVisitedChildPath(key));
-    auto nibbles = PolkadotCodec::keyToNibbles(key);
-    OUTCOME_TRY(node, trie_.getNode(trie_.getRoot(), nibbles));
+    OUTCOME_TRY(node,
+                trie_.getNode(trie_.getRoot(), NibbleSlice::fromKey(key)));
 
     bool node_has_value = node != nullptr and node->value.has_value();
     if (node_has_value) {
@@ -91,7 +104,7 @@ namespace kagome::storage::trie {
       auto type = current->getTrieType();
       if (type == NodeType::BranchEmptyValue
           or type == NodeType::BranchWithValue) {
-        auto branch = std::dynamic_pointer_cast<BranchNode>(current);
+        auto branch = std::static_pointer_cast<BranchNode>(current);
         // find the rightmost child
         for (int8_t i = branch->kMaxChildren - 1; i >= 0; i--) {
           if (branch->children.at(i) != nullptr) {
@@ -117,25 +130,22 @@ namespace kagome::storage::trie {
       return outcome::success();
     }
     visited_root_ = true;
-    auto nibbles = PolkadotCodec::keyToNibbles(key);
-    gsl::span<const uint8_t> left_nibbles(nibbles);
-    BOOST_ASSERT(left_nibbles.size() >= 0);
+    auto left_nibbles = NibbleSlice::fromKey(key);
     NodePtr current = trie_.getRoot();
     while (true) {
-      auto [left_mismatch, current_mismatch] =
-          std::mismatch(left_nibbles.begin(),
-                        left_nibbles.end(),
-                        current->key_nibbles.begin(),
-                        current->key_nibbles.end());
+      auto common_length =
+          left_nibbles.commonPrefixLength(current->key_nibbles);
+      bool left_ended = common_length == left_nibbles.size();
+      bool current_ended = common_length == current->key_nibbles.size();
       // parts of every sequence within their common length (minimum of their
       // lengths) are equal
-      bool part_equal = left_mismatch == left_nibbles.end()
-                        or current_mismatch == current->key_nibbles.end();
+      bool part_equal = left_ended or current_ended;
       // if current choice is lexicographically less or equal to the left part
       // of the sought key, we just take the closest node with value
-      bool less_or_eq =
-          (part_equal and left_mismatch == left_nibbles.end())
-          or (not part_equal and *left_mismatch < *current_mismatch);
+      bool less_or_eq = (part_equal and left_ended)
+                        or (not part_equal
+                            and left_nibbles[common_length]
+                                    < current->key_nibbles[common_length]);
       if (less_or_eq) {
         switch (current->getTrieType()) {
           case NodeType::BranchEmptyValue:
@@ -155,16 +165,16 @@ namespace kagome::storage::trie {
       // its prefix is equal to the key, then we proceed to a child node that
       // starts with a nibble that is greater of equal to the first nibble of
       // the left part (if there is no such child, proceed to the next case)
-      bool longer = (part_equal and left_mismatch != left_nibbles.end()
-                     and current_mismatch == current->key_nibbles.end());
+      bool longer = (part_equal and not left_ended and current_ended);
       if (longer) {
         switch (current->getTrieType()) {
           case NodeType::BranchEmptyValue:
           case NodeType::BranchWithValue: {
             auto current_as_branch =
-                std::dynamic_pointer_cast<BranchNode>(current);
+                std::static_pointer_cast<BranchNode>(current);
             OUTCOME_TRY(child_idx,
-                        getChildWithMinIdx(current_as_branch, *left_mismatch));
+                        getChildWithMinIdx(current_as_branch,
+                                           left_nibbles[common_length]));
             if (child_idx != -1) {
               last_visited_child_.emplace_back(current_as_branch, child_idx);
               OUTCOME_TRY(new_current,
@@ -187,7 +197,10 @@ namespace kagome::storage::trie {
       // lexicographically greater than the current, we must return to its
       // parent and find a child greater than the current one
       bool longer_or_bigger =
-          longer or (not part_equal and *left_mismatch > *current_mismatch);
+          longer
+          or (not part_equal
+              and left_nibbles[common_length]
+                      > current->key_nibbles[common_length]);
       if (longer_or_bigger) {
         while (not last_visited_child_.empty()) {
           auto [parent, idx] = last_visited_child_.back();
@@ -213,14 +226,14 @@ namespace kagome::storage::trie {
       if (not node->isBranch()) {
         return Error::INVALID_NODE_TYPE;  // can't be a leaf without a value
       }
-      auto node_as_value = std::dynamic_pointer_cast<BranchNode>(node);
+      auto node_as_value = std::static_pointer_cast<BranchNode>(node);
       for (uint8_t i = 0; i < BranchNode::kMaxChildren; i++) {
         OUTCOME_TRY(child, trie_.retrieveChild(node_as_value, i));
         if (child != nullptr) {
           last_visited_child_.emplace_back(node_as_value, i);
           switch (child->getTrieType()) {
             case NodeType::BranchEmptyValue:
-              node = std::dynamic_pointer_cast<BranchNode>(child);
+              node = std::static_pointer_cast<BranchNode>(child);
               goto BREAK;
             case NodeType::BranchWithValue:
             case NodeType::Leaf:
@@ -295,7 +308,7 @@ namespace kagome::storage::trie {
 
       } else if (current_->getTrieType() == NodeType::BranchEmptyValue
                  or current_->getTrieType() == NodeType::BranchWithValue) {
-        auto p = std::dynamic_pointer_cast<BranchNode>(current_);
+        auto p = std::static_pointer_cast<BranchNode>(current_);
         if (last_visited_child_.empty()
             or last_visited_child_.back().parent != p) {
           last_visited_child_.emplace_back(p, -1);
@@ -322,10 +335,7 @@ namespace kagome::storage::trie {
     for (const auto &node_idx : last_visited_child_) {
       const auto &node = node_idx.parent;
       auto idx = node_idx.child_idx;
-      std::copy(node->key_nibbles.begin(),
-                node->key_nibbles.end(),
-                std::back_inserter<Buffer>(key_nibbles));
-      key_nibbles.putUint8(idx);
+      key_nibbles.put(node->key_nibbles).putUint8(idx);
     }
     key_nibbles.put(current_->key_nibbles);
     using Codec = kagome::storage::trie::PolkadotCodec;
@@ -386,7 +396,8 @@ namespace kagome::storage::trie {
 
   auto PolkadotTrieCursorImpl::constructLastVisitedChildPath(
       const common::Buffer &key) -> outcome::result<std::list<TriePathEntry>> {
-    OUTCOME_TRY(path, trie_.getPath(trie_.getRoot(), codec_.keyToNibbles(key)));
+    OUTCOME_TRY(path,
+                trie_.getPath(trie_.getRoot(), NibbleSlice::fromKey(key)));
     std::list<TriePathEntry> last_visited_child;
     for (auto &&[branch, idx] : path) {
       last_visited_child.emplace_back(branch, idx);
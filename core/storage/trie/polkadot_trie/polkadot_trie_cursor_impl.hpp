@@ -33,6 +33,12 @@ namespace kagome::storage::trie {
     static outcome::result<std::unique_ptr<PolkadotTrieCursorImpl>> createAt(
         const common::Buffer &key, const PolkadotTrie &trie);
 
+    /**
+     * @returns the keys of \arg trie starting with \arg prefix, ascending
+     */
+    static outcome::result<std::vector<common::Buffer>> collectKeys(
+        const PolkadotTrie &trie, const common::Buffer &prefix);
+
     outcome::result<bool> seekFirst() override;
 
     outcome::result<bool> seek(const common::Buffer &key) override;
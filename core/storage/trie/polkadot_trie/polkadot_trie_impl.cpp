@@ -5,7 +5,9 @@
 
 #include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
 #include <utility>
 
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor_impl.hpp"
@@ -25,12 +27,15 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, PolkadotTrieImpl::Error, e) {
 namespace kagome::storage::trie {
 
   PolkadotTrieImpl::PolkadotTrieImpl(ChildRetrieveFunctor f)
-      : retrieve_child_{std::move(f)} {
+      : retrieve_child_{std::move(f)},
+        arena_{std::make_shared<NodeArena>()} {
     BOOST_ASSERT(retrieve_child_);
   }
 
   PolkadotTrieImpl::PolkadotTrieImpl(NodePtr root, ChildRetrieveFunctor f)
-      : retrieve_child_{std::move(f)}, root_{std::move(root)} {
+      : retrieve_child_{std::move(f)},
+        root_{std::move(root)},
+        arena_{std::make_shared<NodeArena>()} {
     BOOST_ASSERT(retrieve_child_);
   }
 
@@ -46,15 +51,16 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PolkadotTrieImpl::put(const Buffer &key,
                                               Buffer &&value) {
-    auto k_enc = PolkadotCodec::keyToNibbles(key);
+    auto k_enc = NibbleSlice::fromKey(key);
 
     NodePtr root = root_;
 
     // insert fetches a sequence of nodes (a path) from the storage and
     // these nodes are processed in memory, so any changes applied to them
-    // will be written back to the storage only on storeNode call
-    OUTCOME_TRY(n,
-                insert(root, k_enc, std::make_shared<LeafNode>(k_enc, value)));
+    // will be written back to the storage only on storeNode call;
+    // the partial key of the new leaf is set once its place is found
+    auto leaf = makeNode<LeafNode>(KeyNibbles{}, std::move(value));
+    OUTCOME_TRY(n, insert(root, k_enc, std::move(leaf)));
     root_ = n;
 
     return outcome::success();
@@ -67,15 +73,15 @@ namespace kagome::storage::trie {
     if (not root_) {
       return outcome::success(std::make_tuple(true, 0ULL));
     }
-    auto key_nibbles = PolkadotCodec::keyToNibbles(prefix);
-    OUTCOME_TRY(tup, detachNode(root_, key_nibbles, callback));
+    OUTCOME_TRY(tup,
+                detachNode(root_, NibbleSlice::fromKey(prefix), callback));
     root_ = std::get<0>(tup);
 
     return outcome::success(std::make_tuple(true, std::get<1>(tup)));
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::insert(
-      const NodePtr &parent, const KeyNibbles &key_nibbles, NodePtr node) {
+      const NodePtr &parent, const NibbleSlice &key_nibbles, NodePtr node) {
     using T = PolkadotNode::Type;
 
     // just update the node key and return it as the new root
@@ -83,16 +89,19 @@ namespace kagome::storage::trie {
       node->key_nibbles = key_nibbles;
       return node;
     }
+    // the parent is either changed or replaced, as is every node on the way
+    // to it, since they are inserted to as well
+    parent->merkle_value = boost::none;
 
     switch (parent->getTrieType()) {
       case T::BranchEmptyValue:
       case T::BranchWithValue: {
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
         return updateBranch(parent_as_branch, key_nibbles, node);
       }
       case T::Leaf: {
         // need to convert this leaf into a branch
-        auto br = std::make_shared<BranchNode>();
+        auto br = makeNode<BranchNode>();
         auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
 
         if (parent->key_nibbles == key_nibbles
@@ -101,8 +110,7 @@ namespace kagome::storage::trie {
           return node;
         }
 
-        br->key_nibbles = key_nibbles.subbuffer(0, length);
-        auto parentKey = parent->key_nibbles;
+        br->key_nibbles = key_nibbles.subspan(0, length);
 
         // value goes at this branch
         if (key_nibbles.size() == length) {
@@ -111,14 +119,15 @@ namespace kagome::storage::trie {
           // if we are not replacing previous leaf, then add it as a
           // child to the new branch
           if (parent->key_nibbles.size() > key_nibbles.size()) {
-            parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-            br->children.at(parentKey[length]) = parent;
+            auto parent_idx = parent->key_nibbles[length];
+            parent->key_nibbles = parent->key_nibbles.subspan(length + 1);
+            br->children.at(parent_idx) = parent;
           }
 
           return br;
         }
 
-        node->key_nibbles = key_nibbles.subbuffer(length + 1);
+        node->key_nibbles = key_nibbles.subspan(length + 1);
 
         if (length == parent->key_nibbles.size()) {
           // if leaf's key is covered by this branch, then make the leaf's
@@ -128,8 +137,9 @@ namespace kagome::storage::trie {
         } else {
           // otherwise, make the leaf a child of the branch and update its
           // partial key
-          parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-          br->children.at(parentKey[length]) = parent;
+          auto parent_idx = parent->key_nibbles[length];
+          parent->key_nibbles = parent->key_nibbles.subspan(length + 1);
+          br->children.at(parent_idx) = parent;
           br->children.at(key_nibbles[length]) = node;
         }
 
@@ -141,7 +151,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::updateBranch(
-      BranchPtr parent, const KeyNibbles &key_nibbles, const NodePtr &node) {
+      BranchPtr parent, const NibbleSlice &key_nibbles, const NodePtr &node) {
     auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
 
     if (length == parent->key_nibbles.size()) {
@@ -156,11 +166,11 @@ namespace kagome::storage::trie {
         parent->children.at(key_nibbles[length]) = n;
         return parent;
       }
-      node->key_nibbles = key_nibbles.subbuffer(length + 1);
+      node->key_nibbles = key_nibbles.subspan(length + 1);
       parent->children.at(key_nibbles[length]) = node;
       return parent;
     }
-    auto br = std::make_shared<BranchNode>(key_nibbles.subspan(0, length));
+    auto br = makeNode<BranchNode>(KeyNibbles{key_nibbles.subspan(0, length)});
     auto parentIdx = parent->key_nibbles[length];
     OUTCOME_TRY(
         new_branch,
@@ -181,16 +191,141 @@ namespace kagome::storage::trie {
     if (not root_) {
       return TrieError::NO_VALUE;
     }
-    auto nibbles = PolkadotCodec::keyToNibbles(key);
-    OUTCOME_TRY(node, getNode(root_, nibbles));
+    OUTCOME_TRY(node, getNode(root_, NibbleSlice::fromKey(key)));
     if (node && node->value) {
       return node->value.get();
     }
     return TrieError::NO_VALUE;
   }
 
+  std::vector<outcome::result<common::Buffer>> PolkadotTrieImpl::getMany(
+      const std::vector<common::Buffer> &keys) const {
+    std::vector<outcome::result<common::Buffer>> values(keys.size(),
+                                                        TrieError::NO_VALUE);
+    if (not root_) {
+      return values;
+    }
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) {
+      return keys[lhs] < keys[rhs];
+    });
+
+    std::vector<PathFrame> path;
+    NibbleSlice previous;
+    for (auto i : order) {
+      auto key_nibbles = NibbleSlice::fromKey(keys[i]);
+      // the way to a node depends only on the nibbles of the key before its
+      // partial key, so the nodes found for the previous key up to the end
+      // of the common prefix of the keys are on the way to this key as well
+      auto common_length = key_nibbles.commonPrefixLength(previous);
+      while (not path.empty() and path.back().first > common_length) {
+        path.pop_back();
+      }
+      if (path.empty()) {
+        path.emplace_back(0, root_);
+      }
+      auto node = descend(path, key_nibbles);
+      if (not node) {
+        values[i] = node.error();
+      } else if (node.value() != nullptr and node.value()->value) {
+        values[i] = node.value()->value.get();
+      }
+      previous = key_nibbles;
+    }
+    return values;
+  }
+
+  outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::descend(
+      std::vector<PathFrame> &path, const NibbleSlice &key_nibbles) const {
+    using T = PolkadotNode::Type;
+    while (true) {
+      auto [offset, parent] = path.back();
+      auto rest = key_nibbles.subspan(offset);
+      switch (parent->getTrieType()) {
+        case T::BranchEmptyValue:
+        case T::BranchWithValue: {
+          if (parent->key_nibbles == rest or rest.empty()) {
+            return parent;
+          }
+          if (rest.size() < parent->key_nibbles.size()) {
+            return nullptr;
+          }
+          auto length = getCommonPrefixLength(parent->key_nibbles, rest);
+          auto branch = std::static_pointer_cast<BranchNode>(parent);
+          OUTCOME_TRY(child, retrieveChild(branch, rest[length]));
+          if (child == nullptr) {
+            return nullptr;
+          }
+          path.emplace_back(offset + length + 1, std::move(child));
+          break;
+        }
+        case T::Leaf:
+          if (parent->key_nibbles == rest) {
+            return parent;
+          }
+          return nullptr;
+        case T::Special:
+          return Error::INVALID_NODE_TYPE;
+      }
+    }
+  }
+
+  outcome::result<PolkadotTrie::StoredValue> PolkadotTrieImpl::getStoredValue(
+      const common::Buffer &key, const common::Buffer &known_db_key) const {
+    using T = PolkadotNode::Type;
+    auto key_nibbles = NibbleSlice::fromKey(key);
+    auto node = root_;
+    // key of the node in the storage, known only if it is retrieved on the
+    // way to the key, i.e. is not modified in this trie
+    boost::optional<common::Buffer> db_key;
+    size_t offset = 0;
+    while (node != nullptr) {
+      auto rest = key_nibbles.subspan(offset);
+      switch (node->getTrieType()) {
+        case T::BranchEmptyValue:
+        case T::BranchWithValue: {
+          if (node->key_nibbles == rest or rest.empty()) {
+            if (not node->value) {
+              return TrieError::NO_VALUE;
+            }
+            return StoredValue{std::move(db_key), node->value};
+          }
+          if (rest.size() < node->key_nibbles.size()) {
+            return TrieError::NO_VALUE;
+          }
+          auto length = getCommonPrefixLength(node->key_nibbles, rest);
+          auto branch = std::static_pointer_cast<BranchNode>(node);
+          auto idx = rest[length];
+          const auto &child = branch->children.at(idx);
+          db_key = boost::none;
+          if (child != nullptr and child->isDummy()) {
+            const auto &child_db_key =
+                static_cast<const DummyNode &>(*child).db_key;
+            if (child_db_key == known_db_key) {
+              return StoredValue{child_db_key, boost::none};
+            }
+            db_key = child_db_key;
+          }
+          OUTCOME_TRY(n, retrieveChild(branch, idx));
+          node = std::move(n);
+          offset += length + 1;
+          break;
+        }
+        case T::Leaf:
+          if (node->key_nibbles == rest) {
+            return StoredValue{std::move(db_key), node->value};
+          }
+          return TrieError::NO_VALUE;
+        case T::Special:
+          return Error::INVALID_NODE_TYPE;
+      }
+    }
+    return TrieError::NO_VALUE;
+  }
+
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::getNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) const {
+      NodePtr parent, const NibbleSlice &key_nibbles) const {
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
       return nullptr;
@@ -204,7 +339,7 @@ namespace kagome::storage::trie {
         if (key_nibbles.size() < parent->key_nibbles.size()) {
           return nullptr;
         }
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
         auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
         OUTCOME_TRY(n, retrieveChild(parent_as_branch, key_nibbles[length]));
         return getNode(n, key_nibbles.subspan(length + 1));
@@ -222,7 +357,7 @@ namespace kagome::storage::trie {
 
   outcome::result<std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>>
   PolkadotTrieImpl::getPath(NodePtr parent,
-                            const KeyNibbles &key_nibbles) const {
+                            const NibbleSlice &key_nibbles) const {
     using Path = std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>;
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
@@ -235,13 +370,11 @@ namespace kagome::storage::trie {
         if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
           return Path{};
         }
-        auto common_nibbles =
-            gsl::make_span(parent->key_nibbles.data(), length);
-        if (key_nibbles == common_nibbles
+        if (key_nibbles == parent->key_nibbles.subspan(0, length)
             and key_nibbles.size() < parent->key_nibbles.size()) {
           return Path{};
         }
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
         OUTCOME_TRY(n, retrieveChild(parent_as_branch, key_nibbles[length]));
         OUTCOME_TRY(path, getPath(n, key_nibbles.subspan(length + 1)));
         path.push_front({parent_as_branch, key_nibbles[length]});
@@ -267,7 +400,7 @@ namespace kagome::storage::trie {
       return false;
     }
 
-    auto node = getNode(root_, PolkadotCodec::keyToNibbles(key));
+    auto node = getNode(root_, NibbleSlice::fromKey(key));
     return node.has_value() && (node.value() != nullptr)
            && (node.value()->value);
   }
@@ -278,7 +411,7 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PolkadotTrieImpl::remove(const common::Buffer &key) {
     if (root_) {
-      auto key_nibbles = PolkadotCodec::keyToNibbles(key);
+      auto key_nibbles = NibbleSlice::fromKey(key);
       // delete node will fetch nodes that it needs from the storage (the nodes
       // typically are a path in the trie) and work on them in memory
       OUTCOME_TRY(n, deleteNode(root_, key_nibbles));
@@ -290,7 +423,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::deleteNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) {
+      NodePtr parent, const NibbleSlice &key_nibbles) {
     if (parent == nullptr) {
       return nullptr;
     }
@@ -300,7 +433,8 @@ namespace kagome::storage::trie {
       case T::BranchWithValue:
       case T::BranchEmptyValue: {
         auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
+        parent->merkle_value = boost::none;
         if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
           parent->value = boost::none;
           newRoot = parent;
@@ -325,14 +459,14 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::handleDeletion(
-      const BranchPtr &parent, NodePtr node, const KeyNibbles &key_nibbles) {
+      const BranchPtr &parent, NodePtr node, const NibbleSlice &key_nibbles) {
     auto newRoot = std::move(node);
     auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
     auto bitmap = parent->childrenBitmap();
     // turn branch node left with no children to a leaf node
     if (bitmap == 0 and parent->value) {
-      newRoot = std::make_shared<LeafNode>(key_nibbles.subspan(0, length),
-                                           parent->value);
+      newRoot = makeNode<LeafNode>(KeyNibbles{key_nibbles.subspan(0, length)},
+                                   parent->value);
     } else if (parent->childrenNum() == 1 && !parent->value) {
       size_t idx = 0;
       for (idx = 0; idx < 16; idx++) {
@@ -345,16 +479,15 @@ namespace kagome::storage::trie {
       using T = PolkadotNode::Type;
       if (child->getTrieType() == T::Leaf) {
         auto newKey = parent->key_nibbles;
-        newKey.putUint8(idx);
-        newKey.putBuffer(child->key_nibbles);
-        newRoot = std::make_shared<LeafNode>(newKey, child->value);
+        newKey.putUint8(idx).put(child->key_nibbles);
+        newRoot = makeNode<LeafNode>(std::move(newKey), child->value);
       } else if (child->getTrieType() == T::BranchEmptyValue
                  or child->getTrieType() == T::BranchWithValue) {
-        auto branch = std::make_shared<BranchNode>();
-        branch->key_nibbles.putBuffer(parent->key_nibbles)
+        auto branch = makeNode<BranchNode>();
+        branch->key_nibbles.put(parent->key_nibbles)
             .putUint8(idx)
-            .putBuffer(child->key_nibbles);
-        auto child_as_branch = std::dynamic_pointer_cast<BranchNode>(child);
+            .put(child->key_nibbles);
+        auto child_as_branch = std::static_pointer_cast<BranchNode>(child);
         for (size_t i = 0; i < child_as_branch->children.size(); i++) {
           if (child_as_branch->children.at(i)) {
             branch->children.at(i) = child_as_branch->children.at(i);
@@ -369,7 +502,7 @@ namespace kagome::storage::trie {
 
   outcome::result<std::tuple<PolkadotTrie::NodePtr, size_t>>
   PolkadotTrieImpl::detachNode(const NodePtr &parent,
-                               const KeyNibbles &prefix_nibbles,
+                               const NibbleSlice &prefix_nibbles,
                                const OnDetachCallback &callback) {
     size_t count = 0;
     if (parent == nullptr) {
@@ -377,26 +510,20 @@ namespace kagome::storage::trie {
     }
     if (parent->key_nibbles.size() >= prefix_nibbles.size()) {
       // if this is the node to be detached -- detach it
-      bool prefix_equal = std::equal(prefix_nibbles.begin(),
-                                     prefix_nibbles.end(),
-                                     parent->key_nibbles.begin());
-      if (prefix_equal) {
+      if (NibbleSlice{parent->key_nibbles}.startsWith(prefix_nibbles)) {
         return {nullptr, count};
       }
       return {parent, count};
     }
     // if parent's key is smaller and it is not a prefix of the prefix, don't
     // change anything
-    bool prefix_equal = std::equal(parent->key_nibbles.begin(),
-                                   parent->key_nibbles.end(),
-                                   prefix_nibbles.begin());
-    if (not prefix_equal) {
+    if (not prefix_nibbles.startsWith(parent->key_nibbles)) {
       return {parent, count};
     }
     using T = PolkadotNode::Type;
     if (parent->getTrieType() == T::BranchWithValue
         or parent->getTrieType() == T::BranchEmptyValue) {
-      auto branch = std::dynamic_pointer_cast<BranchNode>(parent);
+      auto branch = std::static_pointer_cast<BranchNode>(parent);
 
       const auto length = parent->key_nibbles.size();
       BOOST_ASSERT(
@@ -410,6 +537,7 @@ namespace kagome::storage::trie {
           tup, detachNode(child, prefix_nibbles.subspan(length + 1), callback));
       auto to_detach = branch->children.at(prefix_nibbles[length]);
       branch->children.at(prefix_nibbles[length]) = std::get<0>(tup);
+      branch->merkle_value = boost::none;
 
       OUTCOME_TRY(size, notifyIsDetached(to_detach, callback));
       return {branch, count + size};
@@ -422,7 +550,7 @@ namespace kagome::storage::trie {
     size_t count = 0;
     if (node) {
       if (node->isBranch()) {
-        auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+        auto branch = std::static_pointer_cast<BranchNode>(node);
         for (auto &child : branch->children) {
           OUTCOME_TRY(size, notifyIsDetached(child, callback));
           count += size;
@@ -442,10 +570,8 @@ namespace kagome::storage::trie {
   }
 
   uint32_t PolkadotTrieImpl::getCommonPrefixLength(
-      const KeyNibbles &first, const KeyNibbles &second) const {
-    auto &&[it1, it2] =
-        std::mismatch(first.begin(), first.end(), second.begin(), second.end());
-    return it1 - first.begin();
+      const NibbleSlice &first, const NibbleSlice &second) const {
+    return first.commonPrefixLength(second);
   }
 
 }  // namespace kagome::storage::trie
@@ -9,6 +9,7 @@
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 
 #include "storage/buffer_map_types.hpp"
+#include "storage/trie/polkadot_trie/node_arena.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
 
 namespace kagome::storage::trie {
@@ -42,10 +43,10 @@ namespace kagome::storage::trie {
     NodePtr getRoot() const override;
 
     outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        NodePtr parent, const NibbleSlice &key_nibbles) const override;
 
     outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        NodePtr parent, const NibbleSlice &key_nibbles) const override;
 
     /**
      * Remove all entries, which key starts with the prefix
@@ -67,43 +68,82 @@ namespace kagome::storage::trie {
     outcome::result<common::Buffer> get(
         const common::Buffer &key) const override;
 
+    /**
+     * Looks the keys up in their sorted order, so that the nodes on the
+     * common part of the paths to neighbouring keys are visited once
+     */
+    std::vector<outcome::result<common::Buffer>> getMany(
+        const std::vector<common::Buffer> &keys) const override;
+
+    outcome::result<StoredValue> getStoredValue(
+        const common::Buffer &key,
+        const common::Buffer &known_db_key) const override;
+
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
 
     bool contains(const common::Buffer &key) const override;
 
     bool empty() const override;
 
+    /**
+     * @returns the arena the nodes created by the trie are allocated in
+     */
+    const NodeArena &arena() const {
+      return *arena_;
+    }
+
    private:
+    // nodes created by the trie live in its arena, so that a trie built for a
+    // batch costs a few large allocations instead of one per node
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeNode(Args &&...args) {
+      return std::allocate_shared<T>(ArenaAllocator<T>{arena_},
+                                     std::forward<Args>(args)...);
+    }
+
+    // a node visited on the way to a key and the position of its partial key
+    // in the key
+    using PathFrame = std::pair<size_t, NodePtr>;
+
+    /**
+     * Continues the lookup of \arg key_nibbles from the last node of \arg
+     * path, appending the visited nodes to it
+     * @returns the node of the key or nullptr if there is none
+     */
+    outcome::result<NodePtr> descend(std::vector<PathFrame> &path,
+                                     const NibbleSlice &key_nibbles) const;
+
     outcome::result<size_t> notifyIsDetached(const NodePtr &parent,
                                              const OnDetachCallback &callback);
 
     outcome::result<NodePtr> insert(const NodePtr &parent,
-                                    const KeyNibbles &key_nibbles,
+                                    const NibbleSlice &key_nibbles,
                                     NodePtr node);
 
     outcome::result<NodePtr> updateBranch(BranchPtr parent,
-                                          const KeyNibbles &key_nibbles,
+                                          const NibbleSlice &key_nibbles,
                                           const NodePtr &node);
 
     outcome::result<NodePtr> deleteNode(NodePtr parent,
-                                        const KeyNibbles &key_nibbles);
+                                        const NibbleSlice &key_nibbles);
     outcome::result<NodePtr> handleDeletion(const BranchPtr &parent,
                                             NodePtr node,
-                                            const KeyNibbles &key_nibbles);
+                                            const NibbleSlice &key_nibbles);
     // remove a node with its children
     outcome::result<std::tuple<NodePtr, size_t>> detachNode(
         const NodePtr &parent,
-        const KeyNibbles &prefix_nibbles,
+        const NibbleSlice &prefix_nibbles,
         const OnDetachCallback &callback);
 
-    uint32_t getCommonPrefixLength(const KeyNibbles &pref1,
-                                   const KeyNibbles &pref2) const;
+    uint32_t getCommonPrefixLength(const NibbleSlice &pref1,
+                                   const NibbleSlice &pref2) const;
 
     outcome::result<NodePtr> retrieveChild(BranchPtr parent,
                                            uint8_t idx) const override;
 
     ChildRetrieveFunctor retrieve_child_;
     NodePtr root_;
+    std::shared_ptr<NodeArena> arena_;
   };
 
 }  // namespace kagome::storage::trie
@@ -30,11 +30,6 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, PolkadotCodec::Error, e) {
 
 namespace kagome::storage::trie {
 
-  inline uint8_t byteFromNibbles(uint8_t high, uint8_t low) {
-    // get low4 from nibbles to avoid check: if(low > 0xff) return error
-    return (high << 4u) | (low & 0xfu);
-  }
-
   inline common::Buffer ushortToBytes(uint16_t b) {
     common::Buffer out(2, 0);
     out[1] = (b >> 8u) & 0xffu;
@@ -42,39 +37,19 @@ namespace kagome::storage::trie {
     return out;
   }
 
-  common::Buffer PolkadotCodec::nibblesToKey(const KeyNibbles &nibbles) {
-    Buffer res;
-    if (nibbles.size() % 2 == 0) {
-      res = Buffer(nibbles.size() / 2, 0);
-      for (size_t i = 0; i < nibbles.size(); i += 2) {
-        res[i / 2] = byteFromNibbles(nibbles[i], nibbles[i + 1]);
-      }
-    } else {
-      res = Buffer(nibbles.size() / 2 + 1, 0);
-      res[0] = nibbles[0];
-      for (size_t i = 2; i < nibbles.size(); i += 2) {
-        res[i / 2] = byteFromNibbles(nibbles[i - 1], nibbles[i]);
-      }
+  common::Buffer PolkadotCodec::nibblesToKey(const NibbleSlice &nibbles) {
+    // an odd number of nibbles is padded with a zero nibble at the front
+    auto padding = nibbles.size() % 2;
+    Buffer res((nibbles.size() + padding) / 2, 0);
+    for (size_t i = 0; i < nibbles.size(); ++i) {
+      auto pos = i + padding;
+      res[pos / 2] |= pos % 2 == 0 ? nibbles[i] << 4u : nibbles[i];
     }
     return res;
   }
 
   KeyNibbles PolkadotCodec::keyToNibbles(const common::Buffer &key) {
-    if (key.empty()) {
-      return {};
-    }
-    if (key.size() == 1 && key[0] == 0) {
-      return KeyNibbles{common::Buffer{0, 0}};
-    }
-
-    auto l = key.size() * 2;
-    KeyNibbles res(common::Buffer(l, 0));
-    for (size_t i = 0; i < key.size(); i++) {
-      res[2 * i] = key[i] >> 4u;
-      res[2 * i + 1] = key[i] & 0xfu;
-    }
-
-    return res;
+    return KeyNibbles{NibbleSlice::fromKey(key)};
   }
 
   common::Buffer PolkadotCodec::merkleValue(const common::Buffer &buf) const {
@@ -101,12 +76,14 @@ namespace kagome::storage::trie {
 
   outcome::result<common::Buffer> PolkadotCodec::encodeNode(
       const Node &node) const {
-    switch (static_cast<PolkadotNode::Type>(node.getType())) {
+    // this codec is only given the nodes of a polkadot trie
+    auto &polkadot_node = static_cast<const PolkadotNode &>(node);
+    switch (polkadot_node.getTrieType()) {
       case PolkadotNode::Type::BranchEmptyValue:
       case PolkadotNode::Type::BranchWithValue:
-        return encodeBranch(dynamic_cast<const BranchNode &>(node));
+        return encodeBranch(static_cast<const BranchNode &>(polkadot_node));
       case PolkadotNode::Type::Leaf:
-        return encodeLeaf(dynamic_cast<const LeafNode &>(node));
+        return encodeLeaf(static_cast<const LeafNode &>(polkadot_node));
 
       case PolkadotNode::Type::Special:
         // special node is not handled right now
@@ -123,11 +100,11 @@ namespace kagome::storage::trie {
 
     uint8_t head = 0;
     // set bits 6..7
-    switch (static_cast<PolkadotNode::Type>(node.getType())) {
+    switch (node.getTrieType()) {
       case PolkadotNode::Type::BranchEmptyValue:
       case PolkadotNode::Type::BranchWithValue:
       case PolkadotNode::Type::Leaf:
-        head = node.getType();
+        head = static_cast<uint8_t>(node.getTrieType());
         break;
       default:
         return Error::UNKNOWN_NODE_TYPE;
@@ -181,9 +158,14 @@ namespace kagome::storage::trie {
       if (child) {
         if (child->isDummy()) {
           auto merkle_value =
-              std::dynamic_pointer_cast<DummyNode>(child)->db_key;
+              std::static_pointer_cast<DummyNode>(child)->db_key;
           OUTCOME_TRY(scale_enc, scale::encode(std::move(merkle_value)));
           encoding.put(scale_enc);
+        } else if (child->merkle_value) {
+          // the subtree of the child is not changed since its merkle value
+          // was calculated
+          OUTCOME_TRY(scale_enc, scale::encode(child->merkle_value.value()));
+          encoding.put(scale_enc);
         } else {
           OUTCOME_TRY(enc, encodeNode(*child));
           OUTCOME_TRY(scale_enc, scale::encode(merkleValue(enc)));
@@ -211,7 +193,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeNode(
-      const common::Buffer &encoded_data) const {
+      gsl::span<const uint8_t> encoded_data) const {
     BufferStream stream{encoded_data};
     // decode the header with the node type and the partial key length
     OUTCOME_TRY(header, decodeHeader(stream));
@@ -274,13 +256,9 @@ namespace kagome::storage::trie {
       }
       partial_key.putUint8(stream.next());
     }
-    // array of nibbles is much more convenient than array of bytes, though it
-    // wastes some memory
-    KeyNibbles partial_key_nibbles = keyToNibbles(partial_key);
-    if (nibbles_num % 2 == 1) {
-      partial_key_nibbles = partial_key_nibbles.subbuffer(1);
-    }
-    return partial_key_nibbles;
+    // the padding nibble of an odd partial key goes first
+    return KeyNibbles{
+        NibbleSlice{partial_key.data(), nibbles_num % 2, nibbles_num}};
   }
 
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeBranch(
@@ -33,7 +33,7 @@ namespace kagome::storage::trie {
     outcome::result<Buffer> encodeNode(const Node &node) const override;
 
     outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const override;
+        gsl::span<const uint8_t> encoded_data) const override;
 
     common::Buffer merkleValue(const Buffer &buf) const override;
 
@@ -48,7 +48,7 @@ namespace kagome::storage::trie {
     /**
      * Collects an array of nibbles to a key
      */
-    static Buffer nibblesToKey(const KeyNibbles &nibbles);
+    static Buffer nibblesToKey(const NibbleSlice &nibbles);
 
     /**
      * Encodes a node header accroding to the specification
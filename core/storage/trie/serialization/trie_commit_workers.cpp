@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_commit_workers.hpp"
+
+#include <future>
+
+#include <boost/asio/post.hpp>
+
+namespace kagome::storage::trie {
+
+  TrieCommitWorkers::TrieCommitWorkers(size_t threads,
+                                       size_t dirty_nodes_threshold)
+      : dirty_nodes_threshold_{dirty_nodes_threshold}, pool_{threads} {}
+
+  TrieCommitWorkers::~TrieCommitWorkers() {
+    pool_.join();
+  }
+
+  size_t TrieCommitWorkers::dirtyNodesThreshold() const {
+    return dirty_nodes_threshold_;
+  }
+
+  void TrieCommitWorkers::runAll(std::vector<std::function<void()>> tasks) {
+    if (tasks.empty()) {
+      return;
+    }
+    std::vector<std::future<void>> done;
+    done.reserve(tasks.size() - 1);
+    for (size_t i = 1; i < tasks.size(); ++i) {
+      auto task =
+          std::make_shared<std::packaged_task<void()>>(std::move(tasks[i]));
+      done.emplace_back(task->get_future());
+      boost::asio::post(pool_, [task] { (*task)(); });
+    }
+    tasks.front()();
+    for (auto &f : done) {
+      f.wait();
+    }
+  }
+
+}  // namespace kagome::storage::trie
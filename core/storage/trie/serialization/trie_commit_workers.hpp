@@ -0,0 +1,47 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_COMMIT_WORKERS
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_COMMIT_WORKERS
+
+#include <functional>
+#include <vector>
+
+#include <boost/asio/thread_pool.hpp>
+
+namespace kagome::storage::trie {
+
+  /**
+   * Threads which encode and hash independent subtrees of a trie being
+   * stored, so that a commit of a large number of modified nodes does not
+   * have to be done on a single thread
+   */
+  class TrieCommitWorkers {
+   public:
+    /**
+     * @param threads number of worker threads
+     * @param dirty_nodes_threshold minimal number of modified nodes in a trie
+     * to store it in parallel
+     */
+    TrieCommitWorkers(size_t threads, size_t dirty_nodes_threshold);
+    ~TrieCommitWorkers();
+
+    size_t dirtyNodesThreshold() const;
+
+    /**
+     * Runs \arg tasks, one of them on the calling thread and the rest on the
+     * workers, and waits for all of them to finish.
+     * Must not be called from a task
+     */
+    void runAll(std::vector<std::function<void()>> tasks);
+
+   private:
+    const size_t dirty_nodes_threshold_;
+    boost::asio::thread_pool pool_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_COMMIT_WORKERS
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+namespace {
+  constexpr auto kLookupsCounterName = "kagome_trie_node_cache_lookups";
+  constexpr auto kEntriesGaugeName = "kagome_trie_node_cache_entries";
+}  // namespace
+
+namespace kagome::storage::trie {
+
+  TrieNodeCache::TrieNodeCache(size_t capacity) : cache_{capacity} {
+    registry_->registerCounterFamily(
+        kLookupsCounterName,
+        "Number of lookups of decoded trie nodes in the cache by result");
+    hits_metric_ = registry_->registerCounterMetric(kLookupsCounterName,
+                                                    {{"result", "hit"}});
+    misses_metric_ = registry_->registerCounterMetric(kLookupsCounterName,
+                                                      {{"result", "miss"}});
+    registry_->registerGaugeFamily(kEntriesGaugeName,
+                                   "Number of decoded trie nodes in the cache");
+    entries_metric_ = registry_->registerGaugeMetric(kEntriesGaugeName);
+  }
+
+  std::shared_ptr<PolkadotNode> TrieNodeCache::get(const common::Buffer &key) {
+    auto node = cache_.get(key);
+    if (node == nullptr) {
+      misses_metric_->inc();
+      return nullptr;
+    }
+    hits_metric_->inc();
+    // the cached node itself is immutable, so it may be copied without the
+    // lock being held
+    return copyNode(*node);
+  }
+
+  void TrieNodeCache::put(const common::Buffer &key, const PolkadotNode &node) {
+    auto copy = copyNode(node);
+    if (copy == nullptr) {
+      return;
+    }
+    // the same merkle value always denotes the same node
+    cache_.put(key, std::move(copy));
+    entries_metric_->set(cache_.entries());
+  }
+
+  size_t TrieNodeCache::size() const {
+    return cache_.entries();
+  }
+
+  size_t TrieNodeCache::capacity() const {
+    return cache_.maxEntries();
+  }
+
+  uint64_t TrieNodeCache::hits() const {
+    return cache_.hits();
+  }
+
+  uint64_t TrieNodeCache::misses() const {
+    return cache_.misses();
+  }
+
+  std::shared_ptr<PolkadotNode> TrieNodeCache::copyNode(
+      const PolkadotNode &node) {
+    using T = PolkadotNode::Type;
+    switch (node.getTrieType()) {
+      case T::BranchEmptyValue:
+      case T::BranchWithValue: {
+        auto &branch = static_cast<const BranchNode &>(node);
+        BOOST_ASSERT(std::all_of(
+            branch.children.begin(),
+            branch.children.end(),
+            [](const auto &child) { return !child || child->isDummy(); }));
+        // children are dummy nodes, which are never modified, so they may be
+        // shared between the copies
+        return std::make_shared<BranchNode>(branch);
+      }
+      case T::Leaf:
+        return std::make_shared<LeafNode>(static_cast<const LeafNode &>(node));
+      case T::Special:
+        break;
+    }
+    // dummy nodes are not worth caching
+    return nullptr;
+  }
+
+}  // namespace kagome::storage::trie
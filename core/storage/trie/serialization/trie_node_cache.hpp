@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
+
+#include <memory>
+
+#include "common/buffer.hpp"
+#include "common/lru_cache.hpp"
+#include "metrics/metrics.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Bounded LRU cache of decoded trie nodes, keyed by their merkle value.
+   * Nodes are content-addressed, so an entry never becomes stale and the
+   * cache may be shared by all the batches of a trie storage.
+   * A trie modifies its nodes in place, so the cache stores its own copy of a
+   * node and hands out a fresh copy on every lookup.
+   * The lookups and the number of nodes kept are exported as metrics.
+   * Thread-safe.
+   */
+  class TrieNodeCache {
+   public:
+    /**
+     * @param capacity max number of nodes kept
+     */
+    explicit TrieNodeCache(size_t capacity);
+
+    /**
+     * @returns a copy of the node stored under the merkle value \arg key, or
+     * nullptr if there is no such node in the cache
+     */
+    std::shared_ptr<PolkadotNode> get(const common::Buffer &key);
+
+    /**
+     * Puts a copy of \arg node to the cache under the merkle value \arg key,
+     * evicting the least recently used node if the cache is full.
+     * Children of a branch node must be dummy nodes
+     */
+    void put(const common::Buffer &key, const PolkadotNode &node);
+
+    size_t size() const;
+    size_t capacity() const;
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+   private:
+    static std::shared_ptr<PolkadotNode> copyNode(const PolkadotNode &node);
+
+    common::LruCache<common::Buffer, PolkadotNode> cache_;
+
+    // metrics
+    metrics::RegistryPtr registry_ = metrics::createRegistry();
+    metrics::Counter *hits_metric_;
+    metrics::Counter *misses_metric_;
+    metrics::Gauge *entries_metric_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
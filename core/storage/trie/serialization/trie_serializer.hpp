@@ -30,6 +30,14 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<RootHash> storeTrie(PolkadotTrie &trie) = 0;
 
+    /**
+     * Calculates the root hash of a trie without writing it to the storage.
+     * Merkle values of the nodes are kept in them, so that only the nodes
+     * changed since the previous calculation are encoded and hashed again
+     */
+    virtual outcome::result<RootHash> calculateRootHash(
+        PolkadotTrie &trie) const = 0;
+
     /**
      * Fetches a trie from the storage. A nullptr is returned in case that there
      * is no entry for provided key.
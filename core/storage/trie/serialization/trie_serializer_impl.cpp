@@ -5,21 +5,127 @@
 
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 
+#include <functional>
+#include <iterator>
+
+#include <boost/optional.hpp>
+
 #include "outcome/outcome.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
+#include "storage/trie/serialization/trie_commit_workers.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/trie_storage_backend.hpp"
 
 namespace kagome::storage::trie {
 
+  namespace {
+    /**
+     * @returns database keys of the children of a stored node, which are all
+     * dummy nodes at this point
+     */
+    std::vector<common::Buffer> childKeys(const PolkadotNode &node) {
+      std::vector<common::Buffer> keys;
+      if (node.isBranch()) {
+        for (auto &child : static_cast<const BranchNode &>(node).children) {
+          if (child != nullptr) {
+            keys.push_back(std::static_pointer_cast<DummyNode>(child)->db_key);
+          }
+        }
+      }
+      return keys;
+    }
+
+    /**
+     * @returns number of the nodes of the subtree \arg node which are not
+     * stored yet, counting up to \arg limit
+     */
+    size_t countDirtyNodes(const PolkadotNode &node, size_t limit) {
+      size_t count = 0;
+      std::vector<const PolkadotNode *> stack{&node};
+      while (not stack.empty() and count < limit) {
+        auto current = stack.back();
+        stack.pop_back();
+        ++count;
+        if (current->isBranch()) {
+          auto branch = static_cast<const BranchNode *>(current);
+          for (auto &child : branch->children) {
+            if (child and not child->isDummy()) {
+              stack.push_back(child.get());
+            }
+          }
+        }
+      }
+      return count;
+    }
+
+    /**
+     * Batch which keeps the written entries in memory, so that the entries of
+     * a subtree stored on a worker thread can be moved to the actual batch
+     */
+    class CollectingBatch : public BufferBatch {
+     public:
+      using Entry = std::pair<common::Buffer, boost::optional<common::Buffer>>;
+
+      outcome::result<void> put(const common::Buffer &key,
+                                const common::Buffer &value) override {
+        entries_.emplace_back(key, value);
+        return outcome::success();
+      }
+
+      outcome::result<void> put(const common::Buffer &key,
+                                common::Buffer &&value) override {
+        entries_.emplace_back(key, std::move(value));
+        return outcome::success();
+      }
+
+      outcome::result<void> remove(const common::Buffer &key) override {
+        entries_.emplace_back(key, boost::none);
+        return outcome::success();
+      }
+
+      outcome::result<void> commit() override {
+        return outcome::success();
+      }
+
+      void clear() override {
+        entries_.clear();
+      }
+
+      /**
+       * Moves the collected entries to \arg batch in the order of writing
+       */
+      outcome::result<void> moveTo(BufferBatch &batch) {
+        for (auto &[key, value] : entries_) {
+          if (value) {
+            OUTCOME_TRY(batch.put(key, std::move(value.value())));
+          } else {
+            OUTCOME_TRY(batch.remove(key));
+          }
+        }
+        entries_.clear();
+        return outcome::success();
+      }
+
+     private:
+      std::vector<Entry> entries_;
+    };
+  }  // namespace
+
   TrieSerializerImpl::TrieSerializerImpl(
       std::shared_ptr<PolkadotTrieFactory> factory,
       std::shared_ptr<Codec> codec,
-      std::shared_ptr<TrieStorageBackend> backend)
+      std::shared_ptr<TrieStorageBackend> backend,
+      std::shared_ptr<TrieNodeCache> node_cache,
+      std::shared_ptr<TriePruner> pruner,
+      std::shared_ptr<TrieCommitWorkers> workers)
       : trie_factory_{std::move(factory)},
         codec_{std::move(codec)},
-        backend_{std::move(backend)} {
+        backend_{std::move(backend)},
+        node_cache_{std::move(node_cache)},
+        pruner_{std::move(pruner)},
+        workers_{std::move(workers)} {
     BOOST_ASSERT(trie_factory_ != nullptr);
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(backend_ != nullptr);
@@ -36,6 +142,38 @@ namespace kagome::storage::trie {
     return storeRootNode(*trie.getRoot());
   }
 
+  outcome::result<RootHash> TrieSerializerImpl::calculateRootHash(
+      PolkadotTrie &trie) const {
+    if (trie.getRoot() == nullptr) {
+      return getEmptyRootHash();
+    }
+    OUTCOME_TRY(merkle_value, calculateMerkleValue(*trie.getRoot()));
+    // the merkle value of a node encoded to less bytes than a hash is the
+    // encoding itself, whereas the root hash is always a hash
+    if (merkle_value.size() < RootHash::size()) {
+      return codec_->hash256(merkle_value);
+    }
+    return RootHash::fromSpan(merkle_value);
+  }
+
+  outcome::result<common::Buffer> TrieSerializerImpl::calculateMerkleValue(
+      PolkadotNode &node) const {
+    if (node.merkle_value) {
+      return node.merkle_value.value();
+    }
+    if (node.isBranch()) {
+      for (auto &child : static_cast<BranchNode &>(node).children) {
+        if (child and not child->isDummy()) {
+          OUTCOME_TRY(calculateMerkleValue(*child));
+        }
+      }
+    }
+    // the codec takes the merkle values of the children from them
+    OUTCOME_TRY(enc, codec_->encodeNode(node));
+    node.merkle_value = codec_->merkleValue(enc);
+    return node.merkle_value.value();
+  }
+
   outcome::result<std::shared_ptr<PolkadotTrie>>
   TrieSerializerImpl::retrieveTrie(const common::Buffer &db_key) const {
     PolkadotTrieFactory::ChildRetrieveFunctor f =
@@ -52,6 +190,8 @@ namespace kagome::storage::trie {
   outcome::result<RootHash> TrieSerializerImpl::storeRootNode(
       PolkadotNode &node) {
     auto batch = backend_->batch();
+    std::vector<TriePruner::StoredNode> stored;
+    auto stored_ptr = pruner_ != nullptr ? &stored : nullptr;
     using T = PolkadotNode::Type;
 
     // if node is a branch node, its children must be stored to the storage
@@ -59,20 +199,38 @@ namespace kagome::storage::trie {
     // of its encoded representation required to save it to the storage
     if (node.getTrieType() == T::BranchEmptyValue
         || node.getTrieType() == T::BranchWithValue) {
-      auto &branch = dynamic_cast<BranchNode &>(node);
-      OUTCOME_TRY(storeChildren(branch, *batch));
+      auto &branch = static_cast<BranchNode &>(node);
+      if (workers_ != nullptr
+          and countDirtyNodes(node, workers_->dirtyNodesThreshold())
+                  >= workers_->dirtyNodesThreshold()) {
+        OUTCOME_TRY(storeChildrenParallel(branch, *batch, stored_ptr));
+      } else {
+        OUTCOME_TRY(storeChildren(branch, *batch, stored_ptr));
+      }
     }
 
     OUTCOME_TRY(enc, codec_->encodeNode(node));
     auto key = codec_->hash256(enc);
+    // the root stays in memory, so a following root calculation is free
+    node.merkle_value = codec_->merkleValue(enc);
     OUTCOME_TRY(batch->put(Buffer{key}, enc));
-    OUTCOME_TRY(batch->commit());
+    if (pruner_ != nullptr) {
+      stored.push_back({Buffer{key}, childKeys(node)});
+      OUTCOME_TRY(pruner_->onNodesStored(stored, *batch));
+    } else {
+      OUTCOME_TRY(batch->commit());
+    }
+    if (node_cache_) {
+      node_cache_->put(Buffer{key}, node);
+    }
 
     return key;
   }
 
   outcome::result<common::Buffer> TrieSerializerImpl::storeNode(
-      PolkadotNode &node, BufferBatch &batch) {
+      PolkadotNode &node,
+      BufferBatch &batch,
+      std::vector<TriePruner::StoredNode> *stored) {
     using T = PolkadotNode::Type;
 
     // if node is a branch node, its children must be stored to the storage
@@ -80,20 +238,30 @@ namespace kagome::storage::trie {
     // of its encoded representation required to save it to the storage
     if (node.getTrieType() == T::BranchEmptyValue
         || node.getTrieType() == T::BranchWithValue) {
-      auto &branch = dynamic_cast<BranchNode &>(node);
-      OUTCOME_TRY(storeChildren(branch, batch));
+      auto &branch = static_cast<BranchNode &>(node);
+      OUTCOME_TRY(storeChildren(branch, batch, stored));
     }
     OUTCOME_TRY(enc, codec_->encodeNode(node));
     auto key = Buffer{codec_->merkleValue(enc)};
     OUTCOME_TRY(batch.put(key, enc));
+    if (stored != nullptr) {
+      stored->push_back({key, childKeys(node)});
+    }
+    if (node_cache_) {
+      // the children have just been replaced with dummy nodes, so the node
+      // looks exactly as it would after being decoded from the storage
+      node_cache_->put(key, node);
+    }
     return key;
   }
 
-  outcome::result<void> TrieSerializerImpl::storeChildren(BranchNode &branch,
-                                                          BufferBatch &batch) {
+  outcome::result<void> TrieSerializerImpl::storeChildren(
+      BranchNode &branch,
+      BufferBatch &batch,
+      std::vector<TriePruner::StoredNode> *stored) {
     for (auto &child : branch.children) {
       if (child and not child->isDummy()) {
-        OUTCOME_TRY(hash, storeNode(*child, batch));
+        OUTCOME_TRY(hash, storeNode(*child, batch, stored));
         // when a node is written to the storage, it is replaced with a dummy
         // node to avoid memory waste
         child = std::make_shared<DummyNode>(hash);
@@ -102,6 +270,64 @@ namespace kagome::storage::trie {
     return outcome::success();
   }
 
+  outcome::result<void> TrieSerializerImpl::storeChildrenParallel(
+      BranchNode &branch,
+      BufferBatch &batch,
+      std::vector<TriePruner::StoredNode> *stored) {
+    std::vector<size_t> dirty;
+    for (size_t i = 0; i < branch.children.size(); ++i) {
+      auto &child = branch.children.at(i);
+      if (child and not child->isDummy()) {
+        dirty.push_back(i);
+      }
+    }
+
+    // a single modified child gives nothing to parallelize, so the split is
+    // looked for deeper in its subtree
+    if (dirty.size() == 1) {
+      auto &child = branch.children.at(dirty.front());
+      if (child->isBranch()) {
+        OUTCOME_TRY(storeChildrenParallel(
+            static_cast<BranchNode &>(*child), batch, stored));
+      }
+      OUTCOME_TRY(hash, storeNode(*child, batch, stored));
+      child = std::make_shared<DummyNode>(hash);
+      return outcome::success();
+    }
+
+    struct Subtree {
+      CollectingBatch batch;
+      std::vector<TriePruner::StoredNode> stored;
+      outcome::result<common::Buffer> key = common::Buffer{};
+    };
+    std::vector<Subtree> subtrees(dirty.size());
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(dirty.size());
+    for (size_t i = 0; i < dirty.size(); ++i) {
+      tasks.emplace_back([&, i] {
+        auto &subtree = subtrees.at(i);
+        subtree.key = storeNode(*branch.children.at(dirty.at(i)),
+                                subtree.batch,
+                                stored != nullptr ? &subtree.stored : nullptr);
+      });
+    }
+    workers_->runAll(std::move(tasks));
+
+    // the entries are written in the same order as a serial store does
+    for (size_t i = 0; i < dirty.size(); ++i) {
+      auto &subtree = subtrees.at(i);
+      OUTCOME_TRY(hash, std::move(subtree.key));
+      OUTCOME_TRY(subtree.batch.moveTo(batch));
+      if (stored != nullptr) {
+        std::move(subtree.stored.begin(),
+                  subtree.stored.end(),
+                  std::back_inserter(*stored));
+      }
+      branch.children.at(dirty.at(i)) = std::make_shared<DummyNode>(hash);
+    }
+    return outcome::success();
+  }
+
   outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::retrieveChild(
       const PolkadotTrie::BranchPtr &parent, uint8_t idx) const {
     if (parent->children.at(idx) == nullptr) {
@@ -109,8 +335,12 @@ namespace kagome::storage::trie {
     }
     if (parent->children.at(idx)->isDummy()) {
       auto dummy =
-          std::dynamic_pointer_cast<DummyNode>(parent->children.at(idx));
+          std::static_pointer_cast<DummyNode>(parent->children.at(idx));
       OUTCOME_TRY(n, retrieveNode(dummy->db_key));
+      // a child is referred to by its merkle value
+      if (n != nullptr) {
+        n->merkle_value = dummy->db_key;
+      }
       parent->children.at(idx) = n;
     }
     return parent->children.at(idx);
@@ -121,9 +351,25 @@ namespace kagome::storage::trie {
     if (db_key.empty() or db_key == getEmptyRootHash()) {
       return nullptr;
     }
-    OUTCOME_TRY(enc, backend_->get(db_key));
-    OUTCOME_TRY(n, codec_->decodeNode(enc));
-    return std::dynamic_pointer_cast<PolkadotNode>(n);
+    if (node_cache_) {
+      if (auto cached = node_cache_->get(db_key); cached != nullptr) {
+        return cached;
+      }
+    }
+    // the node is decoded right from the memory the value is read to
+    std::shared_ptr<Node> n;
+    OUTCOME_TRY(backend_->view(
+        db_key, [&](auto enc) -> outcome::result<void> {
+          OUTCOME_TRY(decoded, codec_->decodeNode(enc));
+          n = std::move(decoded);
+          return outcome::success();
+        }));
+    // the codec decodes polkadot trie nodes only
+    auto node = std::static_pointer_cast<PolkadotNode>(n);
+    if (node_cache_ and node != nullptr) {
+      node_cache_->put(db_key, *node);
+    }
+    return node;
   }
 
 }  // namespace kagome::storage::trie
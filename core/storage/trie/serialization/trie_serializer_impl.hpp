@@ -9,11 +9,14 @@
 #include "storage/trie/serialization/trie_serializer.hpp"
 
 #include "storage/buffer_map_types.hpp"
+#include "storage/trie/impl/trie_pruner.hpp"
 
 namespace kagome::storage::trie {
   class Codec;
   class PolkadotTrieFactory;
   class TrieStorageBackend;
+  class TrieNodeCache;
+  class TrieCommitWorkers;
   struct BranchNode;
   struct PolkadotNode;
 }  // namespace kagome::storage::trie
@@ -22,15 +25,28 @@ namespace kagome::storage::trie {
 
   class TrieSerializerImpl : public TrieSerializer {
    public:
+    /**
+     * @param node_cache optional cache of decoded nodes, which is consulted
+     * before the backend and filled on both reads and writes
+     * @param pruner optional state pruner, which counts the references of the
+     * written nodes
+     * @param workers optional worker threads to store large tries with
+     */
     TrieSerializerImpl(std::shared_ptr<PolkadotTrieFactory> factory,
                        std::shared_ptr<Codec> codec,
-                       std::shared_ptr<TrieStorageBackend> backend);
+                       std::shared_ptr<TrieStorageBackend> backend,
+                       std::shared_ptr<TrieNodeCache> node_cache = nullptr,
+                       std::shared_ptr<TriePruner> pruner = nullptr,
+                       std::shared_ptr<TrieCommitWorkers> workers = nullptr);
     ~TrieSerializerImpl() override = default;
 
     RootHash getEmptyRootHash() const override;
 
     outcome::result<RootHash> storeTrie(PolkadotTrie &trie) override;
 
+    outcome::result<RootHash> calculateRootHash(
+        PolkadotTrie &trie) const override;
+
     outcome::result<std::shared_ptr<PolkadotTrie>> retrieveTrie(
         const common::Buffer &db_key) const override;
 
@@ -38,12 +54,34 @@ namespace kagome::storage::trie {
     /**
      * Writes a node to a persistent storage, recursively storing its
      * descendants as well. Then replaces the node children to dummy nodes to
-     * avoid memory waste
+     * avoid memory waste.
+     * If \arg stored is provided, the written nodes are appended to it, each
+     * one after its children
      */
     outcome::result<RootHash> storeRootNode(PolkadotNode &node);
-    outcome::result<common::Buffer> storeNode(PolkadotNode &node,
-                                              BufferBatch &batch);
-    outcome::result<void> storeChildren(BranchNode &branch, BufferBatch &batch);
+    outcome::result<common::Buffer> storeNode(
+        PolkadotNode &node,
+        BufferBatch &batch,
+        std::vector<TriePruner::StoredNode> *stored);
+    outcome::result<void> storeChildren(
+        BranchNode &branch,
+        BufferBatch &batch,
+        std::vector<TriePruner::StoredNode> *stored);
+    /**
+     * Stores the modified children of \arg branch like storeChildren, but
+     * the independent subtrees are encoded and hashed on the worker threads.
+     * The written entries and nodes are the same as of a serial store
+     */
+    outcome::result<void> storeChildrenParallel(
+        BranchNode &branch,
+        BufferBatch &batch,
+        std::vector<TriePruner::StoredNode> *stored);
+    /**
+     * @returns the merkle value of \arg node, calculating the merkle values of
+     * its changed descendants first and caching them all in the nodes
+     */
+    outcome::result<common::Buffer> calculateMerkleValue(
+        PolkadotNode &node) const;
     /**
      * Fetches a node from the storage. A nullptr is returned in case that there
      * is no entry for provided key. Mind that a branch node will have dummy
@@ -61,6 +99,9 @@ namespace kagome::storage::trie {
     std::shared_ptr<PolkadotTrieFactory> trie_factory_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieStorageBackend> backend_;
+    std::shared_ptr<TrieNodeCache> node_cache_;
+    std::shared_ptr<TriePruner> pruner_;
+    std::shared_ptr<TrieCommitWorkers> workers_;
   };
 }  // namespace kagome::storage::trie
 
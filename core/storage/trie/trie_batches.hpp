@@ -7,6 +7,7 @@
 #define KAGOME_STORAGE_TRIE_IMPL_TRIE_BATCH
 
 #include "storage/buffer_map_types.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
 #include "storage/trie/types.hpp"
 
@@ -30,6 +31,13 @@ namespace kagome::storage::trie {
     virtual outcome::result<std::tuple<bool, uint32_t>> clearPrefix(
         const Buffer &prefix,
         boost::optional<uint64_t> limit = boost::none) = 0;
+
+    /**
+     * Appends \arg item to the SCALE encoded vector stored under \arg key,
+     * or stores a new vector of the item if there is no value
+     */
+    virtual outcome::result<void> append(const Buffer &key,
+                                         const Buffer &item) = 0;
   };
 
   class TopperTrieBatch;
@@ -48,6 +56,13 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<RootHash> commit() = 0;
 
+    /**
+     * Calculates the root of the trie with the changes made in the batch,
+     * leaving them uncommitted
+     * @returns the root the batch would have after commit
+     */
+    virtual outcome::result<RootHash> calculateRoot() = 0;
+
     /**
      * Creates a batch on top of this batch
      */
@@ -58,7 +73,15 @@ namespace kagome::storage::trie {
    * A temporary in-memory trie built on top of a persistent one
    * All changes to it are simply discarded when the batch is destroyed
    */
-  class EphemeralTrieBatch : public TrieBatch {};
+  class EphemeralTrieBatch : public TrieBatch {
+   public:
+    /**
+     * Gets the value of \arg key unless it is held by the node stored under
+     * \arg known_db_key, see PolkadotTrie::getStoredValue()
+     */
+    virtual outcome::result<PolkadotTrie::StoredValue> getStoredValue(
+        const Buffer &key, const Buffer &known_db_key) const = 0;
+  };
 
   /**
    * A batch on top of another batch
@@ -70,6 +93,22 @@ namespace kagome::storage::trie {
      * Writes changes to the parent batch
      */
     virtual outcome::result<void> writeBack() = 0;
+
+    /**
+     * Starts a transaction nested into the batch: the changes made after it
+     * can be rolled back without discarding the earlier changes of the batch
+     */
+    virtual void startTransaction() = 0;
+
+    /**
+     * Discards the changes made since the last started nested transaction
+     */
+    virtual void rollbackTransaction() = 0;
+
+    /**
+     * Finishes the last started nested transaction, keeping its changes
+     */
+    virtual void commitTransaction() = 0;
   };
 
 }  // namespace kagome::storage::trie
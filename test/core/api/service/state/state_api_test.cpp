@@ -18,6 +18,7 @@
 #include "mock/core/storage/trie/trie_batches_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
 #include "primitives/block_header.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 
@@ -77,6 +78,46 @@ namespace kagome::api {
     ASSERT_EQ(r1, "1"_buf);
   }
 
+  /**
+   * @given state api
+   * @when values of several keys are queried at a block
+   * @then the values are read from the state of the block at once @and the
+   * absent keys are reported without a value
+   */
+  TEST(StateApiTest, QueryStorageAt) {
+    auto storage = std::make_shared<TrieStorageMock>();
+    auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+    auto block_tree = std::make_shared<BlockTreeMock>();
+    auto runtime_core = std::make_shared<CoreMock>();
+    auto metadata = std::make_shared<MetadataMock>();
+
+    api::StateApiImpl api{
+        block_header_repo, storage, block_tree, runtime_core, metadata};
+
+    primitives::BlockId bid = "B"_hash256;
+    EXPECT_CALL(*block_header_repo, getBlockHeader(bid))
+        .WillOnce(testing::Return(BlockHeader{.state_root = "ABC"_hash256}));
+    EXPECT_CALL(*storage, getEphemeralBatchAt("ABC"_hash256))
+        .WillOnce(testing::Invoke([](auto &root) {
+          auto batch = std::make_unique<EphemeralTrieBatchMock>();
+          EXPECT_CALL(*batch, get("a"_buf))
+              .WillOnce(testing::Return("1"_buf));
+          EXPECT_CALL(*batch, get("b"_buf))
+              .WillOnce(testing::Return(storage::trie::TrieError::NO_VALUE));
+          return batch;
+        }));
+
+    EXPECT_OUTCOME_TRUE(sets, api.queryStorageAt({"a"_buf, "b"_buf},
+                                                     "B"_hash256));
+    ASSERT_EQ(sets.size(), 1);
+    ASSERT_EQ(sets[0].block, "B"_hash256);
+    ASSERT_EQ(sets[0].changes.size(), 2);
+    ASSERT_EQ(sets[0].changes[0].key, "a"_buf);
+    ASSERT_EQ(sets[0].changes[0].data, boost::make_optional("1"_buf));
+    ASSERT_EQ(sets[0].changes[1].key, "b"_buf);
+    ASSERT_EQ(sets[0].changes[1].data, boost::none);
+  }
+
   class GetKeysPagedTest : public ::testing::Test {
    public:
     void SetUp() override {
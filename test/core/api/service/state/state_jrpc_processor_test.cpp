@@ -29,6 +29,7 @@ class StateJrpcProcessorTest : public testing::Test {
     kCallType_UnsubscribeRuntimeVersion,
     kCallType_GetKeysPaged,
     kCallType_GetStorage,
+    kCallType_QueryStorageAt,
     kCallType_StorageSubscribe,
     kCallType_StorageUnsubscribe,
     kCallType_GetMetadata,
@@ -84,6 +85,11 @@ class StateJrpcProcessorTest : public testing::Test {
           call_contexts_.emplace(std::make_pair(CallType::kCallType_GetStorage,
                                                 CallContext{.handler = f}));
         }));
+    EXPECT_CALL(*server, registerHandler("state_queryStorageAt", _))
+        .WillOnce(testing::Invoke([&](auto &name, auto &&f) {
+          call_contexts_.emplace(std::make_pair(
+              CallType::kCallType_QueryStorageAt, CallContext{.handler = f}));
+        }));
     EXPECT_CALL(*server, registerHandler("state_subscribeStorage", _))
         .WillOnce(testing::Invoke([&](auto &name, auto &&f) {
           call_contexts_.emplace(std::make_pair(
@@ -152,6 +158,37 @@ TEST_F(StateJrpcProcessorTest, ProcessAnotherRequest) {
   ASSERT_EQ(expected_result.asVector(), result_vec);
 }
 
+/**
+ * @given a request of state_queryStorageAt with keys and a block
+ * @when processing it
+ * @then the values of the keys at the block are returned as a change set
+ */
+TEST_F(StateJrpcProcessorTest, ProcessQueryStorageAtRequest) {
+  kagome::primitives::StorageChangeSet change_set{
+      "010203"_hash256, {{"0a"_hex2buf, "0b"_hex2buf}, {"0c"_hex2buf, {}}}};
+  EXPECT_CALL(*state_api,
+              queryStorageAt(std::vector{"0a"_hex2buf, "0c"_hex2buf},
+                             boost::make_optional("010203"_hash256)))
+      .WillOnce(testing::Return(std::vector{change_set}));
+
+  registerHandlers();
+
+  jsonrpc::Request::Parameters params{
+      jsonrpc::Value::Array{"0x0a", "0x0c"},
+      "0x" + ("010203"_hash256).toHex()};
+  auto result = execute(CallType::kCallType_QueryStorageAt, params);
+  auto &sets = result.AsArray();
+  ASSERT_EQ(sets.size(), 1);
+  auto &set = sets[0].AsStruct();
+  ASSERT_EQ(set.at("block").AsString(), "0x" + ("010203"_hash256).toHex());
+  auto &changes = set.at("changes").AsArray();
+  ASSERT_EQ(changes.size(), 2);
+  ASSERT_EQ(changes[0].AsArray()[0].AsString(), "0x0a");
+  ASSERT_EQ(changes[0].AsArray()[1].AsString(), "0x0b");
+  ASSERT_EQ(changes[1].AsArray()[0].AsString(), "0x0c");
+  ASSERT_TRUE(changes[1].AsArray()[1].IsNil());
+}
+
 /**
  * @given a request of state_getStorage with invalid params
  * @when processing it
@@ -500,3 +500,84 @@ TEST_F(AppConfigurationTest, NodeNameAsCommandLineOption) {
       app_config_->initialize_from_args(std::size(args), (char **)args));
   ASSERT_EQ(app_config_->nodeName(), "Alice's node");
 }
+
+/**
+ * @given newly created AppConfigurationImpl
+ * @when trie node cache size is set in command line arguments
+ * @then it replaces the default size
+ */
+TEST_F(AppConfigurationTest, TrieNodeCacheSizeAsCommandLineOption) {
+  char const *args[] = {"/path/",
+                        "--chain",
+                        chain_path.native().c_str(),
+                        "--base-path",
+                        base_path.native().c_str(),
+                        "--trie-node-cache",
+                        "1024"};
+  ASSERT_TRUE(
+      app_config_->initialize_from_args(std::size(args), (char **)args));
+  ASSERT_EQ(app_config_->trieNodeCacheSize(), 1024);
+}
+
+/**
+ * @given newly created AppConfigurationImpl
+ * @when database options are set in command line arguments
+ * @then they are passed to the database config, sizes converted from MiB
+ */
+TEST_F(AppConfigurationTest, DatabaseOptionsAsCommandLineOptions) {
+  char const *args[] = {"/path/",
+                        "--chain",
+                        chain_path.native().c_str(),
+                        "--base-path",
+                        base_path.native().c_str(),
+                        "--db-cache",
+                        "128",
+                        "--db-bloom-bits",
+                        "0",
+                        "--db-write-buffer",
+                        "32",
+                        "--db-max-open-files",
+                        "500",
+                        "--disable-db-compression"};
+  ASSERT_TRUE(
+      app_config_->initialize_from_args(std::size(args), (char **)args));
+  auto &config = app_config_->levelDbConfig();
+  ASSERT_EQ(config.block_cache_size, 128 * 1024 * 1024);
+  ASSERT_EQ(config.bloom_filter_bits, 0);
+  ASSERT_EQ(config.write_buffer_size, 32 * 1024 * 1024);
+  ASSERT_EQ(config.max_open_files, 500);
+  ASSERT_FALSE(config.compression);
+}
+
+/**
+ * @given newly created AppConfigurationImpl
+ * @when wasm execution method is set in command line arguments
+ * @then the runtime is optimized for an accepted value @and an unknown value
+ * is rejected
+ */
+TEST_F(AppConfigurationTest, WasmExecutionAsCommandLineOption) {
+  using RuntimeExecutionMethod = AppConfiguration::RuntimeExecutionMethod;
+  ASSERT_EQ(app_config_->runtimeExecMethod(),
+            RuntimeExecutionMethod::Interpret);
+
+  char const *args[] = {"/path/",
+                        "--chain",
+                        chain_path.native().c_str(),
+                        "--base-path",
+                        base_path.native().c_str(),
+                        "--wasm-execution",
+                        "Optimized"};
+  ASSERT_TRUE(
+      app_config_->initialize_from_args(std::size(args), (char **)args));
+  ASSERT_EQ(app_config_->runtimeExecMethod(), RuntimeExecutionMethod::Optimize);
+
+  char const *invalid_args[] = {"/path/",
+                                "--chain",
+                                chain_path.native().c_str(),
+                                "--base-path",
+                                base_path.native().c_str(),
+                                "--wasm-execution",
+                                "Jit"};
+  ASSERT_FALSE(app_config_->initialize_from_args(std::size(invalid_args),
+                                                 (char **)invalid_args));
+}
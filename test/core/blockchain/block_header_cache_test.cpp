@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::blockchain::BlockHeaderCache;
+using kagome::primitives::BlockHeader;
+
+/**
+ * @given an empty header cache
+ * @when a header is looked up @and then put to the cache and looked up again
+ * @then the first lookup misses @and the second one returns the header
+ */
+TEST(BlockHeaderCacheTest, PutGet) {
+  BlockHeaderCache cache{4};
+  BlockHeader header{.parent_hash = "parent"_hash256, .number = 1};
+
+  ASSERT_EQ(cache.get("block"_hash256), nullptr);
+  cache.put("block"_hash256, header);
+
+  auto cached = cache.get("block"_hash256);
+  ASSERT_NE(cached, nullptr);
+  ASSERT_EQ(*cached, header);
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 1);
+
+  cache.remove("block"_hash256);
+  ASSERT_EQ(cache.get("block"_hash256), nullptr);
+  ASSERT_EQ(cache.size(), 0);
+}
+
+/**
+ * @given a cache full of headers
+ * @when one more header is put
+ * @then the least recently used header is evicted
+ */
+TEST(BlockHeaderCacheTest, EvictsLeastRecentlyUsedHeader) {
+  BlockHeaderCache cache{2};
+  cache.put("block1"_hash256, BlockHeader{.number = 1});
+  cache.put("block2"_hash256, BlockHeader{.number = 2});
+  // the first header becomes the most recently used one
+  ASSERT_NE(cache.get("block1"_hash256), nullptr);
+
+  cache.put("block3"_hash256, BlockHeader{.number = 3});
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_NE(cache.get("block1"_hash256), nullptr);
+  ASSERT_EQ(cache.get("block2"_hash256), nullptr);
+  ASSERT_NE(cache.get("block3"_hash256), nullptr);
+}
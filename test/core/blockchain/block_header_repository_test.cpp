@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "blockchain/impl/key_value_block_header_repository.hpp"
+#include "blockchain/impl/key_value_block_storage.hpp"
 #include "blockchain/impl/storage_util.hpp"
 #include "crypto/hasher/hasher_impl.hpp"
 #include "scale/scale.hpp"
@@ -19,8 +20,10 @@
 #include "testutil/prepare_loggers.hpp"
 #include "testutil/storage/base_leveldb_test.hpp"
 
+using kagome::blockchain::BlockHeaderCache;
 using kagome::blockchain::BlockHeaderRepository;
 using kagome::blockchain::KeyValueBlockHeaderRepository;
+using kagome::blockchain::KeyValueBlockStorage;
 using kagome::blockchain::numberAndHashToLookupKey;
 using kagome::blockchain::numberToIndexKey;
 using kagome::blockchain::prependPrefix;
@@ -28,6 +31,7 @@ using kagome::blockchain::putWithPrefix;
 using kagome::blockchain::prefix::Prefix;
 using kagome::common::Buffer;
 using kagome::common::Hash256;
+using kagome::primitives::Block;
 using kagome::primitives::BlockHeader;
 using kagome::primitives::BlockId;
 using kagome::primitives::BlockNumber;
@@ -150,6 +154,77 @@ TEST_P(BlockHeaderRepository_NumberParametrized_Test, GetHeader) {
   ASSERT_EQ(header_by_num, header_should_be);
 }
 
+/**
+ * @given two stored headers with the same number
+ * @when one of them is marked as the canonical chain block
+ * @then its hash is returned by the number @and the hash of the last stored
+ * one is returned once it is unmarked
+ */
+TEST_F(BlockHeaderRepository_Test, CanonicalHashByNumber) {
+  EXPECT_OUTCOME_TRUE(block_storage,
+                      KeyValueBlockStorage::createWithGenesis(
+                          "genesis_root"_hash256, db_, hasher_, [](auto &) {}));
+  auto fork_header = getDefaultHeader();
+  fork_header.state_root = "fork_root"_hash256;
+  EXPECT_OUTCOME_TRUE(hash, storeHeader(5, getDefaultHeader()));
+  EXPECT_OUTCOME_TRUE(fork_hash, storeHeader(5, fork_header));
+  EXPECT_OUTCOME_TRUE(hash6, storeHeader(6, getDefaultHeader()));
+  EXPECT_OUTCOME_TRUE(hash8, storeHeader(8, getDefaultHeader()));
+
+  EXPECT_OUTCOME_TRUE(last_stored_hash, header_repo_->getHashByNumber(5));
+  ASSERT_EQ(last_stored_hash, fork_hash);
+
+  EXPECT_OUTCOME_TRUE_1(block_storage->updateCanonicalHashes(
+      {}, {{5, hash}, {6, hash6}, {8, hash8}}));
+  EXPECT_OUTCOME_TRUE(canonical_hash, header_repo_->getHashByNumber(5));
+  ASSERT_EQ(canonical_hash, hash);
+
+  // the scan stops at the first unmarked number
+  EXPECT_OUTCOME_TRUE(hashes, block_storage->getCanonicalHashes(5, 8));
+  ASSERT_EQ(hashes, (std::vector<Hash256>{hash, hash6}));
+
+  EXPECT_OUTCOME_TRUE_1(block_storage->updateCanonicalHashes({5}, {}));
+  EXPECT_OUTCOME_TRUE(unmarked_hash, header_repo_->getHashByNumber(5));
+  ASSERT_EQ(unmarked_hash, fork_hash);
+}
+
+/**
+ * @given a header repository and a block storage sharing a header cache
+ * @when a block is put to the storage @and its header is retrieved by the hash
+ * and by the number
+ * @then the header is served from the cache @and it is not found anymore once
+ * the block is removed
+ */
+TEST_F(BlockHeaderRepository_Test, CachedHeader) {
+  auto cache = std::make_shared<BlockHeaderCache>();
+  header_repo_ =
+      std::make_shared<KeyValueBlockHeaderRepository>(db_, hasher_, cache);
+  EXPECT_OUTCOME_TRUE(block_storage,
+                      KeyValueBlockStorage::createWithGenesis(
+                          "genesis_root"_hash256,
+                          db_,
+                          hasher_,
+                          [](auto &) {},
+                          cache));
+
+  auto header = getDefaultHeader();
+  EXPECT_OUTCOME_TRUE(hash, block_storage->putBlock(Block{header, {}}));
+  // the genesis block is cached too
+  ASSERT_EQ(cache->size(), 2);
+
+  EXPECT_OUTCOME_TRUE(header_by_hash, header_repo_->getBlockHeader(hash));
+  EXPECT_OUTCOME_TRUE(header_by_num,
+                      header_repo_->getBlockHeader(header.number));
+  ASSERT_EQ(header_by_hash, header);
+  ASSERT_EQ(header_by_num, header);
+  ASSERT_EQ(cache->hits(), 2);
+  ASSERT_EQ(cache->misses(), 0);
+
+  EXPECT_OUTCOME_TRUE_1(block_storage->removeBlock(hash, header.number));
+  EXPECT_OUTCOME_FALSE(err, header_repo_->getBlockHeader(hash));
+  ASSERT_EQ(err, kagome::blockchain::Error::BLOCK_NOT_FOUND);
+}
+
 INSTANTIATE_TEST_CASE_P(Numbers,
                         BlockHeaderRepository_NumberParametrized_Test,
                         testing::ValuesIn(ParamValues));
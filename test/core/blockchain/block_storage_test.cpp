@@ -50,10 +50,8 @@ class BlockStorageTest : public testing::Test {
 
   std::shared_ptr<KeyValueBlockStorage> createWithGenesis() {
     EXPECT_CALL(*hasher, blake2b_256(_))
-        // calculate hash of genesis block at check existance of block
-        .WillOnce(Return(genesis_block_hash))
-        // calculate hash of genesis block at put block header
-        .WillRepeatedly(Return(genesis_block_hash));
+        // calculate hash of genesis block once for the whole insertion
+        .WillOnce(Return(genesis_block_hash));
 
     EXPECT_CALL(*storage, get(_))
         // trying to get last finalized block hash which not exists yet
@@ -171,9 +169,8 @@ TEST_F(BlockStorageTest, CreateWithStorageError) {
 TEST_F(BlockStorageTest, PutBlock) {
   auto block_storage = createWithGenesis();
 
-  EXPECT_CALL(*hasher, blake2b_256(_))
-      .WillOnce(Return(regular_block_hash))
-      .WillOnce(Return(regular_block_hash));
+  // the header is hashed once for both the existence check and the put
+  EXPECT_CALL(*hasher, blake2b_256(_)).WillOnce(Return(regular_block_hash));
 
   EXPECT_CALL(*storage, get(_))
       .WillOnce(Return(kagome::blockchain::Error::BLOCK_NOT_FOUND))
@@ -22,6 +22,14 @@
 #include "primitives/block_id.hpp"
 #include "primitives/justification.hpp"
 #include "scale/scale.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_pruner.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 #include "testutil/prepare_loggers.hpp"
 
@@ -37,6 +45,7 @@ using namespace std::chrono_literals;
 
 using prefix::Prefix;
 using testing::_;
+using testing::Invoke;
 using testing::Return;
 
 struct BlockTreeTest : public testing::Test {
@@ -55,14 +64,6 @@ struct BlockTreeTest : public testing::Test {
     EXPECT_CALL(*header_repo_, getHashByNumber(kFinalizedBlockInfo.number))
         .WillRepeatedly(Return(kFinalizedBlockInfo.hash));
 
-    auto chain_events_engine =
-        std::make_shared<primitives::events::ChainSubscriptionEngine>();
-    auto ext_events_engine =
-        std::make_shared<primitives::events::ExtrinsicSubscriptionEngine>();
-
-    auto extrinsic_event_key_repo =
-        std::make_shared<subscription::ExtrinsicEventKeyRepository>();
-
     clock_ = std::make_shared<SystemClockMock>();
 
     babe_config_ = std::make_shared<primitives::BabeConfiguration>();
@@ -75,6 +76,59 @@ struct BlockTreeTest : public testing::Test {
     babe_util_ = std::make_shared<BabeUtilMock>();
     EXPECT_CALL(*babe_util_, slotToEpoch(_)).WillRepeatedly(Return(0));
 
+    // the canonical chain index is kept in memory
+    EXPECT_CALL(*storage_, getCanonicalHash(_))
+        .WillRepeatedly(Invoke(
+            [this](BlockNumber number)
+                -> outcome::result<boost::optional<BlockHash>> {
+              if (auto it = canonical_hashes_.find(number);
+                  it != canonical_hashes_.end()) {
+                return boost::make_optional(it->second);
+              }
+              return boost::optional<BlockHash>{};
+            }));
+    EXPECT_CALL(*storage_, getCanonicalHashes(_, _))
+        .WillRepeatedly(Invoke([this](BlockNumber from, BlockNumber to)
+                                   -> outcome::result<std::vector<BlockHash>> {
+          std::vector<BlockHash> hashes;
+          for (auto number = from;
+               number <= to and canonical_hashes_.count(number) != 0;
+               ++number) {
+            hashes.push_back(canonical_hashes_.at(number));
+          }
+          return hashes;
+        }));
+    EXPECT_CALL(*storage_, updateCanonicalHashes(_, _))
+        .WillRepeatedly(
+            Invoke([this](const std::vector<BlockNumber> &removed,
+                          const std::vector<BlockInfo> &marked)
+                       -> outcome::result<void> {
+              ++canonical_writes_;
+              for (auto number : removed) {
+                canonical_hashes_.erase(number);
+              }
+              for (const auto &block : marked) {
+                canonical_hashes_[block.number] = block.hash;
+              }
+              return outcome::success();
+            }));
+
+    initBlockTree(nullptr);
+  }
+
+  /**
+   * Creates the block tree starting from the last finalized block, which
+   * tells \arg state_pruner the states of its blocks
+   */
+  void initBlockTree(std::shared_ptr<trie::TriePruner> state_pruner) {
+    auto chain_events_engine =
+        std::make_shared<primitives::events::ChainSubscriptionEngine>();
+    auto ext_events_engine =
+        std::make_shared<primitives::events::ExtrinsicSubscriptionEngine>();
+
+    auto extrinsic_event_key_repo =
+        std::make_shared<subscription::ExtrinsicEventKeyRepository>();
+
     block_tree_ = BlockTreeImpl::create(header_repo_,
                                         storage_,
                                         kLastFinalizedBlockId,
@@ -85,7 +139,9 @@ struct BlockTreeTest : public testing::Test {
                                         extrinsic_event_key_repo,
                                         runtime_core_,
                                         babe_config_,
-                                        babe_util_)
+                                        babe_util_,
+                                        nullptr,
+                                        std::move(state_pruner))
                       .value();
   }
 
@@ -94,10 +150,10 @@ struct BlockTreeTest : public testing::Test {
    * @return block, which was added, along with its hash
    */
   BlockHash addBlock(const Block &block) {
-    auto encoded_block = scale::encode(block).value();
-    auto hash = hasher_->blake2b_256(encoded_block);
+    auto hash = hasher_->blake2b_256(scale::encode(block.header).value());
 
-    EXPECT_CALL(*storage_, putBlock(block)).WillRepeatedly(Return(hash));
+    EXPECT_CALL(*storage_, putBlock(_, block.body))
+        .WillRepeatedly(Return(outcome::success()));
     EXPECT_TRUE(block_tree_->addBlock(block));
 
     EXPECT_CALL(*header_repo_, getBlockHeader(primitives::BlockId(hash)))
@@ -116,6 +172,65 @@ struct BlockTreeTest : public testing::Test {
     return addBlock(Block{header, {}});
   }
 
+  /**
+   * Creates the block tree telling the states of its blocks to a pruner of
+   * the trie storage kept in memory
+   */
+  void initPrunedBlockTree() {
+    auto db = std::make_shared<InMemoryStorage>();
+    state_backend_ =
+        std::make_shared<trie::TrieStorageBackendImpl>(db, Buffer{1});
+    auto codec = std::make_shared<trie::PolkadotCodec>();
+    auto factory = std::make_shared<trie::PolkadotTrieFactoryImpl>();
+    state_pruner_ = trie::TriePruner::create(
+                        db, state_backend_, codec, Buffer{2}, Buffer{3}, 1)
+                        .value();
+    state_serializer_ = std::make_shared<trie::TrieSerializerImpl>(
+        factory, codec, state_backend_, nullptr, state_pruner_);
+    trie_storage_ = trie::TrieStorageImpl::createEmpty(
+                        factory, codec, state_serializer_, boost::none)
+                        .value();
+
+    EXPECT_CALL(*storage_, getBlockHeader(kLastFinalizedBlockId))
+        .WillOnce(Return(finalized_block_header_));
+    initBlockTree(state_pruner_);
+  }
+
+  /**
+   * @returns root of a new state of the trie storage keeping \arg value
+   */
+  trie::RootHash commitState(const Buffer &value) {
+    auto batch =
+        trie_storage_
+            ->getPersistentBatchAt(state_serializer_->getEmptyRootHash())
+            .value();
+    EXPECT_OUTCOME_TRUE_1(batch->put("01"_buf, value));
+    return batch->commit().value();
+  }
+
+  /**
+   * Expects the block with \arg header and \arg hash to be discarded on
+   * finalization exactly once
+   */
+  void expectDiscarded(const BlockHeader &header, const BlockHash &hash) {
+    EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash)))
+        .WillRepeatedly(Return(outcome::success(header)));
+    EXPECT_CALL(*storage_, getBlockBody(primitives::BlockId(hash)))
+        .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+    EXPECT_CALL(*storage_, removeBlock(hash, header.number))
+        .WillOnce(Return(outcome::success()));
+  }
+
+  /**
+   * Expects the block with \arg header and \arg hash to be finalized
+   */
+  void expectFinalized(const BlockHeader &header, const BlockHash &hash) {
+    EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash)))
+        .WillRepeatedly(Return(outcome::success(header)));
+    EXPECT_CALL(*storage_, getBlockBody(primitives::BlockId(hash)))
+        .WillRepeatedly(Return(outcome::success(BlockBody{})));
+  }
+
   const BlockInfo kFinalizedBlockInfo{
       42ul, BlockHash::fromString("andj4kdn4odnfkslfn3k4jdnbmeodkv4").value()};
 
@@ -141,6 +256,16 @@ struct BlockTreeTest : public testing::Test {
 
   std::shared_ptr<BlockTreeImpl> block_tree_;
 
+  // set by initPrunedBlockTree()
+  std::shared_ptr<trie::TrieStorageBackendImpl> state_backend_;
+  std::shared_ptr<trie::TriePruner> state_pruner_;
+  std::shared_ptr<trie::TrieSerializerImpl> state_serializer_;
+  std::unique_ptr<trie::TrieStorageImpl> trie_storage_;
+
+  // the canonical chain index and the number of writes to it
+  std::map<BlockNumber, BlockHash> canonical_hashes_;
+  size_t canonical_writes_ = 0;
+
   const BlockId kLastFinalizedBlockId = kFinalizedBlockInfo.hash;
 
   BlockHeader finalized_block_header_{.number = kFinalizedBlockInfo.number,
@@ -263,6 +388,307 @@ TEST_F(BlockTreeTest, Finalize) {
   ASSERT_EQ(block_tree_->getLastFinalized().hash, hash);
 }
 
+/**
+ * @given block tree with a long chain and a fork off it
+ * @when checking whether there is a direct chain between its blocks
+ * @then only the blocks on the same branch are in a direct chain
+ */
+TEST_F(BlockTreeTest, HasDirectChain) {
+  // GIVEN
+  std::vector<BlockHash> chain{kFinalizedBlockInfo.hash};
+  for (auto i = 0; i < 20; ++i) {
+    chain.push_back(addHeaderToRepository(
+        chain.back(), kFinalizedBlockInfo.number + chain.size()));
+  }
+  BlockHeader fork_header{.parent_hash = chain[5],
+                          .number = kFinalizedBlockInfo.number + 6,
+                          .digest = {Consensus{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+
+  // WHEN & THEN
+  ASSERT_TRUE(block_tree_->hasDirectChain(chain[0], chain[20]));
+  ASSERT_TRUE(block_tree_->hasDirectChain(chain[3], chain[17]));
+  ASSERT_TRUE(block_tree_->hasDirectChain(chain[7], chain[7]));
+  ASSERT_FALSE(block_tree_->hasDirectChain(chain[20], chain[3]));
+  ASSERT_TRUE(block_tree_->hasDirectChain(chain[5], fork_hash));
+  ASSERT_FALSE(block_tree_->hasDirectChain(chain[6], fork_hash));
+  ASSERT_FALSE(block_tree_->hasDirectChain(fork_hash, chain[20]));
+}
+
+/**
+ * @given block tree with a fork off a non-finalized block
+ * @when finalizing a block on the other branch of the fork
+ * @then the fork @and the ancestors of the finalized block are not in the
+ * tree anymore
+ */
+TEST_F(BlockTreeTest, FinalizeForgetsPrunedBlocks) {
+  // GIVEN
+  auto hash1 = addHeaderToRepository(kLastFinalizedBlockId,
+                                     kFinalizedBlockInfo.number + 1);
+  BlockHeader header2{.parent_hash = hash1,
+                      .number = kFinalizedBlockInfo.number + 2,
+                      .digest = {PreRuntime{}}};
+  auto hash2 = addBlock(Block{header2, {}});
+  BlockHeader fork_header{.parent_hash = hash1,
+                          .number = kFinalizedBlockInfo.number + 2,
+                          .digest = {Consensus{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash2)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(justification, hash2, header2.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockBody(primitives::BlockId(fork_hash)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, removeBlock(fork_hash, fork_header.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash2))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash2)))
+      .WillRepeatedly(Return(outcome::success(header2)));
+  EXPECT_CALL(*storage_, getBlockBody(primitives::BlockId(hash2)))
+      .WillOnce(Return(outcome::success(BlockBody{})));
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash2, justification));
+
+  // THEN
+  EXPECT_OUTCOME_TRUE(children, block_tree_->getChildren(hash2));
+  ASSERT_TRUE(children.empty());
+  for (const auto &hash : {fork_hash, hash1, kFinalizedBlockInfo.hash}) {
+    EXPECT_OUTCOME_FALSE(err, block_tree_->getChildren(hash));
+    ASSERT_EQ(err, BlockTreeError::NO_SUCH_BLOCK);
+  }
+}
+
+/**
+ * @given block tree pruning the states of its blocks @and a fork off the last
+ * finalized block
+ * @when finalizing a block on the other branch
+ * @then the fork is removed along with its state @and the finalized state is
+ * kept
+ */
+TEST_F(BlockTreeTest, FinalizeReleasesForksOffLastFinalized) {
+  // GIVEN
+  initPrunedBlockTree();
+
+  BlockHeader header1{.parent_hash = kFinalizedBlockInfo.hash,
+                      .number = kFinalizedBlockInfo.number + 1,
+                      .state_root = commitState("a"_buf),
+                      .digest = {PreRuntime{}}};
+  auto hash1 = addBlock(Block{header1, {}});
+  BlockHeader fork_header{.parent_hash = kFinalizedBlockInfo.hash,
+                          .number = kFinalizedBlockInfo.number + 1,
+                          .state_root = commitState("b"_buf),
+                          .digest = {Consensus{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+  ASSERT_TRUE(state_pruner_->hasState(fork_header.state_root).value());
+
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash1)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(justification, hash1, header1.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash1))
+      .WillOnce(Return(outcome::success()));
+  expectDiscarded(fork_header, fork_hash);
+  expectFinalized(header1, hash1);
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash1, justification));
+
+  // THEN
+  ASSERT_FALSE(state_pruner_->hasState(fork_header.state_root).value());
+  ASSERT_FALSE(state_backend_->contains(Buffer{fork_header.state_root}));
+  ASSERT_TRUE(state_pruner_->hasState(header1.state_root).value());
+  EXPECT_OUTCOME_FALSE(err, block_tree_->getChildren(fork_hash));
+  ASSERT_EQ(err, BlockTreeError::NO_SUCH_BLOCK);
+}
+
+/**
+ * @given block tree pruning the states of its blocks @and a fork of three
+ * blocks off a non-finalized block
+ * @when finalizing a block on the other branch
+ * @then each block of the fork, its tip included, is removed once along with
+ * its state
+ */
+TEST_F(BlockTreeTest, FinalizeReleasesLongForks) {
+  // GIVEN
+  initPrunedBlockTree();
+
+  BlockHeader header1{.parent_hash = kFinalizedBlockInfo.hash,
+                      .number = kFinalizedBlockInfo.number + 1,
+                      .state_root = commitState("a"_buf),
+                      .digest = {PreRuntime{}}};
+  auto hash1 = addBlock(Block{header1, {}});
+  BlockHeader header2{.parent_hash = hash1,
+                      .number = header1.number + 1,
+                      .state_root = commitState("b"_buf),
+                      .digest = {PreRuntime{}}};
+  auto hash2 = addBlock(Block{header2, {}});
+
+  std::vector<BlockHeader> fork_headers;
+  std::vector<BlockHash> fork_hashes;
+  auto fork_parent = hash1;
+  auto fork_number = header1.number;
+  for (auto value : {"c"_buf, "d"_buf, "e"_buf}) {
+    fork_headers.push_back(BlockHeader{.parent_hash = fork_parent,
+                                       .number = ++fork_number,
+                                       .state_root = commitState(value),
+                                       .digest = {Consensus{}}});
+    fork_parent = addBlock(Block{fork_headers.back(), {}});
+    fork_hashes.push_back(fork_parent);
+  }
+
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash2)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(justification, hash2, header2.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash2))
+      .WillOnce(Return(outcome::success()));
+  for (size_t i = 0; i < fork_hashes.size(); ++i) {
+    expectDiscarded(fork_headers[i], fork_hashes[i]);
+  }
+  expectFinalized(header1, hash1);
+  expectFinalized(header2, hash2);
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash2, justification));
+
+  // THEN
+  for (size_t i = 0; i < fork_hashes.size(); ++i) {
+    ASSERT_FALSE(state_pruner_->hasState(fork_headers[i].state_root).value());
+    ASSERT_FALSE(
+        state_backend_->contains(Buffer{fork_headers[i].state_root}));
+    EXPECT_OUTCOME_FALSE(err, block_tree_->getChildren(fork_hashes[i]));
+    ASSERT_EQ(err, BlockTreeError::NO_SUCH_BLOCK);
+  }
+  ASSERT_TRUE(state_pruner_->hasState(header2.state_root).value());
+}
+
+/**
+ * @given block tree with a chain of blocks
+ * @when a fork off the chain becomes the best chain @and then the other branch
+ * is finalized
+ * @then the canonical chain index follows the best chain @and then the
+ * finalized one
+ */
+TEST_F(BlockTreeTest, CanonicalChainFollowsBestChain) {
+  // GIVEN
+  auto hash1 = addHeaderToRepository(kLastFinalizedBlockId,
+                                     kFinalizedBlockInfo.number + 1);
+  BlockHeader header2{.parent_hash = hash1,
+                      .number = kFinalizedBlockInfo.number + 2,
+                      .digest = {PreRuntime{}}};
+  auto hash2 = addBlock(Block{header2, {}});
+  ASSERT_EQ(canonical_hashes_,
+            (std::map<BlockNumber, BlockHash>{
+                {kFinalizedBlockInfo.number, kFinalizedBlockInfo.hash},
+                {header2.number - 1, hash1},
+                {header2.number, hash2}}));
+
+  // WHEN
+  BlockHeader fork_header2{.parent_hash = hash1,
+                           .number = header2.number,
+                           .digest = {Consensus{}}};
+  auto fork_hash2 = addBlock(Block{fork_header2, {}});
+  auto fork_hash3 = addHeaderToRepository(fork_hash2, header2.number + 1);
+
+  // THEN
+  ASSERT_EQ(canonical_hashes_,
+            (std::map<BlockNumber, BlockHash>{
+                {kFinalizedBlockInfo.number, kFinalizedBlockInfo.hash},
+                {header2.number - 1, hash1},
+                {header2.number, fork_hash2},
+                {header2.number + 1, fork_hash3}}));
+
+  // WHEN
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash2)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(justification, hash2, header2.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockBody(_))
+      .WillRepeatedly(Return(outcome::success(BlockBody{})));
+  EXPECT_CALL(*storage_, removeBlock(_, _))
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash2))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash2)))
+      .WillRepeatedly(Return(outcome::success(header2)));
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+  ASSERT_TRUE(block_tree_->finalize(hash2, justification));
+
+  // THEN
+  ASSERT_EQ(canonical_hashes_,
+            (std::map<BlockNumber, BlockHash>{
+                {kFinalizedBlockInfo.number, kFinalizedBlockInfo.hash},
+                {header2.number - 1, hash1},
+                {header2.number, hash2}}));
+}
+
+/**
+ * @given block tree with a best chain of three blocks @and a fork of one block
+ * off its first block
+ * @when the fork is finalized, so the best chain becomes shorter
+ * @then the canonical chain index is switched to the fork in a single write,
+ * the numbers past the fork unmarked
+ */
+TEST_F(BlockTreeTest, CanonicalChainSwitchesToShorterForkAtOnce) {
+  // GIVEN
+  auto hash1 = addHeaderToRepository(kLastFinalizedBlockId,
+                                     kFinalizedBlockInfo.number + 1);
+  auto hash2 = addHeaderToRepository(hash1, kFinalizedBlockInfo.number + 2);
+  auto hash3 = addHeaderToRepository(hash2, kFinalizedBlockInfo.number + 3);
+  BlockHeader fork_header{.parent_hash = hash1,
+                          .number = kFinalizedBlockInfo.number + 2,
+                          .digest = {Consensus{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+  ASSERT_EQ(canonical_hashes_,
+            (std::map<BlockNumber, BlockHash>{
+                {kFinalizedBlockInfo.number, kFinalizedBlockInfo.hash},
+                {fork_header.number - 1, hash1},
+                {fork_header.number, hash2},
+                {fork_header.number + 1, hash3}}));
+
+  // WHEN
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(fork_hash)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_,
+              putJustification(justification, fork_hash, fork_header.number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockBody(_))
+      .WillRepeatedly(Return(outcome::success(BlockBody{})));
+  EXPECT_CALL(*storage_, removeBlock(_, _))
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(fork_hash))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(fork_hash)))
+      .WillRepeatedly(Return(outcome::success(fork_header)));
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+  canonical_writes_ = 0;
+  ASSERT_TRUE(block_tree_->finalize(fork_hash, justification));
+
+  // THEN
+  ASSERT_EQ(canonical_writes_, 1u);
+  ASSERT_EQ(canonical_hashes_,
+            (std::map<BlockNumber, BlockHash>{
+                {kFinalizedBlockInfo.number, kFinalizedBlockInfo.hash},
+                {fork_header.number - 1, hash1},
+                {fork_header.number, fork_hash}}));
+}
+
 /**
  * @given block tree with at least three blocks inside
  * @when asking for chain from the lowest block to the closest finalized one
@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/lru_cache.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using kagome::common::LruCache;
+
+using Cache = LruCache<int, std::string>;
+
+std::shared_ptr<const std::string> makeValue(std::string value) {
+  return std::make_shared<const std::string>(std::move(value));
+}
+
+/**
+ * @given a cache of two entries with two values
+ * @when the first one is used @and a third value is put
+ * @then the second value, which is the least recently used one, is evicted
+ */
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+  Cache cache{2};
+  cache.put(1, makeValue("a"));
+  cache.put(2, makeValue("b"));
+  ASSERT_EQ(*cache.get(1), "a");
+
+  cache.put(3, makeValue("c"));
+
+  ASSERT_EQ(cache.entries(), 2);
+  ASSERT_EQ(cache.get(2), nullptr);
+  ASSERT_EQ(*cache.get(1), "a");
+  ASSERT_EQ(*cache.get(3), "c");
+  ASSERT_EQ(cache.hits(), 3);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+/**
+ * @given a cache bounded by the total size of its values
+ * @when values exceeding the bound in total are put
+ * @then the least recently used ones are evicted until the values fit
+ * @and a value larger than the bound is not kept at all
+ */
+TEST(LruCacheTest, KeepsWithinMaxSize) {
+  Cache cache{10, 5};
+  cache.put(1, makeValue("aa"), 2);
+  cache.put(2, makeValue("bb"), 2);
+  cache.put(3, makeValue("ccc"), 3);
+
+  ASSERT_EQ(cache.size(), 5);
+  ASSERT_EQ(cache.get(1), nullptr);
+  ASSERT_NE(cache.get(2), nullptr);
+
+  cache.put(4, makeValue("dddddd"), 6);
+  ASSERT_EQ(cache.get(4), nullptr);
+  ASSERT_EQ(cache.size(), 5);
+}
+
+/**
+ * @given a cache with a value
+ * @when the value is removed
+ * @then it is not found @and its size is not accounted anymore
+ */
+TEST(LruCacheTest, Remove) {
+  Cache cache{2, 10};
+  cache.put(1, makeValue("aaa"), 3);
+  cache.remove(1);
+
+  ASSERT_EQ(cache.get(1), nullptr);
+  ASSERT_EQ(cache.entries(), 0);
+  ASSERT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,296 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/babe_synchronizer_impl.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/asio/io_context.hpp>
+
+#include "mock/core/application/app_configuration_mock.hpp"
+#include "mock/core/blockchain/block_header_repository_mock.hpp"
+#include "mock/core/network/peer_manager_mock.hpp"
+#include "mock/core/network/router_mock.hpp"
+#include "mock/core/network/sync_protocol_mock.hpp"
+#include "network/protocols/protocol_error.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace kagome;
+using application::AppConfigurationMock;
+using blockchain::BlockHeaderRepositoryMock;
+using consensus::BabeSynchronizerImpl;
+using network::BlocksRequest;
+using network::BlocksResponse;
+using network::PeerManagerMock;
+using network::RouterMock;
+using network::SyncProtocolMock;
+using primitives::BlockData;
+using primitives::BlockHash;
+using primitives::BlockHeader;
+using primitives::BlockNumber;
+using PeerId = libp2p::peer::PeerId;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class BabeSynchronizerTest : public testing::Test {
+ public:
+  using ResponseHandler =
+      std::function<void(outcome::result<BlocksResponse>)>;
+
+  /// Max number of blocks in a response, so in a chunk
+  static constexpr uint32_t kChunkSize = 2;
+
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    EXPECT_CALL(app_config_, maxBlocksInResponse())
+        .WillRepeatedly(Return(kChunkSize));
+    EXPECT_CALL(*router_, getSyncProtocol())
+        .WillRepeatedly(Return(sync_protocol_));
+
+    // the sent requests are answered by the tests
+    EXPECT_CALL(*sync_protocol_, requestProxy(_, _, _))
+        .WillRepeatedly(Invoke([this](const PeerId &peer_id,
+                                      const BlocksRequest &request,
+                                      const ResponseHandler &handler) {
+          requests_.push_back({peer_id, request, handler});
+        }));
+
+    EXPECT_CALL(*peer_manager_, forEachPeer(_))
+        .WillRepeatedly(
+            Invoke([this](std::function<void(const PeerId &)> func) {
+              for (const auto &peer : peers_) {
+                func(peer);
+              }
+            }));
+
+    // a chain of blocks, the synchronization starts from the first one
+    BlockHash parent_hash{};
+    for (BlockNumber number = 0; number <= 6; ++number) {
+      BlockHash hash{};
+      hash[0] = number + 1;
+      chain_.push_back(BlockData{
+          .hash = hash,
+          .header = BlockHeader{.parent_hash = parent_hash, .number = number}});
+      parent_hash = hash;
+    }
+    EXPECT_CALL(*header_repo_, getNumberByHash(chain_.front().hash))
+        .WillRepeatedly(Return(BlockNumber{0}));
+
+    synchronizer_ = std::make_shared<BabeSynchronizerImpl>(
+        app_config_, router_, peer_manager_, header_repo_, io_context_);
+    synchronizer_->setChunkTimeout(std::chrono::milliseconds(1));
+  }
+
+  /**
+   * Makes \arg peer_id known to the peer manager as the one having the blocks
+   * of the chain up to \arg best_number
+   */
+  void addPeer(const PeerId &peer_id, BlockNumber best_number) {
+    peers_.push_back(peer_id);
+    network::Status status;
+    status.best_block = {best_number, chain_.at(best_number).hash};
+    EXPECT_CALL(*peer_manager_, getPeerStatus(peer_id))
+        .WillRepeatedly(Return(status));
+  }
+
+  /**
+   * Requests the blocks of the chain from the first one up to the one with
+   * \arg to number as announced by \arg peer_id
+   */
+  void requestBlocks(const PeerId &peer_id, BlockNumber to) {
+    synchronizer_->request(
+        chain_.front().hash, chain_.at(to).hash, peer_id, [this](auto blocks) {
+          if (not blocks) {
+            results_.emplace_back(boost::none);
+            return;
+          }
+          std::vector<BlockHash> hashes;
+          for (const auto &block : blocks->get()) {
+            hashes.push_back(block.hash);
+          }
+          results_.emplace_back(std::move(hashes));
+        });
+  }
+
+  /**
+   * Answers the request with \arg index with the blocks of the chain from
+   * \arg first to \arg last inclusive
+   */
+  void respond(size_t index, size_t first, size_t last) {
+    BlocksResponse response{
+        requests_.at(index).request.id,
+        std::vector<BlockData>(chain_.begin() + first,
+                               chain_.begin() + last + 1)};
+    // the handler may send new requests
+    auto handler = requests_.at(index).handler;
+    handler(std::move(response));
+  }
+
+  void fail(size_t index) {
+    auto handler = requests_.at(index).handler;
+    handler(network::ProtocolError::GONE);
+  }
+
+  /// @returns hashes of the blocks of the chain from \arg first to \arg last
+  std::vector<BlockHash> hashes(size_t first, size_t last) const {
+    std::vector<BlockHash> hashes;
+    for (auto i = first; i <= last; ++i) {
+      hashes.push_back(chain_.at(i).hash);
+    }
+    return hashes;
+  }
+
+  struct SentRequest {
+    PeerId peer_id;
+    BlocksRequest request;
+    ResponseHandler handler;
+  };
+
+  AppConfigurationMock app_config_;
+  std::shared_ptr<RouterMock> router_ = std::make_shared<RouterMock>();
+  std::shared_ptr<SyncProtocolMock> sync_protocol_ =
+      std::make_shared<SyncProtocolMock>();
+  std::shared_ptr<PeerManagerMock> peer_manager_ =
+      std::make_shared<PeerManagerMock>();
+  std::shared_ptr<BlockHeaderRepositoryMock> header_repo_ =
+      std::make_shared<BlockHeaderRepositoryMock>();
+  std::shared_ptr<boost::asio::io_context> io_context_ =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<BabeSynchronizerImpl> synchronizer_;
+
+  std::vector<BlockData> chain_;
+  std::vector<PeerId> peers_;
+  std::vector<SentRequest> requests_;
+  std::vector<boost::optional<std::vector<BlockHash>>> results_;
+};
+
+/**
+ * @given several peers having the whole range of blocks
+ * @when the range is requested
+ * @then its chunks are requested from different peers at once
+ * @and the blocks are passed to the handler in order once all the chunks are
+ * received, though they arrive out of order
+ */
+TEST_F(BabeSynchronizerTest, ChunksArriveOutOfOrder) {
+  for (auto peer : {"peer0"_peerid, "peer1"_peerid, "peer2"_peerid,
+                    "peer3"_peerid}) {
+    addPeer(peer, 6);
+  }
+
+  requestBlocks("peer0"_peerid, 6);
+  ASSERT_EQ(requests_.size(), 4);
+  for (size_t i = 0; i < requests_.size(); ++i) {
+    ASSERT_EQ(requests_[i].request.max, kChunkSize);
+    for (size_t j = 0; j < i; ++j) {
+      ASSERT_NE(requests_[i].peer_id, requests_[j].peer_id);
+    }
+  }
+  ASSERT_EQ(requests_[0].request.from, primitives::BlockId{chain_[0].hash});
+  ASSERT_EQ(requests_[2].request.from, primitives::BlockId{BlockNumber{4}});
+
+  respond(3, 6, 6);
+  respond(1, 2, 3);
+  respond(2, 4, 5);
+  ASSERT_TRUE(results_.empty());
+
+  respond(0, 0, 1);
+  ASSERT_EQ(results_.size(), 1);
+  ASSERT_EQ(results_[0], hashes(0, 6));
+}
+
+/**
+ * @given a peer not responding with a chunk of blocks
+ * @when the chunk timeout expires
+ * @then the chunk is requested from another peer
+ */
+TEST_F(BabeSynchronizerTest, TimedOutChunkIsRetriedOnAnotherPeer) {
+  addPeer("peer0"_peerid, 1);
+  addPeer("peer1"_peerid, 1);
+
+  requestBlocks("peer0"_peerid, 1);
+  ASSERT_EQ(requests_.size(), 1);
+  ASSERT_EQ(requests_[0].peer_id, "peer0"_peerid);
+
+  io_context_->run_one();
+  ASSERT_EQ(requests_.size(), 2);
+  ASSERT_EQ(requests_[1].peer_id, "peer1"_peerid);
+  ASSERT_EQ(requests_[1].request.from, requests_[0].request.from);
+
+  respond(1, 0, 1);
+  ASSERT_EQ(results_.size(), 1);
+  ASSERT_EQ(results_[0], hashes(0, 1));
+}
+
+/**
+ * @given a chunk of blocks requested again after a timeout
+ * @when the timed out peer responds after all
+ * @then its response is ignored @and the chunk is taken from the response to
+ * the last attempt
+ */
+TEST_F(BabeSynchronizerTest, LateResponseIsIgnored) {
+  addPeer("peer0"_peerid, 1);
+  addPeer("peer1"_peerid, 1);
+
+  requestBlocks("peer0"_peerid, 1);
+  io_context_->run_one();
+  ASSERT_EQ(requests_.size(), 2);
+
+  respond(0, 0, 0);
+  ASSERT_TRUE(results_.empty());
+
+  respond(1, 0, 1);
+  ASSERT_EQ(results_.size(), 1);
+  ASSERT_EQ(results_[0], hashes(0, 1));
+}
+
+/**
+ * @given peers failing to respond with a chunk of blocks
+ * @when the chunk has been requested kMaxChunkAttempts times
+ * @then it is given up @and the handler is called with no blocks
+ */
+TEST_F(BabeSynchronizerTest, ChunkIsGivenUpAfterMaxAttempts) {
+  for (auto peer : {"peer0"_peerid, "peer1"_peerid, "peer2"_peerid,
+                    "peer3"_peerid}) {
+    addPeer(peer, 1);
+  }
+
+  requestBlocks("peer0"_peerid, 1);
+  for (size_t i = 0; i < BabeSynchronizerImpl::kMaxChunkAttempts; ++i) {
+    ASSERT_EQ(requests_.size(), i + 1);
+    ASSERT_TRUE(results_.empty());
+    fail(i);
+  }
+
+  ASSERT_EQ(requests_.size(), BabeSynchronizerImpl::kMaxChunkAttempts);
+  ASSERT_EQ(results_.size(), 1);
+  ASSERT_EQ(results_[0], boost::none);
+}
+
+/**
+ * @given a peer which failed to respond and a peer which responded
+ * @when blocks announced by the failed peer are requested
+ * @then they are requested from the peer with the better score
+ */
+TEST_F(BabeSynchronizerTest, PeerChoiceFollowsScore) {
+  addPeer("peer0"_peerid, 1);
+  addPeer("peer1"_peerid, 1);
+
+  // the announcing peer is tried first, as neither of the peers is measured
+  requestBlocks("peer0"_peerid, 1);
+  ASSERT_EQ(requests_[0].peer_id, "peer0"_peerid);
+  fail(0);
+  ASSERT_EQ(requests_[1].peer_id, "peer1"_peerid);
+  respond(1, 0, 1);
+  ASSERT_EQ(results_.size(), 1);
+
+  requestBlocks("peer0"_peerid, 1);
+  ASSERT_EQ(requests_.size(), 3);
+  ASSERT_EQ(requests_[2].peer_id, "peer1"_peerid);
+}
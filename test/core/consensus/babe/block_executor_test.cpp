@@ -0,0 +1,248 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/block_executor.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/asio/io_context.hpp>
+
+#include "blockchain/block_tree_error.hpp"
+#include "clock/impl/basic_waitable_timer.hpp"
+#include "consensus/babe/types/babe_block_header.hpp"
+#include "consensus/babe/types/seal.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/core/consensus/authority/authority_update_observer_mock.hpp"
+#include "mock/core/consensus/babe/babe_synchronizer_mock.hpp"
+#include "mock/core/consensus/babe/babe_util_mock.hpp"
+#include "mock/core/consensus/grandpa/environment_mock.hpp"
+#include "mock/core/consensus/validation/block_validator_mock.hpp"
+#include "mock/core/runtime/core_mock.hpp"
+#include "mock/core/transaction_pool/transaction_pool_mock.hpp"
+#include "scale/scale.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace kagome;
+using blockchain::BlockTreeMock;
+using consensus::BabeBlockHeader;
+using consensus::BabeSynchronizer;
+using consensus::BabeSynchronizerMock;
+using consensus::BlockExecutor;
+using primitives::BlockData;
+using primitives::BlockHash;
+using primitives::BlockHeader;
+using primitives::BlockId;
+using primitives::BlockInfo;
+using primitives::Justification;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class BlockExecutorTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    io_context_ = std::make_shared<boost::asio::io_context>();
+    block_tree_ = std::make_shared<BlockTreeMock>();
+    babe_synchronizer_ = std::make_shared<BabeSynchronizerMock>();
+
+    // the requested pages are answered by the tests
+    EXPECT_CALL(*babe_synchronizer_, request(_, _, _, _))
+        .WillRepeatedly(
+            Invoke([this](const BlockId &from,
+                          const BlockHash &,
+                          const libp2p::peer::PeerId &,
+                          const BabeSynchronizer::BlocksHandler &handler) {
+              requests_.emplace_back(boost::get<BlockHash>(from), handler);
+            }));
+
+    // the downloaded blocks are known, so they are not executed
+    EXPECT_CALL(*block_tree_, getBlockBody(_))
+        .WillRepeatedly(Return(primitives::BlockBody{}));
+    EXPECT_CALL(*block_tree_, addExistingBlock(_, _))
+        .WillRepeatedly(
+            Invoke([this](const BlockHash &hash, const BlockHeader &) {
+              applied_.push_back(hash);
+              return outcome::result<void>{outcome::success()};
+            }));
+
+    block_executor_ = std::make_shared<BlockExecutor>(
+        block_tree_,
+        core_,
+        std::make_shared<primitives::BabeConfiguration>(),
+        babe_synchronizer_,
+        block_validator_,
+        grandpa_environment_,
+        std::make_shared<transaction_pool::TransactionPoolMock>(),
+        hasher_,
+        std::make_shared<authority::AuthorityUpdateObserverMock>(),
+        babe_util_,
+        io_context_,
+        std::make_unique<clock::BasicWaitableTimer>(io_context_));
+
+    // a chain of blocks, the synchronization starts from the first one
+    BlockHash parent_hash{};
+    for (primitives::BlockNumber number = 0; number <= 4; ++number) {
+      BlockHeader header{.parent_hash = parent_hash,
+                         .number = number,
+                         .digest = makeBabeDigests(number)};
+      parent_hash = hasher_->blake2b_256(scale::encode(header).value());
+      chain_.push_back(BlockData{.hash = parent_hash, .header = header});
+    }
+    from_ = chain_.front().hash;
+  }
+
+  /**
+   * @returns BABE pre-runtime and seal digests of a block produced in the
+   * \arg slot by the first authority
+   */
+  static primitives::Digest makeBabeDigests(consensus::BabeSlotNumber slot) {
+    BabeBlockHeader babe_header{BabeBlockHeader::kVRFHeader, slot, {}, 0};
+    return {primitives::PreRuntime{{primitives::kBabeEngineId,
+                                    scale::encode(babe_header).value()}},
+            primitives::Seal{{primitives::kBabeEngineId,
+                              scale::encode(consensus::Seal{}).value()}}};
+  }
+
+  /**
+   * Answers the request with \arg index with the blocks of the chain from
+   * \arg first to \arg last inclusive
+   */
+  void respond(size_t index, size_t first, size_t last) {
+    std::vector<BlockData> page(chain_.begin() + first,
+                                chain_.begin() + last + 1);
+    requests_.at(index).second(std::cref(page));
+  }
+
+  void runQueued() {
+    io_context_->restart();
+    io_context_->run();
+  }
+
+  BlockHash from_;
+
+  std::shared_ptr<boost::asio::io_context> io_context_;
+  std::shared_ptr<BlockTreeMock> block_tree_;
+  std::shared_ptr<BabeSynchronizerMock> babe_synchronizer_;
+  std::shared_ptr<runtime::CoreMock> core_ =
+      std::make_shared<runtime::CoreMock>();
+  std::shared_ptr<consensus::BlockValidatorMock> block_validator_ =
+      std::make_shared<consensus::BlockValidatorMock>();
+  std::shared_ptr<consensus::grandpa::EnvironmentMock> grandpa_environment_ =
+      std::make_shared<consensus::grandpa::EnvironmentMock>();
+  std::shared_ptr<consensus::BabeUtilMock> babe_util_ =
+      std::make_shared<consensus::BabeUtilMock>();
+  std::shared_ptr<crypto::Hasher> hasher_ =
+      std::make_shared<crypto::HasherImpl>();
+  std::shared_ptr<BlockExecutor> block_executor_;
+
+  std::vector<BlockData> chain_;
+  std::vector<std::pair<BlockHash, BabeSynchronizer::BlocksHandler>>
+      requests_;
+  std::vector<BlockHash> applied_;
+};
+
+/**
+ * @given a block executor synchronizing the blocks of a chain
+ * @when the first page of blocks is received
+ * @then the next page is requested before the received blocks are applied
+ * @and all the blocks are applied in order once both pages are received
+ */
+TEST_F(BlockExecutorTest, NextPageIsRequestedAhead) {
+  bool retrieved = false;
+  block_executor_->requestBlocks(
+      from_, chain_.back().hash, "peer"_peerid, [&] { retrieved = true; });
+  ASSERT_EQ(requests_.size(), 1);
+  ASSERT_EQ(requests_[0].first, from_);
+
+  respond(0, 0, 2);
+  ASSERT_EQ(requests_.size(), 2);
+  ASSERT_EQ(requests_[1].first, chain_[2].hash);
+  ASSERT_TRUE(applied_.empty());
+
+  runQueued();
+  ASSERT_EQ(applied_, (std::vector<BlockHash>{chain_[1].hash, chain_[2].hash}));
+  ASSERT_FALSE(retrieved);
+
+  // the page starts with the last block of the previous one
+  respond(1, 2, 4);
+  runQueued();
+  ASSERT_EQ(applied_,
+            (std::vector<BlockHash>{chain_[1].hash,
+                                    chain_[2].hash,
+                                    chain_[3].hash,
+                                    chain_[4].hash}));
+  ASSERT_TRUE(retrieved);
+  ASSERT_EQ(requests_.size(), 2);
+}
+
+/**
+ * @given a block executor synchronizing the blocks of a chain
+ * @when a received page does not continue the chain
+ * @then the blocks before the gap are applied @and nothing more is requested
+ */
+TEST_F(BlockExecutorTest, PageBreakingTheChainIsRejected) {
+  bool retrieved = false;
+  block_executor_->requestBlocks(
+      from_, chain_.back().hash, "peer"_peerid, [&] { retrieved = true; });
+
+  std::vector<BlockData> page{chain_[1], chain_[3]};
+  requests_.at(0).second(std::cref(page));
+  runQueued();
+
+  ASSERT_EQ(applied_, (std::vector<BlockHash>{chain_[1].hash}));
+  ASSERT_TRUE(retrieved);
+  ASSERT_EQ(requests_.size(), 1);
+}
+
+/**
+ * @given a block executor synchronizing the blocks of a chain
+ * @when a received block which is not known yet comes with a justification
+ * @then the block is executed and added to the tree @and its justification is
+ * applied
+ */
+TEST_F(BlockExecutorTest, JustificationOfSyncedBlockIsApplied) {
+  Justification justification{"justification"_buf};
+  chain_[1].justification = justification;
+
+  // the first block is executed, the rest are known
+  EXPECT_CALL(*block_tree_, getBlockBody(BlockId{chain_[1].hash}))
+      .WillOnce(Return(blockchain::BlockTreeError::NO_SUCH_BLOCK));
+  EXPECT_CALL(*babe_util_, setLastEpoch(_))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*babe_util_, slotToEpoch(1)).WillOnce(Return(0));
+  EXPECT_CALL(*block_tree_, getEpochDescriptor(0, chain_[0].hash))
+      .WillOnce(Return(consensus::EpochDigest{
+          .authorities = {primitives::Authority{.weight = 1}}}));
+  EXPECT_CALL(*block_validator_, validateHeader(_, 0, _, _, _))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*core_, execute_block(_)).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_tree_, addBlock(_, _))
+      .WillOnce(Invoke([this](const primitives::HashedBlockHeader &header,
+                              const primitives::BlockBody &) {
+        EXPECT_EQ(header.hash(), chain_[1].hash);
+        return outcome::result<void>{outcome::success()};
+      }));
+  EXPECT_CALL(*grandpa_environment_,
+              applyJustification(BlockInfo{1, chain_[1].hash}, justification))
+      .WillOnce(Return(outcome::success()));
+
+  bool retrieved = false;
+  block_executor_->requestBlocks(
+      from_, chain_.back().hash, "peer"_peerid, [&] { retrieved = true; });
+  respond(0, 0, 4);
+  runQueued();
+
+  // the executed block is not added as an existing one
+  ASSERT_EQ(applied_,
+            (std::vector<BlockHash>{
+                chain_[2].hash, chain_[3].hash, chain_[4].hash}));
+  ASSERT_TRUE(retrieved);
+}
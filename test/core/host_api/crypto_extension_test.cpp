@@ -446,83 +446,129 @@ TEST_F(CryptoExtensionTest, Sr25519VerifyFailure) {
  * @when trying to finish batch
  * @then exception is thrown
  */
-// TODO (kamilsa) 05.07.21 https://github.com/soramitsu/kagome/issues/804
-//TEST_F(CryptoExtensionTest, VerificationBatching_FinishWithoutStart) {
-//  ASSERT_THROW(crypto_ext_->ext_finish_batch_verify(), std::runtime_error);
-//}
+TEST_F(CryptoExtensionTest, VerificationBatching_FinishWithoutStart) {
+  ASSERT_THROW(crypto_ext_->ext_finish_batch_verify(), std::runtime_error);
+}
 
 /**
  * @given initialized crypto extention without started batch
  * @when trying to start batch twice
  * @then exception is thrown at second call
  */
-// TODO (kamilsa) 05.07.21 https://github.com/soramitsu/kagome/issues/804
-//TEST_F(CryptoExtensionTest, VerificationBatching_StartAgainWithoutFinish) {
-//  ASSERT_NO_THROW(crypto_ext_->ext_start_batch_verify());
-//  ASSERT_THROW(crypto_ext_->ext_start_batch_verify(), std::runtime_error);
-//}
+TEST_F(CryptoExtensionTest, VerificationBatching_StartAgainWithoutFinish) {
+  ASSERT_NO_THROW(crypto_ext_->ext_start_batch_verify());
+  ASSERT_THROW(crypto_ext_->ext_start_batch_verify(), std::runtime_error);
+}
 
 /**
  * @given initialized crypto extention without started batch
  * @when start batch, check valid signature, and finish batch
  * @then verification returns positive, batch result is positive too
  */
-// TODO (kamilsa) 05.07.21 https://github.com/soramitsu/kagome/issues/804
-//TEST_F(CryptoExtensionTest, VerificationBatching_NormalOrderAndSuccess) {
-//  auto pub_key = gsl::span<uint8_t>(sr25519_keypair.public_key);
-//  auto valid_signature = Buffer(sr25519_signature);
-//
-//  WasmPointer input_data = 0;
-//  WasmSize input_size = input.size();
-//  WasmResult input_span{input_data, input_size};
-//  WasmPointer sig_data_ptr = 42;
-//  WasmPointer pub_key_data_ptr = 123;
-//
-//  EXPECT_CALL(*memory_, loadN(input_data, input_size)).WillOnce(Return(input));
-//  EXPECT_CALL(*memory_, loadN(pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
-//      .WillOnce(Return(Buffer(pub_key)));
-//  EXPECT_CALL(*memory_, loadN(sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
-//      .WillOnce(Return(valid_signature));
-//
-//  ASSERT_NO_THROW(crypto_ext_->ext_start_batch_verify());
-//
-//  WasmSize result_in_place = crypto_ext_->ext_sr25519_verify_v1(
-//      sig_data_ptr, input_span.combine(), pub_key_data_ptr);
-//  ASSERT_EQ(result_in_place, CryptoExtension::kVerifySuccess);
-//
-//  WasmSize final_result;
-//  ASSERT_NO_THROW(final_result = crypto_ext_->ext_finish_batch_verify());
-//  ASSERT_EQ(final_result, CryptoExtension::kVerifyBatchSuccess);
-//}
+TEST_F(CryptoExtensionTest, VerificationBatching_NormalOrderAndSuccess) {
+  auto pub_key = gsl::span<uint8_t>(sr25519_keypair.public_key);
+  auto valid_signature = Buffer(sr25519_signature);
+
+  WasmPointer input_data = 0;
+  WasmSize input_size = input.size();
+  WasmResult input_span{input_data, input_size};
+  WasmPointer sig_data_ptr = 42;
+  WasmPointer pub_key_data_ptr = 123;
+
+  EXPECT_CALL(*memory_, loadN(input_data, input_size)).WillOnce(Return(input));
+  EXPECT_CALL(*memory_, loadN(pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
+      .WillOnce(Return(Buffer(pub_key)));
+  EXPECT_CALL(*memory_, loadN(sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillOnce(Return(valid_signature));
+
+  ASSERT_NO_THROW(crypto_ext_->ext_start_batch_verify());
+
+  WasmSize result_in_place = crypto_ext_->ext_sr25519_verify_v1(
+      sig_data_ptr, input_span.combine(), pub_key_data_ptr);
+  ASSERT_EQ(result_in_place, CryptoExtension::kVerifySuccess);
+
+  WasmSize final_result;
+  ASSERT_NO_THROW(final_result = crypto_ext_->ext_finish_batch_verify());
+  ASSERT_EQ(final_result, CryptoExtension::kVerifyBatchSuccess);
+}
 
 /**
  * @given initialized crypto extention without started batch
- * @when start batch, check valid signature, and finish batch
- * @then verification returns positive, but batch returns negative result
+ * @when check valid signature, and finish batch
+ * @then verification returns positive, but finishing batch throws
+ */
+TEST_F(CryptoExtensionTest, VerificationBatching_FinishAfterInPlaceVerify) {
+  auto pub_key = gsl::span<uint8_t>(sr25519_keypair.public_key);
+  auto valid_signature = Buffer(sr25519_signature);
+
+  WasmPointer input_data = 0;
+  WasmSize input_size = input.size();
+  WasmResult input_span{input_data, input_size};
+  WasmPointer sig_data_ptr = 42;
+  WasmPointer pub_key_data_ptr = 123;
+
+  EXPECT_CALL(*memory_, loadN(input_data, input_size)).WillOnce(Return(input));
+  EXPECT_CALL(*memory_, loadN(pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
+      .WillOnce(Return(Buffer(pub_key)));
+  EXPECT_CALL(*memory_, loadN(sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillOnce(Return(valid_signature));
+
+  WasmSize result_in_place = crypto_ext_->ext_sr25519_verify_v1(
+      sig_data_ptr, input_span.combine(), pub_key_data_ptr);
+  ASSERT_EQ(result_in_place, CryptoExtension::kVerifySuccess);
+
+  ASSERT_ANY_THROW(crypto_ext_->ext_finish_batch_verify());
+}
+
+/**
+ * @given crypto extension with verification workers
+ * @when start batch, check valid and invalid signatures, and finish batch
+ * @then verifications return positive in place, but batch result is negative
  */
-// TODO (kamilsa) 05.07.21 https://github.com/soramitsu/kagome/issues/804
-//TEST_F(CryptoExtensionTest, VerificationBatching_NormalOrderAndInvalid) {
-//  auto pub_key = gsl::span<uint8_t>(sr25519_keypair.public_key);
-//  auto valid_signature = Buffer(sr25519_signature);
-//
-//  WasmPointer input_data = 0;
-//  WasmSize input_size = input.size();
-//  WasmResult input_span{input_data, input_size};
-//  WasmPointer sig_data_ptr = 42;
-//  WasmPointer pub_key_data_ptr = 123;
-//
-//  EXPECT_CALL(*memory_, loadN(input_data, input_size)).WillOnce(Return(input));
-//  EXPECT_CALL(*memory_, loadN(pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
-//      .WillOnce(Return(Buffer(pub_key)));
-//  EXPECT_CALL(*memory_, loadN(sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
-//      .WillOnce(Return(valid_signature));
-//
-//  WasmSize result_in_place = crypto_ext_->ext_sr25519_verify_v1(
-//      sig_data_ptr, input_span.combine(), pub_key_data_ptr);
-//  ASSERT_EQ(result_in_place, CryptoExtension::kVerifySuccess);
-//
-//  ASSERT_ANY_THROW(crypto_ext_->ext_finish_batch_verify());
-//}
+TEST_F(CryptoExtensionTest, VerificationBatching_WorkersAndInvalid) {
+  auto crypto_ext = std::make_shared<CryptoExtension>(
+      memory_,
+      sr25519_provider_,
+      ed25519_provider_,
+      secp256k1_provider_,
+      hasher_,
+      crypto_store_,
+      bip39_provider_,
+      std::make_shared<BatchVerificationWorkers>(2));
+
+  auto pub_key = gsl::span<uint8_t>(sr25519_keypair.public_key);
+  auto valid_signature = Buffer(sr25519_signature);
+  auto invalid_signature = valid_signature;
+  ++invalid_signature[0];
+
+  WasmPointer input_data = 0;
+  WasmSize input_size = input.size();
+  WasmResult input_span{input_data, input_size};
+  WasmPointer sig_data_ptr = 42;
+  WasmPointer pub_key_data_ptr = 123;
+
+  EXPECT_CALL(*memory_, loadN(input_data, input_size))
+      .WillRepeatedly(Return(input));
+  EXPECT_CALL(*memory_, loadN(pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
+      .WillRepeatedly(Return(Buffer(pub_key)));
+  EXPECT_CALL(*memory_, loadN(sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillOnce(Return(valid_signature))
+      .WillOnce(Return(invalid_signature));
+
+  ASSERT_NO_THROW(crypto_ext->ext_start_batch_verify());
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_EQ(crypto_ext->ext_sr25519_verify_v1(
+                  sig_data_ptr, input_span.combine(), pub_key_data_ptr),
+              CryptoExtension::kVerifySuccess);
+  }
+  ASSERT_EQ(crypto_ext->ext_finish_batch_verify(),
+            CryptoExtension::kVerifyBatchFail);
+
+  // the batch is over, so a new one may be started
+  ASSERT_NO_THROW(crypto_ext->ext_start_batch_verify());
+  ASSERT_EQ(crypto_ext->ext_finish_batch_verify(),
+            CryptoExtension::kVerifyBatchSuccess);
+}
 
 /**
  * @given initialized crypto extensions @and some bytes
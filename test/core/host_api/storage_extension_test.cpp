@@ -14,7 +14,7 @@
 #include "mock/core/storage/trie/polkadot_trie_cursor_mock.h"
 #include "mock/core/storage/trie/trie_batches_mock.hpp"
 #include "runtime/wasm_result.hpp"
-#include "scale/encode_append.hpp"
+#include "scale/scale.hpp"
 #include "storage/changes_trie/changes_trie_config.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 #include "testutil/literals.hpp"
@@ -488,105 +488,54 @@ INSTANTIATE_TEST_CASE_P(Instance,
                         // empty argument for the macro
 );
 
+/**
+ * @given a key and an item
+ * @when the item is appended to storage
+ * @then it is appended by the persistent batch without reading the stored
+ * vector
+ */
 TEST_F(StorageExtensionTest, ExtStorageAppendTest) {
-  // @given key and two values
   WasmResult key(43, 43);
   Buffer key_data(key.length, 'k');
+  Buffer value_data{kagome::scale::encode(Buffer(42, '1')).value()};
+  WasmResult value(42, value_data.size());
 
-  Buffer value_data1(42, '1');
-  Buffer value_data1_encoded{kagome::scale::encode(value_data1).value()};
-  WasmResult value1(42, value_data1_encoded.size());
-
-  Buffer value_data2(43, '2');
-  Buffer value_data2_encoded{kagome::scale::encode(value_data2).value()};
-  WasmResult value2(45, value_data2_encoded.size());
-
-  // @given wasm memory that can provide these key and values
   EXPECT_CALL(*memory_, loadN(key.address, key.length))
-      .WillRepeatedly(Return(key_data));
-  EXPECT_CALL(*memory_, loadN(value1.address, value1.length))
-      .WillOnce(Return(value_data1_encoded));
-  EXPECT_CALL(*memory_, loadN(value2.address, value2.length))
-      .WillOnce(Return(value_data2_encoded));
-
-  std::vector<kagome::scale::EncodeOpaqueValue> vals;
-  Buffer vals_encoded;
-  {
-    // @when there is no value by given key in trie
-    EXPECT_CALL(*trie_batch_, get(key_data))
-        .WillOnce(Return(outcome::failure(boost::system::error_code{})));
-
-    // @then storage is inserted by scale encoded vector containing
-    // EncodeOpaqueValue with value1
-    vals.push_back(
-        kagome::scale::EncodeOpaqueValue{value_data1_encoded.asVector()});
-    vals_encoded = Buffer(kagome::scale::encode(vals).value());
-    EXPECT_CALL(*trie_batch_, put_rvalueHack(key_data, vals_encoded))
-        .WillOnce(Return(outcome::success()));
-
-    storage_extension_->ext_storage_append_version_1(key.combine(),
-                                                     value1.combine());
-  }
-
-  {
-    // @when there is a value by given key (inserted above)
-    EXPECT_CALL(*trie_batch_, get(key_data)).WillOnce(Return(vals_encoded));
-
-    // @then storage is inserted by scale encoded vector containing two
-    // EncodeOpaqueValues with value1 and value2
-    vals.push_back(
-        kagome::scale::EncodeOpaqueValue{value_data2_encoded.asVector()});
-    vals_encoded = Buffer(kagome::scale::encode(vals).value());
-    EXPECT_CALL(*trie_batch_, put_rvalueHack(key_data, vals_encoded))
-        .WillOnce(Return(outcome::success()));
+      .WillOnce(Return(key_data));
+  EXPECT_CALL(*memory_, loadN(value.address, value.length))
+      .WillOnce(Return(value_data));
+  EXPECT_CALL(*trie_batch_, append(key_data, value_data))
+      .WillOnce(Return(outcome::success()));
 
-    storage_extension_->ext_storage_append_version_1(key.combine(),
-                                                     value2.combine());
-  }
+  storage_extension_->ext_storage_append_version_1(key.combine(),
+                                                   value.combine());
 }
 
-TEST_F(StorageExtensionTest, ExtStorageAppendTestCompactLenChanged) {
-  // @given key and two values
+/**
+ * @given a batch on top of the persistent one
+ * @when a value is appended to storage
+ * @then it is appended by the batch without reading the stored vector
+ */
+TEST_F(StorageExtensionTest, ExtStorageAppendToTopperBatch) {
+  auto topper_batch =
+      std::make_shared<kagome::storage::trie::TopperTrieBatchMock>();
+  EXPECT_CALL(*storage_provider_, getCurrentBatch())
+      .WillRepeatedly(Return(topper_batch));
+
   WasmResult key(43, 43);
   Buffer key_data(key.length, 'k');
+  Buffer value_data{kagome::scale::encode(Buffer(42, '1')).value()};
+  WasmResult value(42, value_data.size());
 
-  Buffer value_data1(42, '1');
-  Buffer value_data1_encoded{kagome::scale::encode(value_data1).value()};
-  WasmResult value1(42, value_data1_encoded.size());
-
-  Buffer value_data2(43, '2');
-  Buffer value_data2_encoded{kagome::scale::encode(value_data2).value()};
-  WasmResult value2(45, value_data2_encoded.size());
-
-  // @given wasm memory that can provide these key and values
   EXPECT_CALL(*memory_, loadN(key.address, key.length))
-      .WillRepeatedly(Return(key_data));
-  EXPECT_CALL(*memory_, loadN(value2.address, value2.length))
-      .WillOnce(Return(value_data2_encoded));
-
-  // @when vals contains (2^6 - 1) elements (high limit for one-byte compact
-  // integers)
-  std::vector<kagome::scale::EncodeOpaqueValue> vals(
-      kagome::scale::compact::EncodingCategoryLimits::kMinUint16 - 1,
-      kagome::scale::EncodeOpaqueValue{value_data1_encoded.asVector()});
-  Buffer vals_encoded = Buffer(kagome::scale::encode(vals).value());
-
-  {
-    // @when encoded vals is stored by given key
-    EXPECT_CALL(*trie_batch_, get(key_data)).WillOnce(Return(vals_encoded));
-
-    // @when storage is inserted by one more value by the same key
-    vals.push_back(
-        kagome::scale::EncodeOpaqueValue{value_data2_encoded.asVector()});
-    vals_encoded = Buffer(kagome::scale::encode(vals).value());
-
-    // @then everything fine: storage is inserted with vals with new value
-    EXPECT_CALL(*trie_batch_, put_rvalueHack(key_data, vals_encoded))
-        .WillOnce(Return(outcome::success()));
+      .WillOnce(Return(key_data));
+  EXPECT_CALL(*memory_, loadN(value.address, value.length))
+      .WillOnce(Return(value_data));
+  EXPECT_CALL(*topper_batch, append(key_data, value_data))
+      .WillOnce(Return(outcome::success()));
 
-    storage_extension_->ext_storage_append_version_1(key.combine(),
-                                                     value2.combine());
-  }
+  storage_extension_->ext_storage_append_version_1(key.combine(),
+                                                   value.combine());
 }
 
 /**
@@ -621,6 +570,28 @@ TEST_P(BuffersParametrizedTest, Blake2_256_EnumeratedTrieRoot) {
       values_ptr, lens_ptr, values.size(), result);
 }
 
+/**
+ * @given persistent batch with changes
+ * @when calling ext_storage_root_version_1 several times
+ * @then the root is calculated by the batch each time, and the changes are
+ * not committed to the storage
+ */
+TEST_F(StorageExtensionTest, StorageRootV1DoesNotCommit) {
+  auto root = "root"_hash256;
+  WasmSpan result = WasmResult(1984, Hash256::size()).combine();
+
+  EXPECT_CALL(*trie_batch_, calculateRoot())
+      .Times(2)
+      .WillRepeatedly(Return(root));
+  EXPECT_CALL(*trie_batch_, commit()).Times(0);
+  EXPECT_CALL(*memory_, storeBuffer(gsl::span<const uint8_t>(root)))
+      .Times(2)
+      .WillRepeatedly(Return(result));
+
+  ASSERT_EQ(result, storage_extension_->ext_storage_root_version_1());
+  ASSERT_EQ(result, storage_extension_->ext_storage_root_version_1());
+}
+
 /**
  * @given a set of values, which ordered trie hash we want to calculate from
  * wasm
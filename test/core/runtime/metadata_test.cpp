@@ -21,6 +21,7 @@ using ::testing::Return;
 using kagome::blockchain::BlockHeaderRepositoryMock;
 using kagome::runtime::Metadata;
 using kagome::runtime::binaryen::MetadataImpl;
+using kagome::runtime::binaryen::RuntimeCallCache;
 
 namespace fs = boost::filesystem;
 
@@ -32,13 +33,25 @@ class MetadataTest : public RuntimeTest {
 
   void SetUp() override {
     RuntimeTest::SetUp();
-    prepareEphemeralStorageExpects();
 
+    header_repo_ = std::make_shared<BlockHeaderRepositoryMock>();
     api_ = std::make_shared<MetadataImpl>(
-        runtime_env_factory_, std::make_shared<BlockHeaderRepositoryMock>());
+        runtime_env_factory_, header_repo_, wasm_provider_);
+  }
+
+  /**
+   * Expects a runtime environment to be made at \arg state_root
+   */
+  void expectEnvironmentAt(const kagome::common::Hash256 &state_root) {
+    EXPECT_CALL(*storage_provider_, setToEphemeralAt(state_root))
+        .WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*storage_provider_, getCurrentBatch());
+    EXPECT_CALL(*batch_mock_, get(_));
+    EXPECT_CALL(*storage_provider_, rollbackTransaction());
   }
 
  protected:
+  std::shared_ptr<BlockHeaderRepositoryMock> header_repo_;
   std::shared_ptr<Metadata> api_;
 };
 
@@ -48,6 +61,33 @@ class MetadataTest : public RuntimeTest {
  * @then successful result is returned
  */
 TEST_F(MetadataTest, metadata) {
-  EXPECT_CALL(*storage_provider_, rollbackTransaction());
+  auto latest_root = "42"_hash256;
+  EXPECT_CALL(*storage_provider_, getLatestRootMock())
+      .WillOnce(Return(latest_root));
+  expectEnvironmentAt(latest_root);
   ASSERT_TRUE(api_->metadata({}));
 }
+
+/**
+ * @given Metadata api with a runtime call cache
+ * @when metadata() is invoked twice for a block
+ * @then the runtime is called once, and the second result is taken from the
+ * cache
+ */
+TEST_F(MetadataTest, CachedMetadata) {
+  auto header = createBlockHeader();
+  EXPECT_CALL(*header_repo_, getBlockHeader(_))
+      .Times(2)
+      .WillRepeatedly(Return(header));
+  expectEnvironmentAt(header.state_root);
+
+  auto cache = std::make_shared<RuntimeCallCache>();
+  api_ = std::make_shared<MetadataImpl>(
+      runtime_env_factory_, header_repo_, wasm_provider_, cache);
+  auto block_hash = "block"_hash256;
+  EXPECT_OUTCOME_TRUE(metadata, api_->metadata(block_hash));
+  EXPECT_OUTCOME_TRUE(cached_metadata, api_->metadata(block_hash));
+  ASSERT_EQ(metadata, cached_metadata);
+  ASSERT_EQ(cache->hits(), 1u);
+  ASSERT_EQ(cache->misses(), 1u);
+}
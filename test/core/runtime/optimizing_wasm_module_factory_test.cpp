@@ -0,0 +1,154 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/optimizing_wasm_module_factory.hpp"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+#include <binaryen/wasm.h>
+
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/runtime/trie_storage_provider_mock.hpp"
+#include "mock/core/storage/trie/trie_batches_mock.hpp"
+#include "runtime/binaryen/module/wasm_module_impl.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+#include "testutil/runtime/common/basic_wasm_provider.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using kagome::common::Buffer;
+using kagome::crypto::HasherImpl;
+using kagome::primitives::BlockHash;
+using kagome::runtime::BasicWasmProvider;
+using kagome::runtime::TrieStorageProviderMock;
+using kagome::runtime::binaryen::OptimizingWasmModuleFactory;
+using kagome::runtime::binaryen::WasmModuleCache;
+using kagome::runtime::binaryen::WasmModuleImpl;
+using kagome::storage::trie::EphemeralTrieBatchMock;
+using kagome::storage::trie::TrieError;
+
+using testing::_;
+using testing::Return;
+
+struct OptimizingWasmModuleFactoryTest : public test::BaseFS_Test {
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  OptimizingWasmModuleFactoryTest()
+      : test::BaseFS_Test("/tmp/kagome_optimizing_wasm_module_factory") {}
+
+  void SetUp() override {
+    BaseFS_Test::SetUp();
+    // no :heappages in the state
+    EXPECT_CALL(*batch_, get(_)).WillRepeatedly(Return(TrieError::NO_VALUE));
+    EXPECT_CALL(*storage_provider_, getCurrentBatch())
+        .WillRepeatedly(Return(batch_));
+  }
+
+  /// @returns the content of the file at \arg path
+  static Buffer readFile(const fs::path &path) {
+    return BasicWasmProvider{path.string()}.getStateCodeAt(BlockHash{});
+  }
+
+  /// @returns the code of a module exporting a function summing two numbers
+  Buffer sumTwoCode() const {
+    return readFile(fs::path(__FILE__).parent_path() / "wasm/sumtwo.wasm");
+  }
+
+  /// @returns path of the file keeping the module optimized from \arg code
+  fs::path optimizedPath(const Buffer &code) const {
+    auto kind =
+        "O" + std::to_string(OptimizingWasmModuleFactory::kOptimizeLevel);
+    return base_path / WasmModuleCache::kExecutorVersion
+           / (hasher_->twox_256(code).toHex() + "." + kind + ".wasm");
+  }
+
+  /// @returns a factory keeping the optimized modules in the test directory
+  OptimizingWasmModuleFactory makeFactory() const {
+    return OptimizingWasmModuleFactory{
+        std::make_shared<WasmModuleCache>(base_path), hasher_};
+  }
+
+  std::shared_ptr<HasherImpl> hasher_ = std::make_shared<HasherImpl>();
+  std::shared_ptr<EphemeralTrieBatchMock> batch_ =
+      std::make_shared<EphemeralTrieBatchMock>();
+  std::shared_ptr<TrieStorageProviderMock> storage_provider_ =
+      std::make_shared<TrieStorageProviderMock>();
+};
+
+/**
+ * @given a factory with an empty cache
+ * @when a module is created from a runtime code
+ * @then the optimized module is kept in the cache under the optimization
+ * level @and it still exports the functions of the code
+ */
+TEST_F(OptimizingWasmModuleFactoryTest, OptimizedModuleIsCached) {
+  auto factory = makeFactory();
+  auto code = sumTwoCode();
+
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code, nullptr, storage_provider_));
+
+  ASSERT_TRUE(fs::exists(optimizedPath(code)));
+  EXPECT_OUTCOME_TRUE(module,
+                      WasmModuleImpl::parseCode(readFile(optimizedPath(code))));
+  ASSERT_NE(module->getExportOrNull("sumtwo"), nullptr);
+}
+
+/**
+ * @given a cache keeping the optimized module of a runtime code
+ * @when a module is created from the runtime code
+ * @then the cached module is used as it is
+ */
+TEST_F(OptimizingWasmModuleFactoryTest, CachedModuleIsLoaded) {
+  auto code = sumTwoCode();
+  {
+    auto factory = makeFactory();
+    EXPECT_OUTCOME_TRUE_1(
+        factory.createModule(code, nullptr, storage_provider_));
+  }
+  // the code optimized again would differ from the original one
+  std::ofstream{optimizedPath(code).native(),
+                std::ios::binary | std::ios::trunc}
+      .write(reinterpret_cast<const char *>(code.data()),  // NOLINT
+             code.size());
+
+  auto factory = makeFactory();
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code, nullptr, storage_provider_));
+  ASSERT_EQ(readFile(optimizedPath(code)), code);
+}
+
+/**
+ * @given a cache keeping a damaged module of a runtime code
+ * @when a module is created from the runtime code
+ * @then the module is created from the code optimized again @and the cached
+ * module is replaced by the optimized one
+ */
+TEST_F(OptimizingWasmModuleFactoryTest, DamagedCachedModuleIsReplaced) {
+  auto code = sumTwoCode();
+  fs::create_directories(optimizedPath(code).parent_path());
+  std::ofstream{optimizedPath(code).native(), std::ios::trunc} << "invalid";
+
+  auto factory = makeFactory();
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code, nullptr, storage_provider_));
+
+  EXPECT_OUTCOME_TRUE(module,
+                      WasmModuleImpl::parseCode(readFile(optimizedPath(code))));
+  ASSERT_NE(module->getExportOrNull("sumtwo"), nullptr);
+}
+
+/**
+ * @given a factory
+ * @when a module is created from an empty code
+ * @then an error is returned
+ */
+TEST_F(OptimizingWasmModuleFactoryTest, EmptyCode) {
+  auto factory = makeFactory();
+  EXPECT_OUTCOME_FALSE(
+      err, factory.createModule(Buffer{}, nullptr, storage_provider_));
+  ASSERT_EQ(err, WasmModuleImpl::Error::EMPTY_STATE_CODE);
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_api/runtime_call_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::common::Buffer;
+using kagome::runtime::binaryen::RuntimeCallCache;
+
+/**
+ * @given an empty call cache
+ * @when a result is looked up @and then put to the cache and looked up again
+ * @then the first lookup misses @and the second one returns the result
+ */
+TEST(RuntimeCallCacheTest, PutGet) {
+  RuntimeCallCache cache{4, 1024};
+  auto key = RuntimeCallCache::makeKey("code"_hash256, "Core_version", {});
+
+  ASSERT_EQ(cache.get(key), nullptr);
+  cache.put(key, "version"_buf);
+
+  auto result = cache.get(key);
+  ASSERT_NE(result, nullptr);
+  ASSERT_EQ(*result, "version"_buf);
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+/**
+ * @given calls of the same method
+ * @when they differ in the scope or in the arguments
+ * @then their keys differ
+ */
+TEST(RuntimeCallCacheTest, KeysOfDifferentCalls) {
+  auto key = RuntimeCallCache::makeKey("root"_hash256, "Method", "01"_hex2buf);
+  ASSERT_NE(key,
+            RuntimeCallCache::makeKey("root2"_hash256, "Method", "01"_hex2buf));
+  ASSERT_NE(key,
+            RuntimeCallCache::makeKey("root"_hash256, "Method", "02"_hex2buf));
+  // the name and the arguments are not mixed up
+  ASSERT_NE(RuntimeCallCache::makeKey("root"_hash256, "Metho", "6401"_hex2buf),
+            key);
+}
+
+/**
+ * @given a cache full of entries
+ * @when one more result is put
+ * @then the least recently used result is evicted
+ */
+TEST(RuntimeCallCacheTest, EvictsLeastRecentlyUsedEntry) {
+  RuntimeCallCache cache{2, 1024};
+  auto key1 = RuntimeCallCache::makeKey("root"_hash256, "A", {});
+  auto key2 = RuntimeCallCache::makeKey("root"_hash256, "B", {});
+  auto key3 = RuntimeCallCache::makeKey("root"_hash256, "C", {});
+  cache.put(key1, "a"_buf);
+  cache.put(key2, "b"_buf);
+  // the first result becomes the most recently used one
+  ASSERT_NE(cache.get(key1), nullptr);
+
+  cache.put(key3, "c"_buf);
+  ASSERT_EQ(cache.entries(), 2);
+  ASSERT_NE(cache.get(key1), nullptr);
+  ASSERT_EQ(cache.get(key2), nullptr);
+  ASSERT_NE(cache.get(key3), nullptr);
+}
+
+/**
+ * @given a cache bounded by the total size of the results
+ * @when the results outgrow the bound
+ * @then the least recently used results are evicted @and a result larger
+ * than the bound is not kept
+ */
+TEST(RuntimeCallCacheTest, BoundedBySize) {
+  RuntimeCallCache cache{16, 8};
+  auto key1 = RuntimeCallCache::makeKey("root"_hash256, "A", {});
+  auto key2 = RuntimeCallCache::makeKey("root"_hash256, "B", {});
+  auto key3 = RuntimeCallCache::makeKey("root"_hash256, "C", {});
+  cache.put(key1, "abcd"_buf);
+  cache.put(key2, "efgh"_buf);
+  ASSERT_EQ(cache.size(), 8);
+
+  cache.put(key3, "ij"_buf);
+  ASSERT_EQ(cache.get(key1), nullptr);
+  ASSERT_EQ(cache.size(), 6);
+
+  cache.put(key1, "too large result"_buf);
+  ASSERT_EQ(cache.get(key1), nullptr);
+  ASSERT_EQ(cache.entries(), 2);
+}
@@ -7,12 +7,16 @@
 
 #include <gtest/gtest.h>
 
+#include "crypto/twox/twox.hpp"
 #include "mock/core/storage/trie/trie_batches_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
 #include "testutil/literals.hpp"
 
 using namespace kagome;  // NOLINT
 
+using storage::trie::PolkadotTrie;
+using StoredValue = PolkadotTrie::StoredValue;
+using ::testing::_;
 using ::testing::Invoke;
 using ::testing::Return;
 
@@ -24,6 +28,7 @@ class StorageWasmProviderTest : public ::testing::Test {
 
  protected:
   common::Buffer state_code_;
+  common::Buffer code_db_key_{1};
 };
 
 /**
@@ -41,8 +46,8 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenNoStorageUpdates) {
   EXPECT_CALL(*trie_db, getEphemeralBatch())
       .WillOnce(Invoke([this]() {
         auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-        EXPECT_CALL(*batch, get(runtime::kRuntimeCodeKey))
-            .WillOnce(Return(state_code_));
+        EXPECT_CALL(*batch, getStoredValue(runtime::kRuntimeCodeKey, _))
+            .WillOnce(Return(StoredValue{code_db_key_, state_code_}));
         return batch;
       }));
   auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
@@ -71,18 +76,19 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenStorageUpdates) {
   EXPECT_CALL(*trie_db, getEphemeralBatch())
       .WillOnce(Invoke([this]() {
         auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-        EXPECT_CALL(*batch, get(runtime::kRuntimeCodeKey))
-            .WillOnce(Return(state_code_));
+        EXPECT_CALL(*batch, getStoredValue(runtime::kRuntimeCodeKey, _))
+            .WillOnce(Return(StoredValue{code_db_key_, state_code_}));
         return batch;
       }));
   auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
 
   common::Buffer new_state_code{{1, 3, 3, 8}};
   EXPECT_CALL(*trie_db, getEphemeralBatchAt(second_state_root))
-      .WillOnce(Invoke([&new_state_code](auto &) {
+      .WillOnce(Invoke([this, &new_state_code](auto &) {
         auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-        EXPECT_CALL(*batch, get(runtime::kRuntimeCodeKey))
-            .WillOnce(Return(new_state_code));
+        EXPECT_CALL(*batch,
+                    getStoredValue(runtime::kRuntimeCodeKey, code_db_key_))
+            .WillOnce(Return(StoredValue{common::Buffer{2}, new_state_code}));
         return batch;
       }));
 
@@ -91,4 +97,48 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenStorageUpdates) {
 
   // then
   ASSERT_EQ(obtained_state_code, new_state_code);
+  ASSERT_EQ(wasm_provider->getStateCodeHashAt(second_state_root),
+            crypto::make_twox256(new_state_code));
+}
+
+/**
+ * @given wasm provider initialized with a storage with "state_code" stored by
+ * runtime key in a node with "code_db_key"
+ * @when storage root is updated by "second_state_root", which keeps the node
+ * with the code @and state code is obtained by wasm provider
+ * @then the node with the code is not loaded @and obtained state code and its
+ * hash are the ones of "state_code"
+ */
+TEST_F(StorageWasmProviderTest, GetCodeWhenCodeNodeIsUnchanged) {
+  auto trie_db = std::make_shared<storage::trie::TrieStorageMock>();
+  storage::trie::RootHash first_state_root{{1, 1, 1, 1}};
+  storage::trie::RootHash second_state_root{{2, 2, 2, 2}};
+
+  // given
+  EXPECT_CALL(*trie_db, getRootHashMock()).WillOnce(Return(first_state_root));
+  EXPECT_CALL(*trie_db, getEphemeralBatch())
+      .WillOnce(Invoke([this]() {
+        auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
+        EXPECT_CALL(*batch, getStoredValue(runtime::kRuntimeCodeKey, _))
+            .WillOnce(Return(StoredValue{code_db_key_, state_code_}));
+        return batch;
+      }));
+  auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
+
+  EXPECT_CALL(*trie_db, getEphemeralBatchAt(second_state_root))
+      .WillOnce(Invoke([this](auto &) {
+        auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
+        EXPECT_CALL(*batch,
+                    getStoredValue(runtime::kRuntimeCodeKey, code_db_key_))
+            .WillOnce(Return(StoredValue{code_db_key_, boost::none}));
+        return batch;
+      }));
+
+  // when
+  auto &obtained_state_code = wasm_provider->getStateCodeAt(second_state_root);
+
+  // then
+  ASSERT_EQ(obtained_state_code, state_code_);
+  ASSERT_EQ(wasm_provider->getStateCodeHashAt(second_state_root),
+            crypto::make_twox256(state_code_));
 }
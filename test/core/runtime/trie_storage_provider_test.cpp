@@ -97,103 +97,129 @@ TEST_F(TrieStorageProviderTest, NestedTransactions) {
   ASSERT_OUTCOME_SUCCESS_TRY(batch0->put("E"_buf, "-"_buf));
   check(batch0, "-----");
 
+  auto current = [this] { return storage_provider_->getCurrentBatch(); };
+
   /// @when 1. start tx 1
   {  // Transaction 1 - will be commited
     ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-    auto batch1 = storage_provider_->getCurrentBatch();
 
     /// @that 1. top level state is not changed, tx1 state like top level state
     check(batch0, "-----");
-    check(batch1, "-----");
+    check(current(), "-----");
 
     /// @when 2. change one of values
-    ASSERT_OUTCOME_SUCCESS_TRY(batch1->put("A"_buf, "1"_buf));
+    ASSERT_OUTCOME_SUCCESS_TRY(current()->put("A"_buf, "1"_buf));
 
     /// @that 2. top level state is not changed, tx1 state is changed
     check(batch0, "-----");
-    check(batch1, "1----");
+    check(current(), "1----");
 
     {
       /// @when 3. start tx 2
       ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-      auto batch2 = storage_provider_->getCurrentBatch();
 
-      /// @that 3. top level and tx1 state are not changed, tx2 state like tx1
-      /// state
+      /// @that 3. top level state is not changed, tx2 state like tx1 state
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "1----");
+      check(current(), "1----");
 
       /// @when 4. change next value
-      ASSERT_OUTCOME_SUCCESS_TRY(batch2->put("B"_buf, "2"_buf));
+      ASSERT_OUTCOME_SUCCESS_TRY(current()->put("B"_buf, "2"_buf));
 
-      /// @that 4. top level and tx1 state are not changed, tx2 state is changed
+      /// @that 4. top level state is not changed, tx2 state is changed
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "12---");
+      check(current(), "12---");
 
       {
         /// @when 5. start tx 3
         ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-        auto batch3 = storage_provider_->getCurrentBatch();
 
-        /// @that 5. top level, tx1, tx2 state are not changed, tx3 state like
-        /// tx2 state
+        /// @that 5. top level state is not changed, tx3 state like tx2 state
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "12---");
-        check(batch3, "12---");
+        check(current(), "12---");
 
-        /// @when 6. change next value
-        ASSERT_OUTCOME_SUCCESS_TRY(batch3->put("C"_buf, "3"_buf));
+        /// @when 6. change next value and the one changed in tx1
+        ASSERT_OUTCOME_SUCCESS_TRY(current()->put("C"_buf, "3"_buf));
+        ASSERT_OUTCOME_SUCCESS_TRY(current()->put("A"_buf, "3"_buf));
 
-        /// @that 6. top level, tx1 and tx2 state are not changed, tx3 state is
-        /// changed
+        /// @that 6. top level state is not changed, tx3 state is changed
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "12---");
-        check(batch3, "123--");
+        check(current(), "323--");
 
         /// @when 7. commit tx3
         ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
 
-        /// @that 7. top level and tx1 state are not changed, tx2 state became
-        /// like tx3
+        /// @that 7. top level state is not changed, tx2 state became like tx3
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "123--");
-        check(batch3, "123--");
+        check(current(), "323--");
       }
 
       /// @when 8. change next value
-      ASSERT_OUTCOME_SUCCESS_TRY(batch2->put("D"_buf, "2"_buf));
+      ASSERT_OUTCOME_SUCCESS_TRY(current()->put("D"_buf, "2"_buf));
 
-      /// @that 8. top level and tx1 state are not changed, tx2 state is changed
+      /// @that 8. top level state is not changed, tx2 state is changed
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "1232-");
+      check(current(), "3232-");
 
       /// @when 9. rollback tx2
       ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->rollbackTransaction());
 
-      /// @that 9. top level and tx1 state are not changed, tx2 state does not
-      /// matter anymore
+      /// @that 9. top level state is not changed, tx1 state is restored
+      /// including the change committed from tx3
       check(batch0, "-----");
-      check(batch1, "1----");
+      check(current(), "1----");
     }
 
     /// @when 10. change next value
-    ASSERT_OUTCOME_SUCCESS_TRY(batch1->put("E"_buf, "1"_buf));
+    ASSERT_OUTCOME_SUCCESS_TRY(current()->put("E"_buf, "1"_buf));
 
     /// @that 10. top level is not changed, tx1 state is changed
     check(batch0, "-----");
-    check(batch1, "1---1");
+    check(current(), "1---1");
 
-    /// @when 11. commit tx3
+    /// @when 11. commit tx1
     ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
 
     /// @that 11. top level became like tx1 state
     check(batch0, "1---1");
-    check(batch1, "1---1");
+    check(current(), "1---1");
   }
 }
+
+/**
+ * @given batch with values under a prefix
+ * @when the prefix is cleared in a nested transaction, a value is put under
+ * it, and the transaction is rolled back or committed
+ * @then the cleared values reappear on rollback, and only the value put after
+ * clearing stays on commit
+ */
+TEST_F(TrieStorageProviderTest, ClearPrefixInNestedTransaction) {
+  auto batch0 = storage_provider_->getCurrentBatch();
+  ASSERT_OUTCOME_SUCCESS_TRY(batch0->put("pa"_buf, "1"_buf));
+  ASSERT_OUTCOME_SUCCESS_TRY(batch0->put("pb"_buf, "2"_buf));
+  ASSERT_OUTCOME_SUCCESS_TRY(batch0->put("q"_buf, "3"_buf));
+
+  ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
+  auto batch = storage_provider_->getCurrentBatch();
+  ASSERT_OUTCOME_SUCCESS_TRY(batch->put("pc"_buf, "4"_buf));
+
+  ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
+  ASSERT_OUTCOME_SUCCESS_TRY(batch->clearPrefix("p"_buf));
+  ASSERT_FALSE(batch->contains("pa"_buf));
+  ASSERT_FALSE(batch->contains("pc"_buf));
+  ASSERT_TRUE(batch->contains("q"_buf));
+  ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->rollbackTransaction());
+  ASSERT_TRUE(batch->contains("pa"_buf));
+  ASSERT_TRUE(batch->contains("pc"_buf));
+
+  ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
+  ASSERT_OUTCOME_SUCCESS_TRY(batch->clearPrefix("p"_buf));
+  ASSERT_OUTCOME_SUCCESS_TRY(batch->put("pb"_buf, "5"_buf));
+  ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
+  ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
+
+  ASSERT_FALSE(batch0->contains("pa"_buf));
+  ASSERT_FALSE(batch0->contains("pc"_buf));
+  ASSERT_OUTCOME_SUCCESS(pb, batch0->get("pb"_buf));
+  ASSERT_EQ(pb, "5"_buf);
+  ASSERT_TRUE(batch0->contains("q"_buf));
+}
@@ -8,8 +8,10 @@
 #include "runtime/binaryen/wasm_memory_impl.hpp"
 #include "testutil/prepare_loggers.hpp"
 
+using kagome::runtime::binaryen::kAllocationHeaderSize;
 using kagome::runtime::binaryen::kDefaultHeapBase;
 using kagome::runtime::binaryen::kInitialMemorySize;
+using kagome::runtime::binaryen::kMaxAllocationSize;
 using kagome::runtime::binaryen::roundUpAlign;
 using kagome::runtime::binaryen::WasmMemoryImpl;
 
@@ -72,7 +74,8 @@ TEST_F(MemoryHeapTest, AllocatedTooBigMemoryFailed) {
 /**
  * @given memory with already allocated memory of size1
  * @when allocate memory with size2
- * @then the pointer pointing to the end of the first memory chunk is returned
+ * @then the pointer pointing right after the header following the first
+ * memory chunk rounded up to a power of two is returned
  */
 TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
   const size_t size1 = 2049;
@@ -80,13 +83,25 @@ TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
 
   // allocate memory of size 1
   auto ptr1 = memory_.allocate(size1);
-  // first memory chunk is always allocated at min non-zero aligned address
-  ASSERT_EQ(ptr1, kDefaultHeapBase);
+  // first memory chunk is always allocated right after its header at the heap
+  // base
+  ASSERT_EQ(ptr1, kDefaultHeapBase + kAllocationHeaderSize);
 
   // allocated second memory chunk
   auto ptr2 = memory_.allocate(size2);
-  // second memory chunk is placed right after the first one (alligned by 4)
-  ASSERT_EQ(ptr2, roundUpAlign(size1 + ptr1));
+  // second memory chunk is placed right after the first one (rounded up to
+  // 4096) and its own header
+  ASSERT_EQ(ptr2, ptr1 + 4096 + kAllocationHeaderSize);
+}
+
+/**
+ * @given memory of arbitrary size
+ * @when trying to allocate memory bigger than max allocation size
+ * @then zero pointer is returned
+ */
+TEST_F(MemoryHeapTest, AllocateMoreThanMaxAllocationSizeFailed) {
+  ASSERT_NE(memory_.allocate(kMaxAllocationSize), 0);
+  ASSERT_EQ(memory_.allocate(kMaxAllocationSize + 1), 0);
 }
 
 /**
@@ -148,94 +163,88 @@ TEST_F(MemoryHeapTest, AllocateAfterDeallocate) {
 }
 
 /**
- * @given full memory with deallocated memory chunk of size1
- * @when allocate memory chunk of size bigger than size1
- * @then allocate returns memory of size bigger
+ * @given memory with deallocated memory chunk of size1
+ * @when allocate memory chunk of size of the bigger size class than size1
+ * @then it is allocated at the end of the heap
  */
 TEST_F(MemoryHeapTest, AllocateTooBigMemoryAfterDeallocate) {
-  // two memory sizes totalling to the total memory size
   const size_t size1 = 2047;
   const size_t size2 = 2049;
 
-  // allocate two memory chunks with total size equal to the memory size
   auto ptr1 = memory_.allocate(size1);
   auto ptr2 = memory_.allocate(size2);
 
   // calculate memory offset after two allocations
-  auto mem_offset = ptr2 + size2;
+  auto mem_offset = ptr2 + 4096;
 
   // deallocate first memory chunk
   memory_.deallocate(ptr1);
 
-  // allocate new memory chunk with bigger size than the space left in the
-  // memory
-  auto ptr3 = memory_.allocate(size1 + 1);
+  // chunk of 2048 bytes does not fit 2049 bytes
+  auto ptr3 = memory_.allocate(size1 + 2);
 
-  // memory is allocated on mem offset (aligned by 4)
-  ASSERT_EQ(ptr3, kagome::runtime::binaryen::roundUpAlign(mem_offset));
+  ASSERT_EQ(ptr3, mem_offset + kAllocationHeaderSize);
 }
 
 /**
- * @given full memory with different sized memory chunks
- * @when deallocate chunks in various ways: in order, reversed, single chunk
- * @then neighbor chunks are combined
+ * @given memory with chunks of different size classes
+ * @when chunks are deallocated and allocated again
+ * @then a freed chunk is reused by the next allocation of its size class only,
+ * the last freed one first
  */
-TEST_F(MemoryHeapTest, CombineDeallocatedChunks) {
-  // Fill memory
-  constexpr size_t size1 = roundUpAlign(1) * 1;
-  auto ptr1 = memory_.allocate(size1);
-  constexpr size_t size2 = roundUpAlign(1) * 2;
-  auto ptr2 = memory_.allocate(size2);
-  constexpr size_t size3 = roundUpAlign(1) * 3;
-  auto ptr3 = memory_.allocate(size3);
-  constexpr size_t size4 = roundUpAlign(1) * 4;
-  auto ptr4 = memory_.allocate(size4);
-  constexpr size_t size5 = roundUpAlign(1) * 5;
-  auto ptr5 = memory_.allocate(size5);
-  constexpr size_t size6 = roundUpAlign(1) * 6;
-  auto ptr6 = memory_.allocate(size6);
-  constexpr size_t size7 = roundUpAlign(1) * 7;
-  auto ptr7 = memory_.allocate(size7);
-  // A: [ 1 ][ 2 ][ 3 ][ 4 ][ 5 ][ 6 ][ 7 ]
-  // D:
-
-  memory_.deallocate(ptr2);
-  // A: [ 1 ]     [ 3 ][ 4 ][ 5 ][ 6 ][ 7 ]
-  // D:      [ 2 ]
-  memory_.deallocate(ptr3);
-  // A: [ 1 ]          [ 4 ][ 5 ][ 6 ][ 7 ]
-  // D:      [ 2    3 ]
-  {
-    auto opt_size = memory_.getDeallocatedChunkSize(ptr2);
-    ASSERT_TRUE(opt_size);
-    EXPECT_EQ(opt_size.value(), size2 + size3);
-  }
+TEST_F(MemoryHeapTest, ReuseFreedChunksOfSameSizeClass) {
+  auto ptr1 = memory_.allocate(8);
+  auto ptr2 = memory_.allocate(100);
+  auto ptr3 = memory_.allocate(5);
+  auto ptr4 = memory_.allocate(128);
+
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr1), 8u);
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr2), 128u);
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr3), 8u);
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr4), 128u);
+
+  EXPECT_EQ(memory_.deallocate(ptr1), 8u);
+  EXPECT_EQ(memory_.deallocate(ptr3), 8u);
+  EXPECT_EQ(memory_.deallocate(ptr2), 128u);
+  EXPECT_EQ(memory_.getFreeChunksNum(8), 2);
+  EXPECT_EQ(memory_.getFreeChunksNum(128), 1);
+
+  // chunk freed twice is not freed again
+  EXPECT_FALSE(memory_.deallocate(ptr1));
+  EXPECT_FALSE(memory_.getAllocatedChunkSize(ptr1));
+
+  EXPECT_EQ(memory_.allocate(7), ptr3);
+  EXPECT_EQ(memory_.allocate(1), ptr1);
+  EXPECT_EQ(memory_.allocate(65), ptr2);
+  EXPECT_EQ(memory_.getFreeChunksNum(8), 0);
+  EXPECT_EQ(memory_.getFreeChunksNum(128), 0);
+}
 
-  memory_.deallocate(ptr5);
-  // A: [ 1 ]          [ 4 ]     [ 6 ][ 7 ]
-  // D:      [ 2    3 ]     [ 5 ]
-  memory_.deallocate(ptr6);
-  // A: [ 1 ]          [ 4 ]          [ 7 ]
-  // D:      [ 2    3 ]     [ 5    6 ]
-  {
-    auto opt_size = memory_.getDeallocatedChunkSize(ptr5);
-    ASSERT_TRUE(opt_size.has_value());
-    EXPECT_EQ(opt_size.value(), size5 + size6);
+/**
+ * @given memory with a sequence of interleaved allocations and deallocations
+ * @when data is stored to every allocated chunk
+ * @then no chunk overwrites the data of another one
+ */
+TEST_F(MemoryHeapTest, AllocatedChunksDoNotOverlap) {
+  std::vector<std::pair<kagome::runtime::WasmPointer, kagome::common::Buffer>>
+      chunks;
+  uint8_t fill = 0;
+  for (size_t i = 0; i < 300; ++i) {
+    const size_t size = 1 + (i * 37) % 700;
+    auto ptr = memory_.allocate(size);
+    ASSERT_NE(ptr, 0);
+    kagome::common::Buffer data(size, ++fill);
+    memory_.storeBuffer(ptr, data);
+    chunks.emplace_back(ptr, std::move(data));
+    if (i % 3 == 2) {
+      auto freed = chunks.begin() + (i % chunks.size());
+      ASSERT_TRUE(memory_.deallocate(freed->first));
+      chunks.erase(freed);
+    }
   }
-
-  memory_.deallocate(ptr4);
-  // A: [ 1 ]                         [ 7 ]
-  // D:      [ 2    3    4    5    6 ]
-  {
-    auto opt_size = memory_.getDeallocatedChunkSize(ptr2);
-    ASSERT_TRUE(opt_size.has_value());
-    EXPECT_EQ(opt_size.value(), size2 + size3 + size4 + size5 + size6);
+  for (auto &[ptr, data] : chunks) {
+    EXPECT_EQ(memory_.loadN(ptr, data.size()), data);
   }
-
-  EXPECT_EQ(memory_.getDeallocatedChunksNum(), 1);
-  EXPECT_EQ(memory_.getAllocatedChunksNum(), 2);
-  EXPECT_TRUE(memory_.getAllocatedChunkSize(ptr1));
-  EXPECT_TRUE(memory_.getAllocatedChunkSize(ptr7));
 }
 
 /**
@@ -259,18 +268,41 @@ TEST_F(MemoryHeapTest, LoadNTest) {
 /**
  * @given Some memory is allocated
  * @when Memory is reset
- * @then Allocated memory's offset is min non-zero aligned address
+ * @then Memory is allocated right after the header at the heap base
  */
 TEST_F(MemoryHeapTest, ResetTest) {
   const size_t N = 42;
 
-  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase);
+  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase + kAllocationHeaderSize);
 
   memory_.reset();
-  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase);
+  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase + kAllocationHeaderSize);
 
   auto newHeapBase = roundUpAlign(kDefaultHeapBase + 12345);
   memory_.setHeapBase(newHeapBase);
   memory_.reset();
-  ASSERT_EQ(memory_.allocate(N), newHeapBase);
+  ASSERT_EQ(memory_.allocate(N), newHeapBase + kAllocationHeaderSize);
+}
+
+/**
+ * @given memory with a snapshot of the part below the heap base
+ * @when values are stored below the heap base @and to an allocated chunk
+ * @and the snapshot is restored
+ * @then the values below the heap base are the ones from the snapshot @and
+ * the allocated chunk keeps its value
+ */
+TEST_F(MemoryHeapTest, RestoreSnapshot) {
+  memory_.store32(42, 1);
+  memory_.takeSnapshot();
+
+  memory_.store32(42, 2);
+  memory_.store64(kDefaultHeapBase - sizeof(int64_t), 3);
+  auto ptr = memory_.allocate(sizeof(int32_t));
+  memory_.store32(ptr, 4);
+
+  memory_.restoreSnapshot();
+
+  ASSERT_EQ(memory_.load32u(42), 1);
+  ASSERT_EQ(memory_.load64u(kDefaultHeapBase - sizeof(int64_t)), 0);
+  ASSERT_EQ(memory_.load32u(ptr), 4);
 }
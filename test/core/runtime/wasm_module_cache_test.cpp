@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_cache.hpp"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+#include <binaryen/wasm.h>
+
+#include "runtime/binaryen/module/wasm_module_impl.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using kagome::common::Hash256;
+using kagome::runtime::binaryen::WasmModuleCache;
+using kagome::runtime::binaryen::WasmModuleImpl;
+
+struct WasmModuleCacheTest : public test::BaseFS_Test {
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  WasmModuleCacheTest() : test::BaseFS_Test("/tmp/kagome_wasm_module_cache") {}
+
+  Hash256 code_hash{{1, 2, 3}};
+};
+
+/**
+ * @given empty cache
+ * @when a module with a custom section is stored
+ * @then the module is loaded without the custom section @and the stored
+ * module keeps it @and a module of another kind is not loaded
+ */
+TEST_F(WasmModuleCacheTest, StoreAndLoad) {
+  WasmModuleCache cache{base_path};
+  ASSERT_FALSE(cache.load(code_hash, "O2"));
+
+  wasm::Module module;
+  wasm::UserSection section;
+  section.name = "custom";
+  section.data = {1, 2, 3};
+  module.userSections.push_back(section);
+  cache.store(code_hash, "O2", module);
+  ASSERT_EQ(module.userSections.size(), 1);
+
+  auto loaded = cache.load(code_hash, "O2");
+  ASSERT_TRUE(loaded);
+  EXPECT_OUTCOME_TRUE(parsed, WasmModuleImpl::parseCode(loaded.value()));
+  ASSERT_TRUE(parsed->userSections.empty());
+
+  ASSERT_FALSE(cache.load(code_hash, "O1"));
+}
+
+/**
+ * @given cache directory with the modules of another executor version @and a
+ * module kept before the modules were versioned
+ * @when cache is created on it
+ * @then those modules are removed @and other files are kept
+ */
+TEST_F(WasmModuleCacheTest, RemovesOtherVersions) {
+  auto stale = base_path / "binaryen-v0";
+  fs::create_directories(stale);
+  std::ofstream{(stale / "module.wasm").native()} << "stale";
+  auto unversioned = base_path / "module.wasm";
+  std::ofstream{unversioned.native()} << "stale";
+  auto other = base_path / "notes.txt";
+  std::ofstream{other.native()} << "other";
+
+  WasmModuleCache cache{base_path};
+
+  ASSERT_FALSE(fs::exists(stale));
+  ASSERT_FALSE(fs::exists(unversioned));
+  ASSERT_TRUE(fs::exists(other));
+}
+
+/**
+ * @given cache keeping a module
+ * @when the module is removed
+ * @then it is not loaded anymore
+ */
+TEST_F(WasmModuleCacheTest, Remove) {
+  WasmModuleCache cache{base_path};
+  wasm::Module module;
+  cache.store(code_hash, "O2", module);
+  ASSERT_TRUE(cache.load(code_hash, "O2"));
+
+  cache.remove(code_hash, "O2");
+
+  ASSERT_FALSE(cache.load(code_hash, "O2"));
+}
@@ -0,0 +1,167 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_instance_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/host_api/host_api_factory_mock.hpp"
+#include "mock/core/host_api/host_api_mock.hpp"
+#include "mock/core/runtime/trie_storage_provider_mock.hpp"
+#include "mock/core/runtime/wasm_module_mock.hpp"
+#include "runtime/binaryen/binaryen_wasm_memory_factory.hpp"
+#include "runtime/binaryen/runtime_environment.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using kagome::common::Hash256;
+using kagome::host_api::HostApi;
+using kagome::host_api::HostApiFactoryMock;
+using kagome::host_api::HostApiMock;
+using kagome::runtime::TrieStorageProviderMock;
+using kagome::runtime::WasmMemory;
+using kagome::runtime::binaryen::BinaryenWasmMemoryFactory;
+using kagome::runtime::binaryen::RuntimeEnvironment;
+using kagome::runtime::binaryen::RuntimeExternalInterface;
+using kagome::runtime::binaryen::WasmModuleInstance;
+using kagome::runtime::binaryen::WasmModuleInstanceMock;
+using kagome::runtime::binaryen::WasmModuleInstancePool;
+using kagome::runtime::binaryen::WasmModuleMock;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class WasmModuleInstancePoolTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    // the host api gives the memory of the interface it is made for
+    EXPECT_CALL(*host_api_factory_, make(_, _, _, _))
+        .WillRepeatedly(Invoke([](auto &, auto &, auto memory, auto &) {
+          auto host_api = std::make_unique<HostApiMock>();
+          EXPECT_CALL(*host_api, memory()).WillRepeatedly(Return(memory));
+          return std::unique_ptr<HostApi>(std::move(host_api));
+        }));
+
+    EXPECT_CALL(module_, instantiate(_))
+        .WillRepeatedly(Invoke([this](auto &) {
+          auto instance = std::make_unique<WasmModuleInstanceMock>();
+          EXPECT_CALL(*instance, getExportGlobal(_))
+              .WillRepeatedly(Return(wasm::Literal(int32_t{1024})));
+          EXPECT_CALL(*instance, restoreGlobals())
+              .WillRepeatedly(Invoke([this] { ++restored_; }));
+          return std::unique_ptr<WasmModuleInstance>(std::move(instance));
+        }));
+  }
+
+  /**
+   * @returns environment with an instance of the module of the code with
+   * \arg code_hash taken from the pool
+   */
+  RuntimeEnvironment acquire(const Hash256 &code_hash) {
+    return pool_
+        ->acquire(code_hash,
+                  module_,
+                  [this] {
+                    ++instantiated_;
+                    return std::make_shared<RuntimeExternalInterface>(
+                        nullptr,
+                        nullptr,
+                        memory_factory_,
+                        host_api_factory_,
+                        storage_provider_);
+                  })
+        .value();
+  }
+
+  void initPool(size_t capacity) {
+    pool_ = std::make_shared<WasmModuleInstancePool>(capacity);
+  }
+
+  Hash256 code1_{{1}};
+  Hash256 code2_{{2}};
+
+  std::shared_ptr<BinaryenWasmMemoryFactory> memory_factory_ =
+      std::make_shared<BinaryenWasmMemoryFactory>();
+  std::shared_ptr<HostApiFactoryMock> host_api_factory_ =
+      std::make_shared<HostApiFactoryMock>();
+  std::shared_ptr<TrieStorageProviderMock> storage_provider_ =
+      std::make_shared<TrieStorageProviderMock>();
+  WasmModuleMock module_;
+  std::shared_ptr<WasmModuleInstancePool> pool_;
+
+  // number of the instances made by the pool
+  size_t instantiated_ = 0;
+  // number of the instances returned to the pool
+  size_t restored_ = 0;
+};
+
+/**
+ * @given a pool
+ * @when an instance is acquired, released and acquired again
+ * @then the released instance is restored and reused
+ */
+TEST_F(WasmModuleInstancePoolTest, ReleasedInstanceIsReused) {
+  initPool(1);
+  { auto env = acquire(code1_); }
+  ASSERT_EQ(restored_, 1);
+
+  auto env = acquire(code1_);
+  ASSERT_EQ(instantiated_, 1);
+}
+
+/**
+ * @given a pool of one instance
+ * @when two instances are used at once and released
+ * @then only one of them is kept
+ */
+TEST_F(WasmModuleInstancePoolTest, KeepsAtMostCapacity) {
+  initPool(1);
+  {
+    auto env1 = acquire(code1_);
+    auto env2 = acquire(code1_);
+  }
+  ASSERT_EQ(instantiated_, 2);
+
+  auto env1 = acquire(code1_);
+  auto env2 = acquire(code1_);
+  ASSERT_EQ(instantiated_, 3);
+}
+
+/**
+ * @given a full pool keeping an instance of a runtime code
+ * @when an instance of another code is released
+ * @then the instance of the code used before is dropped in favour of it
+ */
+TEST_F(WasmModuleInstancePoolTest, InstancesOfReplacedCodeAreDropped) {
+  initPool(1);
+  { auto env = acquire(code1_); }
+  { auto env = acquire(code2_); }
+  ASSERT_EQ(instantiated_, 2);
+
+  { auto env = acquire(code2_); }
+  ASSERT_EQ(instantiated_, 2);
+
+  { auto env = acquire(code1_); }
+  ASSERT_EQ(instantiated_, 3);
+}
+
+/**
+ * @given an instance taken from a pool
+ * @when the pool is destroyed before the instance is released
+ * @then the instance is destroyed without being returned to the pool
+ */
+TEST_F(WasmModuleInstancePoolTest, ReleaseAfterPoolIsDestroyed) {
+  initPool(1);
+  auto env = acquire(code1_);
+  pool_.reset();
+
+  env.module_instance.reset();
+  ASSERT_EQ(restored_, 0);
+}
@@ -38,4 +38,33 @@ namespace kagome::scale {
                                                   0, 3,  0, 0, 0, 4, 0, 0, 0,
                                                   5, 0,  0, 0, 2, 0, 0, 0})));
   }
+
+  /**
+   * @given encoded vector with the max number of items, whose length is
+   * encoded in a single byte
+   * @when several items are appended at once
+   * @then the result is the same as if they were appended one by one
+   */
+  TEST(EncodeAppend, AppendMany) {
+    auto item = scale::encode(uint32_t{42}).value();
+    std::vector<uint8_t> one_by_one{};
+    for (size_t i = 0; i < 63; ++i) {
+      ASSERT_TRUE(append_or_new_vec(one_by_one, item).has_value());
+    }
+    auto at_once = one_by_one;
+
+    auto item1 = scale::encode(uint16_t{1}).value();
+    auto item2 = scale::encode(uint64_t{2}).value();
+    ASSERT_TRUE(append_or_new_vec(one_by_one, item1).has_value());
+    ASSERT_TRUE(append_or_new_vec(one_by_one, item2).has_value());
+    ASSERT_TRUE(append_or_new_vec(at_once, {item1, item2}).has_value());
+    ASSERT_THAT(at_once, ContainerEq(one_by_one));
+
+    std::vector<uint8_t> new_vec{};
+    ASSERT_TRUE(append_or_new_vec(new_vec, {item1, item2}).has_value());
+    std::vector<uint8_t> expected{8};
+    expected.insert(expected.end(), item1.begin(), item1.end());
+    expected.insert(expected.end(), item2.begin(), item2.end());
+    ASSERT_THAT(new_vec, ContainerEq(expected));
+  }
 }  // namespace kagome::scale
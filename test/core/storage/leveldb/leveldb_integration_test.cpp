@@ -124,3 +124,75 @@ TEST_F(LevelDB_Integration_Test, Iterator) {
     EXPECT_EQ(counter[i], 1);
   }
 }
+
+/**
+ * @given database with some of the keys to read
+ * @when the keys are read at once in an unsorted order
+ * @then the values of the present keys are returned in the order of the keys
+ * @and the absent keys are not found
+ */
+TEST_F(LevelDB_Integration_Test, GetMany) {
+  EXPECT_OUTCOME_TRUE_1(db_->put(Buffer{1}, Buffer{11}));
+  EXPECT_OUTCOME_TRUE_1(db_->put(Buffer{1, 2}, Buffer{12}));
+  EXPECT_OUTCOME_TRUE_1(db_->put(Buffer{3}, Buffer{13}));
+
+  auto values = db_->getMany({{3}, {2}, {1, 2}, {1}, {4}});
+  ASSERT_EQ(values.size(), 5);
+  EXPECT_OUTCOME_TRUE_2(first, values[0]);
+  EXPECT_EQ(first, Buffer{13});
+  EXPECT_EQ(values[1].error(), DatabaseError::NOT_FOUND);
+  EXPECT_OUTCOME_TRUE_2(third, values[2]);
+  EXPECT_EQ(third, Buffer{12});
+  EXPECT_OUTCOME_TRUE_2(fourth, values[3]);
+  EXPECT_EQ(fourth, Buffer{11});
+  EXPECT_EQ(values[4].error(), DatabaseError::NOT_FOUND);
+}
+
+/**
+ * @given database with {key}
+ * @when {key} and an absent key are viewed
+ * @then the consumer is given {value} @and the absent key is not found
+ * without calling the consumer
+ */
+TEST_F(LevelDB_Integration_Test, View) {
+  EXPECT_OUTCOME_TRUE_1(db_->put(key_, value_));
+  EXPECT_OUTCOME_TRUE_1(
+      db_->view(key_, [this](auto value) -> outcome::result<void> {
+        EXPECT_EQ(Buffer{value}, value_);
+        return outcome::success();
+      }));
+
+  bool called = false;
+  auto r = db_->view(Buffer{4, 2}, [&called](auto) -> outcome::result<void> {
+    called = true;
+    return outcome::success();
+  });
+  EXPECT_FALSE(r);
+  EXPECT_EQ(r.error(), DatabaseError::NOT_FOUND);
+  EXPECT_FALSE(called);
+}
+
+/**
+ * @given database with {key}, reopened with a block cache, bloom filters and
+ * no compression
+ * @when {key} and an absent key are read
+ * @then {value} is read @and the absent key is not found
+ */
+TEST_F(LevelDB_Integration_Test, CreateWithConfig) {
+  EXPECT_OUTCOME_TRUE_1(db_->put(key_, value_));
+  db_.reset();
+
+  LevelDBConfig config;
+  config.block_cache_size = 1024 * 1024;
+  config.bloom_filter_bits = 10;
+  config.write_buffer_size = 1024 * 1024;
+  config.max_open_files = 100;
+  config.compression = false;
+  EXPECT_OUTCOME_TRUE(db, LevelDB::create(getPathString(), config));
+
+  EXPECT_OUTCOME_TRUE_2(val, db->get(key_));
+  EXPECT_EQ(val, value_);
+  auto r = db->get(Buffer{4, 2});
+  EXPECT_FALSE(r);
+  EXPECT_EQ(r.error(), DatabaseError::NOT_FOUND);
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_nibbles.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::NibbleSlice;
+
+/**
+ * @given a key
+ * @when it is viewed as nibbles
+ * @then its nibbles are its bytes split into halves, the high one first
+ */
+TEST(NibbleSliceTest, SplitsKeyBytes) {
+  auto key = "1a2b"_hex2buf;
+  auto nibbles = NibbleSlice::fromKey(key);
+  ASSERT_EQ(nibbles, (KeyNibbles{1, 0xa, 2, 0xb}));
+  ASSERT_EQ(nibbles.subspan(1, 2), (KeyNibbles{0xa, 2}));
+  ASSERT_EQ(nibbles.subspan(3), (KeyNibbles{0xb}));
+  ASSERT_TRUE(nibbles.subspan(4).empty());
+}
+
+/**
+ * @given slices which start in different halves of a byte
+ * @when their common prefix is computed
+ * @then it is the same as for the nibbles stored one per byte
+ */
+TEST(NibbleSliceTest, CommonPrefixOfUnalignedSlices) {
+  auto first = "123456"_hex2buf;
+  auto second = "234560"_hex2buf;
+  auto first_nibbles = NibbleSlice::fromKey(first);
+  auto second_nibbles = NibbleSlice::fromKey(second);
+  ASSERT_EQ(first_nibbles.subspan(1).commonPrefixLength(second_nibbles), 5);
+  ASSERT_EQ(first_nibbles.commonPrefixLength(second_nibbles), 0);
+  ASSERT_TRUE(
+      first_nibbles.subspan(1).startsWith(second_nibbles.subspan(0, 3)));
+  ASSERT_TRUE(second_nibbles.startsWith(first_nibbles.subspan(1)));
+  ASSERT_FALSE(first_nibbles.subspan(1).startsWith(second_nibbles));
+}
+
+/**
+ * @given a slice which starts in the middle of a byte
+ * @when nibbles are copied from it and appended to
+ * @then the copy holds the same nibbles in the same order
+ */
+TEST(KeyNibblesTest, CopiesAndAppendsSlices) {
+  auto key = "abcdef"_hex2buf;
+  KeyNibbles nibbles{NibbleSlice::fromKey(key).subspan(1, 3)};
+  ASSERT_EQ(nibbles, (KeyNibbles{0xb, 0xc, 0xd}));
+
+  nibbles.putUint8(1).put(NibbleSlice::fromKey(key).subspan(3));
+  ASSERT_EQ(nibbles, (KeyNibbles{0xb, 0xc, 0xd, 1, 0xd, 0xe, 0xf}));
+
+  // a part of itself is assigned to the sequence
+  nibbles = nibbles.subspan(2, 3);
+  ASSERT_EQ(nibbles, (KeyNibbles{0xd, 1, 0xd}));
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/node_arena.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::trie::NodeArena;
+using kagome::storage::trie::PolkadotTrieImpl;
+
+namespace {
+  std::vector<Buffer> makeKeys(size_t n) {
+    std::mt19937 rand{42};
+    std::vector<Buffer> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      Buffer key(32, 0);
+      for (auto &byte : key) {
+        byte = rand();
+      }
+      keys.push_back(std::move(key));
+    }
+    return keys;
+  }
+}  // namespace
+
+/**
+ * @given a trie
+ * @when many entries are put into it
+ * @then its nodes take far fewer allocations from the system than there are
+ * nodes @and the entries are readable
+ */
+TEST(NodeArenaTest, NodesAreAllocatedInChunks) {
+  PolkadotTrieImpl trie;
+  auto keys = makeKeys(1000);
+  for (auto &key : keys) {
+    EXPECT_OUTCOME_TRUE_1(trie.put(key, key));
+  }
+  ASSERT_GE(trie.arena().allocations(), keys.size());
+  ASSERT_LT(trie.arena().chunks(), trie.arena().allocations() / 10);
+  for (auto &key : keys) {
+    EXPECT_OUTCOME_TRUE(value, trie.get(key));
+    ASSERT_EQ(value, key);
+  }
+}
+
+/**
+ * @given a trie with some entries
+ * @when the trie is destroyed
+ * @then its nodes which are still referenced stay valid
+ */
+TEST(NodeArenaTest, NodesOutliveTrie) {
+  auto trie = std::make_unique<PolkadotTrieImpl>();
+  EXPECT_OUTCOME_TRUE_1(trie->put("0102"_hex2buf, "a"_buf));
+  EXPECT_OUTCOME_TRUE_1(trie->put("0103"_hex2buf, "b"_buf));
+  auto root = trie->getRoot();
+  trie.reset();
+
+  PolkadotTrieImpl other{root};
+  EXPECT_OUTCOME_TRUE(value, other.get("0102"_hex2buf));
+  ASSERT_EQ(value, "a"_buf);
+  EXPECT_OUTCOME_TRUE_1(other.put("0104"_hex2buf, "c"_buf));
+  EXPECT_OUTCOME_TRUE(value2, other.get("0103"_hex2buf));
+  ASSERT_EQ(value2, "b"_buf);
+}
+
+/**
+ * @given a trie
+ * @when the same entries are put into it and removed from it many times
+ * @then the nodes freed by the removal are reused @and the arena takes no
+ * more memory from the system than for the first time
+ */
+TEST(NodeArenaTest, FreedNodesAreReused) {
+  PolkadotTrieImpl trie;
+  auto keys = makeKeys(1000);
+  size_t chunks = 0;
+  for (auto round = 0; round < 10; ++round) {
+    for (auto &key : keys) {
+      EXPECT_OUTCOME_TRUE_1(trie.put(key, key));
+    }
+    for (auto &key : keys) {
+      EXPECT_OUTCOME_TRUE_1(trie.remove(key));
+    }
+    if (round == 0) {
+      chunks = trie.arena().chunks();
+    }
+  }
+  ASSERT_EQ(trie.arena().chunks(), chunks);
+  ASSERT_GT(trie.arena().reusedAllocations(), trie.arena().allocations() / 2);
+}
+
+/**
+ * Measures the time to build and drop a trie with 100k entries and the
+ * number of allocations its nodes take; run with
+ * --gtest_also_run_disabled_tests
+ */
+TEST(NodeArenaTest, DISABLED_Benchmark) {
+  auto keys = makeKeys(100000);
+  auto start = std::chrono::steady_clock::now();
+  auto trie = std::make_unique<PolkadotTrieImpl>();
+  for (auto &key : keys) {
+    EXPECT_OUTCOME_TRUE_1(trie->put(key, key));
+  }
+  auto built = std::chrono::steady_clock::now();
+  auto allocations = trie->arena().allocations();
+  auto bytes = trie->arena().allocatedBytes();
+  auto chunks = trie->arena().chunks();
+  trie.reset();
+  auto dropped = std::chrono::steady_clock::now();
+
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  std::cout << "build: " << duration_cast<milliseconds>(built - start).count()
+            << " ms, drop: "
+            << duration_cast<milliseconds>(dropped - built).count()
+            << " ms; " << allocations << " nodes of " << bytes
+            << " bytes in " << chunks << " chunks" << std::endl;
+}
@@ -3,6 +3,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <chrono>
+#include <iostream>
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include "storage/in_memory/in_memory_storage.hpp"
@@ -414,3 +418,127 @@ TEST_F(TrieTest, GetNodeReturnsNullptrWhenNotFound) {
       trie->getNode(trie->getRoot(), KeyNibbles{"01020304050607"_hex2buf}));
   ASSERT_EQ(res, nullptr) << res->value->toHex();
 }
+
+/**
+ * @given a trie with keys sharing prefixes
+ * @when several keys, present, absent and repeated, are read at once
+ * @then the results are the same as when the keys are read one by one
+ */
+TEST_F(TrieTest, GetMany) {
+  for (auto &entry : TrieTest::data) {
+    EXPECT_OUTCOME_TRUE_1(trie->put(entry.first, entry.second));
+  }
+  std::vector<Buffer> keys{"0a0b0c"_hex2buf,
+                           "0102"_hex2buf,
+                           "123456"_hex2buf,
+                           "010203"_hex2buf,
+                           "12"_hex2buf,
+                           "1234"_hex2buf,
+                           "0a0b0c"_hex2buf,
+                           "010a0b"_hex2buf,
+                           "0a"_hex2buf,
+                           "12345678"_hex2buf,
+                           ""_buf};
+  auto values = trie->getMany(keys);
+  ASSERT_EQ(values.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto expected = trie->get(keys[i]);
+    ASSERT_EQ(values[i].has_value(), expected.has_value()) << i;
+    if (expected) {
+      ASSERT_EQ(values[i].value(), expected.value()) << i;
+    } else {
+      ASSERT_EQ(values[i].error(), expected.error()) << i;
+    }
+  }
+}
+
+/**
+ * @given a trie with many short random keys
+ * @when many random keys are read at once
+ * @then the results are the same as when the keys are read one by one
+ */
+TEST_F(TrieTest, GetManyRandomKeys) {
+  std::mt19937 rand{42};
+  auto random_key = [&rand] {
+    Buffer key(rand() % 4, 0);
+    for (auto &byte : key) {
+      // few distinct bytes make the keys share prefixes
+      byte = rand() % 3 * 0x11 + rand() % 2;
+    }
+    return key;
+  };
+  for (size_t i = 0; i < 200; ++i) {
+    auto key = random_key();
+    EXPECT_OUTCOME_TRUE_1(trie->put(key, key));
+  }
+  std::vector<Buffer> keys;
+  for (size_t i = 0; i < 500; ++i) {
+    keys.push_back(random_key());
+  }
+  auto values = trie->getMany(keys);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(values[i].has_value(), trie->contains(keys[i])) << keys[i];
+    if (values[i]) {
+      ASSERT_EQ(values[i].value(), keys[i]);
+    }
+  }
+}
+
+/**
+ * @given a trie with branches, branches with values and leaves
+ * @when the nodes are inspected
+ * @then their kind agrees with their trie type
+ */
+TEST_F(TrieTest, NodeKindsMatchTypes) {
+  using T = kagome::storage::trie::PolkadotNode::Type;
+  EXPECT_OUTCOME_TRUE_1(trie->put("0102"_hex2buf, "a"_buf));
+  EXPECT_OUTCOME_TRUE_1(trie->put("0103"_hex2buf, "b"_buf));
+  auto root = trie->getRoot();
+  ASSERT_TRUE(root->isBranch());
+  ASSERT_FALSE(root->isDummy());
+  ASSERT_EQ(root->getTrieType(), T::BranchEmptyValue);
+  ASSERT_EQ(root->getType(), static_cast<int>(T::BranchEmptyValue));
+
+  EXPECT_OUTCOME_TRUE_1(trie->put("01"_hex2buf, "c"_buf));
+  root = trie->getRoot();
+  ASSERT_TRUE(root->isBranch());
+  ASSERT_EQ(root->getTrieType(), T::BranchWithValue);
+
+  EXPECT_OUTCOME_TRUE(leaf, trie->getNode(root, KeyNibbles{0, 1, 0, 2}));
+  ASSERT_FALSE(leaf->isBranch());
+  ASSERT_EQ(leaf->getTrieType(), T::Leaf);
+}
+
+/**
+ * Measures the time of a lookup in a trie with 100k entries; run with
+ * --gtest_also_run_disabled_tests
+ */
+TEST_F(TrieTest, DISABLED_LookupBenchmark) {
+  constexpr size_t kEntries = 100000;
+  constexpr size_t kRounds = 10;
+  std::mt19937 rand{42};
+  std::vector<Buffer> keys;
+  keys.reserve(kEntries);
+  for (size_t i = 0; i < kEntries; ++i) {
+    Buffer key(32, 0);
+    for (auto &byte : key) {
+      byte = rand();
+    }
+    EXPECT_OUTCOME_TRUE_1(trie->put(key, key));
+    keys.push_back(std::move(key));
+  }
+
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < kRounds; ++round) {
+    for (auto &key : keys) {
+      found += trie->contains(key);
+    }
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_EQ(found, kEntries * kRounds);
+
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+  std::cout << "lookup: " << ns.count() / (kEntries * kRounds) << " ns"
+            << std::endl;
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/flat_state.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::FlatState;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::RootHash;
+using kagome::storage::trie::TrieError;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class FlatStateTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    open();
+  }
+
+  /**
+   * Opens the flat state over the database and a trie storage with it, as
+   * it is done on start
+   */
+  void open() {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory,
+        codec,
+        std::make_shared<TrieStorageBackendImpl>(db, Buffer{1}));
+    empty_root = serializer->getEmptyRootHash();
+    flat_state =
+        FlatState::create(db, Buffer{2}, Buffer{3}, empty_root).value();
+    storage = TrieStorageImpl::createEmpty(
+                  factory, codec, serializer, boost::none, flat_state)
+                  .value();
+  }
+
+  /**
+   * Commits \arg changes on top of the state \arg root
+   * @returns the new state root
+   */
+  RootHash commit(const RootHash &root,
+                  const std::vector<std::pair<Buffer, Buffer>> &changes) {
+    auto batch = storage->getPersistentBatchAt(root).value();
+    for (auto &[key, value] : changes) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(key, value));
+    }
+    return batch->commit().value();
+  }
+
+  std::shared_ptr<InMemoryStorage> db = std::make_shared<InMemoryStorage>();
+  RootHash empty_root;
+  std::shared_ptr<FlatState> flat_state;
+  std::unique_ptr<TrieStorageImpl> storage;
+};
+
+/**
+ * @given a committed state
+ * @when it is finalized
+ * @then its values are served by the flat state @and by batches at it
+ */
+TEST_F(FlatStateTest, FinalizedStateIsReadable) {
+  auto root = commit(empty_root, {{"01"_buf, "a"_buf}, {"02"_buf, "b"_buf}});
+  EXPECT_OUTCOME_FALSE(outdated, flat_state->get(root, "01"_buf));
+  ASSERT_EQ(outdated, FlatState::Error::OUTDATED);
+
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(root));
+  ASSERT_EQ(flat_state->root(), root);
+  EXPECT_OUTCOME_TRUE(v, flat_state->get(root, "01"_buf));
+  ASSERT_EQ(v, "a"_buf);
+  EXPECT_OUTCOME_FALSE(no_value, flat_state->get(root, "03"_buf));
+  ASSERT_EQ(no_value, TrieError::NO_VALUE);
+
+  auto batch = storage->getEphemeralBatchAt(root).value();
+  EXPECT_OUTCOME_TRUE(v2, batch->get("02"_buf));
+  ASSERT_EQ(v2, "b"_buf);
+  ASSERT_FALSE(batch->contains("03"_buf));
+}
+
+/**
+ * @given a chain of two states @and a fork of the first one
+ * @when the last state of the chain is finalized
+ * @then the flat state contains the merged changes of the chain only
+ */
+TEST_F(FlatStateTest, AppliesChainAndDropsForks) {
+  auto root1 = commit(empty_root, {{"01"_buf, "a"_buf}});
+  auto root2 = commit(root1, {{"01"_buf, "b"_buf}, {"02"_buf, "c"_buf}});
+  auto fork = commit(root1, {{"03"_buf, "d"_buf}});
+
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(root2));
+  EXPECT_OUTCOME_TRUE(v1, flat_state->get(root2, "01"_buf));
+  ASSERT_EQ(v1, "b"_buf);
+  EXPECT_OUTCOME_TRUE(v2, flat_state->get(root2, "02"_buf));
+  ASSERT_EQ(v2, "c"_buf);
+  EXPECT_OUTCOME_FALSE(no_value, flat_state->get(root2, "03"_buf));
+  ASSERT_EQ(no_value, TrieError::NO_VALUE);
+
+  // the fork is no longer reachable, so the flat state stays where it is
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(fork));
+  ASSERT_EQ(flat_state->root(), root2);
+}
+
+/**
+ * @given a finalized state @and a batch at it
+ * @when entries are changed in the batch
+ * @then the batch reads the changed entries from the trie
+ */
+TEST_F(FlatStateTest, BatchSeesItsOwnChanges) {
+  auto root = commit(
+      empty_root,
+      {{"0101"_buf, "a"_buf}, {"0102"_buf, "b"_buf}, {"02"_buf, "c"_buf}});
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(root));
+
+  auto batch = storage->getPersistentBatchAt(root).value();
+  EXPECT_OUTCOME_TRUE_1(batch->put("02"_buf, "d"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->clearPrefix("01"_buf));
+  EXPECT_OUTCOME_TRUE(v, batch->get("02"_buf));
+  ASSERT_EQ(v, "d"_buf);
+  ASSERT_FALSE(batch->contains("0101"_buf));
+  ASSERT_FALSE(batch->contains("0102"_buf));
+
+  EXPECT_OUTCOME_TRUE(new_root, batch->commit());
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(new_root));
+  EXPECT_OUTCOME_FALSE(no_value, flat_state->get(new_root, "0101"_buf));
+  ASSERT_EQ(no_value, TrieError::NO_VALUE);
+  EXPECT_OUTCOME_TRUE(v2, flat_state->get(new_root, "02"_buf));
+  ASSERT_EQ(v2, "d"_buf);
+}
+
+/**
+ * @given a flat state at some finalized state
+ * @when it is reopened over the same database
+ * @then it is at the same state
+ */
+TEST_F(FlatStateTest, RootIsPersisted) {
+  auto root = commit(empty_root, {{"01"_buf, "a"_buf}});
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(root));
+
+  auto reopened =
+      FlatState::create(db, Buffer{2}, Buffer{3}, empty_root).value();
+  ASSERT_EQ(reopened->root(), root);
+}
+
+/**
+ * @given a flat state moved past the genesis state
+ * @when the genesis state is committed again after a restart
+ * @then its changes are not journaled
+ */
+TEST_F(FlatStateTest, GenesisIsNotJournaledAgain) {
+  std::vector<std::pair<Buffer, Buffer>> genesis{{"01"_buf, "a"_buf}};
+  auto genesis_root = commit(empty_root, genesis);
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(genesis_root));
+  auto root = commit(genesis_root, {{"02"_buf, "b"_buf}});
+  EXPECT_OUTCOME_TRUE_1(flat_state->finalize(root));
+
+  open();
+  ASSERT_EQ(commit(empty_root, genesis), genesis_root);
+  ASSERT_FALSE(db->contains(Buffer{3}.put(genesis_root)));
+  ASSERT_EQ(flat_state->root(), root);
+}
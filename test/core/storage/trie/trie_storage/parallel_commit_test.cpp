@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_commit_workers.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::RootHash;
+using kagome::storage::trie::TrieCommitWorkers;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class ParallelCommitTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  /**
+   * @returns a trie storage over \arg db which stores tries on \arg workers
+   */
+  std::unique_ptr<TrieStorageImpl> makeStorage(
+      std::shared_ptr<InMemoryStorage> db,
+      std::shared_ptr<TrieCommitWorkers> workers) {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory,
+        codec,
+        std::make_shared<TrieStorageBackendImpl>(db, Buffer{1}),
+        nullptr,
+        nullptr,
+        std::move(workers));
+    return TrieStorageImpl::createEmpty(
+               factory, codec, serializer, boost::none)
+        .value();
+  }
+
+  /**
+   * @returns \arg n random entries, whose keys start with \arg prefix
+   */
+  static std::vector<std::pair<Buffer, Buffer>> makeEntries(
+      size_t n, const Buffer &prefix = {}) {
+    std::mt19937 rand{42};
+    std::vector<std::pair<Buffer, Buffer>> entries;
+    entries.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      Buffer key{prefix};
+      for (size_t j = 0; j < 32; ++j) {
+        key.putUint8(rand() % 256);
+      }
+      entries.emplace_back(std::move(key), Buffer{}.putUint64(rand()));
+    }
+    return entries;
+  }
+
+  /**
+   * Commits \arg entries to \arg storage
+   * @returns the new state root
+   */
+  static RootHash commit(
+      TrieStorageImpl &storage,
+      const std::vector<std::pair<Buffer, Buffer>> &entries) {
+    auto batch = storage.getPersistentBatch().value();
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(key, value));
+    }
+    return batch->commit().value();
+  }
+
+  /**
+   * Checks that a serial and a parallel commit of \arg entries give the same
+   * state, which is readable from the database written in parallel
+   */
+  void checkSameState(const std::vector<std::pair<Buffer, Buffer>> &entries) {
+    auto serial_db = std::make_shared<InMemoryStorage>();
+    auto serial_root = commit(*makeStorage(serial_db, nullptr), entries);
+
+    auto parallel_db = std::make_shared<InMemoryStorage>();
+    auto parallel_root = commit(
+        *makeStorage(parallel_db, std::make_shared<TrieCommitWorkers>(3, 1)),
+        entries);
+    ASSERT_EQ(serial_root, parallel_root);
+
+    auto batch = makeStorage(parallel_db, nullptr)
+                     ->getEphemeralBatchAt(parallel_root)
+                     .value();
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE(v, batch->get(key));
+      ASSERT_EQ(v, value);
+    }
+  }
+};
+
+/**
+ * @given a set of entries with random keys
+ * @when it is committed serially and in parallel
+ * @then both commits give the same state
+ */
+TEST_F(ParallelCommitTest, SameStateAsSerial) {
+  checkSameState(makeEntries(2000));
+}
+
+/**
+ * @given a set of entries whose keys have a common prefix, so that the root
+ * has a single child
+ * @when it is committed serially and in parallel
+ * @then both commits give the same state
+ */
+TEST_F(ParallelCommitTest, SameStateWithCommonPrefix) {
+  checkSameState(makeEntries(2000, Buffer{0x12, 0x34}));
+}
+
+/**
+ * Compares the time of serial and parallel commits of a trie with 100k
+ * entries; run with --gtest_also_run_disabled_tests
+ */
+TEST_F(ParallelCommitTest, DISABLED_Benchmark) {
+  auto entries = makeEntries(100000);
+  auto measure = [&](std::shared_ptr<TrieCommitWorkers> workers) {
+    auto storage =
+        makeStorage(std::make_shared<InMemoryStorage>(), std::move(workers));
+    auto batch = storage->getPersistentBatch().value();
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(key, value));
+    }
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_OUTCOME_TRUE_1(batch->commit());
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+  auto threads = std::max(std::thread::hardware_concurrency(), 2u);
+  auto serial = measure(nullptr);
+  auto parallel = measure(std::make_shared<TrieCommitWorkers>(threads - 1, 1));
+  std::cout << "serial commit: " << serial << " ms, parallel commit on "
+            << threads << " threads: " << parallel << " ms" << std::endl;
+}
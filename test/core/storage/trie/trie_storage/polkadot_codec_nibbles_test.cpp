@@ -32,7 +32,7 @@ TEST_P(KeyToNibbles, keyToNibbles) {
   auto codec = std::make_unique<PolkadotCodec>();
   auto [nibbles, key] = GetParam();
   auto actualNibbles = codec->keyToNibbles(key);
-  ASSERT_EQ(nibbles, actualNibbles);
+  ASSERT_EQ(KeyNibbles{nibbles}, actualNibbles);
 }
 
 const std::vector<std::pair<Buffer, Buffer>> KEY_TO_NIBBLES = {
@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/storage/trie/trie_batches_mock.hpp"
+#include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::DatabaseError;
+using kagome::storage::trie::PersistentTrieBatchMock;
+using kagome::storage::trie::TopperTrieBatchImpl;
+using kagome::storage::trie::TrieError;
+using testing::_;
+using testing::Return;
+
+class TopperTrieBatchTest : public testing::Test {
+ public:
+  std::shared_ptr<PersistentTrieBatchMock> parent_ =
+      std::make_shared<PersistentTrieBatchMock>();
+  TopperTrieBatchImpl topper_{parent_};
+};
+
+/**
+ * @given a topper batch over a batch with no value under a key
+ * @when an item is appended to the key
+ * @then the value is a new vector of the item
+ */
+TEST_F(TopperTrieBatchTest, AppendToMissingValue) {
+  EXPECT_CALL(*parent_, get("key"_buf)).WillOnce(Return(TrieError::NO_VALUE));
+
+  auto item = Buffer{kagome::scale::encode(uint32_t{1}).value()};
+  EXPECT_OUTCOME_TRUE_1(topper_.append("key"_buf, item));
+
+  EXPECT_OUTCOME_TRUE(value, topper_.get("key"_buf));
+  ASSERT_EQ(value,
+            Buffer{kagome::scale::encode(std::vector<uint32_t>{1}).value()});
+}
+
+/**
+ * @given a topper batch over a batch failing to read a key
+ * @when an item is appended to the key
+ * @then the error is returned @and the key is not changed, so nothing is
+ * written back
+ */
+TEST_F(TopperTrieBatchTest, AppendPassesOnParentError) {
+  EXPECT_CALL(*parent_, get("key"_buf))
+      .WillRepeatedly(Return(DatabaseError::IO_ERROR));
+
+  auto item = Buffer{kagome::scale::encode(uint32_t{1}).value()};
+  EXPECT_OUTCOME_FALSE(err, topper_.append("key"_buf, item));
+  ASSERT_EQ(err, DatabaseError::IO_ERROR);
+
+  EXPECT_OUTCOME_FALSE(get_err, topper_.get("key"_buf));
+  ASSERT_EQ(get_err, DatabaseError::IO_ERROR);
+  EXPECT_CALL(*parent_, put(_, _)).Times(0);
+  EXPECT_CALL(*parent_, put_rvalueHack(_, _)).Times(0);
+  EXPECT_OUTCOME_TRUE_1(topper_.writeBack());
+}
@@ -6,6 +6,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "mock/core/storage/changes_trie/changes_tracker_mock.hpp"
+#include "scale/encode_append.hpp"
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 #include "storage/in_memory/in_memory_storage.hpp"
 #include "storage/trie/impl/persistent_trie_batch_impl.hpp"
@@ -209,6 +211,37 @@ TEST_F(TrieBatchTest, ConsistentOnFailure) {
   ASSERT_EQ(trie->getRootHash(), old_root);
 }
 
+/**
+ * @given a persistent batch
+ * @when calculating its root between the changes
+ * @then nothing is written to the storage, and the calculated root is the one
+ * the batch gets on commit
+ */
+TEST_F(TrieBatchTest, CalculateRootWithoutCommit) {
+  auto batch = trie->getPersistentBatch().value();
+  auto empty_root = trie->getRootHash();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE(root, batch->calculateRoot());
+  // the second calculation takes the merkle values cached by the first one
+  EXPECT_OUTCOME_TRUE(same_root, batch->calculateRoot());
+  ASSERT_EQ(root, same_root);
+  ASSERT_EQ(trie->getRootHash(), empty_root);
+  ASSERT_FALSE(trie->getEphemeralBatchAt(root));
+  EXPECT_OUTCOME_TRUE(committed_root, batch->commit());
+  ASSERT_EQ(root, committed_root);
+
+  // the changed nodes are retrieved from the storage now
+  batch = trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(batch->put("123457"_hex2buf, "43"_hex2buf));
+  EXPECT_OUTCOME_TRUE(put_root, batch->calculateRoot());
+  EXPECT_OUTCOME_TRUE_1(batch->remove(data[2].first));
+  EXPECT_OUTCOME_TRUE_1(batch->clearPrefix("0a"_hex2buf));
+  EXPECT_OUTCOME_TRUE(changed_root, batch->calculateRoot());
+  ASSERT_NE(changed_root, put_root);
+  EXPECT_OUTCOME_TRUE(committed_changed_root, batch->commit());
+  ASSERT_EQ(changed_root, committed_changed_root);
+}
+
 TEST_F(TrieBatchTest, TopperBatchAtomic) {
   std::shared_ptr<PersistentTrieBatch> p_batch =
       trie->getPersistentBatch().value();
@@ -236,4 +269,181 @@ TEST_F(TrieBatchTest, TopperBatchAtomic) {
   ASSERT_FALSE(p_batch->contains("123"_buf));
 }
 
+/**
+ * @given a persistent batch and a topper batch with changes on top of it
+ * @when several keys are read from the topper batch at once
+ * @then the changed keys are read from the topper batch, the rest from the
+ * persistent one
+ */
+TEST_F(TrieBatchTest, TopperBatchGetMany) {
+  std::shared_ptr<PersistentTrieBatch> p_batch =
+      trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*p_batch);
+
+  auto t_batch = p_batch->batchOnTop();
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("1234"_hex2buf, "abcd"_hex2buf));
+  EXPECT_OUTCOME_TRUE_1(t_batch->remove("010203"_hex2buf));
+
+  auto values = t_batch->getMany(
+      {"010203"_hex2buf, "1234"_hex2buf, "0a0b0c"_hex2buf, "0a"_hex2buf});
+  ASSERT_EQ(values.size(), 4);
+  ASSERT_EQ(values[0].error(), TrieError::NO_VALUE);
+  EXPECT_OUTCOME_TRUE(changed, values[1]);
+  ASSERT_EQ(changed, "abcd"_hex2buf);
+  EXPECT_OUTCOME_TRUE(unchanged, values[2]);
+  ASSERT_EQ(unchanged, "deadbeef"_hex2buf);
+  ASSERT_EQ(values[3].error(), TrieError::NO_VALUE);
+}
+
+/**
+ * @given a persistent batch with an encoded vector and a topper batch on top
+ * of it
+ * @when items are appended to the vector in the topper batch, in nested
+ * transactions as well
+ * @then the vector read from the topper batch and written back to the
+ * persistent one has the items of the committed transactions only
+ */
+TEST_F(TrieBatchTest, TopperBatchAppend) {
+  std::shared_ptr<PersistentTrieBatch> p_batch =
+      trie->getPersistentBatch().value();
+  auto item = kagome::scale::encode(uint32_t{42}).value();
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i < 60; ++i) {
+    ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  }
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("vec"_buf, Buffer{expected}));
+
+  auto t_batch = p_batch->batchOnTop();
+  // the length of the vector outgrows a single byte of compact encoding
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_OUTCOME_TRUE_1(t_batch->append("vec"_buf, Buffer{item}));
+    ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  }
+  EXPECT_OUTCOME_TRUE(appended, t_batch->get("vec"_buf));
+  ASSERT_EQ(appended, Buffer{expected});
+
+  t_batch->startTransaction();
+  EXPECT_OUTCOME_TRUE_1(t_batch->append("vec"_buf, Buffer{item}));
+  EXPECT_OUTCOME_TRUE_1(t_batch->append("new"_buf, Buffer{item}));
+  t_batch->rollbackTransaction();
+  ASSERT_FALSE(t_batch->contains("new"_buf));
+
+  t_batch->startTransaction();
+  EXPECT_OUTCOME_TRUE_1(t_batch->append("vec"_buf, Buffer{item}));
+  ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  t_batch->commitTransaction();
+
+  EXPECT_OUTCOME_TRUE_1(t_batch->writeBack());
+  EXPECT_OUTCOME_TRUE(written, p_batch->get("vec"_buf));
+  ASSERT_EQ(written, Buffer{expected});
+}
+
+/**
+ * @given a persistent batch with a SCALE encoded vector
+ * @when items are appended to the vector in the batch
+ * @then the vector is read with the items from the batch before and after
+ * commit
+ */
+TEST_F(TrieBatchTest, PersistentBatchAppend) {
+  auto batch = trie->getPersistentBatch().value();
+  auto item = kagome::scale::encode(uint32_t{42}).value();
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i < 62; ++i) {
+    ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  }
+  EXPECT_OUTCOME_TRUE_1(batch->put("vec"_buf, Buffer{expected}));
+
+  // the length of the vector outgrows a single byte of compact encoding
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_OUTCOME_TRUE_1(batch->append("vec"_buf, Buffer{item}));
+    ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  }
+  EXPECT_OUTCOME_TRUE_1(batch->append("new"_buf, Buffer{item}));
+  ASSERT_TRUE(batch->contains("new"_buf));
+  EXPECT_OUTCOME_TRUE(appended, batch->get("vec"_buf));
+  ASSERT_EQ(appended, Buffer{expected});
+
+  // the items appended after a read are kept as well
+  EXPECT_OUTCOME_TRUE_1(batch->append("vec"_buf, Buffer{item}));
+  ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  auto values = batch->getMany({"vec"_buf, "new"_buf});
+  ASSERT_EQ(values[0].value(), Buffer{expected});
+  ASSERT_EQ(values[1].value(), Buffer{kagome::scale::encode(
+                                   std::vector<uint32_t>{42}).value()});
+
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  auto committed = trie->getEphemeralBatch().value();
+  EXPECT_OUTCOME_TRUE(written, committed->get("vec"_buf));
+  ASSERT_EQ(written, Buffer{expected});
+}
+
+/**
+ * @given a persistent batch reporting its changes to a changes tracker
+ * @when items are appended to a vector and the extrinsic index is changed
+ * @then every append is reported before the change of the index
+ */
+TEST_F(TrieBatchTest, PersistentBatchAppendIsTracked) {
+  auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+  auto codec = std::make_shared<PolkadotCodec>();
+  auto serializer = std::make_shared<TrieSerializerImpl>(
+      factory,
+      codec,
+      std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<kagome::storage::InMemoryStorage>(), kNodePrefix));
+  auto changes =
+      std::make_shared<kagome::storage::changes_trie::ChangesTrackerMock>();
+  EXPECT_CALL(*changes, setExtrinsicIdxGetter(_));
+  std::shared_ptr<PersistentTrieBatch> batch =
+      PersistentTrieBatchImpl::create(
+          codec,
+          serializer,
+          boost::make_optional<
+              std::shared_ptr<kagome::storage::changes_trie::ChangesTracker>>(
+              changes),
+          factory->createEmpty(),
+          [](const auto &) {});
+
+  auto item = kagome::scale::encode(uint32_t{42}).value();
+  std::vector<uint8_t> expected;
+  ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+  ASSERT_TRUE(kagome::scale::append_or_new_vec(expected, item).has_value());
+
+  testing::InSequence s;
+  EXPECT_CALL(*changes, onPut("vec"_buf, Buffer{expected}, true))
+      .Times(2)
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*changes, onPut(":extrinsic_index"_buf, _, true))
+      .WillOnce(Return(outcome::success()));
+
+  EXPECT_OUTCOME_TRUE_1(batch->append("vec"_buf, Buffer{item}));
+  EXPECT_OUTCOME_TRUE_1(batch->append("vec"_buf, Buffer{item}));
+  Buffer extrinsic_index{kagome::scale::encode(uint32_t{1}).value()};
+  EXPECT_OUTCOME_TRUE_1(batch->put(":extrinsic_index"_buf, extrinsic_index));
+}
+
+/**
+ * @given an ephemeral batch
+ * @when items are appended to a missing value and to a SCALE encoded vector
+ * @then a new vector is stored for the missing value @and the vector is
+ * extended, the length prefix outgrowing a single byte as well
+ */
+TEST_F(TrieBatchTest, EphemeralBatchAppend) {
+  auto batch = trie->getEphemeralBatch().value();
+  auto item = kagome::scale::encode(uint32_t{42}).value();
+
+  EXPECT_OUTCOME_TRUE_1(batch->append("new"_buf, Buffer{item}));
+  EXPECT_OUTCOME_TRUE(created, batch->get("new"_buf));
+  ASSERT_EQ(created,
+            Buffer{kagome::scale::encode(std::vector<uint32_t>{42}).value()});
+
+  std::vector<uint32_t> expected(
+      kagome::scale::compact::EncodingCategoryLimits::kMinUint16 - 1, 42);
+  EXPECT_OUTCOME_TRUE_1(
+      batch->put("vec"_buf, Buffer{kagome::scale::encode(expected).value()}));
+  EXPECT_OUTCOME_TRUE_1(batch->append("vec"_buf, Buffer{item}));
+  expected.push_back(42);
+  EXPECT_OUTCOME_TRUE(appended, batch->get("vec"_buf));
+  ASSERT_EQ(appended, Buffer{kagome::scale::encode(expected).value()});
+}
+
 /// TODO(Harrm): #595 test clearPrefix
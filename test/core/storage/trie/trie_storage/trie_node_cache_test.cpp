@@ -0,0 +1,131 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::DummyNode;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::LeafNode;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+/**
+ * @given an empty node cache
+ * @when a node is looked up @and then put to the cache and looked up again
+ * @then the first lookup misses @and the second one returns an equal copy of
+ * the node
+ */
+TEST(TrieNodeCacheTest, PutGet) {
+  TrieNodeCache cache{4};
+  LeafNode leaf{KeyNibbles{1, 2, 3}, "abc"_buf};
+
+  ASSERT_EQ(cache.get("key"_buf), nullptr);
+  cache.put("key"_buf, leaf);
+
+  auto node = cache.get("key"_buf);
+  ASSERT_NE(node, nullptr);
+  ASSERT_EQ(node->key_nibbles, leaf.key_nibbles);
+  ASSERT_EQ(node->value.get(), leaf.value.get());
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+/**
+ * @given a cache containing a branch node
+ * @when the returned copy of the node is modified
+ * @then the cached node stays the same
+ */
+TEST(TrieNodeCacheTest, ReturnsCopies) {
+  TrieNodeCache cache{4};
+  BranchNode branch{KeyNibbles{1}, "abc"_buf};
+  branch.children.at(3) = std::make_shared<DummyNode>("child"_buf);
+  cache.put("key"_buf, branch);
+
+  auto node = cache.get("key"_buf);
+  ASSERT_TRUE(node->isBranch());
+  auto &copy = static_cast<BranchNode &>(*node);
+  copy.value = "def"_buf;
+  copy.children.at(3) = nullptr;
+
+  auto again = cache.get("key"_buf);
+  ASSERT_EQ(again->value.get(), "abc"_buf);
+  ASSERT_NE(static_cast<BranchNode &>(*again).children.at(3), nullptr);
+}
+
+/**
+ * @given a full cache
+ * @when one more node is put
+ * @then the least recently used node is evicted
+ */
+TEST(TrieNodeCacheTest, EvictsLeastRecentlyUsed) {
+  TrieNodeCache cache{2};
+  LeafNode leaf{KeyNibbles{1}, "abc"_buf};
+  cache.put("a"_buf, leaf);
+  cache.put("b"_buf, leaf);
+  // touch 'a', so that 'b' becomes the least recently used
+  ASSERT_NE(cache.get("a"_buf), nullptr);
+  cache.put("c"_buf, leaf);
+
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_NE(cache.get("a"_buf), nullptr);
+  ASSERT_EQ(cache.get("b"_buf), nullptr);
+  ASSERT_NE(cache.get("c"_buf), nullptr);
+}
+
+/**
+ * @given a trie storage which serializer uses a node cache
+ * @when values are committed @and read through a new batch
+ * @then the nodes are taken from the cache rather than the backend
+ */
+TEST(TrieNodeCacheTest, SerializerUsesCache) {
+  testutil::prepareLoggers();
+
+  auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+  auto codec = std::make_shared<PolkadotCodec>();
+  auto cache = std::make_shared<TrieNodeCache>(1024);
+  auto serializer = std::make_shared<TrieSerializerImpl>(
+      factory,
+      codec,
+      std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), Buffer{1}),
+      cache);
+  auto storage =
+      TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+          .value();
+
+  auto batch = storage->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(batch->put("123"_buf, "abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->put("345"_buf, "def"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  ASSERT_GT(cache->size(), 0);
+  auto misses = cache->misses();
+
+  auto read_batch = storage->getEphemeralBatch().value();
+  EXPECT_OUTCOME_TRUE(v1, read_batch->get("123"_buf));
+  ASSERT_EQ(v1, "abc"_buf);
+  EXPECT_OUTCOME_TRUE(v2, read_batch->get("345"_buf));
+  ASSERT_EQ(v2, "def"_buf);
+  ASSERT_EQ(cache->misses(), misses);
+  ASSERT_GT(cache->hits(), 0);
+}
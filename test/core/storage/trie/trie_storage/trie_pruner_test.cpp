@@ -0,0 +1,172 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::RootHash;
+using kagome::storage::trie::TriePruner;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class TriePrunerTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  /**
+   * Creates a trie storage whose states are pruned keeping \arg
+   * states_to_keep finalized ones
+   */
+  void init(uint32_t states_to_keep) {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    pruner = TriePruner::create(
+                 db, backend, codec, Buffer{2}, Buffer{3}, states_to_keep)
+                 .value();
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory, codec, backend, nullptr, pruner);
+    empty_root = serializer->getEmptyRootHash();
+    storage =
+        TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+            .value();
+  }
+
+  /**
+   * Commits \arg changes on top of the state \arg root
+   * @returns the new state root
+   */
+  RootHash commit(const RootHash &root,
+                  const std::vector<std::pair<Buffer, Buffer>> &changes) {
+    auto batch = storage->getPersistentBatchAt(root).value();
+    for (auto &[key, value] : changes) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(key, value));
+    }
+    return batch->commit().value();
+  }
+
+  /**
+   * Commits \arg changes on top of the state \arg root as a block state
+   * @returns the new state root
+   */
+  RootHash addBlock(const RootHash &root,
+                    const std::vector<std::pair<Buffer, Buffer>> &changes) {
+    auto new_root = commit(root, changes);
+    EXPECT_OUTCOME_TRUE_1(pruner->addState(new_root));
+    return new_root;
+  }
+
+  bool isStored(const RootHash &root) {
+    return backend->contains(Buffer{root});
+  }
+
+  std::shared_ptr<InMemoryStorage> db = std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TrieStorageBackendImpl> backend =
+      std::make_shared<TrieStorageBackendImpl>(db, Buffer{1});
+  RootHash empty_root;
+  std::shared_ptr<TriePruner> pruner;
+  std::unique_ptr<TrieStorageImpl> storage;
+};
+
+/**
+ * @given a chain of two block states @and a fork of the first one
+ * @when the chain is finalized
+ * @then the state of the fork is removed @and the chain states are intact
+ */
+TEST_F(TriePrunerTest, RemovesDiscardedFork) {
+  init(2);
+  auto root1 =
+      addBlock(empty_root, {{"0101"_buf, "a"_buf}, {"0102"_buf, "b"_buf}});
+  auto fork = addBlock(root1, {{"0103"_buf, "c"_buf}});
+  auto root2 = addBlock(root1, {{"0201"_buf, "d"_buf}});
+
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({root1, root2}, {fork}));
+
+  ASSERT_FALSE(isStored(fork));
+  ASSERT_TRUE(isStored(root1));
+  auto batch = storage->getEphemeralBatchAt(root2).value();
+  EXPECT_OUTCOME_TRUE(v1, batch->get("0101"_buf));
+  ASSERT_EQ(v1, "a"_buf);
+  EXPECT_OUTCOME_TRUE(v2, batch->get("0201"_buf));
+  ASSERT_EQ(v2, "d"_buf);
+}
+
+/**
+ * @given a chain of two finalized block states @and one state to keep
+ * @when the second one is finalized
+ * @then the first one is removed @and the nodes it shares with the second one
+ * are kept
+ */
+TEST_F(TriePrunerTest, KeepsConfiguredNumberOfStates) {
+  init(1);
+  auto root1 =
+      addBlock(empty_root, {{"0101"_buf, "a"_buf}, {"0102"_buf, "b"_buf}});
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({root1}, {}));
+  ASSERT_TRUE(isStored(root1));
+
+  auto root2 = addBlock(root1, {{"0201"_buf, "c"_buf}});
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({root2}, {}));
+  ASSERT_FALSE(isStored(root1));
+
+  auto batch = storage->getEphemeralBatchAt(root2).value();
+  EXPECT_OUTCOME_TRUE(v1, batch->get("0101"_buf));
+  ASSERT_EQ(v1, "a"_buf);
+  EXPECT_OUTCOME_TRUE(v2, batch->get("0102"_buf));
+  ASSERT_EQ(v2, "b"_buf);
+  EXPECT_OUTCOME_TRUE(v3, batch->get("0201"_buf));
+  ASSERT_EQ(v3, "c"_buf);
+}
+
+/**
+ * @given a state which no block refers to
+ * @when two finalizations happen
+ * @then the state is kept after the first one @and removed after the second
+ */
+TEST_F(TriePrunerTest, RemovesIntermediateStates) {
+  init(2);
+  auto root1 = addBlock(empty_root, {{"01"_buf, "a"_buf}});
+  auto intermediate = commit(root1, {{"02"_buf, "b"_buf}});
+
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({root1}, {}));
+  ASSERT_TRUE(isStored(intermediate));
+
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({}, {}));
+  ASSERT_FALSE(isStored(intermediate));
+  ASSERT_TRUE(isStored(root1));
+}
+
+/**
+ * @given a pruner with some finalized states
+ * @when it is reopened over the same database
+ * @then it keeps releasing the finalized states in the same order
+ */
+TEST_F(TriePrunerTest, FinalizedStatesArePersisted) {
+  init(1);
+  auto root1 = addBlock(empty_root, {{"01"_buf, "a"_buf}});
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({root1}, {}));
+
+  init(1);
+  auto root2 = addBlock(root1, {{"02"_buf, "b"_buf}});
+  EXPECT_OUTCOME_TRUE_1(pruner->onFinalized({root2}, {}));
+  ASSERT_FALSE(isStored(root1));
+  ASSERT_TRUE(isStored(root2));
+}
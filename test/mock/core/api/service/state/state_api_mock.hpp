@@ -33,6 +33,11 @@ namespace kagome::api {
         getStorage,
         outcome::result<common::Buffer>(const common::Buffer &key,
                                         const primitives::BlockHash &at));
+    MOCK_CONST_METHOD2(
+        queryStorageAt,
+        outcome::result<std::vector<primitives::StorageChangeSet>>(
+            const std::vector<common::Buffer> &keys,
+            const boost::optional<primitives::BlockHash> &at));
 
     MOCK_METHOD1(
         subscribeStorage,
@@ -27,6 +27,9 @@ namespace kagome::application {
     MOCK_CONST_METHOD1(keystorePath,
                        boost::filesystem::path(std::string chain_id));
 
+    MOCK_CONST_METHOD1(runtimeCacheDirPath,
+                       boost::filesystem::path(std::string chain_id));
+
     MOCK_CONST_METHOD0(nodeKey,
                        const boost::optional<crypto::Ed25519PrivateKey> &());
 
@@ -58,6 +61,22 @@ namespace kagome::application {
 
     MOCK_CONST_METHOD0(peeringConfig, const network::PeeringConfig &());
 
+    MOCK_CONST_METHOD0(trieNodeCacheSize, uint32_t());
+
+    MOCK_CONST_METHOD0(isFlatStateEnabled, bool());
+
+    MOCK_CONST_METHOD0(statePruningDepth, boost::optional<uint32_t>());
+
+    MOCK_CONST_METHOD0(parallelTrieCommitThreshold, uint32_t());
+
+    MOCK_CONST_METHOD0(levelDbConfig, const storage::LevelDBConfig &());
+
+    MOCK_CONST_METHOD0(runtimeInstancePoolSize, boost::optional<uint32_t>());
+
+    MOCK_CONST_METHOD0(runtimeCallCacheSize, uint32_t());
+
+    MOCK_CONST_METHOD0(runtimeExecMethod, RuntimeExecutionMethod());
+
     MOCK_CONST_METHOD0(isRunInDevMode, bool());
 
     MOCK_CONST_METHOD0(nodeName, const std::string &());
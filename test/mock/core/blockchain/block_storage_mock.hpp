@@ -51,6 +51,10 @@ namespace kagome::blockchain {
         putBlock,
         outcome::result<primitives::BlockHash>(const primitives::Block &));
 
+    MOCK_METHOD2(putBlock,
+                 outcome::result<void>(const primitives::HashedBlockHeader &,
+                                       const primitives::BlockBody &));
+
     MOCK_METHOD3(putJustification,
                  outcome::result<void>(const primitives::Justification &,
                                        const primitives::BlockHash &,
@@ -59,6 +63,19 @@ namespace kagome::blockchain {
     MOCK_METHOD2(removeBlock,
                  outcome::result<void>(const primitives::BlockHash &,
                                        const primitives::BlockNumber &));
+
+    MOCK_CONST_METHOD1(getCanonicalHash,
+                       outcome::result<boost::optional<primitives::BlockHash>>(
+                           primitives::BlockNumber));
+
+    MOCK_CONST_METHOD2(getCanonicalHashes,
+                       outcome::result<std::vector<primitives::BlockHash>>(
+                           primitives::BlockNumber, primitives::BlockNumber));
+
+    MOCK_METHOD2(
+        updateCanonicalHashes,
+        outcome::result<void>(const std::vector<primitives::BlockNumber> &,
+                              const std::vector<primitives::BlockInfo> &));
   };
 
 }  // namespace kagome::blockchain
@@ -41,6 +41,10 @@ namespace kagome::blockchain {
 
     MOCK_METHOD1(addBlock, outcome::result<void>(const primitives::Block &));
 
+    MOCK_METHOD2(addBlock,
+                 outcome::result<void>(const primitives::HashedBlockHeader &,
+                                       const primitives::BlockBody &));
+
     MOCK_METHOD2(finalize,
                  outcome::result<void>(const primitives::BlockHash &,
                                        const primitives::Justification &));
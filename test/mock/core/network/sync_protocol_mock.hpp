@@ -0,0 +1,52 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_NETWORK_SYNCPROTOCOLMOCK
+#define KAGOME_NETWORK_SYNCPROTOCOLMOCK
+
+#include "network/protocols/sync_protocol.hpp"
+
+#include <gmock/gmock.h>
+
+namespace kagome::network {
+
+  class SyncProtocolMock final : public SyncProtocol {
+   public:
+    MOCK_CONST_METHOD0(protocol, const Protocol &());
+
+    MOCK_METHOD0(start, bool());
+
+    MOCK_METHOD0(stop, bool());
+
+    MOCK_METHOD1(onIncomingStream, void(std::shared_ptr<Stream>));
+
+    void newOutgoingStream(
+        const PeerInfo &peer_info,
+        std::function<void(outcome::result<std::shared_ptr<Stream>>)> &&cb)
+        override {
+      newOutgoingStreamProxy(peer_info, cb);
+    }
+    MOCK_METHOD2(
+        newOutgoingStreamProxy,
+        void(const PeerInfo &,
+             const std::function<void(
+                 outcome::result<std::shared_ptr<Stream>>)> &));
+
+    void request(const PeerId &peer_id,
+                 BlocksRequest block_request,
+                 std::function<void(outcome::result<BlocksResponse>)>
+                     &&response_handler) override {
+      requestProxy(peer_id, block_request, response_handler);
+    }
+    MOCK_METHOD3(
+        requestProxy,
+        void(const PeerId &,
+             const BlocksRequest &,
+             const std::function<void(outcome::result<BlocksResponse>)> &));
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_NETWORK_SYNCPROTOCOLMOCK
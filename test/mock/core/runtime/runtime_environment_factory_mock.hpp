@@ -31,6 +31,8 @@ namespace kagome::runtime::binaryen {
                  outcome::result<RuntimeEnvironment>(
                      const storage::trie::RootHash &state_root));
 
+    MOCK_CONST_METHOD0(latestStateRoot, storage::trie::RootHash());
+
     MOCK_METHOD0(reset, void());
   };
 
@@ -0,0 +1,34 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_RUNTIME_WASM_MODULE_MOCK_HPP
+#define KAGOME_TEST_MOCK_CORE_RUNTIME_WASM_MODULE_MOCK_HPP
+
+#include "runtime/binaryen/module/wasm_module.hpp"
+
+#include <gmock/gmock.h>
+
+namespace kagome::runtime::binaryen {
+
+  class WasmModuleMock : public WasmModule {
+   public:
+    MOCK_CONST_METHOD1(instantiate,
+                       std::unique_ptr<WasmModuleInstance>(
+                           const std::shared_ptr<RuntimeExternalInterface> &));
+  };
+
+  class WasmModuleInstanceMock : public WasmModuleInstance {
+   public:
+    MOCK_METHOD2(callExportFunction,
+                 wasm::Literal(wasm::Name,
+                               const std::vector<wasm::Literal> &));
+    MOCK_METHOD1(getExportGlobal, wasm::Literal(wasm::Name));
+    MOCK_METHOD0(reset, void());
+    MOCK_METHOD0(restoreGlobals, void());
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_TEST_MOCK_CORE_RUNTIME_WASM_MODULE_MOCK_HPP
@@ -14,7 +14,12 @@ namespace kagome::runtime {
 
   class WasmProviderMock: public WasmProvider {
    public:
-    MOCK_CONST_METHOD0(getStateCode, const common::Buffer &());
+    MOCK_CONST_METHOD1(getStateCodeAt,
+                       const common::Buffer &(const storage::trie::RootHash &));
+
+    MOCK_CONST_METHOD1(
+        getStateCodeHashAt,
+        const common::Hash256 &(const storage::trie::RootHash &));
   };
 
 }
@@ -42,7 +42,13 @@ namespace kagome::storage::trie {
 
     MOCK_METHOD0(commit, outcome::result<storage::trie::RootHash>());
 
+    MOCK_METHOD0(calculateRoot, outcome::result<storage::trie::RootHash>());
+
     MOCK_METHOD0(batchOnTop, std::unique_ptr<TopperTrieBatch>());
+
+    MOCK_METHOD2(append,
+                 outcome::result<void>(const common::Buffer &,
+                                       const common::Buffer &));
   };
 
   class EphemeralTrieBatchMock : public EphemeralTrieBatch {
@@ -50,6 +56,10 @@ namespace kagome::storage::trie {
     MOCK_CONST_METHOD1(get,
                        outcome::result<common::Buffer>(const common::Buffer &));
 
+    MOCK_CONST_METHOD2(getStoredValue,
+                       outcome::result<PolkadotTrie::StoredValue>(
+                           const common::Buffer &, const common::Buffer &));
+
     // issue with gmock when mocks cannot return unique_ptr. Resolved as in
     // https://stackoverflow.com/a/11548191
     MOCK_METHOD0(trieCursorProxy, PolkadotTrieCursor *());
@@ -77,12 +87,26 @@ namespace kagome::storage::trie {
                      boost::optional<uint64_t> limit));
 
     MOCK_CONST_METHOD0(empty, bool());
+
+    MOCK_METHOD2(append,
+                 outcome::result<void>(const common::Buffer &,
+                                       const common::Buffer &));
   };
 
   class TopperTrieBatchMock : public TopperTrieBatch {
    public:
     MOCK_METHOD0(writeBack, outcome::result<void>());
 
+    MOCK_METHOD2(append,
+                 outcome::result<void>(const common::Buffer &,
+                                       const common::Buffer &));
+
+    MOCK_METHOD0(startTransaction, void());
+
+    MOCK_METHOD0(rollbackTransaction, void());
+
+    MOCK_METHOD0(commitTransaction, void());
+
     MOCK_CONST_METHOD1(get,
                        outcome::result<common::Buffer>(const common::Buffer &));
 
@@ -19,10 +19,14 @@ namespace kagome::runtime {
     const common::Buffer &getStateCodeAt(
         const primitives::BlockHash &at) const override;
 
+    const common::Hash256 &getStateCodeHashAt(
+        const primitives::BlockHash &at) const override;
+
    private:
     void initialize(std::string_view path);
 
     kagome::common::Buffer buffer_;
+    kagome::common::Hash256 hash_;
   };
 
 }  // namespace kagome::runtime